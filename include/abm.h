@@ -60,6 +60,15 @@ public:
 	// Initialization and object construction
 	//
 
+	/**
+	 * \brief Seed all random number generators for a reproducible run
+	 * \details Call before creating the agents; without it every run 
+	 * 		is seeded from a random device
+	 * @param seed - run seed
+	 */
+	void set_seed(const uint64_t seed)
+		{ infection.set_seed(seed); flu.set_seed(seed); }
+
 	/**
 	 * \brief Create households based on information in a file
 	 * \details Constructs households based on the ID and
@@ -171,6 +180,20 @@ public:
 	 */	
 	void create_agents(const std::string filename, const int ninf0 = 0);
 
+	/**
+	 * \brief Create places, mobility, and agents from a population image
+	 * \details Image is compiled from the text files with PopulationImage::compile
+	 *		(scripts/population_image/); it is memory-mapped and its records are 
+	 *		used as they are, without parsing; same as calling all the create_ 
+	 *		functions and initialize_mobility() with the text files, so mobility 
+	 *		settings need to be made before this call. Throws std::runtime_error 
+	 *		if the file is not a population image of this version. 
+	 *	
+	 * @param filename - path of the population image
+	 * @param ninf0 - number of initially infected - overwriting the agent records 
+	 */	
+	void create_population(const std::string filename, const int ninf0 = 0);
+
 	/// Start with N_inf agents that have COVID-19 in various stages
 	void initialize_active_cases(const int N_inf);
 
@@ -186,6 +209,21 @@ public:
 	/// Initialization for vaccination vs. reopening studies
 	void initialize_vac_and_reopening();
 
+	/**
+	 * \brief Replace the closures and reopenings with a schedule from a file
+	 * \details By default the schedule is school closure, lockdown, and 
+	 * 		reopening phases 1 to 3 from infection parameters; each line in 
+	 * 		the file is one event as time | target | value, where the target is
+	 * 		one of PolicySchedule::targets() and can have more than one word, e.g.
+	 * 		
+	 * 			29.0 businesses 0.1
+	 * 			34.0 outside workplaces 0.35 
+	 *
+	 * 		Throws std::invalid_argument for unsupported targets or incomplete lines
+	 * @param fname - path of the file with the schedule
+	 */
+	void load_policy_schedule(const std::string& fname);
+
 	//
 	// Transmission of infection
 	//
@@ -211,12 +249,130 @@ public:
 	/// Update transmission dynamics in leisure locations outside of the town
 	void set_outside_leisure_transmission();
 
+	/**
+	 * \brief Set transmission in places outside of the town from a prevalence
+	 * \details Used when towns are coupled; prevalence replaces the estimated
+	 *		fraction of infected - it is the contribution of outside workplaces
+	 *		and, times the leisure locations transmission rate, of outside 
+	 *		leisure locations
+	 * @param prevalence - fraction of infected where outside places are
+	 */
+	void set_outside_prevalence(const double prevalence);
+
 	/// \brief Count contributions of all infectious agents in each place 
 	void compute_place_contributions();
 
+	/**
+	 * \brief Compute place contributions using multiple threads
+	 * \details Agents are split in contiguous chunks between threads,
+	 * 		and place sums are accumulated in agent order after all
+	 * 		threads are done - results are identical to a serial run
+	 * @param n_threads - number of threads, 1 is serial (default)
+	 */
+	void set_parallel_contributions(const int n_threads)
+		{ n_contribution_threads = std::max(1, n_threads); }
+
+	/**
+	 * \brief Split the model between local processes
+	 * \details Households and retirement homes, and the agents living
+	 *		in them, are divided between ranks in contiguous ranges with 
+	 *		similar numbers of residents; agents without a home are 
+	 *		divided by index. Each rank then computes contributions and 
+	 *		transitions only of its own agents; agents of other ranks are
+	 *		removed from its places, from its flu pools, and from loops 
+	 *		and counts of the agent store, and leisure tables of their 
+	 *		households are freed. Counters and daily statistics of each 
+	 *		rank cover its own agents, totals are their sums over ranks.
+	 *
+	 *		Every other place has an owner rank - the rank of most of its
+	 *		agents, or by ID if it has none. Copies of a place owned by 
+	 *		another rank are ghosts; at each step a rank sends sums of 
+	 *		the ghosts its agents use - places they are linked to, all 
+	 *		hospitals, and places they visit in leisure - to the owners, 
+	 *		which add them up and send the totals back. Places used by
+	 *		one rank only are not exchanged.
+	 *
+	 *		All ranks should hold the same model, e.g. forked after it was
+	 *		initialized, and call it together; agent objects are kept so 
+	 *		that IDs stay valid, those of other ranks are not updated. Each 
+	 *		rank draws from its own random number streams, so results 
+	 *		depend on the number of ranks. The model only refers to ranks,
+	 *		call clear_domain() before they are destroyed
+	 * @param ranks - group of processes
+	 */
+	void set_domain(LocalRanks& ranks);
+
+	/// Stop exchanging sums of ghost places, the model still holds only agents of this rank
+	void clear_domain() { domain.ranks = nullptr; }
+
+	/// Rank that computes agent with this ID, 0 if not split
+	int get_agent_rank(const int agent_ID) const
+		{ return domain.agent_ranks.empty() ? 0 : domain.agent_ranks.at(agent_ID - 1); }
+
+	/**
+	 * \brief Rank that owns a place, 0 if not split
+	 * @param type - type of the place, as in the population image
+	 * @param place_ID - ID of the place
+	 */
+	int get_place_rank(const PopulationImage::Table type, const int place_ID) const
+		{ return domain.agent_ranks.empty() ? 0 : domain.owners.at(type).at(place_ID - 1); }
+
 	/// \brief Propagate infection and determine state transitions
 	void compute_state_transitions();
 
+	/**
+	 * \brief Compute state transitions using multiple threads
+	 * \details Agents are split in contiguous chunks between threads,
+	 * 		each with its own counters; random numbers of every agent come 
+	 * 		from a stream keyed by the seed, agent ID, and time step; changes 
+	 * 		to places and flu are stored and applied in agent order after 
+	 * 		all threads are done - new flu agents chosen in that step are 
+	 * 		processed starting with the next step; for a given seed results
+	 * 		are the same for any number of threads 
+	 * @param n_threads - number of threads, 0 is the serial default without
+	 * 		deferred changes
+	 */
+	void set_parallel_transitions(const int n_threads)
+		{ n_transition_threads = std::max(0, n_threads); }
+
+	/**
+	 * \brief Evaluate only susceptible agents in places with infected
+	 * \details After contributions are computed, places with a nonzero
+	 * 		contribution are collected; susceptible agents without flu
+	 * 		and without any of these places have zero probability of 
+	 * 		infection and skip their transitions; results with 
+	 * 		multithreaded transitions are unchanged, in serial runs the 
+	 * 		skipped agents no longer draw random numbers
+	 * @param val - true to enable, default false 
+	 */
+	void set_place_driven_susceptibles(const bool val)
+		{ place_driven_susceptibles = val; }
+
+	/**
+	 * \brief Record time and work counters of each phase of every step
+	 * \details Recorded in transmit_infection() and 
+	 *		transmit_ideal_testing_vac_reopening(); can be switched
+	 *		on and off during a run, records made so far are kept 
+	 * @param val - true to record, default false 
+	 */
+	void set_profiling(const bool val) { profiler.set_enabled(val); }
+
+	/**
+	 * \brief Drop least probable public leisure locations of each household 
+	 * \details Needs to be called before initialize_mobility(); reduces memory 
+	 * 		of leisure probabilities for large towns, see Mobility::set_truncation_tail
+	 * @param tail - fraction of the probability mass to drop, in [0.0, 1.0), default 0.0 
+	 */
+	void set_leisure_truncation_tail(const double tail)
+		{ mobility.set_truncation_tail(tail); }
+
+	/**
+	 * \brief Construct leisure probabilities in initialize_mobility() using multiple threads
+	 * @param n_threads - number of threads, 1 is serial (default)
+	 */
+	void set_parallel_mobility(const int n_threads)
+		{ mobility.set_number_of_threads(n_threads); }
+
 	/// \brief Set the lambda factors to 0.0
 	void reset_contributions()
 		{ contributions.reset_sums(households, schools, workplaces, hospitals, 
@@ -238,6 +394,8 @@ public:
 	int get_num_exposed() const;
 	/// Number of infected - confirmed
 	int get_num_active_cases() const;
+	/// Fraction of infected among agents that are alive
+	double get_prevalence() const;
 	std::vector<int> get_treatment_data() const;
 	/// Current simulation time
 	double get_time() const { return time; }
@@ -283,6 +441,37 @@ public:
 	/// Save the infected agent data to file fname
 	void save_infected_data(const std::string& fname) const;
 
+	/**
+	 * \brief Save the full simulation state to a binary file
+	 * \details Stores agents, places and their members, testing, flu,
+	 * 		mobility, parameters, counters and daily data, and states of 
+	 * 		the random number generators; settings of the computation 
+	 * 		such as number of threads are not stored 
+	 * @param fname - path of the checkpoint file
+	 */
+	void save_checkpoint(const std::string& fname) const;
+
+	/**
+	 * \brief Restore the simulation state saved with save_checkpoint()
+	 * \details Replaces the whole state of this object, which can be
+	 * 		default-constructed; a run continued from the checkpoint with
+	 *		the same computation settings is identical to the original run.
+	 * 		Throws std::runtime_error if the file is not a checkpoint 
+	 *		of this version. 
+	 * @param fname - path of the checkpoint file
+	 */
+	void load_checkpoint(const std::string& fname);
+
+	/**
+	 * \brief Write the simulation state to a stream in the checkpoint format
+	 * \details E.g. to keep a copy of an initialized model in memory
+	 * @param out - stream opened in binary mode
+	 */
+	void save_checkpoint(std::ostream& out) const;
+
+	/// Restore the simulation state written with save_checkpoint(std::ostream&) 
+	void load_checkpoint(std::istream& in);
+
 	/**
 	 * \brief Save infection parameter information
 	 *
@@ -414,6 +603,32 @@ public:
 	*/
 	void print_agents(const std::string filename) const;	
 
+	/**
+	 * \brief Save current agent information without waiting for the write
+	 * \details Same output as print_agents; the fields are copied into
+	 * 		a buffer of the writer and written in its thread 
+	 * @param filename - path of the file to print to
+	 * @param writer - writer that saves the file
+	 */
+	void print_agents(const std::string& filename, AsyncWriter<Agent::Snapshot>& writer) const;
+
+	/**
+	 * \brief Save the step profile as JSON
+	 * \details Totals of each phase and records of each step,
+	 *		see set_profiling() 
+	 * @param filename - path of the file to print to
+	 */
+	void print_profile(const std::string& filename) const
+		{ profiler.write_json(filename); }
+
+	/**
+	 * \brief Save the step profile as a Chrome trace
+	 * \details Can be opened in chrome://tracing or Perfetto
+	 * @param filename - path of the file to print to
+	 */
+	void print_profile_trace(const std::string& filename) const
+		{ profiler.write_chrome_trace(filename); }
+
 	/// Saves the matrix with mobility probabilities
 	void print_mobility_probabilities(const std::string fname)
 		{ mobility.print_probabilities(fname); }
@@ -440,8 +655,11 @@ public:
 	const std::vector<Leisure>& get_vector_of_leisure_locations() const { return leisure_locations; }
 	/// Return a const reference to an Agent object vector
 	const std::vector<Agent>& get_vector_of_agents() const { return agents; }
+	/// Return a const reference to the Mobility object, e.g. for truncation errors
+	const Mobility& get_mobility() const { return mobility; }
 
-	/// Return a non-const reference to an Agent object vector
+	/// Return a non-const reference to an Agent object vector, 
+	/// agents can be changed but not added or removed
 	std::vector<Agent>& vector_of_agents() { return agents; }
 	/// Return a reference to a Hospital object vector
 	std::vector<Hospital>& vector_of_hospitals() { return hospitals; }
@@ -460,7 +678,8 @@ public:
 	/// Return a reference to a vector of leisure locations 
 	std::vector<Leisure>& vector_of_leisure_locations() { return leisure_locations; }
 
-	/// Return a reference to an Agent object vector
+	/// Return a reference to an Agent object vector, 
+	/// agents can be changed but not added or removed
 	std::vector<Agent>& get_vector_of_agents_non_const()  { return agents; }
 	/// Return a copy of an Agent object vector
 	std::vector<Agent> get_copied_vector_of_agents() const { return agents; }
@@ -483,14 +702,22 @@ public:
 
 	/// Return a copy of Infection object
 	Infection get_copied_infection_object() const { return infection; }
-	/// Return a reference to an Infection object
-	Infection& get_infection_object() { return infection; }
+	/// Return a reference to an Infection object, per-thread copies are made again
+	Infection& get_infection_object() { thread_infections.clear(); return infection; }
 	/// Return a const reference to parameter map
 	const std::map<std::string, double>& get_infection_parameters() const
 		{ return infection_parameters; }
-	/// Return a reference to parameter map
-	std::map<std::string, double>& get_infection_parameters() 
-		{ return infection_parameters; }
+	/// Return a const reference to the parameters used in the simulation
+	const InfectionParameters& get_infection_params() const
+		{ return infection_params; }
+	/// Current multipliers of contributions by place type
+	const PlacePolicy& get_place_policy() const { return place_policy; }
+	/// Time and work counters of recorded steps
+	const StepProfiler& get_profiler() const { return profiler; }
+	/// Step profiler, e.g. to clear the records
+	StepProfiler& get_profiler() { return profiler; }
+	/// Closures and reopenings and how many were applied
+	const PolicySchedule& get_policy_schedule() const { return policy_schedule; }
 	/// Return a copy of the Flu object
 	Flu get_flu_object() const { return flu; }
 	/// Return a reference to Flu object
@@ -509,6 +736,25 @@ private:
 
 	using type_getter = bool(Agent::*)() const;
 
+	// Changes in counters from one step of transitions
+	struct TransitionCounts{
+		int infected = 0;
+		int recovering_exposed = 0;
+		int recovered = 0;
+		int dead_tested = 0;
+		int dead_not_tested = 0;
+		int tested = 0;
+		int tested_pos = 0;
+		int tested_neg = 0;
+		int tested_false_pos = 0;
+		int tested_false_neg = 0;
+		// Agents evaluated and agents with a changed state
+		int visited = 0;
+		int fired = 0;
+		// Newly infected, for data collection
+		std::vector<int> infected_IDs;
+	};
+
 	// General model attributes
 	// Time step
 	double dt = 1.0;
@@ -542,8 +788,11 @@ private:
 	// Contacts with time 
 	std::vector<std::vector<int>> agent_contacts;
 
-	// Infection parameters
+	// Infection parameters as loaded, kept up to date 
+	// with infection_params for output and tests
 	std::map<std::string, double> infection_parameters = {};
+	// Infection parameters used in the simulation
+	InfectionParameters infection_params;
 
 	// Age-dependent distributions
 	std::map<std::string, std::map<std::string, double>> age_dependent_distributions = {};
@@ -556,8 +805,64 @@ private:
 	Mobility mobility;
 	// Class for computing infection contributions
 	Contributions contributions;
+	// Number of threads for computing contributions
+	int n_contribution_threads = 1;
+	// Per-thread buffers with contributions to places
+	std::vector<std::vector<DeferredContribution>> contribution_buffers;
+	// Split of the model between local processes
+	struct Domain{
+		// Place of a type from the population image, by index
+		struct PlaceKey{
+			unsigned type;
+			int index;
+			bool operator<(const PlaceKey& other) const
+				{ return type < other.type || (type == other.type && index < other.index); }
+			bool operator==(const PlaceKey& other) const
+				{ return type == other.type && index == other.index; }
+		};
+		// Processes, nullptr if not split or cleared
+		LocalRanks* ranks = nullptr;
+		// Rank of this process
+		int rank = 0;
+		// Rank of each agent, in order of agents, empty if not split
+		std::vector<int> agent_ranks;
+		// Number of agents of ranks before each rank, and of all ranks
+		std::vector<long> rank_offsets;
+		// Owner rank of each place by type, in order of places
+		std::array<std::vector<int>, PopulationImage::agents> owners;
+		// Ghosts that agents of this rank are linked to, 
+		// and those they visit in leisure at this step
+		std::vector<PlaceKey> linked_ghosts, leisure_ghosts;
+		// Sums sent to owners and back, one buffer per rank
+		std::vector<std::vector<double>> messages;
+	};
+	Domain domain;
 	// Class for computing agent transitions
 	Transitions transitions;
+	// Number of threads for computing transitions,
+	// 0 for serial without deferred changes
+	int n_transition_threads = 0;
+	// Per-thread buffers with changes to places and flu
+	std::vector<std::vector<SharedChange>> change_buffers;
+	// Per-thread copies of infection, made once and given
+	// the generator state of infection at each step
+	std::vector<Infection> thread_infections;
+	// True if only susceptible agents in places with infected 
+	// are evaluated
+	bool place_driven_susceptibles = false;
+	/// Places with nonzero infected contribution, flag per place
+	struct HotPlaces{
+		std::vector<char> households, schools, workplaces, hospitals,
+			retirement_homes, carpools, public_transit, leisure_locations;
+		// Total number of such places
+		int count = 0;
+	};
+	// Places with infected at this step
+	HotPlaces hot_places;
+	// Infected agents by the step of their next timed transition
+	EventCalendar transition_calendar;
+	// Time and work of each phase of a step
+	StepProfiler profiler;
 	// Class for setting agent state transitions
 	StatesManager states_manager;
 	// Class for creating and maintaining a population
@@ -566,6 +871,8 @@ private:
 
 	// Vectors of individual model objects
 	std::vector<Agent> agents;
+	// Columnar copy of agents for population-wide loops
+	AgentStore agent_store;
 	std::vector<Household> households;
 	std::vector<RetirementHome> retirement_homes;
 	std::vector<School> schools;
@@ -582,11 +889,15 @@ private:
 	std::string vaccine_group_name;
 	bool vac_verbose = false;
 	
+	// Closures and reopenings
+	// Multipliers of contributions by place type
+	PlacePolicy place_policy;
+	// Changes of the multipliers with time
+	PolicySchedule policy_schedule;
+	// Fraction going to leisure locations with all businesses open
+	double open_leisure_fraction = 0.0;
+
 	// Leisure properties
-	// Initial transmissiont rate
-	double ini_beta_les = 0.0;
-	// Difference between initial and final transmission rate
-	double del_beta_les = 0.0;
 	// Initial fraction going to leisure locations
 	double ini_frac_les = 0.0;
 	// Difference between initial and final fraction
@@ -598,10 +909,101 @@ private:
 	std::vector<std::map<std::string, bool>> agent_prop_bool_flags;
 	std::vector<std::map<std::string, double>> agent_prop_doubles;
 
+	// Checkpoint file type and format version
+	static const std::string checkpoint_kind;
+	static const uint32_t checkpoint_version = 2;
+
 	// Private methods
 	/// Collect the information on infected agent
 	void collect_infected_properties(const Agent& agent);
 
+	/// Columnar copy of the agents, updated by the agents from then on
+	void attach_agents_to_store();
+	/// Places of one type keep slots of agents linked by roles in the store
+	template <typename T>
+	void link_to_store(std::vector<T>& places, const unsigned roles)
+	{
+		for (auto& place : places){
+			place.link_to_store(agent_store, roles);
+		}
+	}
+	// True if each agent updates its own row of the store
+	bool agents_attached();
+
+	/// Read or write the simulation state, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar);
+
+	/// Compartments of agents that can contribute to places
+	static uint64_t contributing_compartments();
+	/// Compartments of agents skipped in contributions and transitions
+	static uint64_t inactive_compartments();
+
+	/// True if the agent adds to places or hospital testing counts at this step
+	bool adds_contributions(const AgentStore::View& agent) const;
+	/// True if agent with index i is computed in this process
+	bool local_agent(const size_t i) const
+		{ return domain.agent_ranks.empty() || domain.agent_ranks[i] == domain.rank; }
+	/// Part of n for this process, in proportion to its agents; n if not split
+	int local_share(const int n) const;
+
+	/// Places an agent is linked to other than in leisure and hospitals
+	void linked_places(const Agent& agent, std::vector<Domain::PlaceKey>& keys) const;
+	/// Place with this key
+	Place& place_at(const Domain::PlaceKey& key);
+	/// Remove agents of other processes from places
+	template <typename T>
+	void keep_local_agents(std::vector<T>& places);
+	/// List a place visited in leisure at this step if it is a ghost
+	void add_leisure_ghost(const bool is_house, const int loc_ID);
+	/// Send sums of ghosts to their owners, replace them with totals sent back
+	void exchange_place_sums();
+
+	/// Start a phase of the step profile
+	void start_phase(const StepProfiler::Phase phase)
+		{ if (profiler.enabled()) profiler.start(phase, rng_draws()); }
+	/// Stop the current phase of the step profile
+	void stop_phase()
+		{ if (profiler.enabled()) profiler.stop(rng_draws()); }
+	/// Random numbers drawn by the model so far
+	uint64_t rng_draws() const
+		{ return infection.get_rng_draws() + flu.get_rng_draws(); }
+
+	/// Collect places with nonzero infected contribution
+	void collect_hot_places();
+	/// Flag places with nonzero infected contribution, return their number
+	template <typename T>
+	static int mark_hot_places(const std::vector<T>& places, std::vector<char>& hot);
+	/// True if the agent has no transitions since no place can infect it
+	bool skips_transitions(const AgentStore::View& agent) const;
+
+	/**
+	 * \brief Mark infected agents with transitions due at this step
+	 * \details Agents changed since their last transitions are scheduled 
+	 *		again first; if steps are not consecutive all infected are 
+	 *		scheduled again 
+	 * @param step - index of the current step
+	 */
+	void mark_due_transitions(const long step);
+
+	/// Count contributions of a single agent to places using contr
+	void compute_agent_contributions(const Agent& agent, Contributions& contr); 
+
+	/// Transitions of a single agent, changes in counters stored in counts
+	void compute_agent_transitions(Agent& agent, Transitions& tr, 
+							Infection& inf, TransitionCounts& counts);
+
+	/// Add changes from one step of transitions to totals and daily data
+	void add_transition_counts(const TransitionCounts& counts);
+
+	/**
+	 * \brief Apply changes to places and flu stored during transitions
+	 * \details Flu swaps are applied last so that agents infected 
+	 *		in this step cannot be chosen as new flu agents 
+	 * @param buffers - changes from each thread, in agent order 
+	 */
+	void apply_shared_changes(const std::vector<std::vector<SharedChange>>& buffers);
+
 	/// Set initial values on all the data collection variables and containers
 	void initialize_data_collection();
 
@@ -614,11 +1016,12 @@ private:
 	/// Initialize testing and its time dependence
 	void load_testing(const std::string);
 
-	/**
-	 * \brief Read object information from a file	
-	 * @param filename - path of the file to print to
-	 */
-	std::vector<std::vector<std::string>> read_object(std::string filename);
+	/// Closures and reopenings from infection parameters
+	void set_default_policy_schedule();
+	/// Apply a single closure or reopening 
+	void apply_policy_event(const PolicySchedule::Event& event, std::vector<Workplace>& workplaces);
+	/// Multiplier of public transit contributions when a fraction of businesses is open
+	double public_transit_multiplier(const double fraction) const;
 
 	/// \brief Set properties of initially infected - exposed
 	void initial_exposed(Agent&);
@@ -644,11 +1047,11 @@ private:
 	 * \brief Print basic places information to a file
 	 */
 	template <typename T>
-	void print_places(std::vector<T> places, const std::string fname) const;
+	void print_places(const std::vector<T>& places, const std::string fname) const;
 
 	/// \brief Print all agent IDs in a particular type of place to a file
 	template <typename T>
-	void print_agents_in_places(std::vector<T> places, const std::string fname) const;
+	void print_agents_in_places(const std::vector<T>& places, const std::string fname) const;
 
 	/**
 	 * \brief Retrieve information about agents from a file and store all in a vector
@@ -656,6 +1059,24 @@ private:
 	 */
 	void load_agents(const std::string fname, const int ninf0 = 0);
 
+	//
+	// Object construction from records of text files or of a population image
+	//
+
+	using place_range = PopulationImage::Records<PopulationImage::PlaceRecord>;
+
+	void add_households(const place_range& records);
+	void add_retirement_homes(const place_range& records);
+	void add_schools(const place_range& records);
+	void add_workplaces(const place_range& records);
+	void add_hospitals(const place_range& records);
+	void add_carpools(const place_range& records);
+	void add_public_transit(const place_range& records);
+	void add_leisure_locations(const place_range& records);
+	/// Create agents, ninf0 as in load_agents 
+	void add_agents(const PopulationImage::Records<PopulationImage::AgentRecord>& records, 
+						const int ninf0);
+
 	/**
 	 * \brief Assign agents to households, schools, and worplaces
 	 */
@@ -667,7 +1088,7 @@ private:
 
 // Write Place objects
 template <typename T>
-void ABM::print_places(std::vector<T> places, const std::string fname) const
+void ABM::print_places(const std::vector<T>& places, const std::string fname) const
 {
 	// AbmIO settings
 	std::string delim(" ");
@@ -681,7 +1102,7 @@ void ABM::print_places(std::vector<T> places, const std::string fname) const
 
 // Write agent IDs in Place objects
 template <typename T>
-void ABM::print_agents_in_places(std::vector<T> places, const std::string fname) const
+void ABM::print_agents_in_places(const std::vector<T>& places, const std::string fname) const
 {
 	// AbmIO settings
 	std::string delim(" ");
@@ -704,4 +1125,55 @@ void ABM::print_agents_in_places(std::vector<T> places, const std::string fname)
 	abm_io.write_vector<int>(agents_all_places);
 }
 
+// Flag places with nonzero infected contribution, return their number
+template <typename T>
+int ABM::mark_hot_places(const std::vector<T>& places, std::vector<char>& hot)
+{
+	int n_hot = 0;
+	hot.assign(places.size(), 0);
+	for (size_t i = 0; i < places.size(); ++i){
+		if (places[i].get_infected_contribution() > 0.0){
+			hot[i] = 1;
+			++n_hot;
+		}
+	}
+	return n_hot;
+}
+
+// Remove agents of other processes from places
+template <typename T>
+void ABM::keep_local_agents(std::vector<T>& places)
+{
+	for (auto& place : places){
+		for (const auto& aID : place.get_agent_IDs()){
+			if (!local_agent(aID - 1)){
+				place.remove_agent(aID);
+			}
+		}
+	}
+}
+
+// Read or write the simulation state, for checkpoints
+template <typename Archive>
+void ABM::serialize(Archive& ar)
+{
+	ar(dt, time);
+	ar(n_infected_tot, n_dead_tot, n_dead_tested, n_dead_not_tested, 
+		n_recovered_tot, n_recovering_exposed, tot_tested, tot_tested_pos, 
+		tot_tested_neg, tot_tested_false_pos, tot_tested_false_neg);
+	ar(n_infected_day, n_dead_day, n_recovered_day, tested_day, tested_pos_day,
+		tested_neg_day, tested_false_pos_day, tested_false_neg_day, agent_contacts);
+	ar(infection_parameters, age_dependent_distributions);
+	if (ar.is_loading() && !infection_parameters.empty()) {
+		infection_params = InfectionParameters(infection_parameters);
+	}
+	ar(infection, testing, mobility, flu);
+	ar(agents, households, retirement_homes, schools, workplaces, hospitals,
+		carpools, public_transit, leisure_locations);
+	ar(random_vaccines, n_vaccinated, group_vaccines, vaccine_group_name, vac_verbose);
+	ar(place_policy, policy_schedule, open_leisure_fraction);
+	ar(ini_frac_les, del_frac_les);
+	ar(collect_data, agent_prop_string_values, agent_prop_bool_flags, agent_prop_doubles);
+}
+
 #endif
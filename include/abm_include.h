@@ -13,6 +13,7 @@
 #include "places/hospital.h"
 #include "places/transit.h"
 #include "places/leisure.h"
+#include "places/place_policy.h"
 
 //
 // Transitions
@@ -33,8 +34,16 @@
 #include "common.h"
 #include "./io_operations/abm_io.h"
 #include "./io_operations/load_parameters.h"
+#include "./io_operations/binary_archive.h"
+#include "./io_operations/population_image.h"
+#include "./io_operations/async_writer.h"
 #include "agent.h"
 #include "infection.h"
+#include "infection_parameters.h"
+#include "policy_schedule.h"
+#include "event_calendar.h"
+#include "local_ranks.h"
+#include "step_profiler.h"
 #include "testing.h"
 #include "contributions.h"
 #include "flu.h"
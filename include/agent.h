@@ -3,6 +3,8 @@
 
 #include "common.h"
 #include "infection.h"
+#include "agent_store.h"
+#include <type_traits>
 
 class Infection;
 
@@ -55,12 +57,22 @@ public:
 			const bool worksHospital, const int hospitalID, const bool infected, 
 			const std::string wt_mode, const double wt_time, 
 			const int cp_ID, const int pt_ID, const bool wfh) 
-			: is_student(student), is_working(works), age(yrs),
-		   		x(xi), y(yi), house_ID(houseID), is_non_covid_patient(isPatient), school_ID(schoolID), 
-				livesRH(lvRH), worksRH(wrkRH), worksSch(wrkSch), work_ID(workID),  
-				works_at_hospital(worksHospital), hospital_ID(hospitalID), is_infected(infected), 
-				work_travel_mode(wt_mode), work_travel_time(wt_time), carpool_ID(cp_ID), 
-				public_transit_ID(pt_ID), works_remotely(wfh){ }  
+			: age(yrs), x(xi), y(yi), house_ID(houseID), school_ID(schoolID), 
+				work_ID(workID), hospital_ID(hospitalID), carpool_ID(cp_ID), 
+				public_transit_ID(pt_ID), work_travel_time(wt_time), work_travel_mode(wt_mode)
+	{ 
+		state.set(AgentState::student, student);
+		state.set(AgentState::works, works);
+		state.set(AgentState::hospital_non_covid_patient, isPatient);
+		state.set(AgentState::retirement_home_resident, lvRH);
+		state.set(AgentState::retirement_home_employee, wrkRH);
+		state.set(AgentState::school_employee, wrkSch);
+		state.set(AgentState::hospital_employee, worksHospital);
+		state.set(AgentState::infected, infected);
+		state.set(AgentState::works_from_home, wfh);
+		state.set(AgentState::travels_by_carpool, wt_mode == "carpool");
+		state.set(AgentState::travels_by_public_transit, wt_mode == "public");
+	}  
 
 	//
 	// Infection related computations
@@ -105,58 +117,61 @@ public:
 	double get_y_location() const { return y; }
 
 	/// True if infected
-	bool infected() const { return is_infected; }
+	bool infected() const { return state.has(AgentState::infected); }
 	/// True if student
-	bool student() const { return is_student; }
+	bool student() const { return state.has(AgentState::student); }
 	/// True if agent works
-	bool works() const { return is_working; }
+	bool works() const { return state.has(AgentState::works); }
 	/// True if agent works at a hospital
-	bool hospital_employee() const { return works_at_hospital; }
+	bool hospital_employee() const { return state.has(AgentState::hospital_employee); }
 	/// True if agent is a hospital patient with condition other than COVID
-	bool hospital_non_covid_patient() const { return is_non_covid_patient; }
+	bool hospital_non_covid_patient() const { return state.has(AgentState::hospital_non_covid_patient); }
 	/// True if agent works in a retirement home 
-	bool retirement_home_employee() const { return worksRH; }
+	bool retirement_home_employee() const { return state.has(AgentState::retirement_home_employee); }
 	/// True if agent works at a school
-	bool school_employee() const { return worksSch; }
+	bool school_employee() const { return state.has(AgentState::school_employee); }
 	/// True if agent lives in a retirement home 
-	bool retirement_home_resident() const { return livesRH; }
+	bool retirement_home_resident() const { return state.has(AgentState::retirement_home_resident); }
 	/// True if agent works from home
-	bool works_from_home() const { return works_remotely; }
+	bool works_from_home() const { return state.has(AgentState::works_from_home); }
 
 	/// State getters
-	bool exposed() const { return is_exposed; }
-	bool recovering_exposed() const { return is_recovering_exposed; }
-	bool symptomatic() const { return is_symptomatic; }
-	bool symptomatic_non_covid() const { return is_symptomatic_non_covid;}
+	bool exposed() const { return state.has(AgentState::exposed); }
+	bool recovering_exposed() const { return state.has(AgentState::recovering_exposed); }
+	bool symptomatic() const { return state.has(AgentState::symptomatic); }
+	bool symptomatic_non_covid() const { return state.has(AgentState::symptomatic_non_covid); }
 	// Testing results
-	bool tested_covid_negative() const { return is_tested_covid_negative; }
-	bool tested_false_negative() const { return is_tested_false_negative; }
-	bool tested_false_positive() const { return is_tested_false_positive; }
-	bool tested_covid_positive() const { return is_tested_covid_positive; }
+	bool tested_covid_negative() const { return state.has(AgentState::tested_covid_negative); }
+	bool tested_false_negative() const { return state.has(AgentState::tested_false_negative); }
+	bool tested_false_positive() const { return state.has(AgentState::tested_false_positive); }
+	bool tested_covid_positive() const { return state.has(AgentState::tested_covid_positive); }
 	// Testing phases and types 
-	bool tested() const { return is_tested; }
-	bool tested_exposed() const { return is_tested_exposed; }
-	bool tested_in_car() const { return is_tested_in_car; }
-	bool tested_in_hospital() const { return is_tested_in_hospital; }
-	bool tested_awaiting_results() const { return is_tested_awaiting_results; }
-	bool tested_awaiting_test() const { return is_tested_awaiting_test; } 
+	bool tested() const { return state.has(AgentState::tested); }
+	bool tested_exposed() const { return state.has(AgentState::tested_exposed); }
+	bool tested_in_car() const { return state.has(AgentState::tested_in_car); }
+	bool tested_in_hospital() const { return state.has(AgentState::tested_in_hospital); }
+	bool tested_awaiting_results() const { return state.has(AgentState::tested_awaiting_results); }
+	bool tested_awaiting_test() const { return state.has(AgentState::tested_awaiting_test); } 
 	double get_time_for_flu_isolation() { return time_flu_ih; }
-	bool get_testing_since_exposed() { return is_testing_since_exposed; }
+	bool get_testing_since_exposed() { return state.has(AgentState::testing_since_exposed); }
 	// Treatment types
-	bool being_treated() const { return is_treated; }
-	bool home_isolated() const { return is_home_isolated; }
-	bool hospitalized() const { return is_hospitalized; }
-	bool hospitalized_ICU() const { return is_hospitalized_ICU; }
+	bool being_treated() const { return state.has(AgentState::being_treated); }
+	bool home_isolated() const { return state.has(AgentState::home_isolated); }
+	bool hospitalized() const { return state.has(AgentState::hospitalized); }
+	bool hospitalized_ICU() const { return state.has(AgentState::hospitalized_ICU); }
 	// Treatment - as set for regular agent
-	bool get_will_be_hospitalized() const { return will_be_hospitalized; }
-	bool get_will_be_hospitalized_ICU() const { return will_be_in_ICU; }
-	bool get_will_be_home_isolated() const { return will_be_home_isolated; }
+	bool get_will_be_hospitalized() const { return state.has(AgentState::will_be_hospitalized); }
+	bool get_will_be_hospitalized_ICU() const { return state.has(AgentState::will_be_in_ICU); }
+	bool get_will_be_home_isolated() const { return state.has(AgentState::will_be_home_isolated); }
 	// Removal
-	bool dying() const { return will_die; }
-	bool recovering() const { return will_recover; }
-	bool removed() const { return is_removed; }
-	bool removed_dead() const { return is_removed_dead; }
-	bool vaccinated() const { return is_vaccinated; }
+	bool dying() const { return state.has(AgentState::dying); }
+	bool recovering() const { return state.has(AgentState::recovering); }
+	bool removed() const { return state.has(AgentState::removed); }
+	bool removed_dead() const { return state.has(AgentState::removed_dead); }
+	bool vaccinated() const { return state.has(AgentState::vaccinated); }
+
+	/// Encoded state of the agent
+	const AgentState& get_state() const { return state; }
 
 	/// Get infectiousness variability factor of an agent
 	double get_inf_variability_factor() const { return inf_var; }
@@ -188,22 +203,32 @@ public:
 	//
 
 	/// Assign ID to an agent
-	void set_ID(const int agent_ID) { ID = agent_ID; }	
+	void set_ID(const int agent_ID) 
+		{ ID = agent_ID; store_row.set_ID(AgentStore::agent, ID); }	
 
 	/// Assign hospital ID for testing
-	void set_hospital_ID(const int ID) { hospital_ID = ID; }
+	void set_hospital_ID(const int ID) 
+		{ hospital_ID = ID; store_row.set_ID(AgentStore::hospital, ID); }
 
 	/// Leisure ID 
-	void set_leisure_ID(const int val) { leisure_location_ID = val; }
+	void set_leisure_ID(const int val) 
+		{ leisure_location_ID = val; store_row.set_ID(AgentStore::leisure, val); }
 	
 	/// Leisure type (household or public)
-	void set_leisure_type(const std::string val) { leisure_type = val; }
+	void set_leisure_type(const std::string val) 
+	{ 
+		leisure_type = val; 
+		set_flag(AgentState::leisure_household, val == "household"); 
+		set_flag(AgentState::leisure_public, val == "public"); 
+	}
 
 	/// Assign household ID
-	void set_household_ID(const int ID) { house_ID = ID; }
+	void set_household_ID(const int ID) 
+		{ house_ID = ID; store_row.set_ID(AgentStore::household, ID); }
 
 	/// Change infection status
-	void set_infected(const bool infected) { is_infected = infected; }
+	void set_infected(const bool infected) 
+		{ set_flag(AgentState::infected, infected); }
 
     // Occupation type ('A', 'B', 'C', 'D', or 'E' )
     void set_occupation(const std::string occ) { occupation = occ; }
@@ -215,87 +240,137 @@ public:
 	void set_latency_duration(const double ltime) { latency_duration = ltime; }
 	/// Compute latency end from current time
 	void set_latency_end_time(const double cur_time) 
-		{ latency_end_time = cur_time + latency_duration; }
+		{ latency_end_time = cur_time + latency_duration; 
+		  store_row.set_timer(AgentStore::latency_end, latency_end_time); }
 	/// Set tme when the pre-infectious period ends
 	void set_infectiousness_start_time(const double cur_time, const double dt) 
-		{ infectiousness_start = cur_time + dt; }
+		{ infectiousness_start = cur_time + dt; 
+		  store_row.set_timer(AgentStore::infectiousness_start, infectiousness_start); }
 
 	// Death 
 	/// Set onset to death duration time
 	void set_time_to_death(const double dtime) { otd_duration = dtime; }
 	/// Compute death time from current time
 	void set_death_time(const double cur_time) 
-		{ death_time = cur_time + otd_duration; }
+		{ death_time = cur_time + otd_duration; 
+		  store_row.set_timer(AgentStore::death_time, death_time); }
 
 	// Recovery
 	/// Set recovery duration time
 	void set_recovery_duration(const double rtime) { recovery_duration = rtime; }
 	/// Compute recovery end from current time
 	void set_recovery_time(const double cur_time) 
-		{ recovery_time = cur_time + recovery_duration; }
+		{ recovery_time = cur_time + recovery_duration; 
+		  store_row.set_timer(AgentStore::recovery_time, recovery_time); }
 
 	// Testing
 	void set_time_to_test(const double test_time) { time_to_test = test_time; }
-	void set_time_of_test(const double cur_time) { time_of_test = cur_time + time_to_test; }
+	void set_time_of_test(const double cur_time) 
+		{ time_of_test = cur_time + time_to_test; 
+		  store_row.set_timer(AgentStore::time_of_test, time_of_test); }
 
 	// Test results
 	void set_time_until_results(const double test_res_time) { time_until_results = test_res_time; }
-	void set_time_of_results(const double cur_time) { time_of_results = cur_time + time_until_results; }
+	void set_time_of_results(const double cur_time) 
+		{ time_of_results = cur_time + time_until_results; 
+		  store_row.set_timer(AgentStore::time_of_results, time_of_results); }
 
+	// Treatment timers are not stored in columns, setters 
+	// only mark the row as changed for the event calendar
 	/// Transition from hospital to ICU
-	void set_time_hsp_to_icu(const double t_icu) { time_hsp_to_ICU = t_icu; }
+	void set_time_hsp_to_icu(const double t_icu) { time_hsp_to_ICU = t_icu; store_row.touch(); }
 	/// Transition from hospital to home isolation
-	void set_time_hsp_to_ih(const double t_ih) { time_hsp_to_ih = t_ih; }
+	void set_time_hsp_to_ih(const double t_ih) { time_hsp_to_ih = t_ih; store_row.touch(); }
 	/// Transition from ICU to hospital
-	void set_time_icu_to_hsp(const double t_icu) { time_icu_to_hsp = t_icu; }
+	void set_time_icu_to_hsp(const double t_icu) { time_icu_to_hsp = t_icu; store_row.touch(); }
 	/// Transition from home isolation to ICU
-	void set_time_ih_to_icu(const double t_icu) { time_ih_to_icu = t_icu; }
+	void set_time_ih_to_icu(const double t_icu) { time_ih_to_icu = t_icu; store_row.touch(); }
 	/// Transition from home isolation to hospital
-	void set_time_ih_to_hsp(const double t_hsp) { time_ih_to_hsp = t_hsp; }
+	void set_time_ih_to_hsp(const double t_hsp) { time_ih_to_hsp = t_hsp; store_row.touch(); }
 
 	/// State setters
-	void set_exposed(const bool val) { is_exposed = val; }
-	void set_recovering_exposed(const bool re) { is_recovering_exposed = re; }
-	void set_symptomatic(const bool val) { is_symptomatic = val; }
-	void set_symptomatic_non_covid(const bool val) { is_symptomatic_non_covid = val; }
+	void set_exposed(const bool val) { set_flag(AgentState::exposed, val); }
+	void set_recovering_exposed(const bool re) { set_flag(AgentState::recovering_exposed, re); }
+	void set_symptomatic(const bool val) { set_flag(AgentState::symptomatic, val); }
+	void set_symptomatic_non_covid(const bool val) { set_flag(AgentState::symptomatic_non_covid, val); }
 
 	// Testing results
-	void set_tested_covid_negative(const bool val) { is_tested_covid_negative = val; }
-	void set_tested_false_negative(const bool val) { is_tested_false_negative = val; }
-	void set_tested_false_positive(const bool val) { is_tested_false_positive = val; }
-	void set_tested_covid_positive(const bool val) { is_tested_covid_positive = val; }
+	void set_tested_covid_negative(const bool val) { set_flag(AgentState::tested_covid_negative, val); }
+	void set_tested_false_negative(const bool val) { set_flag(AgentState::tested_false_negative, val); }
+	void set_tested_false_positive(const bool val) { set_flag(AgentState::tested_false_positive, val); }
+	void set_tested_covid_positive(const bool val) { set_flag(AgentState::tested_covid_positive, val); }
 	// Testing phases and types
-	void set_tested(const bool val) { is_tested = val; }
-	void set_tested_in_car(const bool val) { is_tested_in_car = val; }
-	void set_tested_in_hospital(const bool val) { is_tested_in_hospital = val; }
-	void set_tested_awaiting_results(const bool val) { is_tested_awaiting_results = val; }
-	void set_tested_awaiting_test(const bool val) { is_tested_awaiting_test = val; }
-	void set_tested_exposed(const bool val) { is_tested_exposed = val; }
+	void set_tested(const bool val) { set_flag(AgentState::tested, val); }
+	void set_tested_in_car(const bool val) { set_flag(AgentState::tested_in_car, val); }
+	void set_tested_in_hospital(const bool val) { set_flag(AgentState::tested_in_hospital, val); }
+	void set_tested_awaiting_results(const bool val) { set_flag(AgentState::tested_awaiting_results, val); }
+	void set_tested_awaiting_test(const bool val) { set_flag(AgentState::tested_awaiting_test, val); }
+	void set_tested_exposed(const bool val) { set_flag(AgentState::tested_exposed, val); }
 	void set_flu_isolation(const double val) { time_flu_ih = time_of_test - val; }
-	void set_testing_since_exposed(const bool val) { is_testing_since_exposed = val;}
+	void set_testing_since_exposed(const bool val) { set_flag(AgentState::testing_since_exposed, val); }
 
 	// Treatment types
-	void set_being_treated(const bool val) { is_treated = val; }
-	void set_home_isolated(const bool val) { is_home_isolated = val; }
-	void set_hospitalized(const bool val) { is_hospitalized = val; }
-	void set_hospitalized_ICU(const bool val) { is_hospitalized_ICU = val; }
-	void set_dying(const bool val) { will_die = val; }
-	void set_recovering(const bool val) { will_recover = val; }
-	void set_removed(const bool val) { is_removed = val; }
-	void set_removed_dead(const bool val) { is_removed_dead = val; }
-	void set_vaccinated(const bool val) { is_vaccinated = val; }
+	void set_being_treated(const bool val) { set_flag(AgentState::being_treated, val); }
+	void set_home_isolated(const bool val) { set_flag(AgentState::home_isolated, val); }
+	void set_hospitalized(const bool val) { set_flag(AgentState::hospitalized, val); }
+	void set_hospitalized_ICU(const bool val) { set_flag(AgentState::hospitalized_ICU, val); }
+	void set_dying(const bool val) { set_flag(AgentState::dying, val); }
+	void set_recovering(const bool val) { set_flag(AgentState::recovering, val); }
+	void set_removed(const bool val) { set_flag(AgentState::removed, val); }
+	void set_removed_dead(const bool val) { set_flag(AgentState::removed_dead, val); }
+	void set_vaccinated(const bool val) { set_flag(AgentState::vaccinated, val); }
 	// Treatment - as set for regular
-	void to_be_hospitalized(const bool val) { will_be_hospitalized = val; }
-	void to_be_in_ICU(const bool val) { will_be_in_ICU = val; }
-	void to_be_home_isolated(const bool val) { will_be_home_isolated = val; }
+	void to_be_hospitalized(const bool val) { set_flag(AgentState::will_be_hospitalized, val); }
+	void to_be_in_ICU(const bool val) { set_flag(AgentState::will_be_in_ICU, val); }
+	void to_be_home_isolated(const bool val) { set_flag(AgentState::will_be_home_isolated, val); }
 
 	/// Set infectiousness variability factor of an agent
-	void set_inf_variability_factor(const double var) { inf_var = var; }
+	void set_inf_variability_factor(const double var) 
+		{ inf_var = var; store_row.set_timer(AgentStore::inf_variability, var); }
+
+	/**
+	 * \brief Apply an entry of a state transition table
+	 * \details Throws if the agent's state does not allow the transition
+	 * @param tr - changes of the state flags 
+	 */
+	void change_state(const AgentState::Transition& tr)
+		{ state.apply(tr); store_row.set_flags(state.flags()); }
+
+	/**
+	 * \brief Attach to a row of the columnar agent store
+	 * \details Copies the current attributes to the row, 
+	 *		after that the setters keep the row up to date
+	 * @param row - row of the store for this agent
+	 */
+	void attach_to_store(AgentStore::Row row);
+
+	/// True if the setters update this row of the store
+	bool attached_to(const AgentStore::Row& row) const { return store_row.same_row(row); }
 
 	//
 	// I/O
 	//
 
+	/**
+	 * \brief Read or write all attributes, for checkpoints
+	 * \details Link to the agent store is not stored, agents
+	 * 		need to be attached to a store after loading 
+	 * @param ar - archive, e.g. BinaryArchive 
+	 */
+	template <typename Archive>
+	void serialize(Archive& ar)
+	{
+		uint64_t flags = state.flags();
+		ar(age, latency_duration, infectiousness_start, latency_end_time, otd_duration,
+			death_time, recovery_duration, recovery_time, time_to_test, time_of_test,
+			time_until_results, time_of_results, time_hsp_to_ICU, time_hsp_to_ih,
+			time_icu_to_hsp, time_ih_to_icu, time_ih_to_hsp, time_flu_ih, ID, x, y,
+			house_ID, school_ID, work_ID, hospital_ID, carpool_ID, public_transit_ID,
+			leisure_location_ID, agent_school_type, work_travel_time, work_travel_mode,
+			leisure_type, occupation, occupation_beta, dist_ratio, flags, inf_var);
+		state = AgentState(flags);
+	}
+
 	/**
 	 * \brief Print agent information 
 	 * \details The information is in the same order as in the constructor,
@@ -304,11 +379,37 @@ public:
 	 */	
 	void print_basic(std::ostream& where) const;
 
+	/// Fields printed by print_basic, e.g. to write them in another thread
+	struct Snapshot{
+		int ID;
+		bool student;
+		bool works;
+		int age;
+		double x, y;
+		int house_ID;
+		bool hospital_non_covid_patient;
+		int school_ID;
+		int work_ID;
+		bool hospital_employee;
+		int hospital_ID;
+		bool retirement_home_employee;
+		bool school_employee;
+		bool retirement_home_resident;
+		bool infected;
+	};
+
+	/// Current values of the fields printed by print_basic
+	Snapshot snapshot() const
+	{
+		return Snapshot{ID, student(), works(), age, x, y, house_ID, 
+				hospital_non_covid_patient(), school_ID, work_ID, hospital_employee(), 
+				hospital_ID, retirement_home_employee(), school_employee(), 
+				retirement_home_resident(), infected()};
+	}
+
 private:
 
 	// General demographic information
-	bool is_student = false;
-	bool is_working = false;
 	int age = 0;
 
 	// Latency duration in time
@@ -355,8 +456,6 @@ private:
 
 	// Household ID
 	int house_ID = -1;
-	// Hospital patient with something else than COVID
-	bool is_non_covid_patient = false;
 
 	// School and work related IDs and types
 	int school_ID = -1;
@@ -367,61 +466,31 @@ private:
 	int leisure_location_ID = 0;	
 	int agent_school_type = -1; 
 	double work_travel_time = -1;
-	bool works_at_hospital = false;
-	bool worksRH = false;
-	bool worksSch = false;
-	bool livesRH = false;
-	bool works_remotely = false;
 	std::string work_travel_mode = {};
 	std::string leisure_type;
     std::string occupation = "None";
     double occupation_beta = 0.0;
 
-	// Infection status
-	bool is_infected = false;
-
 	// Ratio of distances with infected and all distances
 	double dist_ratio = 0.0;
 
-	// State information
-	bool is_exposed = false;
-	// Recovering without ever developing symptoms
-	bool is_recovering_exposed = false;
-	bool is_symptomatic = false;
-	bool is_symptomatic_non_covid = false;
-	// Testing results
-	bool is_tested_covid_negative = false;
-	bool is_tested_false_negative = false;
-	bool is_tested_false_positive = false;
-	bool is_tested_covid_positive = false;
-	// Testing phases and types
-	bool is_tested = false;
-	bool is_tested_in_car = false;
-	bool is_tested_in_hospital = false;
-	bool is_tested_awaiting_results = false;
-	bool is_tested_awaiting_test = false;
-	bool is_tested_exposed = false;
-	bool is_testing_since_exposed = false;
-	// Treatment types
-	bool is_treated = false;
-	bool is_home_isolated = false;
-	bool is_hospitalized = false;
-	bool is_hospitalized_ICU = false;
-	bool will_die = false;
-	bool will_recover = false;
-	bool is_removed = false;
-	bool is_removed_dead = false;
-	bool is_vaccinated = false;
-	bool will_be_hospitalized = false;
-	bool will_be_in_ICU = false;
-	bool will_be_home_isolated = false;
+	// Demographic, disease, testing, and treatment 
+	// flags encoded in a single word
+	AgentState state;
 
 	// Infectiousness variability parameter
 	double inf_var = -1.0;
 
+	// Row of the columnar store, if attached
+	AgentStore::Link store_row;
+
 	//
 	// Private member functions
 	//
+
+	/// Set or reset one state flag
+	void set_flag(const AgentState::Flag flag, const bool val)
+		{ state.set(flag, val); store_row.set_flags(state.flags()); }
 	
 	/** 
 	 * \brief Function of distance for infection propagation
@@ -434,7 +503,15 @@ private:
 	double distance_function(const double a, const double b, const double dij) const;
 };
 
+// Agents are moved when their vector reallocates, a
+// throwing move would make the vector copy them instead
+static_assert(std::is_nothrow_move_constructible<Agent>::value,
+				"Agent needs a non-throwing move to keep its store row");
+
 /// Overloaded ostream operator for I/O
 std::ostream& operator<< (std::ostream& out, const Agent& agent);
 
+/// Same output as for the agent the snapshot was taken of
+std::ostream& operator<< (std::ostream& out, const Agent::Snapshot& agent);
+
 #endif
@@ -0,0 +1,88 @@
+#ifndef AGENT_POOL_H
+#define AGENT_POOL_H
+
+#include <vector>
+
+/*****************************************************
+ * class: AgentPool
+ *
+ * Set of agent IDs with constant time insertion,
+ * removal, and access by position
+ *
+ * IDs are stored densely, a removed agent is replaced
+ * by the last one; position of each agent is kept in
+ * a table indexed by agent ID 
+ *
+ *****************************************************/
+
+class AgentPool{
+public:
+
+	//
+	// Constructors
+	//
+
+	AgentPool() = default;
+
+	//
+	// Membership
+	//
+
+	/// Add an agent, agent IDs start with 1; nothing if already present 
+	void add(const int ID)
+	{
+		if (contains(ID)){
+			return;
+		}
+		if (static_cast<size_t>(ID) >= positions.size()){
+			positions.resize(ID + 1, not_present);
+		}
+		positions.at(ID) = IDs.size();
+		IDs.push_back(ID);
+	}
+
+	/// Remove an agent, nothing if not present
+	void remove(const int ID)
+	{
+		if (!contains(ID)){
+			return;
+		}
+		const int pos = positions.at(ID);
+		const int last = IDs.back();
+		IDs.at(pos) = last;
+		positions.at(last) = pos;
+		IDs.pop_back();
+		positions.at(ID) = not_present;
+	}
+
+	/// True if agent is in the pool
+	bool contains(const int ID) const
+	{ 
+		return (ID >= 0) && (static_cast<size_t>(ID) < positions.size()) 
+					&& (positions[ID] != not_present); 
+	}
+
+	/// Number of agents
+	size_t size() const { return IDs.size(); }
+
+	/// Agent at position ind, from 0 to size() - 1
+	int at(const size_t ind) const { return IDs.at(ind); }
+
+	/// IDs of all agents, order changes with removals
+	const std::vector<int>& get_IDs() const { return IDs; }
+
+	/// Read or write the pool, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar) { ar(IDs, positions); }
+
+private:
+	// Marks agents not in the pool
+	enum { not_present = -1 };
+
+	// Agent IDs
+	std::vector<int> IDs;
+	// Position of each agent in IDs, indexed by agent ID
+	std::vector<int> positions;
+};
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef AGENT_STATE_H
+#define AGENT_STATE_H
+
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include <initializer_list>
+
+/*****************************************************
+ * class: AgentState
+ *
+ * Encoded state of an agent - demographic, disease,
+ * testing, and treatment flags packed in one word;
+ * disease, testing, and treatment stages are decoded
+ * from it
+ *
+ * Groups of changes are applied at once as entries
+ * of a transition table, each entry validated
+ * against the flags that have to and cannot be set
+ * before the change
+ *
+ *****************************************************/
+
+class AgentState{
+public:
+
+	/// Bits of the state word
+	enum Flag : unsigned {
+		// Demographics and travel
+		student, works, hospital_employee, hospital_non_covid_patient,
+		retirement_home_employee, school_employee, retirement_home_resident,
+		works_from_home, travels_by_carpool, travels_by_public_transit,
+		leisure_household, leisure_public,
+		// Infection state
+		infected, exposed, recovering_exposed, symptomatic, symptomatic_non_covid,
+		// Testing results
+		tested_covid_negative, tested_false_negative, tested_false_positive,
+		tested_covid_positive,
+		// Testing phases and types
+		tested, tested_in_car, tested_in_hospital, tested_awaiting_results,
+		tested_awaiting_test, tested_exposed, testing_since_exposed,
+		// Treatment and removal
+		being_treated, home_isolated, hospitalized, hospitalized_ICU,
+		dying, recovering, removed, removed_dead, vaccinated,
+		will_be_hospitalized, will_be_in_ICU, will_be_home_isolated,
+		n_flags };
+
+	/// Stages of the disease
+	enum DiseaseStage : uint8_t { susceptible, exposed_stage, symptomatic_stage,
+									removed_stage, invalid_stage };
+	/// Stages of testing
+	enum TestingStage : uint8_t { not_tested, waiting_for_test, waiting_for_results,
+									test_completed };
+	/// Stages of treatment
+	enum TreatmentStage : uint8_t { not_treated, home_isolation, hospitalization,
+									intensive_care };
+
+	/**
+	 * \brief Entry of a transition table
+	 * \details Flags in clear are reset before the flags in set
+	 *		are set; the move is legal if all the required and
+	 *		none of the forbidden flags are set
+	 */
+	struct Transition{
+		const char* name;
+		uint64_t set;
+		uint64_t clear;
+		uint64_t required;
+		uint64_t forbidden;
+	};
+
+	//
+	// Constructors
+	//
+
+	AgentState() = default;
+	explicit AgentState(const uint64_t flags) : word(flags) { }
+
+	//
+	// Masks
+	//
+
+	/// Mask of a single flag
+	static constexpr uint64_t bit(const Flag flag) { return uint64_t(1) << flag; }
+
+	/// Mask of a combination of flags
+	static uint64_t mask(std::initializer_list<Flag> flags)
+	{
+		uint64_t m = 0;
+		for (const auto& flag : flags){
+			m |= bit(flag);
+		}
+		return m;
+	}
+
+	/// Testing flags reset together, without tested exposed
+	static uint64_t testing_flags()
+	{
+		return mask({tested, tested_covid_negative, tested_false_negative,
+					tested_false_positive, tested_in_car, tested_in_hospital,
+					tested_awaiting_results, tested_awaiting_test});
+	}
+
+	/// Treatment flags reset together
+	static uint64_t treatment_flags()
+		{ return mask({being_treated, home_isolated, hospitalized, hospitalized_ICU}); }
+
+	//
+	// State
+	//
+
+	/// True if flag is set
+	bool has(const Flag flag) const { return (word >> flag) & 1; }
+
+	/// Set or reset one flag
+	void set(const Flag flag, const bool val)
+		{ word = val ? (word | bit(flag)) : (word & ~bit(flag)); }
+
+	/// All the flags
+	uint64_t flags() const { return word; }
+
+	/// Apply a table entry, throws if the move is not legal
+	void apply(const Transition& tr)
+	{
+		if (((word & tr.required) != tr.required) || ((word & tr.forbidden) != 0)){
+			throw std::runtime_error(std::string("Illegal agent state transition: ") + tr.name);
+		}
+		word = (word & ~tr.clear) | tr.set;
+	}
+
+	/// Disease stage decoded from the infection and removal flags
+	DiseaseStage disease_stage() const
+	{
+		if (has(removed)){
+			return removed_stage;
+		}
+		if (!has(infected)){
+			return susceptible;
+		}
+		if (has(exposed)){
+			return exposed_stage;
+		}
+		return has(symptomatic) ? symptomatic_stage : invalid_stage;
+	}
+
+	/// Testing stage decoded from the testing flags
+	TestingStage testing_stage() const
+	{
+		if (!has(tested)){
+			return not_tested;
+		}
+		if (has(tested_awaiting_test)){
+			return waiting_for_test;
+		}
+		return has(tested_awaiting_results) ? waiting_for_results : test_completed;
+	}
+
+	/// Treatment stage decoded from the treatment flags
+	TreatmentStage treatment_stage() const
+	{
+		if (has(home_isolated)){
+			return home_isolation;
+		}
+		if (has(hospitalized)){
+			return hospitalization;
+		}
+		return has(hospitalized_ICU) ? intensive_care : not_treated;
+	}
+
+private:
+	uint64_t word = 0;
+};
+
+#endif
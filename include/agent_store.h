@@ -0,0 +1,461 @@
+#ifndef AGENT_STORE_H
+#define AGENT_STORE_H
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include "agent_state.h"
+
+/*****************************************************
+ * class: AgentStore
+ *
+ * Columnar copy of the population - the state 
+ * word of each agent, place IDs, and timers in 
+ * separate arrays
+ *
+ * Agents attached to the store write their changes
+ * through their setters, so loops over the whole
+ * population can select agents by reading a few
+ * columns instead of complete Agent objects
+ *
+ * Rows are also indexed by compartment - bit sets 
+ * with one bit per agent and a count, updated on 
+ * each change of state; loops visit agents of chosen 
+ * compartments in the order of agents
+ *
+ * Each ID column except the agent ID has a slot
+ * column - index of the agent in the list of agents
+ * of that place, kept by the places, -1 if not known
+ *
+ * Rows can also be marked - sets that do not follow
+ * the state; rows written to since the mark was last
+ * removed are in the changed set, rows that the
+ * simulation schedules for transitions in the due set
+ *
+ *****************************************************/
+
+class AgentStore{
+public:
+
+	/// Place and agent ID columns
+	enum IDColumn : unsigned { agent, household, school, work, hospital,
+		carpool, public_transit, leisure, n_ID_columns };
+
+	/// Timer columns
+	enum TimerColumn : unsigned { infectiousness_start, latency_end, time_of_test,
+		time_of_results, recovery_time, death_time, inf_variability, n_timer_columns };
+
+	/// Compartments, the first five follow the disease stage; agents
+	/// of other processes of a split model are only in the remote set
+	enum Compartment : unsigned { susceptible_set, exposed_set, symptomatic_set,
+		removed_set, invalid_set, vaccinated_set, hospital_testing_set, remote_set, 
+		n_compartments };
+
+	/// Marks, sets of rows that do not follow the state
+	enum Mark : unsigned { due_mark, changed_mark, n_marks };
+
+	/// Mask of a combination of compartments
+	static uint64_t compartment_mask(std::initializer_list<Compartment> comps)
+	{
+		uint64_t m = 0;
+		for (const auto& comp : comps){
+			m |= uint64_t(1) << comp;
+		}
+		return m;
+	}
+
+	/// Compartments of an agent with given state flags
+	static uint64_t compartments(const uint64_t flags)
+	{
+		const AgentState state(flags);
+		const AgentState::DiseaseStage stage = state.disease_stage();
+		uint64_t comps = uint64_t(1) << (stage == AgentState::susceptible ? susceptible_set 
+							: stage == AgentState::exposed_stage ? exposed_set 
+							: stage == AgentState::symptomatic_stage ? symptomatic_set 
+							: stage == AgentState::removed_stage ? removed_set : invalid_set);
+		if (state.has(AgentState::vaccinated)){
+			comps |= uint64_t(1) << vaccinated_set;
+		}
+		// Susceptible present in a hospital for testing
+		if (stage == AgentState::susceptible && state.has(AgentState::tested)
+				&& state.has(AgentState::tested_in_hospital) 
+				&& state.has(AgentState::tested_awaiting_test)){
+			comps |= uint64_t(1) << hospital_testing_set;
+		}
+		return comps;
+	}
+
+	/// Storage of all the columns
+	struct Columns{
+		std::vector<uint64_t> flags;
+		std::array<std::vector<int>, n_ID_columns> IDs;
+		// Index of the agent in its place of each ID column
+		std::array<std::vector<int>, n_ID_columns> slots;
+		std::array<std::vector<double>, n_timer_columns> timers;
+		// Compartment bit sets, 64 agents per block, and 
+		// their sizes; atomic so that agents processed in 
+		// different threads can change compartments
+		std::array<std::vector<std::atomic<uint64_t>>, n_compartments> sets;
+		std::array<std::atomic<int>, n_compartments> counts;
+		// Marks, same layout
+		std::array<std::vector<std::atomic<uint64_t>>, n_marks> marks;
+		std::array<std::atomic<int>, n_marks> mark_counts;
+
+		/// Move a row from old to new compartments
+		void move(const size_t row, const uint64_t old_comps, const uint64_t new_comps)
+		{
+			const uint64_t bit = uint64_t(1) << (row % 64);
+			for (unsigned c = 0; c < n_compartments; ++c){
+				const uint64_t comp = uint64_t(1) << c;
+				if ((old_comps & comp) == (new_comps & comp)){
+					continue;
+				}
+				if (new_comps & comp){
+					sets[c][row/64].fetch_or(bit);
+					++counts[c];
+				} else {
+					sets[c][row/64].fetch_and(~bit);
+					--counts[c];
+				}
+			}
+		}
+
+		/// True if a row is in a compartment
+		bool in(const size_t row, const Compartment c) const
+			{ return (sets[c][row/64] >> (row % 64)) & 1; }
+
+		/// Add a mark to a row
+		void mark(const size_t row, const Mark m)
+		{
+			const uint64_t bit = uint64_t(1) << (row % 64);
+			if ((marks[m][row/64].fetch_or(bit) & bit) == 0){
+				++mark_counts[m];
+			}
+		}
+
+		/// Remove a mark from a row
+		void unmark(const size_t row, const Mark m)
+		{
+			const uint64_t bit = uint64_t(1) << (row % 64);
+			if ((marks[m][row/64].fetch_and(~bit) & bit) != 0){
+				--mark_counts[m];
+			}
+		}
+	};
+
+	/// Writable row of the store, does nothing when not set
+	class Row{
+	public:
+		Row() = default;
+		Row(Columns* cols, const size_t index) : columns(cols), row(index) { }
+
+		/// True if set to a row of a store
+		bool attached() const { return columns != nullptr; }
+
+		/// True if set to the same row of the same store
+		bool same_row(const Row& other) const 
+			{ return columns == other.columns && row == other.row; }
+
+		void set_flags(const uint64_t flags)
+		{
+			if (columns == nullptr){
+				return;
+			}
+			const uint64_t old_flags = columns->flags[row];
+			columns->flags[row] = flags;
+			// Agents of other processes keep out of the loops
+			if (columns->in(row, remote_set)){
+				return;
+			}
+			const uint64_t old_comps = compartments(old_flags);
+			const uint64_t new_comps = compartments(flags);
+			if (old_comps != new_comps){
+				columns->move(row, old_comps, new_comps);
+			}
+			columns->mark(row, changed_mark);
+		}
+		void set_ID(const IDColumn col, const int val)
+			{ if (columns != nullptr) { columns->IDs[col][row] = val; } }
+		void set_timer(const TimerColumn col, const double val)
+		{ 
+			if (columns != nullptr) { 
+				columns->timers[col][row] = val; 
+				columns->mark(row, changed_mark);
+			} 
+		}
+		/// Mark as changed, for agent data that is not in the columns
+		void touch() { if (columns != nullptr) { columns->mark(row, changed_mark); } }
+
+	private:
+		Columns* columns = nullptr;
+		size_t row = 0;
+	};
+
+	/**
+	 * \brief Row held by an Agent
+	 * \details Copies are not attached so that only 
+	 * 		the agent in the population writes to its row; 
+	 *		a move takes the row over and detaches the source, 
+	 *		so agents keep their rows when their vector reallocates
+	 */
+	class Link : public Row{
+	public:
+		Link() = default;
+		Link(const Link&) : Row() { }
+		Link& operator=(const Link&) { return *this; }
+		Link(Link&& other) noexcept : Row(other) { other.detach(); }
+		Link& operator=(Link&& other) noexcept
+		{
+			if (this != &other){
+				Row::operator=(other);
+				other.detach();
+			}
+			return *this;
+		}
+
+		/// Attach to a row
+		void attach(const Row& row) { Row::operator=(row); }
+		/// Stop writing to the row
+		void detach() { Row::operator=(Row()); }
+	};
+
+	/// Read-only view of one agent with Agent-like getters
+	class View{
+	public:
+		View(const Columns& cols, const size_t index)
+			: columns(cols), row(index), state(cols.flags[index]) { }
+
+		/// True if flag is set
+		bool has(const AgentState::Flag flag) const { return state.has(flag); }
+		/// All the flags
+		uint64_t flags() const { return state.flags(); }
+		/// Disease stage
+		AgentState::DiseaseStage disease_stage() const { return state.disease_stage(); }
+		/// Testing stage
+		AgentState::TestingStage testing_stage() const { return state.testing_stage(); }
+		/// Treatment stage
+		AgentState::TreatmentStage treatment_stage() const { return state.treatment_stage(); }
+
+		// IDs
+		int get_ID() const { return columns.IDs[agent][row]; }
+		int get_household_ID() const { return columns.IDs[household][row]; }
+		int get_school_ID() const { return columns.IDs[school][row]; }
+		int get_work_ID() const { return columns.IDs[work][row]; }
+		int get_hospital_ID() const { return columns.IDs[hospital][row]; }
+		int get_carpool_ID() const { return columns.IDs[carpool][row]; }
+		int get_public_transit_ID() const { return columns.IDs[public_transit][row]; }
+		int get_leisure_ID() const { return columns.IDs[leisure][row]; }
+
+		// Timers
+		double get_infectiousness_start_time() const
+			{ return columns.timers[infectiousness_start][row]; }
+		double get_latency_end_time() const { return columns.timers[latency_end][row]; }
+		double get_time_of_test() const { return columns.timers[time_of_test][row]; }
+		double get_time_of_results() const { return columns.timers[time_of_results][row]; }
+		double get_recovery_time() const { return columns.timers[recovery_time][row]; }
+		double get_time_of_death() const { return columns.timers[death_time][row]; }
+		double get_inf_variability_factor() const { return columns.timers[inf_variability][row]; }
+
+		// States used in population-wide loops
+		bool infected() const { return has(AgentState::infected); }
+		bool exposed() const { return has(AgentState::exposed); }
+		bool symptomatic() const { return has(AgentState::symptomatic); }
+		bool symptomatic_non_covid() const { return has(AgentState::symptomatic_non_covid); }
+		bool tested() const { return has(AgentState::tested); }
+		bool tested_in_hospital() const { return has(AgentState::tested_in_hospital); }
+		bool tested_awaiting_test() const { return has(AgentState::tested_awaiting_test); }
+		bool tested_covid_positive() const { return has(AgentState::tested_covid_positive); }
+		bool tested_false_positive() const { return has(AgentState::tested_false_positive); }
+		bool home_isolated() const { return has(AgentState::home_isolated); }
+		bool hospitalized() const { return has(AgentState::hospitalized); }
+		bool hospitalized_ICU() const { return has(AgentState::hospitalized_ICU); }
+		bool removed() const { return has(AgentState::removed); }
+		bool vaccinated() const { return has(AgentState::vaccinated); }
+
+	private:
+		const Columns& columns;
+		const size_t row;
+		const AgentState state;
+	};
+
+	//
+	// Constructors
+	//
+
+	AgentStore() : columns(new Columns()) { }
+
+	//
+	// Population
+	//
+
+	/// Set the number of agents, rows are reset to susceptible
+	void resize(const size_t n)
+	{
+		columns->flags.assign(n, 0);
+		for (auto& col : columns->IDs){
+			col.assign(n, 0);
+		}
+		for (auto& col : columns->slots){
+			col.assign(n, -1);
+		}
+		for (auto& col : columns->timers){
+			col.assign(n, 0.0);
+		}
+		const size_t n_blocks = (n + 63)/64;
+		for (unsigned c = 0; c < n_compartments; ++c){
+			columns->sets[c] = std::vector<std::atomic<uint64_t>>(n_blocks);
+			for (auto& block : columns->sets[c]){
+				block = 0;
+			}
+			columns->counts[c] = 0;
+		}
+		for (unsigned m = 0; m < n_marks; ++m){
+			columns->marks[m] = std::vector<std::atomic<uint64_t>>(n_blocks);
+			for (auto& block : columns->marks[m]){
+				block = 0;
+			}
+			columns->mark_counts[m] = 0;
+		}
+		// All rows start with no flags set
+		const uint64_t comps = compartments(0);
+		for (size_t i = 0; i < n; ++i){
+			columns->move(i, 0, comps);
+		}
+	}
+
+	/// Number of agents
+	size_t size() const { return columns->flags.size(); }
+
+	//
+	// Compartments
+	//
+
+	/// Number of blocks of 64 agents in the compartment sets
+	size_t n_blocks() const { return columns->sets[0].size(); }
+
+	/// Number of agents in a compartment
+	int count(const Compartment comp) const { return columns->counts[comp]; }
+
+	/**
+	 * \brief Move agent with index i to the remote set only
+	 * \details For agents of another process when the model is split,
+	 *		the agent is then not visited in loops over compartments and
+	 *		not counted in them; its later changes of state are stored 
+	 *		without moving it or marking it as changed
+	 * @param i - agent index
+	 */
+	void set_remote(const size_t i)
+	{
+		if (!columns->in(i, remote_set)){
+			columns->move(i, compartments(columns->flags[i]), uint64_t(1) << remote_set);
+		}
+	}
+
+	/// True if agent with index i belongs to another process
+	bool remote(const size_t i) const { return columns->in(i, remote_set); }
+
+	/**
+	 * \brief Call func(i) for each agent index i in a range of blocks
+	 * \details Agents are visited in order; the sets of a block 
+	 *		are read once, before its agents are visited
+	 * @param include - mask of compartments, agent in any of them is visited
+	 * @param exclude - mask of compartments, agent in any of them is skipped
+	 * @param first - first block
+	 * @param last - one past the last block
+	 * @param func - function to call
+	 */
+	template <typename F>
+	void for_each_in(const uint64_t include, const uint64_t exclude,
+						const size_t first, const size_t last, F func) const
+		{ for_each_in(include, exclude, 0, first, last, func); }
+
+	/**
+	 * \brief Call func(i) for each agent index i in a range of blocks
+	 * \details Same as for_each_in without marks, agents with 
+	 *		any of the included marks are also visited unless excluded
+	 * @param include - mask of compartments
+	 * @param exclude - mask of compartments
+	 * @param include_marks - mask of marks, bit m for Mark m
+	 * @param first - first block
+	 * @param last - one past the last block
+	 * @param func - function to call
+	 */
+	template <typename F>
+	void for_each_in(const uint64_t include, const uint64_t exclude, const uint64_t include_marks,
+						const size_t first, const size_t last, F func) const
+	{
+		for (size_t b = first; b < last; ++b){
+			uint64_t in = 0, out = 0;
+			for (unsigned m = 0; m < n_marks; ++m){
+				if ((include_marks >> m) & 1){
+					in |= columns->marks[m][b];
+				}
+			}
+			for (unsigned c = 0; c < n_compartments; ++c){
+				if ((include >> c) & 1){
+					in |= columns->sets[c][b];
+				}
+				if ((exclude >> c) & 1){
+					out |= columns->sets[c][b];
+				}
+			}
+			uint64_t block = in & ~out;
+			while (block != 0){
+				const unsigned bit = __builtin_ctzll(block);
+				func(b*64 + bit);
+				block &= block - 1;
+			}
+		}
+	}
+
+	/// Call func(i) for each agent index i in the given compartments
+	template <typename F>
+	void for_each_in(const uint64_t include, const uint64_t exclude, F func) const
+		{ for_each_in(include, exclude, 0, n_blocks(), func); }
+
+	//
+	// Marks
+	//
+
+	/// Number of agents with a mark
+	int count(const Mark m) const { return columns->mark_counts[m]; }
+
+	/// Add a mark to agent with index i
+	void mark(const size_t i, const Mark m) { columns->mark(i, m); }
+
+	/// Remove a mark from agent with index i
+	void unmark(const size_t i, const Mark m) { columns->unmark(i, m); }
+
+	/// Remove a mark from all agents
+	void clear(const Mark m)
+	{
+		for (auto& block : columns->marks[m]){
+			block = 0;
+		}
+		columns->mark_counts[m] = 0;
+	}
+
+	/// Call func(i) for each agent index i with a mark, in order
+	template <typename F>
+	void for_each_marked(const Mark m, F func) const
+		{ for_each_in(0, 0, uint64_t(1) << m, 0, n_blocks(), func); }
+
+	/// Row to attach to agent with index i
+	Row row(const size_t i) { return Row(columns.get(), i); }
+
+	/// View of agent with index i
+	View view(const size_t i) const { return View(*columns, i); }
+
+	/// Columns for places that keep slots of their agents in the store
+	Columns* place_links() { return columns.get(); }
+
+private:
+	// Heap allocated so that rows held by
+	// agents stay valid if the store is moved
+	std::unique_ptr<Columns> columns;
+};
+
+#endif
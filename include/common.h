@@ -15,5 +15,6 @@
 #include <cctype>
 #include <map>
 #include <cassert>
+#include <limits>
 
 #endif
@@ -13,6 +13,7 @@
 #include "places/hospital.h"
 #include "places/transit.h"
 #include "places/leisure.h"
+#include "places/place_policy.h"
 
 //
 // Other
@@ -22,6 +23,14 @@
 #include "agent.h"
 #include "flu.h"
 
+/// \brief Contribution of an agent to a place stored for later 
+/// \details add is null for a hospital testing count without infection contribution
+struct DeferredContribution{
+	Place* place;
+	void (Place::*add)(double);
+	double inf_var;
+};
+
 /***************************************************** 
  * class: Contributions
  *
@@ -44,6 +53,15 @@ public:
 	//
 	// Contributions of agents to places 
 	//
+
+	/** 
+	 * \brief Count a susceptible agent that is being tested in a hospital 
+	 * @param agent - reference to Agent object
+	 * @param time - current time
+	 * @param hospitals - reference to a vector of hospitals 
+	 */
+	void compute_susceptible_contributions(const Agent& agent, const double time,	
+					std::vector<Hospital>& hospitals);
 	
 	/** 
 	 * \brief Count contributions of an exposed agent
@@ -71,12 +89,17 @@ public:
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 					std::vector<Leisure>& leisure_locations);
 
-	/// \brief Compute the total contribution to infection probability at every place
+	/** 
+	 * \brief Compute the total contribution to infection probability at every place
+	 * @param policy - multipliers of contributions by place type, applied after 
+	 * 		the contributions are computed
+	 */
 	void total_place_contributions(std::vector<Household>& households, 
 					std::vector<School>& schools, std::vector<Workplace>& workplaces, 
 					std::vector<Hospital>& hospitals, std::vector<RetirementHome>& retirement_homes,
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-					std::vector<Leisure>& leisure_locations);
+					std::vector<Leisure>& leisure_locations, 
+					const PlacePolicy& policy = PlacePolicy());
 
 	/// \brief Set contributions/sums from all agents in places to 0.0 
 	void reset_sums(std::vector<Household>& households, std::vector<School>& schools,
@@ -85,8 +108,34 @@ public:
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 					std::vector<Leisure>& leisure_locations);
 
+	//
+	// Deferred contributions
+	//
+
+	/**
+	 * \brief Store contributions in a buffer instead of adding them to places
+	 * \details Used for partitioning agents between threads; applying
+	 * 		the buffers in agent order gives the same place sums as a serial pass 
+	 * @param buffer - pointer to the buffer, nullptr to add to places directly 
+	 */
+	void set_deferred_buffer(std::vector<DeferredContribution>* buffer) 
+		{ deferred = buffer; }
+
+	/// \brief Add all stored contributions to their places in the stored order
+	void apply_deferred(const std::vector<DeferredContribution>& buffer) const;
+
 private:
 
+	// Buffer for deferred contributions, nullptr if not used
+	std::vector<DeferredContribution>* deferred = nullptr;
+
+	/// \brief Add contribution to a place or store it if deferred
+	template <typename T, typename U>
+	void add_contribution(T& place, void (U::*add)(double), const double inf_var);
+
+	/// \brief Increase the number of tested in a hospital or store it if deferred
+	void add_tested_count(Hospital& hospital);
+
 	//
 	// Specific contribution types
 	//
@@ -117,6 +166,18 @@ private:
 				const double inf_var, std::vector<Hospital>& hospitals);   
 
 };
+
+// Add contribution to a place or store it if deferred
+template <typename T, typename U>
+void Contributions::add_contribution(T& place, void (U::*add)(double), const double inf_var)
+{
+	if (deferred == nullptr){
+		(place.*add)(inf_var);
+	} else {
+		deferred->push_back({&place, static_cast<void (Place::*)(double)>(add), inf_var});
+	}
+}
+
 #endif
 
 
@@ -0,0 +1,131 @@
+#ifndef ENSEMBLE_H
+#define ENSEMBLE_H
+
+#include "abm.h"
+#include <functional>
+
+/*****************************************************
+ * class: Ensemble
+ *
+ * Independent realizations of one initialized model
+ * run concurrently in a single process
+ *
+ * State of the model is stored in memory once, as a 
+ * checkpoint; each realization restores its own full 
+ * copy, is reseeded, and is propagated for a number of 
+ * steps while its time series are collected
+ *
+ * Town, agents, mobility, and the initial infections
+ * are created once and are the same in all realizations - 
+ * realizations differ from the time the model is
+ * stored on; they are not shared in memory though,
+ * places and agents change during a run so every copy
+ * has its own; memory is the checkpoint plus one whole 
+ * model per thread, each restored from the checkpoint
+ * without copying it
+ *
+ ******************************************************/
+
+class Ensemble{
+public:
+
+	/// Time series of one realization, one entry per step and the final state
+	struct Series{
+		// Active infections
+		std::vector<int> infected;
+		// Cumulative values
+		std::vector<int> total_infected;
+		std::vector<int> total_dead;
+		std::vector<int> total_recovered;
+		std::vector<int> total_tested;
+	};
+
+	/// Function that propagates the model by one step
+	using step_function = void (ABM::*)();
+	/// Function applied to every realization before its first step
+	using setup_function = std::function<void(ABM&)>;
+
+	//
+	// Constructors
+	//
+
+	/**
+	 * \brief Stores the state of an initialized model
+	 * \details Model should be ready to run - with places, agents,
+	 * 		mobility, and any initial cases or vaccinations; it is
+	 * 		not changed
+	 * @param abm - model to copy
+	 */
+	explicit Ensemble(const ABM& abm);
+
+	//
+	// Settings
+	//
+
+	/**
+	 * \brief Number of realizations run at the same time
+	 * \details Each thread runs a contiguous range of realizations;
+	 * 		results do not depend on the number of threads; each thread
+	 *		holds one full copy of the model
+	 * @param n_threads - number of threads, 1 is serial (default)
+	 */
+	void set_number_of_threads(const int n_threads)
+		{ n_ensemble_threads = std::max(1, n_threads); }
+
+	/// Set the function called at each step, default ABM::transmit_ideal_testing_vac_reopening
+	void set_step_function(step_function step) { propagate = step; }
+
+	/**
+	 * \brief Set a function called on each copy before the first step
+	 * \details Computation settings such as ABM::set_place_driven_susceptibles
+	 * 		are not part of the stored state and should be set here; the
+	 * 		function is called from several threads at once
+	 * @param setup - function taking a reference to the copy
+	 */
+	void set_setup_function(setup_function setup) { prepare = setup; }
+
+	//
+	// Simulation
+	//
+
+	/**
+	 * \brief Run one realization for each seed
+	 * \details Realization i is seeded with seeds.at(i) and its series
+	 * 		have n_steps + 1 entries, collected before each step and
+	 * 		after the last one
+	 * @param seeds - seed of each realization
+	 * @param n_steps - number of steps in each realization
+	 * @return series of each realization in order of seeds
+	 */
+	std::vector<Series> run(const std::vector<uint64_t>& seeds, const int n_steps) const;
+
+	/// Restore a copy of the stored model into abm
+	void restore(ABM& abm) const;
+
+	//
+	// Output
+	//
+
+	/**
+	 * \brief Save one quantity of all realizations, one realization per line
+	 * @param fname - path of the file to print to
+	 * @param results - series of all realizations
+	 * @param quantity - series to save, e.g. &Ensemble::Series::infected
+	 */
+	static void print_series(const std::string& fname, const std::vector<Series>& results,
+					std::vector<int> Series::* quantity);
+
+private:
+	// Stored state of the model
+	std::string state;
+	// Number of threads for realizations
+	int n_ensemble_threads = 1;
+	// Step and optional setup of each realization
+	step_function propagate = &ABM::transmit_ideal_testing_vac_reopening;
+	setup_function prepare;
+
+	/// Append values of the current step to the series
+	static void collect(const ABM& abm, Series& series);
+};
+
+#endif
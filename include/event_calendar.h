@@ -0,0 +1,123 @@
+#ifndef EVENT_CALENDAR_H
+#define EVENT_CALENDAR_H
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+/*****************************************************
+ * class: EventCalendar
+ *
+ * Timing wheel of agents keyed by the time step
+ * of their next scheduled transition
+ *
+ * Each agent has at most one scheduled step,
+ * scheduling again replaces it. Slots of the wheel
+ * hold (agent, step) entries for all steps equal
+ * modulo the number of slots; entries of later turns
+ * of the wheel stay in their slot and replaced
+ * entries are dropped when their slot comes due.
+ * Steps are advanced one at a time.
+ *
+ *****************************************************/
+
+class EventCalendar{
+public:
+
+	//
+	// Constructors
+	//
+
+	/**
+	 * \brief Empty calendar
+	 * @param n_slots - number of slots of the wheel, steps in one turn
+	 */
+	explicit EventCalendar(const size_t n_slots = 1024) :
+		slots(n_slots > 0 ? n_slots : 1) { }
+
+	//
+	// Scheduling
+	//
+
+	/**
+	 * \brief Remove all entries and start at a step
+	 * @param n_agents - number of agents that can be scheduled
+	 * @param step - last step treated as already advanced
+	 */
+	void reset(const size_t n_agents, const long step)
+	{
+		for (auto& slot : slots){
+			slot.clear();
+		}
+		scheduled.assign(n_agents, none);
+		current = step;
+	}
+
+	/**
+	 * \brief Schedule an agent, replacing its earlier step
+	 * @param index - index of the agent
+	 * @param step - step of the transition, later than the current step
+	 */
+	void schedule(const size_t index, const long step)
+	{
+		scheduled.at(index) = step;
+		slots.at(step % slots.size()).push_back(Entry{index, step});
+	}
+
+	/// Remove the agent from the calendar
+	void cancel(const size_t index) { scheduled.at(index) = none; }
+
+	/**
+	 * \brief Advance to the next step, call func(index) for each agent due
+	 * \details Agents are unscheduled once due; the order of agents
+	 *		is the order of scheduling
+	 * @param func - function to call
+	 */
+	template <typename F>
+	void advance(F func)
+	{
+		++current;
+		std::vector<Entry>& slot = slots.at(current % slots.size());
+		size_t n_kept = 0;
+		for (size_t k = 0; k < slot.size(); ++k){
+			const Entry entry = slot[k];
+			if (entry.step > current){
+				// Later turn of the wheel
+				slot[n_kept++] = entry;
+			} else if (entry.step == current && scheduled.at(entry.index) == current){
+				scheduled.at(entry.index) = none;
+				func(entry.index);
+			}
+		}
+		slot.resize(n_kept);
+	}
+
+	//
+	// Getters
+	//
+
+	/// Last step advanced to
+	long get_step() const { return current; }
+
+	/// Step an agent is scheduled for, negative if none
+	long scheduled_step(const size_t index) const { return scheduled.at(index); }
+
+	/// Number of agents the calendar was reset for
+	size_t size() const { return scheduled.size(); }
+
+private:
+	struct Entry{
+		size_t index;
+		long step;
+	};
+
+	// Step of agents that are not scheduled
+	enum : long { none = -1 };
+
+	std::vector<std::vector<Entry>> slots;
+	// Scheduled step of each agent
+	std::vector<long> scheduled;
+	long current = none;
+};
+
+#endif
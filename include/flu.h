@@ -4,6 +4,7 @@
 #include "common.h"
 #include "testing.h"
 #include "rng.h"
+#include "agent_pool.h"
 
 /***************************************************** 
  * class: Flu 
@@ -32,6 +33,14 @@ public:
 	/// \brief Specifies the offset in days for the time Flu agents can be tested
 	void set_testing_duration(const double dt) { testing_period = dt; }
 
+	/// \brief Restart the random number generator from seed, separate flu stream
+	void set_seed(const uint64_t seed) 
+		{ rng.set_seed(seed); rng.set_stream(0, 0, RNG::flu); }
+
+	/// Switch to the flu stream of a process when the model is split, keeps the seed
+	void set_rank_stream(const int rank) 
+		{ rng.set_stream(rank, 0, RNG::rank_flu); }
+
 	//
 	//	Flu computations and agent management 
 	//
@@ -47,19 +56,21 @@ public:
 	 * @param index - agent ID (starts with 1)
 	 */
 	void add_susceptible_agent(const int index) 
-		{ susceptible_agent_IDs.push_back(index); }
+		{ susceptible_agents.add(index); }
 
 	/**
-	 * \brief Remove a susceptible agent 
+	 * \brief Remove a susceptible agent, constant time 
 	 * @param index - agent ID (starts with 1)
 	 */
-	void remove_susceptible_agent(const int index);
+	void remove_susceptible_agent(const int index)
+		{ susceptible_agents.remove(index); }
 
 	/**
-	 * \brief Remove a flu agent 
+	 * \brief Remove a flu agent, constant time 
 	 * @param index - agent ID (starts with 1)
 	 */
-	void remove_flu_agent(const int index);
+	void remove_flu_agent(const int index)
+		{ flu_agents.remove(index); }
 
 	/** 
 	 * \brief Remove recovered from flu, add new chosen randomly
@@ -80,10 +91,22 @@ public:
 	// Getters
 	//
 
-	/// \brief Const reference to susceptible IDs vector
-	const std::vector<int>& get_susceptible_IDs() const { return susceptible_agent_IDs; }
-	/// \brief Const reference to IDs of agents with flu
-	const std::vector<int>& get_flu_IDs() const { return flu_agent_IDs; }
+	/// Random numbers drawn so far, for profiling
+	uint64_t get_rng_draws() const { return rng.get_draws(); }
+
+	/// \brief Const reference to susceptible IDs vector, order changes with removals
+	const std::vector<int>& get_susceptible_IDs() const { return susceptible_agents.get_IDs(); }
+	/// \brief Const reference to IDs of agents with flu, order changes with removals
+	const std::vector<int>& get_flu_IDs() const { return flu_agents.get_IDs(); }
+
+	//
+	// I/O
+	//
+
+	/// Read or write all attributes including the generator state, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+		{ ar(nc_sy_frac, frac_tested_fp, testing_period, rng, susceptible_agents, flu_agents); }
 
 private:
 	// Fraction of the total susceptible population
@@ -99,9 +122,9 @@ private:
 	RNG rng;
 
 	// Susceptible agents
-	std::vector<int> susceptible_agent_IDs;
+	AgentPool susceptible_agents;
 	// Susceptible with flu
-	std::vector<int> flu_agent_IDs;
+	AgentPool flu_agents;
 };
 
 #endif
@@ -113,6 +113,16 @@ public:
 	// Setters
 	//
 
+	/// Restart the random number generator from seed
+	void set_seed(const uint64_t seed) { rng.set_seed(seed); }
+
+	/// Draw numbers from the stream of an agent at a time step
+	void set_stream(const int agent_ID, const int step, const RNG::Purpose purpose)
+		{ rng.set_stream(agent_ID, step, purpose); }
+
+	/// Continue from the generator state of another object, parameters are kept
+	void copy_generator(const Infection& other) { rng = other.rng; }
+
 	void set_latency_distribution(const double mean, const double std)
 		{ ln_mean_lat = mean; ln_std_lat = std; }
 
@@ -135,7 +145,7 @@ public:
 	void set_other_probabilities(const double fr_sy_tested, const double pr_dth_icu,
 								 const double fr_death_not_icu)
 		{ prob_sy_tested = fr_sy_tested; prob_death_icu = pr_dth_icu; 
-		  prob_death_not_admitted = fr_death_not_icu; }
+		  prob_death_not_admitted = fr_death_not_icu; compute_age_tables(); }
 
 	/**
 	 * \brief Process and store the age-dependent exposed to symptomatic fractions
@@ -165,6 +175,9 @@ public:
 	// Getters
 	//
 
+	/// Random numbers drawn so far, for profiling
+	uint64_t get_rng_draws() const { return rng.get_draws(); }
+
 	/// Return map with mortality rates
 	const std::map<std::string, std::tuple<int, int, double>>& get_mortality_rates() const 
 		{ return mortality_rates; }
@@ -190,6 +203,19 @@ public:
 	 */	
 	void print_basic(std::ostream& where) const;
 
+	/// Read or write all attributes including the generator state, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+	{
+		ar(dt, ln_mean_lat, ln_std_lat, inf_var_k, inf_var_theta, otd_mean, otd_std,
+			oth_k, oth_theta, htd_k, htd_theta, prob_sy_tested, prob_death_icu,
+			prob_death_not_admitted, rng, expN2sy_fractions, mortality_rates,
+			hospitalization_rates, ICU_rates);
+		if (ar.is_loading()) {
+			compute_age_tables();
+		}
+	}
+
 protected:
 	
 	//
@@ -251,12 +277,30 @@ protected:
 	// ICU rates (age group: min age, max age, probability)
 	std::map<std::string, std::tuple<int, int, double>> ICU_rates;
 
+	// Probabilities for each age from 0 to the oldest age in any
+	// age group, computed from the distributions above whenever
+	// they change; same values as searching the age groups
+	std::vector<double> prob_exposed_never_sy;
+	std::vector<double> prob_hospitalized;
+	std::vector<double> prob_hospitalized_ICU;
+	// Death outside ICU - regular agents, and hospital 
+	// employees or former non-COVID-19 patients
+	std::vector<double> prob_death_non_icu;
+	std::vector<double> prob_death_non_icu_hsp;
+
 	//
 	// Private functions
 	//
 
 	// Extract min and max age in a group from age-dependent distributions
 	std::vector<int> parse_age_group(const std::string group_range);
+
+	// Recompute the per-age probability tables
+	void compute_age_tables();
+
+	// Entry of a per-age table, 0 for ages outside all age groups
+	static double at_age(const std::vector<double>& table, const int age)
+		{ return (age >= 0 && age < static_cast<int>(table.size())) ? table[age] : 0.0; }
 };
 
 /// Overloaded ostream operator for I/O
@@ -0,0 +1,320 @@
+#ifndef INFECTION_PARAMETERS_H
+#define INFECTION_PARAMETERS_H
+
+#include "common.h"
+
+/***************************************************** 
+ * class: InfectionParameters
+ * 
+ * Model parameters used during the simulation, 
+ * as named fields 
+ *
+ * Created once from the map of parameter names to 
+ * values read from the parameter file; all core
+ * parameters need to be present, so an incomplete file 
+ * is detected before the simulation starts. Parameters
+ * of features that not every setup uses - towns with 
+ * outside places, occupations, contact statistics - 
+ * are optional, NaN if not in the file, and checked 
+ * when the feature uses them. Fields have the names 
+ * of the parameters in the file, in lowercase and with 
+ * words separated by underscores.
+ * 
+ *****************************************************/
+
+struct InfectionParameters{
+
+	//
+	// Constructors
+	//
+
+	InfectionParameters() = default;
+
+	/**
+	 * \brief Set all fields from a map of parameter names to values
+	 * \details Throws std::invalid_argument with the names of all missing
+	 *		core parameters if any is not in the map; optional parameters 
+	 *		not in the map are NaN; other entries are ignored
+	 * @param values - map as loaded by LoadParameters::load_parameter_map
+	 */
+	explicit InfectionParameters(const std::map<std::string, double>& values);
+
+	//
+	// Parameters
+	//
+
+	// Transmission rates and absenteeism in places
+	double household_transmission_rate = 0.0;
+	double severity_correction = 0.0;
+	double household_scaling_parameter = 0.0;
+	double workplace_transmission_rate = 0.0;
+	double out_of_town_leisure_transmission = std::numeric_limits<double>::quiet_NaN();
+	double fraction_estimated_infected = std::numeric_limits<double>::quiet_NaN();
+	double work_absenteeism_correction = 0.0;
+	double carpool_transmission_rate = 0.0;
+	double public_transit_current_capacity = 0.0;
+	double public_transit_beta0 = 0.0;
+	double public_transit_beta_full = 0.0;
+	double leisure_locations_transmission_rate = 0.0;
+	double lockdown_absenteeism = 0.0;
+	double rh_employee_absenteeism_factor = 0.0;
+	double rh_employee_transmission_rate = 0.0;
+	double rh_resident_transmission_rate = 0.0;
+	double rh_transmission_rate_of_home_isolated = 0.0;
+	double school_transmission_rate = 0.0;
+	double school_employee_absenteeism_correction = 0.0;
+	double school_employee_transmission_rate = 0.0;
+	double daycare_absenteeism_correction = 0.0;
+	double primary_and_middle_school_absenteeism_correction = 0.0;
+	double high_school_absenteeism_correction = 0.0;
+	double college_absenteeism_correction = 0.0;
+	double healthcare_employees_transmission_rate = 0.0;
+	double hospital_patients_transmission_rate = 0.0;
+	double hospitalized_transmission_rate = 0.0;
+	double hospitalized_icu_transmission_rate = 0.0;
+	double hospital_tested_transmission_rate = 0.0;
+
+	// Testing and flu
+	double negative_tests_fraction = 0.0;
+	double fraction_with_flu = 0.0;
+	double flu_testing_duration = 0.0;
+	double fraction_tested_in_hospitals = 0.0;
+	double fraction_false_negative = 0.0;
+	double fraction_false_positive = 0.0;
+
+	// Infectiousness variability and latency
+	double agent_variability_gamma_shape = 0.0;
+	double agent_variability_gamma_scale = 0.0;
+	double latency_log_normal_mean = 0.0;
+	double latency_log_normal_standard_deviation = 0.0;
+
+	// Fractions tested and testing times
+	double fraction_to_get_tested = 0.0;
+	double average_fraction_to_get_tested = 0.0;
+	double exposed_fraction_to_get_tested = 0.0;
+	double time_from_decision_to_test = 0.0;
+	double time_from_test_to_results = 0.0;
+
+	// Course of the disease
+	double transmission_rate_of_home_isolated = 0.0;
+	double time_from_exposed_to_infectiousness = 0.0;
+	double probability_of_death_in_icu = 0.0;
+	double probability_dying_if_needing_but_not_admitted_to_icu = 0.0;
+	double time_in_hospital = 0.0;
+	double time_in_icu = 0.0;
+	double time_in_hospital_after_icu = 0.0;
+	double recovery_time = 0.0;
+	double oth_gamma_shape = 0.0;
+	double oth_gamma_scale = 0.0;
+	double otd_logn_mean = 0.0;
+	double otd_logn_std = 0.0;
+	double htd_wbl_shape = 0.0;
+	double htd_wbl_scale = 0.0;
+	double time_before_death_to_icu = 0.0;
+
+	// Times of events and policies
+	double time_to_start_data_collection = 0.0;
+	double start_testing = 0.0;
+	double school_closure = 0.0;
+	double lockdown = 0.0;
+	double reopening_phase_1 = 0.0;
+	double reopening_phase_2 = 0.0;
+	double reopening_phase_3 = 0.0;
+	double fraction_of_ld_businesses = 0.0;
+	double fraction_of_phase_1_businesses = 0.0;
+	double fraction_of_phase_2_businesses = 0.0;
+	double fraction_of_phase_3_businesses = 0.0;
+	double fraction_of_phase_4_businesses = 0.0;
+
+	// Reopening, leisure, and vaccination
+	double school_transmission_reduction = 0.0;
+	double leisure_dr0 = 0.0;
+	double leisure_beta = 0.0;
+	double leisure_kappa = 0.0;
+	double leisure_fraction = 0.0;
+	double leisure_fraction_initial = 0.0;
+	double leisure_fraction_final = 0.0;
+	double initially_vaccinated = 0.0;
+	double vaccination_rate = 0.0;
+	double leisure_reopening_rate = 0.0;
+
+	// Maximum number of contacts
+	double max_contacts_at_school = std::numeric_limits<double>::quiet_NaN();
+	double max_contacts_at_hospital = std::numeric_limits<double>::quiet_NaN();
+	double max_contacts_at_rh = std::numeric_limits<double>::quiet_NaN();
+	double max_contacts_at_workplace = std::numeric_limits<double>::quiet_NaN();
+
+	// Transmission rates by occupation
+	double management_science_art_transmission_rate = std::numeric_limits<double>::quiet_NaN();
+	double service_occupation_transmission_rate = std::numeric_limits<double>::quiet_NaN();
+	double sales_office_transmission_rate = std::numeric_limits<double>::quiet_NaN();
+	double construction_maintenance_transmission_rate = std::numeric_limits<double>::quiet_NaN();
+	double production_transportation_transmission_rate = std::numeric_limits<double>::quiet_NaN();
+
+	//
+	// Names
+	//
+
+	/// Name of each core parameter in the parameter file and its field 
+	static const std::vector<std::pair<std::string, double InfectionParameters::*>>& fields();
+
+	/// Name of each optional parameter in the parameter file and its field 
+	static const std::vector<std::pair<std::string, double InfectionParameters::*>>& optional_fields();
+
+	/**
+	 * \brief Value of an optional parameter 
+	 * \details Throws std::invalid_argument if it was not in the parameter file
+	 * @param field - member pointer of the parameter
+	 */
+	double required(double InfectionParameters::* field) const;
+
+};
+
+//
+// Implementations
+//
+
+// Name of each parameter in the parameter file and its field
+inline const std::vector<std::pair<std::string, double InfectionParameters::*>>& InfectionParameters::fields()
+{
+	static const std::vector<std::pair<std::string, double InfectionParameters::*>> names = {
+			{"household transmission rate", &InfectionParameters::household_transmission_rate},
+			{"severity correction", &InfectionParameters::severity_correction},
+			{"household scaling parameter", &InfectionParameters::household_scaling_parameter},
+			{"workplace transmission rate", &InfectionParameters::workplace_transmission_rate},
+			{"work absenteeism correction", &InfectionParameters::work_absenteeism_correction},
+			{"carpool transmission rate", &InfectionParameters::carpool_transmission_rate},
+			{"public transit current capacity", &InfectionParameters::public_transit_current_capacity},
+			{"public transit beta0", &InfectionParameters::public_transit_beta0},
+			{"public transit beta full", &InfectionParameters::public_transit_beta_full},
+			{"leisure locations transmission rate", &InfectionParameters::leisure_locations_transmission_rate},
+			{"lockdown absenteeism", &InfectionParameters::lockdown_absenteeism},
+			{"RH employee absenteeism factor", &InfectionParameters::rh_employee_absenteeism_factor},
+			{"RH employee transmission rate", &InfectionParameters::rh_employee_transmission_rate},
+			{"RH resident transmission rate", &InfectionParameters::rh_resident_transmission_rate},
+			{"RH transmission rate of home isolated", &InfectionParameters::rh_transmission_rate_of_home_isolated},
+			{"school transmission rate", &InfectionParameters::school_transmission_rate},
+			{"school employee absenteeism correction", &InfectionParameters::school_employee_absenteeism_correction},
+			{"school employee transmission rate", &InfectionParameters::school_employee_transmission_rate},
+			{"daycare absenteeism correction", &InfectionParameters::daycare_absenteeism_correction},
+			{"primary and middle school absenteeism correction", &InfectionParameters::primary_and_middle_school_absenteeism_correction},
+			{"high school absenteeism correction", &InfectionParameters::high_school_absenteeism_correction},
+			{"college absenteeism correction", &InfectionParameters::college_absenteeism_correction},
+			{"healthcare employees transmission rate", &InfectionParameters::healthcare_employees_transmission_rate},
+			{"hospital patients transmission rate", &InfectionParameters::hospital_patients_transmission_rate},
+			{"hospitalized transmission rate", &InfectionParameters::hospitalized_transmission_rate},
+			{"hospitalized ICU transmission rate", &InfectionParameters::hospitalized_icu_transmission_rate},
+			{"hospital tested transmission rate", &InfectionParameters::hospital_tested_transmission_rate},
+			{"negative tests fraction", &InfectionParameters::negative_tests_fraction},
+			{"fraction with flu", &InfectionParameters::fraction_with_flu},
+			{"flu testing duration", &InfectionParameters::flu_testing_duration},
+			{"fraction tested in hospitals", &InfectionParameters::fraction_tested_in_hospitals},
+			{"fraction false negative", &InfectionParameters::fraction_false_negative},
+			{"fraction false positive", &InfectionParameters::fraction_false_positive},
+			{"agent variability gamma shape", &InfectionParameters::agent_variability_gamma_shape},
+			{"agent variability gamma scale", &InfectionParameters::agent_variability_gamma_scale},
+			{"latency log-normal mean", &InfectionParameters::latency_log_normal_mean},
+			{"latency log-normal standard deviation", &InfectionParameters::latency_log_normal_standard_deviation},
+			{"fraction to get tested", &InfectionParameters::fraction_to_get_tested},
+			{"average fraction to get tested", &InfectionParameters::average_fraction_to_get_tested},
+			{"exposed fraction to get tested", &InfectionParameters::exposed_fraction_to_get_tested},
+			{"time from decision to test", &InfectionParameters::time_from_decision_to_test},
+			{"time from test to results", &InfectionParameters::time_from_test_to_results},
+			{"transmission rate of home isolated", &InfectionParameters::transmission_rate_of_home_isolated},
+			{"time from exposed to infectiousness", &InfectionParameters::time_from_exposed_to_infectiousness},
+			{"probability of death in ICU", &InfectionParameters::probability_of_death_in_icu},
+			{"probability dying if needing but not admitted to icu", &InfectionParameters::probability_dying_if_needing_but_not_admitted_to_icu},
+			{"time in hospital", &InfectionParameters::time_in_hospital},
+			{"time in ICU", &InfectionParameters::time_in_icu},
+			{"time in hospital after ICU", &InfectionParameters::time_in_hospital_after_icu},
+			{"recovery time", &InfectionParameters::recovery_time},
+			{"oth gamma shape", &InfectionParameters::oth_gamma_shape},
+			{"oth gamma scale", &InfectionParameters::oth_gamma_scale},
+			{"otd logn mean", &InfectionParameters::otd_logn_mean},
+			{"otd logn std", &InfectionParameters::otd_logn_std},
+			{"htd wbl shape", &InfectionParameters::htd_wbl_shape},
+			{"htd wbl scale", &InfectionParameters::htd_wbl_scale},
+			{"time before death to ICU", &InfectionParameters::time_before_death_to_icu},
+			{"time to start data collection", &InfectionParameters::time_to_start_data_collection},
+			{"start testing", &InfectionParameters::start_testing},
+			{"school closure", &InfectionParameters::school_closure},
+			{"lockdown", &InfectionParameters::lockdown},
+			{"reopening phase 1", &InfectionParameters::reopening_phase_1},
+			{"reopening phase 2", &InfectionParameters::reopening_phase_2},
+			{"reopening phase 3", &InfectionParameters::reopening_phase_3},
+			{"fraction of ld businesses", &InfectionParameters::fraction_of_ld_businesses},
+			{"fraction of phase 1 businesses", &InfectionParameters::fraction_of_phase_1_businesses},
+			{"fraction of phase 2 businesses", &InfectionParameters::fraction_of_phase_2_businesses},
+			{"fraction of phase 3 businesses", &InfectionParameters::fraction_of_phase_3_businesses},
+			{"fraction of phase 4 businesses", &InfectionParameters::fraction_of_phase_4_businesses},
+			{"school transmission reduction", &InfectionParameters::school_transmission_reduction},
+			{"leisure - dr0", &InfectionParameters::leisure_dr0},
+			{"leisure - beta", &InfectionParameters::leisure_beta},
+			{"leisure - kappa", &InfectionParameters::leisure_kappa},
+			{"leisure - fraction", &InfectionParameters::leisure_fraction},
+			{"leisure - fraction - initial", &InfectionParameters::leisure_fraction_initial},
+			{"leisure - fraction - final", &InfectionParameters::leisure_fraction_final},
+			{"initially vaccinated", &InfectionParameters::initially_vaccinated},
+			{"vaccination rate", &InfectionParameters::vaccination_rate},
+			{"leisure reopening rate", &InfectionParameters::leisure_reopening_rate}
+		};
+	return names;
+}
+
+// Name of each optional parameter in the parameter file and its field
+inline const std::vector<std::pair<std::string, double InfectionParameters::*>>& InfectionParameters::optional_fields()
+{
+	static const std::vector<std::pair<std::string, double InfectionParameters::*>> names = {
+			{"out-of-town leisure transmission", &InfectionParameters::out_of_town_leisure_transmission},
+			{"fraction estimated infected", &InfectionParameters::fraction_estimated_infected},
+			{"max contacts at school", &InfectionParameters::max_contacts_at_school},
+			{"max contacts at hospital", &InfectionParameters::max_contacts_at_hospital},
+			{"max contacts at RH", &InfectionParameters::max_contacts_at_rh},
+			{"max contacts at workplace", &InfectionParameters::max_contacts_at_workplace},
+			{"management science art transmission rate", &InfectionParameters::management_science_art_transmission_rate},
+			{"service occupation transmission rate", &InfectionParameters::service_occupation_transmission_rate},
+			{"sales office transmission rate", &InfectionParameters::sales_office_transmission_rate},
+			{"construction maintenance transmission rate", &InfectionParameters::construction_maintenance_transmission_rate},
+			{"production transportation transmission rate", &InfectionParameters::production_transportation_transmission_rate}
+		};
+	return names;
+}
+
+// Value of an optional parameter, throws if it was not in the file
+inline double InfectionParameters::required(double InfectionParameters::* field) const
+{
+	if (std::isnan(this->*field)){
+		const auto& names = optional_fields();
+		const auto entry = std::find_if(names.begin(), names.end(), 
+			[field](const std::pair<std::string, double InfectionParameters::*>& name)
+				{ return name.second == field; });
+		throw std::invalid_argument("Missing infection parameter: " 
+				+ (entry != names.end() ? entry->first : std::string("unknown")));
+	}
+	return this->*field;
+}
+
+// Set all fields from a map of parameter names to values
+inline InfectionParameters::InfectionParameters(const std::map<std::string, double>& values)
+{
+	std::string missing = {};
+	for (const auto& field : fields()){
+		const auto entry = values.find(field.first);
+		if (entry == values.end()){
+			missing += (missing.empty() ? "" : ", ") + field.first;
+			continue;
+		}
+		this->*field.second = entry->second;
+	}
+	if (!missing.empty()){
+		throw std::invalid_argument("Missing infection parameters: " + missing);
+	}
+	for (const auto& field : optional_fields()){
+		const auto entry = values.find(field.first);
+		if (entry != values.end()){
+			this->*field.second = entry->second;
+		}
+	}
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define ABM_IO_H
 
 #include "FileHandler.h"
+#include "text_reader.h"
 #include "../common.h"
 
 /*************************************************************** 
@@ -43,13 +44,23 @@ public:
 	
 	/**
 	 * \brief Read whitespace separated data from a file
-	 * \details Currently data in a line needs to be separated by whitespace (tab, blank, ...)
+	 * \details Currently data in a line needs to be separated by whitespace (tab, blank, ...);
+	 * 		throws std::invalid_argument if an entry cannot be converted to T
 	 * @returns std::vector of vectors of type T with the data in each vector being
 	 * 		one line of the file with elements as extracted baed on whitespace
 	 */
 	template<typename T>
 	std::vector<std::vector<T>> read_vector() const;
 
+	/**
+	 * \brief Call func for each line of the file without storing the file
+	 * \details func takes a const std::vector<TextReader::Token>& with the 
+	 * 		whitespace separated entries of the line, valid only during the call
+	 * @param func - callable, called once per line in order
+	 */
+	template<typename F>
+	void for_each_line(F func) const { TextReader(fname).for_each_line(func); }
+
 	//
 	// Writing functionality 
 	//
@@ -99,19 +110,15 @@ private:
 template<typename T>
 std::vector<std::vector<T>> AbmIO::read_vector() const
 {
-	FileHandler file(fname);
-	std::fstream &in = file.get_stream();
-	std::string line;
-   	T elem;
 	std::vector<std::vector<T>> output;
-
-	while (std::getline(in, line)){
-		std::istringstream data_row(line);
-		std::vector<T> temp;
-		while (data_row >> elem)
-			temp.push_back(elem);
-		output.push_back(temp);
-	}
+	for_each_line([&output](const std::vector<TextReader::Token>& line){
+		output.emplace_back();
+		std::vector<T>& row = output.back();
+		row.reserve(line.size());
+		for (const auto& entry : line) {
+			row.push_back(entry.as<T>());
+		}
+	});
 	return output;
 }
 
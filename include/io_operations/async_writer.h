@@ -0,0 +1,219 @@
+#ifndef ASYNC_WRITER_H
+#define ASYNC_WRITER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+/***************************************************************
+ * class: AsyncWriter
+ *
+ * Writes snapshots of simulation data to text files
+ * in a background thread
+ *
+ * The simulation copies the fields to output into a buffer
+ * of plain records taken from the writer, then passes the
+ * buffer back with the name of the file; formatting with
+ * operator<< of T and writing, one record per line, happens
+ * in the writer thread while the simulation continues.
+ * Buffers are reused once written, so after the first few
+ * outputs taking a snapshot does not allocate. At most
+ * max_pending outputs wait at a time, after that writing
+ * blocks until one is done.
+ **************************************************************/
+
+template <typename T>
+class AsyncWriter
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	/**
+	 * \brief Starts the writer thread
+	 * @param n_pending - maximum number of outputs waiting to be written
+	 */
+	explicit AsyncWriter(const size_t n_pending = 2) :
+		max_pending(std::max<size_t>(n_pending, 1)), worker(&AsyncWriter::run, this) { }
+
+	AsyncWriter(const AsyncWriter&) = delete;
+	AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+	//
+	// Writing
+	//
+
+	/**
+	 * \brief Empty buffer for the next snapshot
+	 * \details Capacity is kept from earlier snapshots
+	 */
+	std::vector<T> buffer();
+
+	/**
+	 * \brief Queue a snapshot to be written
+	 * \details Truncates the file if it exists; rethrows errors from earlier
+	 * 		writes
+	 * @param fname - path of the file to write to
+	 * @param records - snapshot, one record per line
+	 */
+	void write(const std::string& fname, std::vector<T>&& records);
+
+	/// Wait until all queued snapshots are written, rethrow write errors
+	void flush();
+
+	//
+	// Destructor
+	//
+
+	/// Writes what is left and stops the thread
+	~AsyncWriter();
+
+private:
+
+	struct Job{
+		std::string fname;
+		std::vector<T> records;
+	};
+
+	size_t max_pending = 2;
+	bool done = false;
+	// True while the thread writes a job
+	bool busy = false;
+	std::deque<Job> jobs;
+	std::vector<std::vector<T>> spare;
+	std::exception_ptr error;
+
+	std::mutex mtx;
+	std::condition_variable job_ready;
+	std::condition_variable job_done;
+	// Last so that everything else exists when it starts
+	std::thread worker;
+
+	// Writer thread
+	void run();
+	// Throw an error from the writer thread, if any
+	void check_error();
+};
+
+//
+// Implementations
+//
+
+// Empty buffer for the next snapshot
+template <typename T>
+std::vector<T> AsyncWriter<T>::buffer()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (spare.empty()) {
+		return std::vector<T>();
+	}
+	std::vector<T> buf = std::move(spare.back());
+	spare.pop_back();
+	buf.clear();
+	return buf;
+}
+
+// Queue a snapshot to be written
+template <typename T>
+void AsyncWriter<T>::write(const std::string& fname, std::vector<T>&& records)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	job_done.wait(lock, [this](){ return jobs.size() < max_pending || error; });
+	check_error();
+	jobs.push_back(Job{fname, std::move(records)});
+	lock.unlock();
+	job_ready.notify_one();
+}
+
+// Wait until all queued snapshots are written
+template <typename T>
+void AsyncWriter<T>::flush()
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	job_done.wait(lock, [this](){ return (jobs.empty() && !busy) || error; });
+	check_error();
+}
+
+// Writes what is left and stops the thread
+template <typename T>
+AsyncWriter<T>::~AsyncWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		done = true;
+	}
+	job_ready.notify_one();
+	worker.join();
+	if (error) {
+		try {
+			std::rethrow_exception(error);
+		} catch (const std::exception& e) {
+			std::cerr << "Error in asynchronous output: " << e.what() << std::endl;
+		}
+	}
+}
+
+// Writer thread
+template <typename T>
+void AsyncWriter<T>::run()
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	while (true) {
+		job_ready.wait(lock, [this](){ return !jobs.empty() || done; });
+		if (jobs.empty()) {
+			return;
+		}
+		Job job = std::move(jobs.front());
+		jobs.pop_front();
+		busy = true;
+		lock.unlock();
+
+		// Format and write without holding the lock
+		std::exception_ptr job_error;
+		try {
+			std::ofstream out(job.fname, std::ios_base::out | std::ios_base::trunc);
+			if (!out.is_open()) {
+				throw std::runtime_error("Error opening file " + job.fname);
+			}
+			for (const auto& rec : job.records) {
+				out << rec << '\n';
+			}
+			if (!out) {
+				throw std::runtime_error("Error writing to file " + job.fname);
+			}
+		} catch (...) {
+			job_error = std::current_exception();
+		}
+
+		lock.lock();
+		busy = false;
+		if (job_error && !error) {
+			error = job_error;
+		}
+		spare.push_back(std::move(job.records));
+		job_done.notify_all();
+	}
+}
+
+// Throw an error from the writer thread, called with the lock held
+template <typename T>
+void AsyncWriter<T>::check_error()
+{
+	if (error) {
+		std::exception_ptr err = error;
+		error = nullptr;
+		std::rethrow_exception(err);
+	}
+}
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef BINARY_ARCHIVE_H
+#define BINARY_ARCHIVE_H
+
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+/***************************************************************
+ * class: BinaryArchive
+ *
+ * Reads or writes objects to a versioned binary file
+ *
+ * The same function lists the members of a class for both
+ * directions - each class to be stored defines
+ *
+ * 		template <typename Archive>
+ * 		void serialize(Archive& ar) { ar(member_1, member_2, ...); }
+ *
+ * and when writing the members are only read. Numbers are
+ * stored in the native byte order, so files are meant to be
+ * read on the same type of machine and with the same version
+ * of the code. Streams can be used in place of files,
+ * e.g. to copy objects through memory.
+ **************************************************************/
+
+class BinaryArchive
+{
+public:
+
+	/// Reading from or writing to a file
+	enum Mode { load, save };
+
+	//
+	// Constructors
+	//
+
+	/**
+	 * \brief Opens the file and writes or verifies the header
+	 * \details Throws a std::runtime_error if the file cannot be opened,
+	 * 		is not of the expected kind, or has a different version
+	 * @param fname - path to the file
+	 * @param mode - load or save
+	 * @param kind - short tag identifying the type of the file
+	 * @param version - version of the file format for this kind
+	 */
+	BinaryArchive(const std::string& fname, const Mode mode,
+					const std::string& kind, const uint32_t version) :
+			file_name(fname), loading(mode == load)
+	{
+		file.open(fname, (loading ? std::ios::in : std::ios::out | std::ios::trunc) | std::ios::binary);
+		if (!file.is_open()) {
+			throw std::runtime_error("Cannot open file " + fname);
+		}
+		in = &file;
+		out = &file;
+		header(kind, version);
+	}
+
+	/**
+	 * \brief Reads from a stream, e.g. a copy of the state held in memory
+	 * \details Stream should be opened in binary mode; throws a 
+	 * 		std::runtime_error if the header does not match 
+	 * @param input - stream to read from
+	 * @param kind - short tag identifying the type of the data
+	 * @param version - version of the format for this kind
+	 * @param name - name of the source for error messages
+	 */
+	BinaryArchive(std::istream& input, const std::string& kind, 
+					const uint32_t version, const std::string& name = "stream") :
+			file_name(name), loading(true), in(&input) 
+		{ header(kind, version); }
+
+	/**
+	 * \brief Writes to a stream, e.g. to keep a copy of the state in memory
+	 * @param output - stream to write to
+	 * @param kind - short tag identifying the type of the data
+	 * @param version - version of the format for this kind
+	 * @param name - name of the destination for error messages
+	 */
+	BinaryArchive(std::ostream& output, const std::string& kind, 
+					const uint32_t version, const std::string& name = "stream") :
+			file_name(name), loading(false), out(&output) 
+		{ header(kind, version); }
+
+	/// True if objects are read from the file
+	bool is_loading() const { return loading; }
+
+	//
+	// Storing objects
+	//
+
+	/// Reads or writes all the arguments in order
+	template <typename T, typename... Ts>
+	void operator()(T& value, Ts&... values)
+		{ io(value); (*this)(values...); }
+
+	void operator()() { }
+
+	/**
+	 * \brief Writes a value that is not a member, e.g. a size, or
+	 * 		verifies it when loading
+	 * @param value - expected value
+	 * @param what - description of the value for the error message
+	 */
+	template <typename T>
+	void check(const T& value, const std::string& what)
+	{
+		T stored = value;
+		io(stored);
+		if (stored != value) {
+			throw std::runtime_error("Wrong " + what + " in file " + file_name);
+		}
+	}
+
+private:
+	std::string file_name;
+	std::fstream file;
+	bool loading = true;
+	// Streams used, the file or given by the caller
+	std::istream* in = nullptr;
+	std::ostream* out = nullptr;
+
+	// Write or verify the kind and version
+	void header(const std::string& kind, const uint32_t version)
+	{
+		// Tag is stored without its size so that any file 
+		// can be safely checked
+		std::string file_kind = kind;
+		uint32_t file_version = version;
+		bytes(&file_kind[0], file_kind.size());
+		if (file_kind != kind) {
+			throw std::runtime_error("File " + file_name + " is not of type " + kind);
+		}
+		io(file_version);
+		if (file_version != version) {
+			throw std::runtime_error("File " + file_name + " has version " + std::to_string(file_version)
+						+ ", expected version " + std::to_string(version));
+		}
+	}
+
+	// Raw bytes of numbers and arrays of numbers
+	void bytes(void* data, const size_t n)
+	{
+		if (n == 0) {
+			return;
+		}
+		const bool good = loading ? static_cast<bool>(in->read(static_cast<char*>(data), n))
+						: static_cast<bool>(out->write(static_cast<const char*>(data), n));
+		if (!good) {
+			throw std::runtime_error((loading ? "Unexpected end of file " : "Cannot write to file ")
+							+ file_name);
+		}
+	}
+
+	// Number of elements of a container
+	template <typename C>
+	size_t size(const C& c)
+	{
+		uint64_t n = c.size();
+		io(n);
+		return n;
+	}
+
+	// Numbers and enumerations
+	template <typename T>
+	typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type
+		io(T& value) { bytes(&value, sizeof(T)); }
+
+	// Classes with a serialize member
+	template <typename T>
+	typename std::enable_if<std::is_class<T>::value>::type
+		io(T& value) { value.serialize(*this); }
+
+	void io(std::string& str)
+	{
+		const size_t n = size(str);
+		if (loading) {
+			str.resize(n);
+		}
+		bytes(&str[0], n);
+	}
+
+	// Vectors of numbers at once, others element by element
+	template <typename T>
+	void io(std::vector<T>& vec)
+	{
+		const size_t n = size(vec);
+		if (loading) {
+			vec.resize(n);
+		}
+		io_elements(vec, std::integral_constant<bool, std::is_arithmetic<T>::value>());
+	}
+
+	template <typename T>
+	void io_elements(std::vector<T>& vec, std::true_type)
+		{ bytes(vec.data(), vec.size()*sizeof(T)); }
+
+	template <typename T>
+	void io_elements(std::vector<T>& vec, std::false_type)
+	{
+		for (auto& element : vec) {
+			io(element);
+		}
+	}
+
+	template <typename T>
+	void io(std::deque<T>& deq)
+	{
+		const size_t n = size(deq);
+		if (loading) {
+			deq.resize(n);
+		}
+		for (auto& element : deq) {
+			io(element);
+		}
+	}
+
+	template <typename K, typename V>
+	void io(std::map<K, V>& m)
+	{
+		const size_t n = size(m);
+		if (!loading) {
+			for (auto& entry : m) {
+				K key = entry.first;
+				io(key);
+				io(entry.second);
+			}
+			return;
+		}
+		m.clear();
+		for (size_t i = 0; i < n; ++i) {
+			K key;
+			V value;
+			io(key);
+			io(value);
+			m.emplace(std::move(key), std::move(value));
+		}
+	}
+
+	template <typename T, size_t N>
+	void io(std::array<T, N>& arr)
+	{
+		for (auto& element : arr) {
+			io(element);
+		}
+	}
+
+	template <typename T1, typename T2>
+	void io(std::pair<T1, T2>& p) { io(p.first); io(p.second); }
+
+	template <typename... Ts>
+	void io(std::tuple<Ts...>& t) { io_tuple<0>(t); }
+
+	template <size_t I, typename... Ts>
+	typename std::enable_if<(I < sizeof...(Ts))>::type io_tuple(std::tuple<Ts...>& t)
+		{ io(std::get<I>(t)); io_tuple<I + 1>(t); }
+
+	template <size_t I, typename... Ts>
+	typename std::enable_if<(I == sizeof...(Ts))>::type io_tuple(std::tuple<Ts...>&) { }
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define LOAD_PARAMETERS_H
 
 #include "FileHandler.h"
+#include "text_reader.h"
 #include "../common.h"
 
 /***************************************************** 
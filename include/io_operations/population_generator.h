@@ -0,0 +1,274 @@
+#ifndef POPULATION_GENERATOR_H
+#define POPULATION_GENERATOR_H
+
+#include "../common.h"
+#include "../rng.h"
+#include "../utils.h"
+#include "text_reader.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <cstdio>
+
+/***************************************************************
+ * class: PopulationGenerator
+ *
+ * Synthetic towns of any size, written in the formats
+ * of the ABM::create_ functions
+ *
+ * Agents are drawn independently from the age, household
+ * size, school size, and workplace size distributions and
+ * the employment and commuting fractions of the parameters.
+ * Places are placed uniformly in a square town. Schools
+ * and workplaces are filled to sizes drawn from lognormal
+ * distributions, households to sizes drawn from the household
+ * size distribution.
+ *
+ * Agents and places are processed in fixed blocks, each
+ * with its own random number stream, and blocks are split
+ * between threads, so a town depends only on the parameters
+ * and the seed, not on the number of threads.
+ *
+ **************************************************************/
+
+class PopulationGenerator
+{
+public:
+
+	/// Town properties, defaults approximate New Rochelle, NY
+	struct Parameters{
+		// Number of agents
+		int n_agents = 80000;
+		uint64_t seed = 2020;
+
+		//
+		// Spatial extent
+		//
+
+		// Center of the town
+		double center_x = 40.93;
+		double center_y = -73.78;
+		// Side of the square town, same units as the center;
+		// if 0, the town has the population density of New Rochelle
+		double side = 0.0;
+
+		//
+		// Size distributions
+		//
+
+		// Fractions of agents in age groups 0-9, 10-19, ..., 90-99
+		std::vector<double> age_groups = {0.12, 0.13, 0.13, 0.13, 0.13,
+										  0.13, 0.12, 0.07, 0.03, 0.01};
+		// Fractions of households with 1, 2, ... members
+		std::vector<double> household_sizes = {0.28, 0.34, 0.16, 0.13, 0.06, 0.02, 0.01};
+		// Mean and standard deviation of the number of students
+		// in a school, lognormal
+		double school_size_mean = 500.0;
+		double school_size_sd = 300.0;
+		// Mean and standard deviation of the number of employees
+		// in a workplace, lognormal
+		double workplace_size_mean = 15.0;
+		double workplace_size_sd = 40.0;
+		// Mean number of residents of a retirement home
+		double retirement_home_size = 130.0;
+		// Mean number of agents in a carpool
+		double carpool_size = 3.0;
+		// Agents per hospital, public transit line, and leisure location
+		double agents_per_hospital = 25000.0;
+		double agents_per_public_transit = 5700.0;
+		double agents_per_leisure_location = 110.0;
+		// Fraction of leisure locations outside of town
+		double fraction_leisure_outside = 0.05;
+
+		//
+		// Agent fractions
+		//
+
+		// Hospitalized with conditions other than COVID-19
+		double fraction_hospital_patients = 0.002;
+		// Retirement home residents, of agents 65 and older
+		double fraction_retirement_home_residents = 0.05;
+		// Students, of agents 22 and younger
+		double fraction_students = 0.9;
+		// Employed, of agents 18 to 69
+		double fraction_employed = 0.65;
+		// Hospital, retirement home, and school staff, of the employed
+		double fraction_hospital_staff = 0.03;
+		double fraction_retirement_home_staff = 0.02;
+		double fraction_school_staff = 0.05;
+		// Working outside of town, of the remaining employed
+		double fraction_working_outside = 0.1;
+		// Working from home, of the remaining employed
+		double fraction_working_from_home = 0.1;
+		// Fractions of commuters by car, carpool, public transit, walking, other
+		std::vector<double> travel_modes = {0.75, 0.1, 0.07, 0.05, 0.03};
+		// Range of commuting times, minutes
+		double min_travel_time = 5.0;
+		double max_travel_time = 90.0;
+		// Initially infected
+		double fraction_infected = 0.0;
+	};
+
+	/**
+	 * \brief Generator of towns with given properties
+	 * @param par - town properties
+	 */
+	explicit PopulationGenerator(const Parameters& par);
+
+	/**
+	 * \brief Read town properties from file
+	 * \details Same format as the model parameter files, a // comment with
+	 *		the property name in one line, its value in the next; size
+	 * 		distributions have all their values in that line; names are
+	 * 		the Parameters members with spaces instead of underscores,
+	 * 		e.g. "household sizes"; properties not in the file keep the defaults
+	 * @param fname - path to the file
+	 */
+	static Parameters load_parameters(const std::string& fname);
+
+	/**
+	 * \brief Generate the town and write all its files
+	 * \details Files are prefix_households.txt, prefix_schools.txt,
+	 *		prefix_workplaces.txt, prefix_hospitals.txt,
+	 * 		prefix_retirement_homes.txt, prefix_carpool.txt, prefix_public.txt,
+	 *		prefix_leisure.txt, and prefix_agents.txt
+	 * @param prefix - path and name of the town
+	 * @param n_threads - number of threads, 1 or less runs in the calling thread
+	 */
+	void generate(const std::string& prefix, const int n_threads = 1);
+
+	//
+	// Getters
+	//
+
+	/// Number of agents in the last generated town
+	size_t number_of_agents() const { return agents.size(); }
+
+	/// Number of households in the last generated town
+	size_t number_of_households() const { return households.size(); }
+
+	/// Number of schools in the last generated town
+	size_t number_of_schools() const { return schools.size(); }
+
+	/// Number of workplaces in the last generated town, in town and outside
+	size_t number_of_workplaces() const { return workplaces.size(); }
+
+private:
+
+	// Agent categories
+	enum Residence : char { household, retirement_home, hospital };
+	enum Role : char { none, regular, outside, hospital_staff,
+						retirement_home_staff, school_staff };
+
+	// Streams of random numbers, one per block and stage
+	enum Stage : uint32_t { agent_stage = 1, assignment_stage = 2,
+							sizes_stage = 3, place_stage = 4 };
+
+	// School types, by age of students: under 5, 5-10, 11-13, 14-17, 18-22
+	static constexpr int n_school_types = 5;
+	static const std::array<std::string, n_school_types>& school_types()
+	{
+		static const std::array<std::string, n_school_types> types =
+			{{"daycare", "primary", "middle", "high", "college"}};
+		return types;
+	}
+
+	// Occupations of regular workplaces
+	static const std::array<std::string, 5>& occupations()
+	{
+		static const std::array<std::string, 5> types = {{"A", "B", "C", "D", "E"}};
+		return types;
+	}
+
+	// Travel modes of commuters, in the order of Parameters::travel_modes
+	static const std::array<std::string, 5>& travel_modes()
+	{
+		static const std::array<std::string, 5> modes =
+			{{"car", "carpool", "public", "walk", "other"}};
+		return modes;
+	}
+
+	// Agent as drawn, IDs are assigned after all places are known
+	struct GeneratedAgent{
+		double travel_time = 0.0;
+		int age = 0;
+		// ID of the household, retirement home, or hospital
+		int home_ID = 0;
+		// School of students, 0 if not a student
+		int school_ID = 0;
+		// Workplace, retirement home, school, or hospital of employees
+		int work_ID = 0;
+		int transit_ID = 0;
+		Residence residence = household;
+		Role role = none;
+		// Index in school_types(), -1 if not a student
+		signed char school_type = -1;
+		// Index in occupations(), -1 if none or not known yet
+		signed char occupation = -1;
+		// Index in travel_modes(), -1 if not commuting
+		signed char travel_mode = -1;
+		bool works_from_home = false;
+		bool infected = false;
+	};
+
+	// Place with coordinates and an index of its type,
+	// -1 for workplaces outside of town, 1 for leisure locations outside;
+	// an aggregate, zero when value-initialized
+	struct GeneratedPlace{
+		double x;
+		double y;
+		int type;
+	};
+
+	// Number of agents or places drawn from one stream
+	static constexpr size_t block_size = 1 << 14;
+
+	Parameters par;
+	// Side of the town
+	double side = 0.0;
+
+	std::vector<GeneratedAgent> agents;
+	std::vector<GeneratedPlace> households;
+	std::vector<GeneratedPlace> retirement_homes;
+	std::vector<GeneratedPlace> hospitals;
+	std::vector<GeneratedPlace> schools;
+	// In town workplaces first, then the outside ones
+	std::vector<GeneratedPlace> workplaces;
+	std::vector<GeneratedPlace> leisure_locations;
+	int n_carpools = 0;
+	int n_public = 0;
+
+	// Checks the parameters, throws if not valid
+	void check_parameters() const;
+
+	// Draws agent properties other than the place IDs
+	void draw_agents(const int n_threads);
+	void draw_agent(GeneratedAgent& agent, RNG& rng) const;
+
+	// Creates places and assigns agents to them
+	void create_places(const int n_threads);
+	// Adds places with lognormal sizes until they fit n_members;
+	// returns the ID of the place of each member, in a random order
+	std::vector<int> fill_places(const int n_members, std::vector<GeneratedPlace>& places,
+					const int type, const double mean, const double sd, RNG& rng) const;
+	// Same for households, with sizes from the household size distribution
+	std::vector<int> fill_households(const int n_members, RNG& rng);
+	// Random coordinates of places, table selects the stream
+	void locate_places(std::vector<GeneratedPlace>& places, const uint32_t table,
+					const int n_threads) const;
+
+	// Writes all files
+	void write_places(const std::string& fname, const std::vector<GeneratedPlace>& places,
+						const int n_threads,
+						const std::function<std::string(const GeneratedPlace&)>& type) const;
+	void write_transit(const std::string& fname, const int n, const std::string& info) const;
+	void write_agents(const std::string& fname, const int n_threads) const;
+
+	// Samples an index from a distribution of fractions
+	static int draw_index(const std::vector<double>& fractions, RNG& rng);
+	// Number of blocks of n items
+	static size_t n_blocks(const size_t n) { return (n + block_size - 1)/block_size; }
+};
+
+#endif
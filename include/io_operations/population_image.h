@@ -0,0 +1,374 @@
+#ifndef POPULATION_IMAGE_H
+#define POPULATION_IMAGE_H
+
+#include "../common.h"
+#include "abm_io.h"
+#include <array>
+#include <cstdint>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/***************************************************************
+ * class: PopulationImage
+ *
+ * Town and population in a single binary file with
+ * fixed-width records, loaded through mmap
+ *
+ * The image is compiled once from the text input files
+ * (households, schools, ..., agents); records hold the
+ * values of the text columns already converted to numbers
+ * so loading is only reading them in place. The file is
+ * mapped read-only and shared, so processes on the same
+ * node that load the same image share its pages. Records
+ * are stored in the native byte order.
+ **************************************************************/
+
+class PopulationImage
+{
+public:
+
+	/// Tables in the image, in the order they are stored
+	enum Table : unsigned { households, retirement_homes, schools, workplaces,
+		hospitals, carpools, public_transit, leisure_locations, agents, n_tables };
+
+	/// Place as defined in one line of a place file
+	struct PlaceRecord{
+		// Coordinates, zero for transit
+		double x = 0.0;
+		double y = 0.0;
+		int32_t ID = 0;
+		// School, workplace, leisure, or transit type,
+		// null-terminated; empty if the place has no type
+		char type[20] = {};
+	};
+
+	/**
+	 * \brief Agent as defined in one line of the agent file
+	 * \details Columns are named as in the Agent constructor; columns that
+	 * 		are not read for an agent (e.g. carpool ID if not in a carpool)
+	 *		are zero
+	 */
+	struct AgentRecord{
+		double x = 0.0;
+		double y = 0.0;
+		double work_travel_time = 0.0;
+		int32_t student = 0;
+		int32_t works = 0;
+		int32_t age = 0;
+		int32_t household_ID = 0;
+		int32_t hospital_non_covid_patient = 0;
+		int32_t school_ID = 0;
+		int32_t retirement_home_resident = 0;
+		int32_t retirement_home_employee = 0;
+		int32_t school_employee = 0;
+		int32_t work_ID = 0;
+		int32_t hospital_employee = 0;
+		int32_t hospital_ID = 0;
+		int32_t infected = 0;
+		int32_t works_from_home = 0;
+		// Work ID of retirement home, school, or hospital employees
+		int32_t special_work_ID = 0;
+		int32_t carpool_ID = 0;
+		int32_t public_transit_ID = 0;
+		char work_travel_mode[16] = {};
+		char occupation[16] = {};
+	};
+
+	/// Read-only range of records, in the image or in a vector
+	template <typename T>
+	class Records{
+	public:
+		Records(const T* first, const size_t n) : data(first), n_records(n) { }
+		Records(const std::vector<T>& vec) : data(vec.data()), n_records(vec.size()) { }
+
+		size_t size() const { return n_records; }
+		const T* begin() const { return data; }
+		const T* end() const { return data + n_records; }
+
+	private:
+		const T* data = nullptr;
+		size_t n_records = 0;
+	};
+
+	//
+	// Constructors
+	//
+
+	/**
+	 * \brief Maps an image file
+	 * \details Throws a std::runtime_error if the file cannot be mapped
+	 * 		or is not a population image of this version
+	 * @param fname - path to the image
+	 */
+	explicit PopulationImage(const std::string& fname) : file_name(fname)
+	{
+		const int fd = open(fname.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw std::runtime_error("Cannot open population image " + fname);
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+			close(fd);
+			throw std::runtime_error("File " + fname + " is not a population image");
+		}
+		n_bytes = st.st_size;
+		void* mapped = mmap(nullptr, n_bytes, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (mapped == MAP_FAILED) {
+			throw std::runtime_error("Cannot map population image " + fname);
+		}
+		image = static_cast<const char*>(mapped);
+		try {
+			check_header();
+		} catch (...) {
+			munmap(const_cast<char*>(image), n_bytes);
+			throw;
+		}
+	}
+
+	PopulationImage(const PopulationImage&) = delete;
+	PopulationImage& operator=(const PopulationImage&) = delete;
+
+	//
+	// Records
+	//
+
+	/// Records of places in table t, t is any table but agents
+	Records<PlaceRecord> place_table(const Table t) const
+	{
+		if (t == agents || t >= n_tables) {
+			throw std::invalid_argument("Agents are not a table of places");
+		}
+		return Records<PlaceRecord>(
+			reinterpret_cast<const PlaceRecord*>(image + header().offsets[t]), header().counts[t]);
+	}
+
+	/// Agent records
+	Records<AgentRecord> agent_table() const
+	{
+		return Records<AgentRecord>(
+			reinterpret_cast<const AgentRecord*>(image + header().offsets[agents]), header().counts[agents]);
+	}
+
+	//
+	// Conversion of text input
+	//
+
+	/**
+	 * \brief Place records from a place file
+	 * \details The file is streamed one line at a time
+	 * @param fname - text file with one place per line
+	 * @param t - table the places are stored in, any but agents
+	 */
+	static std::vector<PlaceRecord> place_records(const std::string& fname, const Table t);
+
+	/// Agent records from an agent file, one agent per line
+	static std::vector<AgentRecord> agent_records(const std::string& fname);
+
+	/**
+	 * \brief Compile text input files into an image
+	 * @param text_files - path of the text file of each table, empty for no such places
+	 * @param fname - path of the image to write
+	 */
+	static void compile(const std::array<std::string, n_tables>& text_files, const std::string& fname);
+
+	/// Contents of a fixed-width text field
+	template <size_t N>
+	static std::string text(const char (&field)[N])
+		{ return std::string(field, strnlen(field, N)); }
+
+	//
+	// Destructor
+	//
+
+	~PopulationImage() { munmap(const_cast<char*>(image), n_bytes); }
+
+private:
+
+	// File starts with the header, tables follow in order
+	struct Header{
+		char magic[8];
+		uint32_t version;
+		uint32_t place_record_size;
+		uint32_t agent_record_size;
+		uint32_t table_count;
+		uint64_t offsets[n_tables];
+		uint64_t counts[n_tables];
+	};
+
+	static constexpr const char* magic = "ABM POP";
+	enum { version = 1 };
+
+	std::string file_name;
+	const char* image = nullptr;
+	size_t n_bytes = 0;
+
+	const Header& header() const { return *reinterpret_cast<const Header*>(image); }
+
+	// Verify the header and that all tables are in the file
+	void check_header() const;
+
+	using line_type = std::vector<TextReader::Token>;
+
+	// Copy an entry into a fixed-width field
+	template <size_t N>
+	static void set_text(char (&field)[N], const TextReader::Token& entry)
+	{
+		if (entry.size() >= N) {
+			throw std::invalid_argument("Value " + entry.str() + " too long for a population image");
+		}
+		std::copy(entry.begin(), entry.end(), field);
+	}
+};
+
+//
+// Implementations
+//
+
+// Place records from a place file
+inline std::vector<PopulationImage::PlaceRecord> PopulationImage::place_records(
+			const std::string& fname, const Table t)
+{
+	if (t == agents || t >= n_tables) {
+		throw std::invalid_argument("Agents are not a table of places");
+	}
+	// Transit has only the ID and type, places with
+	// types have them after the coordinates
+	const bool transit = (t == carpools || t == public_transit);
+	const bool typed = (t == schools || t == workplaces || t == leisure_locations);
+	std::vector<PlaceRecord> records;
+	AbmIO(fname, " ", true, {0, 0, 0}).for_each_line([&](const line_type& line){
+		records.emplace_back();
+		PlaceRecord& rec = records.back();
+		rec.ID = line.at(0).as<int>();
+		if (transit) {
+			set_text(rec.type, line.at(1));
+			return;
+		}
+		rec.x = line.at(1).as<double>();
+		rec.y = line.at(2).as<double>();
+		if (typed) {
+			set_text(rec.type, line.at(3));
+		}
+	});
+	return records;
+}
+
+// Agent records from an agent file
+inline std::vector<PopulationImage::AgentRecord> PopulationImage::agent_records(const std::string& fname)
+{
+	std::vector<AgentRecord> records;
+	AbmIO(fname, " ", true, {0, 0, 0}).for_each_line([&](const line_type& agent){
+		records.emplace_back();
+		AgentRecord& rec = records.back();
+		rec.student = agent.at(0).as<int>();
+		rec.works = agent.at(1).as<int>();
+		rec.age = agent.at(2).as<int>();
+		rec.x = agent.at(3).as<double>();
+		rec.y = agent.at(4).as<double>();
+		rec.hospital_non_covid_patient = agent.at(6).as<int>();
+		rec.school_ID = agent.at(7).as<int>();
+		rec.retirement_home_resident = agent.at(8).as<int>();
+		rec.retirement_home_employee = agent.at(9).as<int>();
+		rec.school_employee = agent.at(10).as<int>();
+		rec.hospital_employee = agent.at(12).as<int>();
+		rec.hospital_ID = agent.at(13).as<int>();
+		rec.infected = agent.at(14).as<int>();
+		rec.works_from_home = agent.at(15).as<int>();
+		set_text(rec.work_travel_mode, agent.at(17));
+		set_text(rec.occupation, agent.at(21));
+
+		// Columns that are only read in some cases,
+		// same cases as when creating the agent
+		const bool patient = (rec.hospital_non_covid_patient == 1);
+		const bool hospital_staff = (rec.hospital_employee == 1 && !patient);
+		const bool works = (rec.works == 1 && !(patient || hospital_staff));
+		if (!patient) {
+			rec.household_ID = agent.at(5).as<int>();
+		}
+		if (rec.retirement_home_employee == 1 || rec.school_employee == 1 || hospital_staff) {
+			rec.special_work_ID = agent.at(18).as<int>();
+		} else if (works) {
+			rec.work_ID = agent.at(11).as<int>();
+		}
+		if (rec.works_from_home != 1 && (works || hospital_staff)) {
+			if (agent.at(17) == "carpool") {
+				rec.carpool_ID = agent.at(19).as<int>();
+			}
+			if (agent.at(17) == "public") {
+				rec.public_transit_ID = agent.at(20).as<int>();
+			}
+			rec.work_travel_time = agent.at(16).as<double>();
+		}
+	});
+	return records;
+}
+
+// Compile text input files into an image
+inline void PopulationImage::compile(const std::array<std::string, n_tables>& text_files,
+										const std::string& fname)
+{
+	std::vector<std::vector<PlaceRecord>> places(agents);
+	std::vector<AgentRecord> agent_recs;
+	for (unsigned t = 0; t < n_tables; ++t) {
+		if (text_files.at(t).empty()) {
+			continue;
+		}
+		if (t == agents) {
+			agent_recs = agent_records(text_files.at(t));
+		} else {
+			places.at(t) = place_records(text_files.at(t), static_cast<Table>(t));
+		}
+	}
+
+	Header head = {};
+	std::copy(magic, magic + 8, head.magic);
+	head.version = version;
+	head.place_record_size = sizeof(PlaceRecord);
+	head.agent_record_size = sizeof(AgentRecord);
+	head.table_count = n_tables;
+	uint64_t offset = sizeof(Header);
+	for (unsigned t = 0; t < n_tables; ++t) {
+		head.offsets[t] = offset;
+		head.counts[t] = (t == agents) ? agent_recs.size() : places.at(t).size();
+		offset += head.counts[t]*((t == agents) ? sizeof(AgentRecord) : sizeof(PlaceRecord));
+	}
+
+	std::ofstream out(fname, std::ios::out | std::ios::trunc | std::ios::binary);
+	if (!out.is_open()) {
+		throw std::runtime_error("Cannot open file " + fname);
+	}
+	out.write(reinterpret_cast<const char*>(&head), sizeof(Header));
+	for (const auto& table : places) {
+		out.write(reinterpret_cast<const char*>(table.data()), table.size()*sizeof(PlaceRecord));
+	}
+	out.write(reinterpret_cast<const char*>(agent_recs.data()), agent_recs.size()*sizeof(AgentRecord));
+	if (!out) {
+		throw std::runtime_error("Cannot write to file " + fname);
+	}
+}
+
+// Verify the header and that all tables are in the file
+inline void PopulationImage::check_header() const
+{
+	const Header& head = header();
+	if (std::string(head.magic, strnlen(head.magic, 8)) != magic) {
+		throw std::runtime_error("File " + file_name + " is not a population image");
+	}
+	if (head.version != version || head.place_record_size != sizeof(PlaceRecord)
+			|| head.agent_record_size != sizeof(AgentRecord) || head.table_count != n_tables) {
+		throw std::runtime_error("Population image " + file_name
+					+ " was compiled with a different version of the code");
+	}
+	for (unsigned t = 0; t < n_tables; ++t) {
+		const uint64_t size = (t == agents) ? sizeof(AgentRecord) : sizeof(PlaceRecord);
+		if (head.offsets[t] % alignof(AgentRecord) != 0 || head.offsets[t] > n_bytes
+				|| head.counts[t] > (n_bytes - head.offsets[t])/size) {
+			throw std::runtime_error("Population image " + file_name + " is truncated or corrupted");
+		}
+	}
+}
+
+#endif
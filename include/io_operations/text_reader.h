@@ -0,0 +1,225 @@
+#ifndef TEXT_READER_H
+#define TEXT_READER_H
+
+#include "../common.h"
+#include <cstdio>
+#include <cerrno>
+#include <ios>
+
+/***************************************************************
+ * class: TextReader
+ *
+ * Streaming tokenizer of whitespace separated text files
+ *
+ * The file is read in large blocks into one buffer and
+ * each line is split into tokens that point into that
+ * buffer, so reading does not allocate per line or per
+ * token; numbers are converted with strtoll and strtod
+ * directly from the buffer. Lines are passed to a
+ * callable as a vector of tokens reused for all lines.
+ **************************************************************/
+
+class TextReader
+{
+public:
+
+	/// Whitespace separated entry of a line, valid only during the callback
+	class Token{
+	public:
+		Token(const char* b, const char* e) : first(b), last(e) { }
+
+		/// Characters of the entry
+		const char* begin() const { return first; }
+		const char* end() const { return last; }
+		/// Number of characters
+		size_t size() const { return last - first; }
+		/// Copy of the entry
+		std::string str() const { return std::string(first, last); }
+		/// True if equal to a string
+		bool operator==(const std::string& s) const
+			{ return s.size() == size() && std::equal(first, last, s.begin()); }
+		bool operator!=(const std::string& s) const { return !(*this == s); }
+
+		/**
+		 * \brief Entry converted to type T
+		 * \details Numbers are converted like std::stoi and std::stod -
+		 * 		from the leading part of the entry; throws std::invalid_argument 
+		 * 		if there is no number and std::out_of_range if it does not fit;
+		 * 		other types than strings, bool, and numbers use operator>> 
+		 */
+		template <typename T>
+		T as() const { T value; convert(value); return value; }
+
+	private:
+		const char* first = nullptr;
+		const char* last = nullptr;
+
+		void convert(std::string& value) const { value.assign(first, last); }
+		void convert(bool& value) const { value = (integer(0, 1) != 0); }
+		void convert(int& value) const 
+			{ value = static_cast<int>(integer(std::numeric_limits<int>::min(), std::numeric_limits<int>::max())); }
+		void convert(long& value) const 
+			{ value = static_cast<long>(integer(std::numeric_limits<long>::min(), std::numeric_limits<long>::max())); }
+		void convert(long long& value) const 
+			{ value = integer(std::numeric_limits<long long>::min(), std::numeric_limits<long long>::max()); }
+		void convert(float& value) const { value = static_cast<float>(floating()); }
+		void convert(double& value) const { value = floating(); }
+
+		template <typename U>
+		void convert(U& value) const
+		{
+			std::istringstream in(str());
+			if (!(in >> value)) {
+				throw std::invalid_argument("Entry " + str() + " cannot be converted");
+			}
+		}
+
+		// Entries are always followed by whitespace or a null
+		// character in the buffer, so conversion stops at the end
+		long long integer(const long long min, const long long max) const
+		{
+			char* end = nullptr;
+			errno = 0;
+			const long long value = std::strtoll(first, &end, 10);
+			check(end, "an integer");
+			if (value < min || value > max) {
+				throw std::out_of_range("Entry " + str() + " out of range");
+			}
+			return value;
+		}
+
+		double floating() const
+		{
+			char* end = nullptr;
+			errno = 0;
+			const double value = std::strtod(first, &end);
+			check(end, "a number");
+			return value;
+		}
+
+		void check(const char* end, const std::string& what) const
+		{
+			if (end == first) {
+				throw std::invalid_argument("Entry " + str() + " is not " + what);
+			}
+			if (errno == ERANGE) {
+				throw std::out_of_range("Entry " + str() + " out of range");
+			}
+		}
+	};
+
+	//
+	// Constructors
+	//
+
+	/**
+	 * \brief Opens a file for reading
+	 * \details Throws std::ios_base::failure if the file cannot be opened,
+	 * 		same as FileHandler
+	 * @param name - path to the file
+	 * @param block - size of blocks read at once, in bytes
+	 */
+	explicit TextReader(const std::string& name, const size_t block = 1 << 20) :
+		fname(name), block_size(std::max<size_t>(block, 64))
+	{
+		file = std::fopen(fname.c_str(), "rb");
+		if (file == nullptr) {
+			std::cerr << "Error opening file " << fname << std::endl;
+			throw std::ios_base::failure(std::strerror(errno));
+		}
+	}
+
+	TextReader(const TextReader&) = delete;
+	TextReader& operator=(const TextReader&) = delete;
+
+	//
+	// Reading
+	//
+
+	/**
+	 * \brief Call func for each line of the file
+	 * \details func takes a const std::vector<TextReader::Token>& with
+	 * 		the entries of the line; blank lines have no entries
+	 * @param func - callable, called once per line in order
+	 */
+	template <typename F>
+	void for_each_line(F func);
+
+	/// Destructor closes the file
+	~TextReader() { std::fclose(file); }
+
+private:
+	std::string fname;
+	size_t block_size = 0;
+	std::FILE* file = nullptr;
+	// Tokens of the current line, reused
+	std::vector<Token> tokens;
+
+	static bool is_space(const char c)
+		{ return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+	// Split the line [begin, end) and pass it to func
+	template <typename F>
+	void process_line(const char* begin, const char* end, F& func)
+	{
+		tokens.clear();
+		const char* pos = begin;
+		while (pos != end) {
+			while (pos != end && is_space(*pos)) {
+				++pos;
+			}
+			const char* start = pos;
+			while (pos != end && !is_space(*pos)) {
+				++pos;
+			}
+			if (start != pos) {
+				tokens.emplace_back(start, pos);
+			}
+		}
+		func(static_cast<const std::vector<Token>&>(tokens));
+	}
+};
+
+// Call func for each line of the file
+template <typename F>
+void TextReader::for_each_line(F func)
+{
+	// One extra character for a terminating null
+	std::vector<char> buffer(block_size + 1);
+	size_t n_kept = 0;
+	bool eof = false;
+	while (!eof) {
+		// Grow the buffer if a single line does not fit
+		if (n_kept == buffer.size() - 1) {
+			buffer.resize(2*buffer.size() - 1);
+		}
+		const size_t n_read = std::fread(buffer.data() + n_kept, 1, buffer.size() - 1 - n_kept, file);
+		if (n_read == 0) {
+			if (std::ferror(file)) {
+				throw std::runtime_error("Error reading file " + fname);
+			}
+			eof = true;
+		}
+		const size_t n_data = n_kept + n_read;
+		buffer[n_data] = '\0';
+
+		// Complete lines
+		const char* line = buffer.data();
+		const char* data_end = buffer.data() + n_data;
+		const char* newline = nullptr;
+		while ((newline = static_cast<const char*>(std::memchr(line, '\n', data_end - line))) != nullptr) {
+			process_line(line, newline, func);
+			line = newline + 1;
+		}
+		// Last line without a newline
+		if (eof && line != data_end) {
+			process_line(line, data_end, func);
+			line = data_end;
+		}
+		// Keep the incomplete line for the next block
+		n_kept = data_end - line;
+		std::copy(line, data_end, buffer.data());
+	}
+}
+
+#endif
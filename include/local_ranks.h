@@ -0,0 +1,330 @@
+#ifndef LOCAL_RANKS_H
+#define LOCAL_RANKS_H
+
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <cstdio>
+#include <algorithm>
+#include <exception>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+/***************************************************************
+ * class: LocalRanks
+ *
+ * Group of processes on one node that run the same
+ * program, each with its own rank, connected with
+ * Unix domain sockets
+ *
+ * Rank 0 is the process that creates the group, it
+ * forks the other ranks; all ranks then continue from
+ * the same point with a copy of its memory. Ranks other
+ * than 0 are connected to rank 0 only - reductions are
+ * summed in rank 0 in the order of ranks and the result
+ * sent back, so all ranks get identical values; buffers
+ * exchanged between pairs of ranks are routed through
+ * rank 0 too.
+ *
+ * Ranks other than 0 end when the group is destroyed,
+ * with an exit status of 0 unless an error occurred;
+ * rank 0 waits for all of them. The group should be
+ * created before any threads are started.
+ **************************************************************/
+
+class LocalRanks
+{
+public:
+
+	//
+	// Constructors
+	//
+
+	/**
+	 * \brief Fork the other ranks
+	 * \details Throws std::runtime_error if a socket or a process
+	 *		cannot be created
+	 * @param n_ranks - number of processes including this one
+	 */
+	explicit LocalRanks(const int n_ranks);
+
+	LocalRanks(const LocalRanks&) = delete;
+	LocalRanks& operator=(const LocalRanks&) = delete;
+
+	//
+	// Communication
+	//
+
+	/**
+	 * \brief Replace values with their sum over all ranks
+	 * \details All ranks call it with the same number of values
+	 * @param values - partial values of this rank, summed on return
+	 */
+	void allreduce_sum(std::vector<double>& values);
+
+	/**
+	 * \brief Send a buffer to each rank and receive one from each
+	 * \details All ranks call it, buffers can have different sizes, 
+	 *		also zero; throws std::invalid_argument if the number of
+	 *		buffers is not the number of ranks
+	 * @param buffers - buffers[r] is sent to rank r and replaced with
+	 *		the buffer rank r sent to this rank; the buffer of this 
+	 *		rank is not sent and stays as it is
+	 */
+	void exchange(std::vector<std::vector<double>>& buffers);
+
+	/// Wait until all ranks reach this call
+	void barrier() { std::vector<double> token(1, 0.0); allreduce_sum(token); }
+
+	/**
+	 * \brief Mark that this rank failed
+	 * \details Ranks other than 0 then exit with a nonzero status, 
+	 *		as they do when the group is destroyed by an exception
+	 */
+	void set_failed() { failed = true; }
+
+	//
+	// Getters
+	//
+
+	/// Rank of this process, 0 to size() - 1
+	int rank() const { return my_rank; }
+	/// Number of ranks
+	int size() const { return n_ranks; }
+
+	/**
+	 * \brief True if all ranks other than 0 ended with status 0
+	 * \details Valid in rank 0 after wait_for_ranks
+	 */
+	bool ranks_succeeded() const { return all_succeeded; }
+
+	/// Rank 0 waits for the other ranks to end, no effect in other ranks
+	void wait_for_ranks();
+
+	//
+	// Destructor
+	//
+
+	/// Ends ranks other than 0, rank 0 waits for them
+	~LocalRanks();
+
+private:
+	int my_rank = 0;
+	int n_ranks = 1;
+	bool failed = false;
+	bool all_succeeded = true;
+	// In rank 0 socket to each other rank, in others only to rank 0
+	std::vector<int> sockets;
+	std::vector<pid_t> children;
+
+	// Send or receive exactly n bytes
+	static void send_all(const int fd, const void* data, const size_t n);
+	static void receive_all(const int fd, void* data, const size_t n);
+	// Send or receive a buffer preceded by its size
+	static void send_buffer(const int fd, const std::vector<double>& buffer);
+	static void receive_buffer(const int fd, std::vector<double>& buffer);
+};
+
+//
+// Implementations
+//
+
+// Fork the other ranks
+inline LocalRanks::LocalRanks(const int ranks) : n_ranks(std::max(ranks, 1))
+{
+	for (int r = 1; r < n_ranks; ++r){
+		int fds[2];
+		if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0){
+			throw std::runtime_error("Cannot create a socket for rank " + std::to_string(r)
+							+ ": " + std::strerror(errno));
+		}
+		// Output buffered so far would be written by both processes
+		std::fflush(nullptr);
+		const pid_t pid = fork();
+		if (pid < 0){
+			throw std::runtime_error("Cannot start rank " + std::to_string(r)
+							+ ": " + std::strerror(errno));
+		}
+		if (pid == 0){
+			// New rank keeps only its connection to rank 0
+			for (const auto& fd : sockets){
+				close(fd);
+			}
+			sockets.assign(1, fds[1]);
+			close(fds[0]);
+			children.clear();
+			my_rank = r;
+			return;
+		}
+		close(fds[1]);
+		sockets.push_back(fds[0]);
+		children.push_back(pid);
+	}
+}
+
+// Replace values with their sum over all ranks
+inline void LocalRanks::allreduce_sum(std::vector<double>& values)
+{
+	if (n_ranks == 1){
+		return;
+	}
+	const size_t n_bytes = values.size()*sizeof(double);
+	if (my_rank == 0){
+		std::vector<double> partial(values.size());
+		for (const auto& fd : sockets){
+			receive_all(fd, partial.data(), n_bytes);
+			for (size_t i = 0; i < values.size(); ++i){
+				values[i] += partial[i];
+			}
+		}
+		for (const auto& fd : sockets){
+			send_all(fd, values.data(), n_bytes);
+		}
+	} else {
+		send_all(sockets.front(), values.data(), n_bytes);
+		receive_all(sockets.front(), values.data(), n_bytes);
+	}
+}
+
+// Send a buffer to each rank and receive one from each
+inline void LocalRanks::exchange(std::vector<std::vector<double>>& buffers)
+{
+	if (buffers.size() != static_cast<size_t>(n_ranks)){
+		throw std::invalid_argument("Exchange needs one buffer for each of the " 
+						+ std::to_string(n_ranks) + " ranks, got " 
+						+ std::to_string(buffers.size()));
+	}
+	if (n_ranks == 1){
+		return;
+	}
+	if (my_rank == 0){
+		// Buffers from each rank to each rank
+		std::vector<std::vector<std::vector<double>>> routed(n_ranks, 
+									std::vector<std::vector<double>>(n_ranks));
+		for (int src = 1; src < n_ranks; ++src){
+			for (int dst = 0; dst < n_ranks; ++dst){
+				if (dst != src){
+					receive_buffer(sockets.at(src - 1), routed[src][dst]);
+				}
+			}
+		}
+		for (int dst = 1; dst < n_ranks; ++dst){
+			for (int src = 0; src < n_ranks; ++src){
+				if (src != dst){
+					send_buffer(sockets.at(dst - 1), src == 0 ? buffers[dst] : routed[src][dst]);
+				}
+			}
+		}
+		for (int src = 1; src < n_ranks; ++src){
+			buffers[src].swap(routed[src][0]);
+		}
+	} else {
+		for (int dst = 0; dst < n_ranks; ++dst){
+			if (dst != my_rank){
+				send_buffer(sockets.front(), buffers[dst]);
+			}
+		}
+		for (int src = 0; src < n_ranks; ++src){
+			if (src != my_rank){
+				receive_buffer(sockets.front(), buffers[src]);
+			}
+		}
+	}
+}
+
+// Rank 0 waits for the other ranks to end
+inline void LocalRanks::wait_for_ranks()
+{
+	if (my_rank != 0){
+		return;
+	}
+	for (const auto& fd : sockets){
+		close(fd);
+	}
+	sockets.clear();
+	for (const auto& pid : children){
+		int status = 0;
+		if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status)
+				|| WEXITSTATUS(status) != 0){
+			all_succeeded = false;
+		}
+	}
+	children.clear();
+}
+
+// Ends ranks other than 0, rank 0 waits for them
+inline LocalRanks::~LocalRanks()
+{
+	if (my_rank == 0){
+		wait_for_ranks();
+		return;
+	}
+	for (const auto& fd : sockets){
+		close(fd);
+	}
+	std::fflush(nullptr);
+	// Skip destructors and exit handlers inherited from rank 0;
+	// also failed if destroyed because of an exception
+	std::_Exit((failed || std::uncaught_exception()) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+// Send exactly n bytes
+inline void LocalRanks::send_all(const int fd, const void* data, const size_t n)
+{
+	const char* buf = static_cast<const char*>(data);
+	size_t sent = 0;
+	while (sent < n){
+		// No SIGPIPE if the other rank ended
+		const ssize_t k = send(fd, buf + sent, n - sent, MSG_NOSIGNAL);
+		if (k < 0 && errno == EINTR){
+			continue;
+		}
+		if (k <= 0){
+			throw std::runtime_error(std::string("Error sending to a local rank: ")
+							+ std::strerror(errno));
+		}
+		sent += static_cast<size_t>(k);
+	}
+}
+
+// Receive exactly n bytes
+inline void LocalRanks::receive_all(const int fd, void* data, const size_t n)
+{
+	char* buf = static_cast<char*>(data);
+	size_t received = 0;
+	while (received < n){
+		const ssize_t k = read(fd, buf + received, n - received);
+		if (k < 0 && errno == EINTR){
+			continue;
+		}
+		if (k <= 0){
+			throw std::runtime_error("Local rank closed the connection or failed");
+		}
+		received += static_cast<size_t>(k);
+	}
+}
+
+// Send a buffer preceded by its size
+inline void LocalRanks::send_buffer(const int fd, const std::vector<double>& buffer)
+{
+	const uint64_t n = buffer.size();
+	send_all(fd, &n, sizeof(n));
+	send_all(fd, buffer.data(), n*sizeof(double));
+}
+
+// Receive a buffer preceded by its size
+inline void LocalRanks::receive_buffer(const int fd, std::vector<double>& buffer)
+{
+	uint64_t n = 0;
+	receive_all(fd, &n, sizeof(n));
+	buffer.resize(n);
+	receive_all(fd, buffer.data(), n*sizeof(double));
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define MOBILITY_H
 
 #include <cmath>
+#include <numeric>
 #include "io_operations/abm_io.h"
 #include "io_operations/load_parameters.h"
 #include "places/place.h"
@@ -71,6 +72,17 @@ public:
 	 */
 	double compute_distance(const Place& loc1, const Place& loc2);
 
+	/**
+	 * \brief Free the tables of households that are not kept
+	 * \details Used when households are split between processes, 
+	 * 		each keeps the tables of its own households; households 
+	 *		whose tables are freed can still be visited as guests, 
+	 *		but cannot be assigned a public location; nothing 
+	 *		if the tables are not constructed
+	 * @param kept - nonzero for each household that keeps its table, in order of IDs 
+	 */
+	void keep_tables(const std::vector<char>& kept);
+
 	//
 	// Setters
 	//
@@ -79,12 +91,43 @@ public:
 	void set_probability_parameters(const double _dr0, const double _beta, const double _kappa)
 		{ dr0 = _dr0; beta = _beta; kappa = _kappa; }
 
+	/**
+	 * \brief Set the tail of the probability mass to drop for each household
+	 * \details Least probable public locations whose total probability 
+	 * 		does not exceed the tail are not stored and never assigned; 
+	 * 		remaining probabilities are renormalized. Default 0.0 keeps
+	 * 		all locations with nonzero probability. Needs to be set before
+	 * 		probabilities are constructed.
+	 * @param tail - fraction of the probability mass, in [0.0, 1.0)
+	 */
+	void set_truncation_tail(const double tail);
+
+	/**
+	 * \brief Construct probabilities using multiple threads
+	 * \details Households are split in contiguous chunks between 
+	 * 		threads, tables are the same for any number of threads
+	 * @param n_threads - number of threads, 1 is serial (default)
+	 */
+	void set_number_of_threads(const int n_threads) 
+		{ n_construction_threads = std::max(1, n_threads); }
+
 	//
 	// Getters
 	//
 	
-	std::vector<std::vector<double>> get_public_probabilities()
-		{ return public_probabilities; }
+	/// Cumulative probabilities of all public locations for each household
+	std::vector<std::vector<double>> get_public_probabilities() const;
+
+	/// Number of stored household - public location probabilities
+	size_t get_number_of_stored_probabilities() const;
+
+	/// Largest probability mass dropped for a household
+	double get_max_truncation_error() const { return max_truncation_error; }
+
+	/// Average probability mass dropped per household
+	double get_mean_truncation_error() const 
+		{ return public_probabilities.empty() ? 0.0 : 
+				total_truncation_error/public_probabilities.size(); }
 
 	//
 	// IO
@@ -93,18 +136,60 @@ public:
 	/// Save the matrix of probabilities to file	
 	void print_probabilities(const std::string fname);
 
+	/// Read or write the probability tables and parameters, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+	{
+		ar(public_probabilities, n_public_locations, dr0, beta, kappa, 
+			truncation_tail, max_truncation_error, total_truncation_error); 
+	}
+
 private:
 
+	// Public locations a household can visit and
+	// their cumulative probabilities
+	struct LeisureTable {
+		// IDs of stored locations, empty if all 
+		// locations are stored in order of IDs
+		std::vector<int> IDs;
+		std::vector<double> cdf;
+		template <typename Archive>
+		void serialize(Archive& ar) { ar(IDs, cdf); }
+	};
+
 	// Probabilities of each household viting 
 	// a given public leisure location
 	// Outer vector: households, inner: public leisure location
-	std::vector<std::vector<double>> public_probabilities;
+	std::vector<LeisureTable> public_probabilities;
+	int n_public_locations = 0;
 
 	// Parameters for the probability model
 	double dr0 = 0.0, beta = 0.0, kappa = 0.0;
 
+	// Dropped probability mass
+	double truncation_tail = 0.0;
+	double max_truncation_error = 0.0, total_truncation_error = 0.0;
+
+	// Threads for constructing the tables
+	int n_construction_threads = 1;
+
+	// Sines and cosines of half of the latitudes 
+	// and longitudes, one entry per location
+	struct HalfAngles {
+		std::vector<double> sin_lat, cos_lat, sin_lon, cos_lon, cos_full_lat;
+		void add(const Place& place, const double to_rad);
+	};
+
+	// Build the table of a household from location probabilities,
+	// stores the dropped fraction of probability mass in error
+	LeisureTable make_table(const std::vector<double>& probs, double& error) const; 
+
+	// Probabilities of visiting all locations in leisure for household house
+	void compute_probabilities(const HalfAngles& houses, const size_t house, 
+					const HalfAngles& leisure, std::vector<double>& probs) const;
+
 	// Computes and returns probabilities based on distance
-	double compute_probability(double dist);
+	double compute_probability(double dist) const;
 
 	// Just Pi
 	double pi = 3.14159265358979323846;
@@ -101,9 +101,12 @@ public:
 	/// \brief Increase number of tested at that time step
 	void increase_total_tested() { n_tested++; }
 
+	/// \brief Replace the number tested at this step, e.g. with a sum over processes
+	void set_n_tested(const int n) { n_tested = n; }
+
   	/// \brief Reset select variables of a place after transmission step
     void reset_contributions() override 
-		{ lambda_tot = 0.0; lambda_sum = 0.0; num_infected = 0; n_tested = 0; }
+		{ lambda_tot = 0.0; lambda_sum = 0.0; num_infected = 0; n_remote = 0; n_tested = 0; }
 
 	/// \brief Contribution takes into account agents tested at current step
 	void compute_infected_contribution() override;
@@ -111,8 +114,6 @@ public:
 	/// \brief Returns number of Flu agents being tested in a hospital at that step
 	int get_n_tested() const { return n_tested; }
 
-	/// \brief Returns number of Flu agents being tested in a hospital at that step
-	double get_lambda_sum() const { return lambda_sum; }
 
 	//
  	// I/O
@@ -128,6 +129,11 @@ public:
 	 */
 	void print_basic(std::ostream& where) const override;
 
+	/// Read or write all attributes, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+		{ Place::serialize(ar); ar(beta_employee, beta_non_covid_patient, beta_testee, beta_hospitalized, beta_hospitalized_ICU, n_tested); }
+
 private:
 	// Transmission rates that depend on the role in 
 	// the hospital, all units are 1/time 
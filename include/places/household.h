@@ -56,6 +56,11 @@ public:
 	 */
 	void print_basic(std::ostream& where) const override;
 
+	/// Read or write all attributes, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+		{ Place::serialize(ar); ar(alpha, beta_ih); }
+
 	//
 	// Infection related computations
 	//
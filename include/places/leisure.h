@@ -83,6 +83,11 @@ public:
 	 */
 	void print_basic(std::ostream& where) const override;
 
+	/// Read or write all attributes, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+		{ Place::serialize(ar); ar(type, lam_tot_out); }
+
 private:
 	// Leisure location type 
 	std::string type = "none";
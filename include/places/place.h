@@ -2,6 +2,7 @@
 #define PLACE_H
 
 #include "../common.h"
+#include "place_members.h"
 
 /***************************************************** 
  * class: Place
@@ -58,11 +59,38 @@ public:
 	 */
 	virtual void compute_infected_contribution();
 
+	/**
+	 * \brief Scale the total contribution computed at this step
+	 * @param mult - multiplier, e.g. due to a closure of this type of places
+	 */
+	void scale_infected_contribution(const double mult) { lambda_tot *= mult; }
+
+	/**
+	 * \brief Add sums of this step from a copy of this place in another process
+	 * \details Used in the process that owns a place when agents are 
+	 *		split between processes, each copy has only agents of its process
+	 * @param sum - sum of contributions of the infected in the copy
+	 * @param n_infected - number of infected that contributed in the copy
+	 * @param n_agents - number of agents registered in the copy
+	 */
+	void add_remote_sums(const double sum, const int n_infected, const int n_agents)
+		{ lambda_sum += sum; num_infected += n_infected; n_remote += n_agents; }
+
+	/**
+	 * \brief Replace the sums of this step with totals over all copies
+	 * \details Used in copies of a place owned by another process
+	 * @param sum - sum of contributions of the infected
+	 * @param n_infected - number of infected that contributed
+	 * @param n_agents - number of agents registered in all copies
+	 */
+	void set_sums(const double sum, const int n_infected, const int n_agents)
+		{ lambda_sum = sum; num_infected = n_infected; n_remote = n_agents - agent_IDs.size(); }
+
 	/**
 	 *	\brief Reset the lambda sum of a place after transmission step
 	 */
 	virtual void reset_contributions() 
-		{ lambda_sum = 0.0; lambda_tot = 0.0; num_infected = 0; }
+		{ lambda_sum = 0.0; lambda_tot = 0.0; num_infected = 0; n_remote = 0; }
 
 	//
 	// Setters
@@ -78,7 +106,7 @@ public:
 	int get_ID() const { return ID; }
 
 	/// Return IDs of agents registered in this place	
-	std::vector<int> get_agent_IDs() const { return agent_IDs; }
+	std::vector<int> get_agent_IDs() const { return agent_IDs.get_IDs(); }
 
 	/// Return total number of infected agents
 	int get_total_infected() const { return num_infected; }
@@ -86,8 +114,13 @@ public:
 	/// Return total number of agents
 	int get_number_of_agents() const { return agent_IDs.size(); }
 
+	/// Agents registered in copies of this place in other processes at this step
+	int get_number_of_remote_agents() const { return n_remote; }
+
 	/// Return probability contribution of infected agents
 	double get_infected_contribution() const { return lambda_tot; }
+	/// Sum of contributions of the infected at this step
+	double get_lambda_sum() const { return lambda_sum; }
 
 	/// Transmission rate
 	double get_transmission_rate() const { return beta_j; }
@@ -133,13 +166,30 @@ public:
 	 * \brief Add a new agent to this place
 	 * @param index - agent ID (starts with 1)
 	 */
-	void add_agent(const int index) { agent_IDs.push_back(index); }
+	void add_agent(const int index) { agent_IDs.add(index); }
 
 	/**
 	 * \brief Remove an agent from this place
+	 * \details Constant time, nothing happens if agent is not present
 	 * @param index - agent ID (starts with 1)
 	 */
-	void remove_agent(const int index);
+	void remove_agent(const int index) { agent_IDs.remove(index); }
+
+	/**
+	 * \brief Keep slots of agents of this place in the agent store
+	 * \details Constant time removal of agents that are linked
+	 *		to this place by their IDs in the store, others are searched for
+	 * @param store - store of the agents
+	 * @param roles - mask of AgentStore::IDColumn that can link agents to this place
+	 */
+	void link_to_store(AgentStore& store, const unsigned roles) 
+		{ agent_IDs.bind(store.place_links(), roles, ID); }
+
+	/// Read or write all attributes, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+		{ ar(ID, x, y, agent_IDs, num_tot, num_infected, lambda_sum, 
+				lambda_tot, ck, beta_j, inf_ratio); }
 
 	// Virtual dtor - avoid UDB and memory leaks
 	virtual ~Place() = default;
@@ -150,9 +200,12 @@ protected:
 	// Location
 	double x = 0.0, y = 0.0;
 	// IDs of agents in this place
-	std::vector<int> agent_IDs;
+	PlaceMembers agent_IDs;
 	// Total number of agents
 	int num_tot = 0;
+	// Agents in copies of this place in other 
+	// processes, when agents are split between them
+	int n_remote = 0;
 	// Total number of infected
 	int num_infected = 0;
 
@@ -0,0 +1,245 @@
+#ifndef PLACE_MEMBERS_H
+#define PLACE_MEMBERS_H
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <atomic>
+#include "../agent_store.h"
+
+/*****************************************************
+ * class: PlaceMembers
+ *
+ * IDs of agents registered in a place with constant
+ * time insertion and removal
+ *
+ * Removed agents leave an empty slot that is reused
+ * by compacting once half of the slots are empty, so
+ * the order of remaining agents does not change
+ *
+ * Slot of each agent is kept in the agent store, in
+ * the slot column of the role that links the agent to
+ * the place, e.g. work for employees of a school; a
+ * slot is used only if the entry it points to is the
+ * agent, otherwise the agent is searched for, so
+ * members that are not bound to a store, or agents
+ * registered in two places of one role, are still
+ * removed correctly
+ *
+ * Insertions and removals are counted per thread
+ * only while a StepProfiler records a phase
+ *
+ *****************************************************/
+
+class PlaceMembers{
+public:
+
+	//
+	// Constructors
+	//
+
+	PlaceMembers() = default;
+
+	/// Copies only the IDs, copy is not bound to the store
+	PlaceMembers(const PlaceMembers& other) :
+		IDs(other.IDs), n_empty(other.n_empty) { }
+
+	PlaceMembers(PlaceMembers&&) = default;
+
+	/// Copies only the IDs, copy is not bound to the store
+	PlaceMembers& operator=(const PlaceMembers& other)
+	{
+		IDs = other.IDs;
+		n_empty = other.n_empty;
+		columns = nullptr;
+		roles = 0;
+		place_ID = 0;
+		return *this;
+	}
+
+	PlaceMembers& operator=(PlaceMembers&&) = default;
+
+	/**
+	 * \brief Keep slots of the agents in a store
+	 * \details Slots of current members are written to the store
+	 * @param cols - columns of the store, nullptr to stop
+	 * @param link_roles - mask of AgentStore::IDColumn, bit r set if
+	 *		agents can be linked to this place by ID column r; the
+	 *		lowest is used for agents not linked by any
+	 * @param ID - ID of the place
+	 */
+	void bind(AgentStore::Columns* cols, const unsigned link_roles, const int ID)
+	{
+		columns = cols;
+		roles = link_roles;
+		place_ID = ID;
+		write_slots();
+	}
+
+	//
+	// Membership
+	//
+
+	/// Add an agent, agent IDs start with 1
+	void add(const int ID)
+	{
+		if (counting()){
+			++thread_changes().inserts;
+		}
+		IDs.push_back(ID);
+		write_slot(ID, IDs.size() - 1);
+	}
+
+	/// Remove an agent, nothing if not present; all its entries if its slot is not known
+	void remove(const int ID)
+	{
+		if (counting()){
+			++thread_changes().removes;
+		}
+		const unsigned role = find(ID);
+		if (role == no_role){
+			for (auto& id : IDs){
+				if (id == ID){
+					id = empty_slot;
+					++n_empty;
+				}
+			}
+		} else {
+			std::vector<int>& slots = columns->slots[role];
+			IDs[slots[ID-1]] = empty_slot;
+			slots[ID-1] = -1;
+			++n_empty;
+		}
+		if (2*n_empty > IDs.size()){
+			compact();
+		}
+	}
+
+	/// Insertions and removals of all places in one thread
+	struct Changes{
+		uint64_t inserts = 0;
+		uint64_t removes = 0;
+	};
+
+	/// Changes made so far by the calling thread, for profiling
+	static Changes& thread_changes()
+	{
+		static thread_local Changes changes;
+		return changes;
+	}
+
+	/// Number of phases being recorded, changes are counted only if any
+	static std::atomic<int>& recording()
+	{
+		static std::atomic<int> n_phases(0);
+		return n_phases;
+	}
+
+	/// True if changes are counted
+	static bool counting() { return recording().load(std::memory_order_relaxed) > 0; }
+
+	/// Number of agents
+	size_t size() const { return IDs.size() - n_empty; }
+
+	/// Read or write the members, for checkpoints; slots are written when bound again
+	template <typename Archive>
+	void serialize(Archive& ar)
+	{
+		ar(IDs, n_empty);
+		if (ar.is_loading()){
+			columns = nullptr;
+			roles = 0;
+		}
+	}
+
+	/// IDs of agents in order of registration
+	std::vector<int> get_IDs() const
+	{
+		if (n_empty == 0){
+			return IDs;
+		}
+		std::vector<int> current;
+		current.reserve(size());
+		std::copy_if(IDs.begin(), IDs.end(), std::back_inserter(current),
+			[](const int id){ return id != empty_slot; });
+		return current;
+	}
+
+private:
+	// Marks a slot of a removed agent
+	static constexpr int empty_slot = -1;
+	// Agent without a known slot
+	static constexpr unsigned no_role = AgentStore::n_ID_columns;
+
+	// Agent IDs and slots of removed agents
+	std::vector<int> IDs;
+	size_t n_empty = 0;
+	// Store with the slots, roles that link agents
+	// to this place, and ID of the place
+	AgentStore::Columns* columns = nullptr;
+	unsigned roles = 0;
+	int place_ID = 0;
+
+	// Role with the slot of an agent in this place, no_role if none
+	unsigned find(const int ID) const
+	{
+		if (columns == nullptr || ID < 1 || static_cast<size_t>(ID) > columns->flags.size()){
+			return no_role;
+		}
+		for (unsigned r = 0; r < AgentStore::n_ID_columns; ++r){
+			if ((roles >> r) & 1){
+				const int slot = columns->slots[r][ID-1];
+				if (slot >= 0 && static_cast<size_t>(slot) < IDs.size() && IDs[slot] == ID){
+					return r;
+				}
+			}
+		}
+		return no_role;
+	}
+
+	// Store the slot of an agent, in the first role
+	// whose place ID is this place or the lowest role
+	void write_slot(const int ID, const size_t slot)
+	{
+		if (columns == nullptr || ID < 1 || static_cast<size_t>(ID) > columns->flags.size()){
+			return;
+		}
+		unsigned role = no_role;
+		for (unsigned r = 0; r < AgentStore::n_ID_columns; ++r){
+			if ((roles >> r) & 1){
+				if (role == no_role){
+					role = r;
+				}
+				if (columns->IDs[r][ID-1] == place_ID){
+					role = r;
+					break;
+				}
+			}
+		}
+		if (role != no_role){
+			columns->slots[role][ID-1] = static_cast<int>(slot);
+		}
+	}
+
+	// Store slots of all agents
+	void write_slots()
+	{
+		for (size_t i = 0; i < IDs.size(); ++i){
+			if (IDs[i] != empty_slot){
+				write_slot(IDs[i], i);
+			}
+		}
+	}
+
+	// Remove empty slots keeping the order
+	void compact()
+	{
+		IDs.erase(std::remove_if(IDs.begin(), IDs.end(),
+			[](const int id){ return id == empty_slot; }), IDs.end());
+		n_empty = 0;
+		write_slots();
+	}
+};
+
+#endif
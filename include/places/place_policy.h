@@ -0,0 +1,36 @@
+#ifndef PLACE_POLICY_H
+#define PLACE_POLICY_H
+
+/*****************************************************
+ * struct: PlacePolicy
+ *
+ * Multipliers of infection contributions of each
+ * place type due to closures and reopenings
+ *
+ * Places keep their own transmission rates; the
+ * multiplier of a type is applied to the total
+ * contribution of every place of that type when
+ * contributions are computed, so a policy change
+ * is a change of a single value. Places outside
+ * the modeled town have separate multipliers for
+ * their assigned contributions.
+ *
+ *****************************************************/
+
+struct PlacePolicy{
+	double schools = 1.0;
+	double workplaces = 1.0;
+	double outside_workplaces = 1.0;
+	double leisure_locations = 1.0;
+	double outside_leisure_locations = 1.0;
+	double carpools = 1.0;
+	double public_transit = 1.0;
+
+	/// Read or write all multipliers, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+		{ ar(schools, workplaces, outside_workplaces, leisure_locations,
+				outside_leisure_locations, carpools, public_transit); }
+};
+
+#endif
@@ -89,6 +89,11 @@ public:
 	 */
 	void print_basic(std::ostream& where) const override;
 
+	/// Read or write all attributes, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+		{ Place::serialize(ar); ar(psi_emp, beta_emp, beta_ih); }
+
 private:
 	// Absenteeism correction - employee
 	double psi_emp = 0.0;
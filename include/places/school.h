@@ -91,6 +91,11 @@ public:
 	 */
 	void print_basic(std::ostream& where) const override;
 
+	/// Read or write all attributes, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+		{ Place::serialize(ar); ar(psi_j, psi_emp, beta_emp); }
+
 private:
 	// Absenteeism correction - student and employee
 	double psi_j = 0.0;
@@ -97,6 +97,11 @@ public:
 	 */
 	void print_basic(std::ostream& where) const override;
 
+	/// Read or write all attributes, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+		{ Place::serialize(ar); ar(psi_j, type, lam_tot_out); }
+
 private:
 	// Absenteeism correction
 	double psi_j = 0.0;
@@ -0,0 +1,117 @@
+#ifndef POLICY_SCHEDULE_H
+#define POLICY_SCHEDULE_H
+
+#include "common.h"
+
+/*****************************************************
+ * class: PolicySchedule
+ *
+ * Time-ordered closures and reopenings
+ *
+ * Each event sets one target, e.g. the multiplier
+ * of a place type, to a value at a given time;
+ * events are applied once, in order of time, and
+ * events with equal times in the order they were
+ * added. Supported targets are in the targets() list.
+ *
+ *****************************************************/
+
+class PolicySchedule{
+public:
+
+	/// Single change of a target
+	struct Event{
+		double time;
+		std::string target;
+		double value;
+
+		/// Read or write the event, for checkpoints
+		template <typename Archive>
+		void serialize(Archive& ar) { ar(time, target, value); }
+	};
+
+	//
+	// Constructors
+	//
+
+	/// Empty schedule
+	PolicySchedule() = default;
+
+	//
+	// Events
+	//
+
+	/**
+	 * \brief Add an event to the schedule
+	 * \details Throws std::invalid_argument if the target is not supported
+	 * @param time - time of the change
+	 * @param target - what changes, one of targets()
+	 * @param value - new value
+	 */
+	void add(const double time, const std::string& target, const double value)
+	{
+		if (std::find(targets().begin(), targets().end(), target) == targets().end()) {
+			throw std::invalid_argument("Unsupported policy target: " + target);
+		}
+		// After events with equal times
+		auto pos = std::upper_bound(events.begin(), events.end(), time,
+						[](const double t, const Event& ev){ return t < ev.time; });
+		events.insert(pos, Event{time, target, value});
+	}
+
+	/**
+	 * \brief Call func for each event due by this time that was not applied yet
+	 * @param time - current time
+	 * @param tol - tolerance, events up to time + tol are due
+	 * @param func - callable taking a const Event&
+	 */
+	template <typename F>
+	void apply_due(const double time, const double tol, F func)
+	{
+		while (next < events.size() && events.at(next).time <= time + tol) {
+			func(static_cast<const Event&>(events.at(next)));
+			++next;
+		}
+	}
+
+	/// Remove all events
+	void clear() { events.clear(); next = 0; }
+
+	//
+	// Getters
+	//
+
+	/// All events in order of application
+	const std::vector<Event>& get_events() const { return events; }
+
+	/// Number of events applied so far
+	size_t number_applied() const { return next; }
+
+	/**
+	 * \brief Supported targets
+	 * \details Place types set the policy multiplier of that type,
+	 * 		"businesses" sets the fraction of open businesses, with 
+	 * 		workplaces in town at the generic workplace transmission rate,
+	 * 		"workplace absenteeism" the absenteeism correction in workplaces
+	 */
+	static const std::vector<std::string>& targets()
+	{
+		static const std::vector<std::string> names =
+			{"schools", "workplaces", "outside workplaces", "leisure locations",
+			 "outside leisure locations", "carpools", "public transit",
+			 "businesses", "workplace absenteeism"};
+		return names;
+	}
+
+	/// Read or write the schedule and its progress, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar) { ar(events, next); }
+
+private:
+	// Events sorted by time
+	std::vector<Event> events;
+	// Index of the first event not applied yet
+	size_t next = 0;
+};
+
+#endif
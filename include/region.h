@@ -0,0 +1,148 @@
+#ifndef REGION_H
+#define REGION_H
+
+#include "abm.h"
+#include <memory>
+
+/*****************************************************
+ * class: Region
+ *
+ * Several towns simulated together in one process
+ * and coupled through commuter flows
+ *
+ * Each town is a complete, initialized model. Towns
+ * are propagated concurrently, one step at a time;
+ * between steps, places outside of each town take
+ * their infection contribution from the prevalence
+ * in the towns its commuters travel to. Flows
+ * that do not reach any of the modeled towns see the
+ * estimated fraction of infected from the infection
+ * parameters of the town, as in single town runs.
+ *
+ * Coupling happens only between steps so results
+ * do not depend on the number of threads
+ *
+ ******************************************************/
+
+class Region{
+public:
+
+	/// Function that propagates a town by one step
+	using step_function = void (ABM::*)();
+
+	//
+	// Constructors
+	//
+
+	/// Region without towns
+	Region() = default;
+
+	//
+	// Settings
+	//
+
+	/**
+	 * \brief Add an initialized town
+	 * \details The model should be ready to run; towns are
+	 *		numbered in the order of adding, starting with 0
+	 * @param abm - model of the town, moved into the region
+	 * @param name - name of the town, used in output
+	 * @return index of the town
+	 */
+	size_t add_town(ABM&& abm, const std::string& name);
+
+	/**
+	 * \brief Set fractions of commuters between towns
+	 * \details flows[i][j] is the fraction of contacts outside
+	 *		of town i that are in town j; throws std::invalid_argument
+	 *		if the matrix does not match the towns, has negative
+	 *		entries, a nonzero diagonal, or rows summing to more than 1
+	 * @param flows - square matrix, one row and column per town
+	 */
+	void set_commuter_flows(const std::vector<std::vector<double>>& flows);
+
+	/**
+	 * \brief Load commuter flows from a file
+	 * \details One row of the matrix per line, whitespace separated
+	 * @param fname - path of the file
+	 */
+	void load_commuter_flows(const std::string& fname);
+
+	/**
+	 * \brief Number of towns propagated at the same time
+	 * @param n_threads - number of threads, 1 is serial (default)
+	 */
+	void set_number_of_threads(const int n_threads)
+		{ n_region_threads = std::max(1, n_threads); }
+
+	/// Set the function called at each step, default ABM::transmit_ideal_testing_vac_reopening
+	void set_step_function(step_function step) { propagate = step; }
+
+	//
+	// Simulation
+	//
+
+	/**
+	 * \brief Set the outside prevalence of each town from the current prevalences
+	 * \details Called before each step, can be called to couple
+	 *		the towns before the first one
+	 */
+	void couple();
+
+	/// Couple the towns and propagate all of them by one step
+	void step();
+
+	/**
+	 * \brief Propagate all towns by a number of steps
+	 * @param n_steps - number of steps
+	 */
+	void run(const int n_steps);
+
+	//
+	// Getters
+	//
+
+	/// Number of towns
+	size_t number_of_towns() const { return towns.size(); }
+
+	/// Model of a town
+	ABM& get_town(const size_t i) { return *towns.at(i); }
+	const ABM& get_town(const size_t i) const { return *towns.at(i); }
+
+	/// Name of a town
+	const std::string& get_town_name(const size_t i) const { return names.at(i); }
+
+	/// Prevalence outside of each town, set at the last coupling
+	const std::vector<double>& get_outside_prevalence() const
+		{ return outside_prevalence; }
+
+	/// Commuter flows between towns
+	const std::vector<std::vector<double>>& get_commuter_flows() const
+		{ return commuter_flows; }
+
+	//
+	// Output
+	//
+
+	/**
+	 * \brief Save prevalence of each town and outside of it
+	 * \details One line per town: name | prevalence | outside prevalence
+	 * @param fname - path of the file to print to
+	 */
+	void print_prevalence(const std::string& fname) const;
+
+private:
+	// Towns, heap allocated so references stay valid
+	std::vector<std::unique_ptr<ABM>> towns;
+	std::vector<std::string> names;
+	// Fraction of outside contacts of each town in other towns
+	std::vector<std::vector<double>> commuter_flows;
+	// Outside prevalence of each town at the last coupling
+	std::vector<double> outside_prevalence;
+	// Number of threads for towns
+	int n_region_threads = 1;
+	// Step of each town
+	step_function propagate = &ABM::transmit_ideal_testing_vac_reopening;
+};
+
+#endif
@@ -2,18 +2,131 @@
 #define RNG_H
 
 #include <random>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
 
-/***************************************************** 
+/*****************************************************
+ * class: Philox4x32
+ *
+ * Counter-based random bit generator, Philox4x32-10
+ * from Salmon et al., "Parallel random numbers: as
+ * easy as 1, 2, 3" (SC11)
+ *
+ * Each 128-bit counter is mapped to four 32-bit
+ * numbers using a 64-bit key, so any position in any
+ * stream can be reached without generating what
+ * precedes it; satisfies the requirements of a
+ * uniform random bit generator
+ *
+ *****************************************************/
+
+class Philox4x32
+{
+public:
+	using result_type = uint32_t;
+	using counter_type = std::array<uint32_t, 4>;
+	using key_type = std::array<uint32_t, 2>;
+
+	Philox4x32() = default;
+	explicit Philox4x32(const uint64_t seed) { set_key(seed); }
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return 0xFFFFFFFF; }
+
+	/// Next number in the stream
+	result_type operator()()
+	{
+		if (index == 4) {
+			output = block(counter, key);
+			increment();
+			index = 0;
+		}
+		return output[index++];
+	}
+
+	/// Sets the key and restarts from counter 0
+	void set_key(const uint64_t seed)
+	{
+		key = {{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}};
+		set_counter({{0, 0, 0, 0}});
+	}
+
+	/// Restarts the stream from a given counter
+	void set_counter(const counter_type& ctr)
+		{ counter = ctr; index = 4; }
+
+	/// Read or write the full state, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar) { ar(key, counter, output, index); }
+
+	/// Ten Philox rounds of a single counter block under key k
+	static counter_type block(counter_type ctr, key_type k)
+	{
+		for (int r = 0; r < 10; ++r) {
+			if (r > 0) {
+				k[0] += W0;
+				k[1] += W1;
+			}
+			const uint64_t p0 = static_cast<uint64_t>(M0)*ctr[0];
+			const uint64_t p1 = static_cast<uint64_t>(M1)*ctr[2];
+			ctr = {{static_cast<uint32_t>(p1 >> 32)^ctr[1]^k[0], static_cast<uint32_t>(p1),
+					static_cast<uint32_t>(p0 >> 32)^ctr[3]^k[1], static_cast<uint32_t>(p0)}};
+		}
+		return ctr;
+	}
+
+private:
+	// Round multipliers and key increments
+	static constexpr uint32_t M0 = 0xD2511F53;
+	static constexpr uint32_t M1 = 0xCD9E8D57;
+	static constexpr uint32_t W0 = 0x9E3779B9;
+	static constexpr uint32_t W1 = 0xBB67AE85;
+
+	key_type key = {{0, 0}};
+	counter_type counter = {{0, 0, 0, 0}};
+	// Numbers from the last block and the next one to use
+	counter_type output = {{0, 0, 0, 0}};
+	int index = 4;
+
+	// Advance to the next block, with a carry
+	// of the first counter word to the second
+	void increment()
+	{
+		if (++counter[0] == 0) {
+			++counter[1];
+		}
+	}
+};
+
+/*****************************************************
  * class: RNG
- * 
- * Random number generator 
- * 
+ *
+ * Random number generator
+ *
+ * Numbers come from a counter-based generator keyed
+ * by a run seed; the stream within a run is selected
+ * by agent ID, time step, and purpose so independent
+ * loops can draw without sharing a generator and
+ * results do not depend on how work is split
+ *
  *****************************************************/
 
 class RNG
 {
 public:
-    RNG() : gen(std::random_device()()) { } 
+	/// Purposes of streams, separate for the same agent and step; 
+	/// rank streams replace general and flu in each process of a split model
+	enum Purpose : uint32_t { general = 0, transitions = 1, flu = 2, 
+								rank_general = 3, rank_flu = 4 };
+
+	/// Seed from a random device, different for each run
+    RNG() : gen((static_cast<uint64_t>(std::random_device()()) << 32)
+					| std::random_device()()) { }
+
+	/// Reproducible generator from a given seed
+	explicit RNG(const uint64_t seed) : gen(seed) { }
 
 	/**
 	 *	\brief Random number sampled from uniform distribution
@@ -21,8 +134,9 @@ public:
 	 *	@param dmax - maximum, exclusive
 	 */
     double get_random(const double dmin, const double dmax)
-	{  
+	{
         std::uniform_real_distribution<double> dist(dmin, dmax);
+        ++n_draws;
         return dist(gen);
     }
 
@@ -32,52 +146,84 @@ public:
 	 *	@param dmax - maximum, inclusive
 	 */
     int get_random_int(const int dmin, const int dmax)
-	{  
+	{
         std::uniform_int_distribution<int> dist(dmin, dmax);
+        ++n_draws;
         return dist(gen);
     }
 
 	/**
 	 *	\brief Random number sampled from a gamma distribution
-	 *	@param k - shape parameter 
-	 *	@param theta - scale parameter 
+	 *	@param k - shape parameter
+	 *	@param theta - scale parameter
 	 */
     double get_random_gamma(const double k, const double theta)
-	{  
+	{
         std::gamma_distribution<double> dist(k, theta);
+        ++n_draws;
         return dist(gen);
     }
 
 	/**
 	 *	\brief Random number sampled from a lognormal distribution
-	 *	@param m - mean 
-	 *	@param s - standard deviation 
+	 *	@param m - mean
+	 *	@param s - standard deviation
 	 */
     double get_random_lognormal(const double m, const double s)
-	{  
+	{
         std::lognormal_distribution<double> dist(m, s);
+        ++n_draws;
         return dist(gen);
     }
 
 	/**
 	 *	\brief Random number sampled from a Weibull distribution
 	 *	@param a - shape parameter
-	 *	@param b - scale parameter 
+	 *	@param b - scale parameter
 	 */
     double get_random_weibull(const double a, const double b)
-	{  
+	{
         std::weibull_distribution<double> dist(a, b);
+        ++n_draws;
         return dist(gen);
     }
 
+	/// Restarts the generator from a given seed, general stream
+	void set_seed(const uint64_t seed)
+	{
+		gen.set_key(seed);
+	}
+
+	/**
+	 *	\brief Switch to the stream of an agent at a time step
+	 *	\details Keeps the seed, the stream is the same
+	 *		regardless of numbers drawn before
+	 *	@param agent_ID - agent ID, or any other index
+	 *	@param step - time step
+	 *	@param purpose - what the numbers are used for
+	 */
+	void set_stream(const uint32_t agent_ID, const uint32_t step, const Purpose purpose)
+	{
+		gen.set_counter({{0, agent_ID, step, static_cast<uint32_t>(purpose)}});
+	}
+
 	/// Performs in-place random shuffling of a vector
 	void vector_shuffle(std::vector<int>& v)
-	{ 
+	{
+		n_draws += v.size();
 		std::shuffle(v.begin(), v.end(), gen);
 	}
 
+	/// Read or write the generator state, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar) { ar(gen); }
+
+	/// Numbers sampled so far, for profiling; not part of checkpoints
+	uint64_t get_draws() const { return n_draws; }
+
 private:
-    std::mt19937 gen;
+    Philox4x32 gen;
+	uint64_t n_draws = 0;
 };
 
 #endif
@@ -68,12 +68,26 @@ public:
 
 private:
 
-	/// Set all testing states to a single value 
-	void set_all_testing_states(Agent& agent, const bool val);
-
-	/// Set all treatment states to a single value 
-	void set_all_treatment_states(Agent& agent, const bool val);
+	//
+	// Transition table, one entry per state change
+	//
 
+	static const AgentState::Transition to_exposed;
+	static const AgentState::Transition to_exposed_never_sy;
+	static const AgentState::Transition exposed_to_removed;
+	static const AgentState::Transition exposed_to_symptomatic;
+	static const AgentState::Transition dying_symptomatic;
+	static const AgentState::Transition recovering_symptomatic;
+	static const AgentState::Transition waiting_in_hospital;
+	static const AgentState::Transition exposed_waiting_in_hospital;
+	static const AgentState::Transition awaiting_results;
+	static const AgentState::Transition false_negative;
+	static const AgentState::Transition icu_dying;
+	static const AgentState::Transition icu_recovering;
+	static const AgentState::Transition hospitalized;
+	static const AgentState::Transition home_isolation;
+	static const AgentState::Transition any_to_removed;
+	static const AgentState::Transition negative;
 };
 
 #endif
@@ -0,0 +1,362 @@
+#ifndef STEP_PROFILER_H
+#define STEP_PROFILER_H
+
+#include <vector>
+#include <array>
+#include <string>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include "places/place_members.h"
+
+/***************************************************************
+ * class: StepProfiler
+ *
+ * Wall time and work counters of each phase of
+ * each time step
+ *
+ * Phases are started and stopped by the model; counts
+ * made while a phase runs are added to that phase.
+ * Membership changes are taken from the counters of
+ * PlaceMembers of the calling thread, which count only
+ * while a phase is recorded, random number draws from
+ * the totals passed when a phase starts and stops. When 
+ * disabled (default), nothing is recorded or counted.
+ *
+ * Records can be saved as JSON, with totals of each
+ * phase and all steps, or as a Chrome trace file
+ * (chrome://tracing, Perfetto) with one event per phase
+ *
+ **************************************************************/
+
+class StepProfiler{
+public:
+
+	/// Phases of a time step
+	enum Phase { testing_and_events, reopening, vaccination, leisure,
+					contributions, transitions, reset, n_phases };
+
+	/// Work counters of each phase
+	enum Counter { agents_visited, places_touched, rng_draws,
+					membership_inserts, membership_removes,
+					transitions_fired, n_counters };
+
+	//
+	// Constructors
+	//
+
+	StepProfiler() = default;
+
+	/// Copies the records, not a running phase
+	StepProfiler(const StepProfiler& other) : on(other.on), steps(other.steps) { }
+
+	/// Copies the records, not a running phase
+	StepProfiler& operator=(const StepProfiler& other)
+	{
+		if (this != &other){
+			end_phase();
+			on = other.on;
+			steps = other.steps;
+		}
+		return *this;
+	}
+
+	~StepProfiler() { end_phase(); }
+
+	//
+	// Settings
+	//
+
+	/// Start (true) or stop recording, records so far are kept
+	void set_enabled(const bool val) 
+	{ 
+		if (!val){
+			end_phase();
+		}
+		on = val; 
+	}
+
+	/// True if recording
+	bool enabled() const { return on; }
+
+	/// Remove all records
+	void clear() { end_phase(); steps.clear(); }
+
+	//
+	// Recording
+	//
+
+	/**
+	 * \brief Start a new step
+	 * @param time - simulation time at the beginning of the step
+	 */
+	void begin_step(const double time)
+	{
+		if (!on){
+			return;
+		}
+		Step step;
+		step.time = time;
+		step.start = now();
+		steps.push_back(step);
+		current = n_phases;
+	}
+
+	/**
+	 * \brief Start a phase of the current step
+	 * @param phase - phase to start
+	 * @param draws - random numbers drawn by the model so far
+	 */
+	void start(const Phase phase, const uint64_t draws)
+	{
+		if (!on || steps.empty()){
+			return;
+		}
+		// Membership changes are counted while any phase runs
+		if (current == n_phases){
+			++PlaceMembers::recording();
+		}
+		current = phase;
+		const PlaceMembers::Changes& changes = PlaceMembers::thread_changes();
+		start_draws = draws;
+		start_inserts = changes.inserts;
+		start_removes = changes.removes;
+		steps.back().phases.at(phase).start = now();
+	}
+
+	/**
+	 * \brief Stop the current phase
+	 * @param draws - random numbers drawn by the model so far
+	 */
+	void stop(const uint64_t draws)
+	{
+		if (!on || steps.empty() || current == n_phases){
+			return;
+		}
+		PhaseRecord& rec = steps.back().phases.at(current);
+		rec.duration += now() - rec.start;
+		const PlaceMembers::Changes& changes = PlaceMembers::thread_changes();
+		rec.counts.at(rng_draws) += draws - start_draws;
+		rec.counts.at(membership_inserts) += changes.inserts - start_inserts;
+		rec.counts.at(membership_removes) += changes.removes - start_removes;
+		rec.ran = true;
+		end_phase();
+	}
+
+	/// Add to a counter of the current phase, nothing outside of phases
+	void count(const Counter counter, const uint64_t n)
+	{
+		if (on && !steps.empty() && current != n_phases){
+			steps.back().phases.at(current).counts.at(counter) += n;
+		}
+	}
+
+	//
+	// Getters
+	//
+
+	/// Number of recorded steps
+	size_t number_of_steps() const { return steps.size(); }
+
+	/// Total time of a phase in all steps, in seconds
+	double total_time(const Phase phase) const
+	{
+		double total = 0.0;
+		for (const auto& step : steps){
+			total += step.phases.at(phase).duration;
+		}
+		return total;
+	}
+
+	/// Total of a counter of a phase in all steps
+	uint64_t total_count(const Phase phase, const Counter counter) const
+	{
+		uint64_t total = 0;
+		for (const auto& step : steps){
+			total += step.phases.at(phase).counts.at(counter);
+		}
+		return total;
+	}
+
+	/// Name of a phase
+	static std::string phase_name(const Phase phase)
+	{
+		static const std::array<std::string, n_phases> names =
+			{{"testing_and_events", "reopening", "vaccination", "leisure",
+			  "contributions", "transitions", "reset"}};
+		return names.at(phase);
+	}
+
+	/// Name of a counter
+	static std::string counter_name(const Counter counter)
+	{
+		static const std::array<std::string, n_counters> names =
+			{{"agents_visited", "places_touched", "rng_draws",
+			  "membership_inserts", "membership_removes", "transitions_fired"}};
+		return names.at(counter);
+	}
+
+	//
+	// Output
+	//
+
+	/**
+	 * \brief Save totals of each phase and records of each step as JSON
+	 * \details Times in milliseconds; phases that did not run are omitted
+	 * @param fname - path of the file to write to
+	 */
+	void write_json(const std::string& fname) const
+	{
+		std::ofstream out(fname);
+		check_open(out, fname);
+		out << std::fixed << std::setprecision(3);
+		out << "{\n  \"n_steps\": " << steps.size() << ",\n  \"phases\": {";
+		bool first = true;
+		for (int p = 0; p < n_phases; ++p){
+			const Phase phase = static_cast<Phase>(p);
+			int calls = 0;
+			double t_min = 0.0, t_max = 0.0;
+			for (const auto& step : steps){
+				const PhaseRecord& rec = step.phases.at(phase);
+				if (!rec.ran){
+					continue;
+				}
+				t_min = (calls == 0) ? rec.duration : std::min(t_min, rec.duration);
+				t_max = std::max(t_max, rec.duration);
+				++calls;
+			}
+			if (calls == 0){
+				continue;
+			}
+			out << (first ? "\n" : ",\n") << "    \"" << phase_name(phase) << "\": {"
+				<< "\"calls\": " << calls << ", \"total_ms\": " << 1000.0*total_time(phase)
+				<< ", \"min_ms\": " << 1000.0*t_min << ", \"max_ms\": " << 1000.0*t_max;
+			for (int c = 0; c < n_counters; ++c){
+				out << ", \"" << counter_name(static_cast<Counter>(c)) << "\": "
+					<< total_count(phase, static_cast<Counter>(c));
+			}
+			out << "}";
+			first = false;
+		}
+		out << "\n  },\n  \"steps\": [";
+		for (size_t s = 0; s < steps.size(); ++s){
+			out << (s == 0 ? "\n" : ",\n") << "    {\"time\": " << steps[s].time;
+			for (int p = 0; p < n_phases; ++p){
+				const PhaseRecord& rec = steps[s].phases.at(p);
+				if (!rec.ran){
+					continue;
+				}
+				out << ", \"" << phase_name(static_cast<Phase>(p)) << "\": {\"ms\": "
+					<< 1000.0*rec.duration;
+				for (int c = 0; c < n_counters; ++c){
+					out << ", \"" << counter_name(static_cast<Counter>(c)) << "\": "
+						<< rec.counts.at(c);
+				}
+				out << "}";
+			}
+			out << "}";
+		}
+		out << "\n  ]\n}\n";
+	}
+
+	/**
+	 * \brief Save all phases as a Chrome trace
+	 * \details One complete event per phase of each step, with
+	 *		its counters as arguments, and counter events per step
+	 * @param fname - path of the file to write to
+	 */
+	void write_chrome_trace(const std::string& fname) const
+	{
+		std::ofstream out(fname);
+		check_open(out, fname);
+		// Microsecond resolution for runs of any length
+		out << std::fixed << std::setprecision(3);
+		out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+		bool first = true;
+		// Microseconds from the start of the first step
+		const double t0 = steps.empty() ? 0.0 : steps.front().start;
+		for (const auto& step : steps){
+			for (int p = 0; p < n_phases; ++p){
+				const PhaseRecord& rec = step.phases.at(p);
+				if (!rec.ran){
+					continue;
+				}
+				out << (first ? "\n" : ",\n") << "{\"name\": \"" << phase_name(static_cast<Phase>(p))
+					<< "\", \"cat\": \"step\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, \"ts\": "
+					<< 1e6*(rec.start - t0) << ", \"dur\": " << 1e6*rec.duration
+					<< ", \"args\": {\"time\": " << step.time;
+				for (int c = 0; c < n_counters; ++c){
+					out << ", \"" << counter_name(static_cast<Counter>(c)) << "\": "
+						<< rec.counts.at(c);
+				}
+				out << "}}";
+				first = false;
+			}
+			// Work of the whole step as counter tracks
+			for (int c = 0; c < n_counters; ++c){
+				uint64_t total = 0;
+				for (const auto& rec : step.phases){
+					total += rec.counts.at(c);
+				}
+				out << (first ? "\n" : ",\n") << "{\"name\": \"" << counter_name(static_cast<Counter>(c))
+					<< "\", \"ph\": \"C\", \"pid\": 1, \"ts\": " << 1e6*(step.start - t0)
+					<< ", \"args\": {\"value\": " << total << "}}";
+				first = false;
+			}
+		}
+		out << "\n]}\n";
+	}
+
+private:
+	struct PhaseRecord{
+		// Seconds from an arbitrary origin
+		double start = 0.0;
+		double duration = 0.0;
+		std::array<uint64_t, n_counters> counts = {{}};
+		bool ran = false;
+	};
+
+	struct Step{
+		double time = 0.0;
+		double start = 0.0;
+		std::array<PhaseRecord, n_phases> phases;
+	};
+
+	bool on = false;
+	std::vector<Step> steps;
+	// Phase that is running, n_phases if none
+	int current = n_phases;
+	// Totals when the phase started
+	uint64_t start_draws = 0;
+	uint64_t start_inserts = 0;
+	uint64_t start_removes = 0;
+
+	// No phase running, stop counting membership changes for it
+	void end_phase()
+	{
+		if (current != n_phases){
+			--PlaceMembers::recording();
+			current = n_phases;
+		}
+	}
+
+	// Current time in seconds
+	static double now()
+	{
+		return std::chrono::duration<double>(
+					std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// Throws if the output file is not open
+	static void check_open(const std::ofstream& out, const std::string& fname)
+	{
+		if (!out.is_open()){
+			throw std::runtime_error("Error opening file " + fname);
+		}
+	}
+};
+
+#endif
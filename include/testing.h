@@ -71,6 +71,20 @@ public:
 	/// Probability flu (non-covid symptomatic) gets tested
 	double get_prob_flu_tested() const { return flu_fraction_to_test; } 
 
+	//
+	// I/O
+	//
+
+	/// Read or write all attributes, for checkpoints
+	template <typename Archive>
+	void serialize(Archive& ar)
+	{ 
+		ar(testing_change_times, start_testing, negative_tests_fraction, 
+			fraction_false_negative, fraction_false_positive, sy_fraction_to_get_tested,
+			exposed_fraction_to_get_tested, flu_fraction_to_test, time_of_next_change,
+			next_testing_fractions); 
+	}
+
 private:
 	// Vector of times marking the time testing is supposed
 	// to change value and corresponding values, i.e. 
@@ -0,0 +1,98 @@
+#ifndef DEFERRED_CHANGES_H
+#define DEFERRED_CHANGES_H
+
+#include "../common.h"
+#include "../places/place.h"
+#include "../flu.h"
+
+/// \brief Change to an object shared between agents
+/// \details place is null for changes to the flu pools 
+struct SharedChange{
+	enum Type {add_agent, remove_agent, remove_susceptible, swap_flu};
+	Type type;
+	Place* place;
+	int agent_ID;
+};
+
+/***************************************************** 
+ * class: DeferredChanges
+ *
+ * Changes of place membership and flu pools made 
+ * during agent transitions; applied directly or,
+ * if a buffer is set, stored and applied after
+ * all agents were processed - used when agents
+ * are split between threads 
+ * 
+ ******************************************************/
+
+class DeferredChanges{
+public:
+
+	//
+	// Constructors
+	//
+
+	/// \brief Default constructor only
+	DeferredChanges() = default;
+
+	/**
+	 * \brief Store changes instead of applying them
+	 * @param buf - pointer to the buffer, nullptr to apply changes directly
+	 */
+	void set_buffer(std::vector<SharedChange>* buf) { buffer = buf; }
+
+	//
+	// Changes
+	//
+
+	/// \brief Add agent with ID agent_ID to a place 
+	void add_agent(Place& place, const int agent_ID) const
+	{ 
+		if (buffer == nullptr){
+			place.add_agent(agent_ID);
+		} else {
+			buffer->push_back({SharedChange::add_agent, &place, agent_ID});
+		}
+	}
+
+	/// \brief Remove agent with ID agent_ID from a place 
+	void remove_agent(Place& place, const int agent_ID) const
+	{ 
+		if (buffer == nullptr){
+			place.remove_agent(agent_ID);
+		} else {
+			buffer->push_back({SharedChange::remove_agent, &place, agent_ID});
+		}
+	}
+
+	/// \brief Remove agent with ID agent_ID from the susceptible flu pool 
+	void remove_susceptible_agent(Flu& flu, const int agent_ID) const
+	{ 
+		if (buffer == nullptr){
+			flu.remove_susceptible_agent(agent_ID);
+		} else {
+			buffer->push_back({SharedChange::remove_susceptible, nullptr, agent_ID});
+		}
+	}
+
+	/** 
+	 * \brief Remove agent from flu and choose a new flu agent 
+	 * @param flu - Flu object
+	 * @param agent_ID - ID of agent that no longer has flu
+	 * @return ID of the new flu agent, -1 if none or if the swap was stored 
+	 */
+	int swap_flu_agent(Flu& flu, const int agent_ID) const
+	{ 
+		if (buffer == nullptr){
+			return flu.swap_flu_agent(agent_ID);
+		} 
+		buffer->push_back({SharedChange::swap_flu, nullptr, agent_ID});
+		return -1;
+	}
+
+private:
+	// Buffer for stored changes, nullptr if not used
+	std::vector<SharedChange>* buffer = nullptr;
+};
+
+#endif
@@ -21,9 +21,11 @@
 #include "../common.h"
 #include "../agent.h"
 #include "../infection.h"
+#include "../infection_parameters.h"
 #include "../states_manager/regular_states_manager.h"
 #include "../flu.h"
 #include "../testing.h"
+#include "deferred_changes.h"
 
 /***************************************************** 
  * class: FluTransitions 
@@ -52,7 +54,7 @@ public:
 			    std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
+				const InfectionParameters& infection_parameters, 
 				std::vector<Agent>& agents, Flu& flu, const Testing& testing, const double dt);
 
 	/// \brief Determine any testing related properties
@@ -60,12 +62,12 @@ public:
 				std::vector<School>& schools, std::vector<Workplace>& workplaces, 
 				std::vector<Hospital>& hospitals, std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters,
+				const InfectionParameters& infection_parameters,
 				const Testing& testing);
 
 	/// \brief Agent transitions related to testing time
 	void testing_transitions_flu(Agent& agent, const double time,
-									const std::map<std::string, double>& infection_parameters);
+									const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions upon receiving test results
 	void testing_results_transitions_flu(Agent& agent, std::vector<Agent>& agents, Flu& flu,
@@ -74,19 +76,26 @@ public:
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters, const Testing& testing);
+			const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Set properties related to newly created agent with flu, including testing
 	void process_new_flu(Agent& agent, const int n_hospitals, const double time, 
 			   		std::vector<School>& schools, std::vector<Workplace>& workplaces,
 					std::vector<RetirementHome>& retirement_homes, std::vector<Transit>& carpools,
 					std::vector<Transit>& public_transit, Infection& infection, 
-					const std::map<std::string, double>& infection_parameters, 
+					const InfectionParameters& infection_parameters, 
 					Flu& flu, const Testing& testing);
+
+	/// \brief Store changes to places and flu in buffer instead of applying them
+	void set_deferred_buffer(std::vector<SharedChange>* buffer) 
+		{ changes.set_buffer(buffer); }
+
 private:
 
 	// For changing agent states
 	RegularStatesManager states_manager;
+	// Changes to places and flu, direct or deferred
+	DeferredChanges changes;
 
 	/// \brief Return total lambda of susceptible agent
 	double compute_susceptible_lambda(const Agent& agent, const double time, 
@@ -98,7 +107,7 @@ private:
 
 	/// \brief Compte and set agent properties related to recovery without symptoms and incubation
 	void recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				                const std::map<std::string, double>& infection_parameters);
+				                const InfectionParameters& infection_parameters);
 
 	/// \brief Remove agent's index from all workplaces and schools that have them registered
 	void remove_from_all_workplaces_and_schools(Agent& agent,
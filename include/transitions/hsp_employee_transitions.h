@@ -20,9 +20,11 @@
 #include "../common.h"
 #include "../agent.h"
 #include "../infection.h"
+#include "../infection_parameters.h"
 #include "../states_manager/hsp_employee_states_manager.h"
 #include "../flu.h"
 #include "../testing.h"
+#include "deferred_changes.h"
 
 /***************************************************** 
  * class: HspEmployeeTransitions 
@@ -50,7 +52,7 @@ public:
 				std::vector<Hospital>& hospitals,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
+				const InfectionParameters& infection_parameters, 
 				std::vector<Agent>& agents, const Testing& testing);
 
 	/// \brief Implement transitions relevant to exposed
@@ -59,13 +61,13 @@ public:
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Hospital>& hospitals,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters, 
+				const InfectionParameters& infection_parameters, 
 				const Testing& testing);
 
 	/// \brief Determine any testing related properties
 	void set_testing_status(Agent& agent, Infection& infection, const double time, 
 				std::vector<School>& schools, std::vector<Hospital>& hospitals, 
-				const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Transitions of a symptomatic agent 
 	/// @return Vector where first entry is one if agent recovered, second if agent died
@@ -74,11 +76,11 @@ public:
 				std::vector<Household>& households, std::vector<School>& schools,
 				std::vector<Hospital>& hospitals,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters);
+				const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions related to testing time
 	void testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters);
+										const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions upon receiving test results
 	int testing_results_transitions(Agent& agent, 
@@ -86,13 +88,13 @@ public:
 			std::vector<Household>& households, std::vector<School>& schools,
 			std::vector<Hospital>& hospitals,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// \brief Determine treatment changes 
 	void treatment_transitions(Agent& agent, const double time, 
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// \brief Remove agent from hospitals and schools for home isolation
 	void remove_from_hospitals_and_schools(const Agent& agent,
@@ -105,12 +107,18 @@ public:
 			std::vector<Household>& households, std::vector<School>& schools,
 			std::vector<Hospital>& hospitals,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
+
+	/// \brief Store changes to places and flu in buffer instead of applying them
+	void set_deferred_buffer(std::vector<SharedChange>* buffer) 
+		{ changes.set_buffer(buffer); }
 
 private:
 
 	// For changing agent states
 	HspEmployeeStatesManager states_manager;
+	// Changes to places and flu, direct or deferred
+	DeferredChanges changes;
 
 	/// \brief Return total lambda of susceptible agent
 	double compute_susceptible_lambda(const Agent& agent, const double time, 
@@ -120,7 +128,7 @@ private:
 
 	/// \brief Compte and set agent properties related to recovery without symptoms and incubation
 	void recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				                const std::map<std::string, double>& infection_parameters);
+				                const InfectionParameters& infection_parameters);
 	
 	/// \brief Verifies and manages removal of an agent from the model
 	/// @return Vector where first entry is one if agent recovered, second if agent died
@@ -18,8 +18,10 @@
 #include "../common.h"
 #include "../agent.h"
 #include "../infection.h"
+#include "../infection_parameters.h"
 #include "../states_manager/hsp_employee_states_manager.h"
 #include "../flu.h"
+#include "deferred_changes.h"
 
 /***************************************************** 
  * class: HspPatientTransitions 
@@ -44,51 +46,57 @@ public:
 	/// \brief Implement transitions relevant to susceptible
 	/// \details Returns 1 if the agent got infected 
 	int susceptible_transitions(Agent& agent, const double time, Infection& infection,	
-				std::vector<Hospital>& hospitals, const std::map<std::string, double>& infection_parameters, 
+				std::vector<Hospital>& hospitals, const InfectionParameters& infection_parameters, 
 				std::vector<Agent>& agents, const Testing& testing);
 
 	/// \brief Implement transitions relevant to exposed
 	/// \details Return 1 if recovered without symptoms 
 	std::vector<int> exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, std::vector<Household>& households,
-				std::vector<Hospital>& hospitals, const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				std::vector<Hospital>& hospitals, const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Determine any testing related properties
 	void set_testing_status(Agent& agent, Infection& infection, const double time, 
 				std::vector<Hospital>& hospitals, 
-				const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Transitions of a symptomatic agent 
 	/// @return Vector where first entry is one if agent recovered, second if agent died
 	std::vector<int> symptomatic_transitions(Agent& agent, const double time, 
 				const double dt, Infection& infection, std::vector<Household>& households,
-				std::vector<Hospital>& hospitals, const std::map<std::string, double>& infection_parameters);
+				std::vector<Hospital>& hospitals, const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions related to testing time
 	void testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters);
+										const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions upon receiving test results
 	int testing_results_transitions(Agent& agent, 
 			const double time, const double dt, Infection& infection,
 			std::vector<Household>& households,	std::vector<Hospital>& hospitals, 
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// \brief Determine treatment changes 
 	void treatment_transitions(Agent& agent, const double time, 
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// Determine type of intial treatement and its properties
 	void select_initial_treatment(Agent& agent, 
 			const double time, const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
+
+	/// \brief Store changes to places and flu in buffer instead of applying them
+	void set_deferred_buffer(std::vector<SharedChange>* buffer) 
+		{ changes.set_buffer(buffer); }
 
 private:
 
 	// For changing agent states
 	HspEmployeeStatesManager states_manager;
+	// Changes to places and flu, direct or deferred
+	DeferredChanges changes;
 
 	/// \brief Return total lambda of susceptible agent
 	double compute_susceptible_lambda(const Agent& agent, const double time, 
@@ -96,7 +104,7 @@ private:
 
 	/// \brief Compte and set agent properties related to recovery without symptoms and incubation
 	void recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				                const std::map<std::string, double>& infection_parameters);
+				                const InfectionParameters& infection_parameters);
 	
 	/// \brief Verifies and manages removal of an agent from the model
 	/// @return Vector where first entry is one if agent recovered, second if agent died
@@ -21,9 +21,11 @@
 #include "../common.h"
 #include "../agent.h"
 #include "../infection.h"
+#include "../infection_parameters.h"
 #include "../states_manager/regular_states_manager.h"
 #include "../flu.h"
 #include "../testing.h"
+#include "deferred_changes.h"
 
 /***************************************************** 
  * class: RegularTransitions 
@@ -52,7 +54,7 @@ public:
 			    std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
+				const InfectionParameters& infection_parameters, 
 				std::vector<Agent>& agents,	Flu& flu, const Testing& testing);
 
 	/// \brief Implement transitions relevant to exposed
@@ -62,7 +64,7 @@ public:
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,				
-				const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Determine any testing related properties
 	bool set_testing_status(Agent& agent, Infection& infection, const double time, 
@@ -70,7 +72,7 @@ public:
 				std::vector<Hospital>& hospitals, 
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Transitions of a symptomatic agent 
 	/// @return Vector where first entry is one if agent recovered, second if agent died
@@ -80,11 +82,11 @@ public:
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters);
+				const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions related to testing time
 	void testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters);
+										const InfectionParameters& infection_parameters);
 
 	/// \brief Agent transitions upon receiving test results
 	int testing_results_transitions(Agent& agent, 
@@ -93,14 +95,14 @@ public:
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// \brief Determine treatment changes 
 	void treatment_transitions(Agent& agent, const double time, 
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// Determine testing status, treatment choices, and recovery 
 	void untested_sy_setup(Agent& agent, Infection& infection, const double time, const double dt, 
@@ -108,7 +110,7 @@ public:
 										std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 										std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing);
 
 	/// Determine type of intial treatement and its properties
@@ -118,12 +120,18 @@ public:
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
+
+	/// \brief Store changes to places and flu in buffer instead of applying them
+	void set_deferred_buffer(std::vector<SharedChange>* buffer) 
+		{ changes.set_buffer(buffer); }
 
 private:
 
 	// For changing agent states
 	RegularStatesManager states_manager;
+	// Changes to places and flu, direct or deferred
+	DeferredChanges changes;
 
 	/// \brief Return total lambda of susceptible agent
 	double compute_susceptible_lambda(const Agent& agent, const double time, 
@@ -134,15 +142,15 @@ private:
 
 	/// \brief Compte and set agent properties related to recovery without symptoms and incubation
 	void recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				                const std::map<std::string, double>& infection_parameters);
+				                const InfectionParameters& infection_parameters);
 
 	/// Determine if the agent is recovering or dying 
 	void recovery_status(Agent& agent, Infection& infection, const double time,
-										const std::map<std::string, double>& infection_parameters);
+										const InfectionParameters& infection_parameters);
 
 	/// Determine if the agent is recovering or dying in ICU 
 	void recovery_status_ICU(Agent& agent, Infection& infection, const double time,
-										const std::map<std::string, double>& infection_parameters);
+										const InfectionParameters& infection_parameters);
 
 	/// Setup initial treatment properties 
 	void setup_initial_treatment(Agent& agent, 
@@ -151,7 +159,7 @@ private:
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters);
+			const InfectionParameters& infection_parameters);
 
 	/// \brief Verifies and manages removal of an agent from the model
 	/// @return Vector where first entry is one if agent recovered, second if agent died
@@ -30,6 +30,7 @@
 #include "../common.h"
 #include "../agent.h"
 #include "../infection.h"
+#include "../infection_parameters.h"
 #include "../flu.h"
 #include "../testing.h"
 
@@ -64,7 +65,7 @@ public:
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
+				const InfectionParameters& infection_parameters, 
 				std::vector<Agent>& agents, Flu& flu, const Testing& testing);
 
 	/// \brief Implement transitions relevant to exposed
@@ -74,7 +75,7 @@ public:
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters, const Testing& testing);
+				const InfectionParameters& infection_parameters, const Testing& testing);
 
 	/// \brief Transitions of a symptomatic agent 
 	/// @return Vector where first entry is one if agent recovered, second if agent died
@@ -84,20 +85,43 @@ public:
 				std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-				const std::map<std::string, double>& infection_parameters);
+				const InfectionParameters& infection_parameters);
 	
+	/**
+	 * \brief Earliest time at which a timer can trigger a transition of an infected agent
+	 * \details Follows the timer checks of exposed and symptomatic transitions 
+	 *		of all agent types; returns infinity if the agent has no timers running
+	 * @param agent - exposed or symptomatic agent
+	 * @param dt - time step
+	 */
+	static double next_transition_time(const Agent& agent, const double dt);
+
 	/// \brief Set properties related to newly created agent with flu, including testing
 	void process_new_flu(Agent& agent, const int n_hospitals, const double time, 
 			   		std::vector<School>& schools, std::vector<Workplace>& workplaces,
 					std::vector<RetirementHome>& retirement_homes, std::vector<Transit>& carpools,
 					std::vector<Transit>& public_transit, Infection& infection, 
-					const std::map<std::string, double>& infection_parameters, 
+					const InfectionParameters& infection_parameters, 
 					Flu& flu, const Testing& testing) 
 		{ flu_tr.process_new_flu(agent, n_hospitals, time, schools, 
 						workplaces, retirement_homes, 
 						carpools, public_transit,
 						infection, infection_parameters, flu, testing); }
 
+	/**
+	 * \brief Store changes to places and flu instead of applying them
+	 * \details Used when agents are split between threads; 
+	 * 		changes are then applied after all threads are done 
+	 * @param buffer - pointer to the buffer, nullptr to apply directly
+	 */
+	void set_deferred_buffer(std::vector<SharedChange>* buffer)
+	{ 
+		regular_tr.set_deferred_buffer(buffer);
+		hsp_emp_tr.set_deferred_buffer(buffer);
+		hsp_pt_tr.set_deferred_buffer(buffer);
+		flu_tr.set_deferred_buffer(buffer); 
+	}
+
 private:
 	// Transition classes
 	RegularTransitions regular_tr;
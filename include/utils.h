@@ -2,6 +2,8 @@
 #define UTILS_H
 
 #include "common.h"
+#include <thread>
+#include <exception>
 
 /**
  * \brief Convert a string to all lower case
@@ -24,6 +26,19 @@ std::string str_to_lower(std::string s);
 template <typename T>
 bool equal_floats(T, T, T);
 
+/**
+ * \brief Process a range of items in contiguous chunks, one thread per chunk
+ * \details Chunk i covers [i*n/n_threads, (i+1)*n/n_threads) so the
+ * 		partition depends only on n and n_threads; an exception thrown
+ * 		in any chunk is rethrown in the calling thread after all threads
+ * 		joined, the one from the lowest chunk first 
+ * @param n - number of items
+ * @param n_threads - number of threads, runs in the calling thread if 1 or less
+ * @param func - callable with signature void(int chunk, size_t first, size_t last)
+ */
+template <typename F>
+void parallel_chunks(const size_t, const int, F);
+
 //
 // Implementations
 //
@@ -36,5 +51,37 @@ bool equal_floats(T num1, T num2, T tol)
     return std::fabs(num1 - num2) <= tol*max_num_one;
 }
 
+// Process a range of items in contiguous chunks, one thread per chunk
+template <typename F>
+void parallel_chunks(const size_t n, const int n_threads, F func)
+{
+	if (n_threads <= 1){
+		func(0, 0, n);
+		return;
+	}
+
+	std::vector<std::thread> workers;
+	std::vector<std::exception_ptr> errors(n_threads);
+	for (int i = 0; i < n_threads; ++i){
+		const size_t first = n*i/n_threads;
+		const size_t last = n*(i+1)/n_threads;
+		workers.emplace_back([&func, &errors, i, first, last](){
+			try {
+				func(i, first, last);
+			} catch (...) {
+				errors.at(i) = std::current_exception();
+			}
+		});
+	}
+	for (auto& worker : workers){
+		worker.join();
+	}
+	for (const auto& error : errors){
+		if (error){
+			std::rethrow_exception(error);
+		}
+	}
+}
+
 
 #endif
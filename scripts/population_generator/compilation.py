@@ -0,0 +1,23 @@
+import subprocess
+
+#
+# Input 
+#
+
+# Path to the main directory
+path = '../../src/'
+# Compiler options
+cx = 'g++'
+std = '-std=c++11'
+opt = '-O3'
+# Threading support
+thr = '-pthread'
+# Source files
+src_files = path + 'io_operations/population_generator.cpp'
+
+# Name of the executable
+exe_name = 'generate_population'
+# Files needed only for this build
+spec_files = 'generate_population.cpp '
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files])
+subprocess.call([compile_com], shell=True)
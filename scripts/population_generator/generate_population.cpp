@@ -0,0 +1,48 @@
+#include "../../include/io_operations/population_generator.h"
+#include <chrono>
+#include <thread>
+
+/***************************************************** 
+ *
+ * Generates a synthetic town with a given number 
+ * of agents in the formats of the ABM::create_ functions
+ *
+ * Run as
+ *
+ * 		./generate_population n_agents prefix [n_threads] [parameter_file]
+ *
+ * e.g. ./generate_population 1000000 towns/town_1M 8
+ * writes towns/town_1M_households.txt, _schools.txt, 
+ * _workplaces.txt, _hospitals.txt, _retirement_homes.txt,
+ * _carpool.txt, _public.txt, _leisure.txt, and _agents.txt;
+ * all cores are used by default; town properties not in
+ * the parameter file, like the seed and the spatial extent, 
+ * have the values of PopulationGenerator::Parameters
+ *
+ ******************************************************/
+
+int main(int argc, char** argv)
+{
+	if (argc < 3 || argc > 5) {
+		std::cerr << "Usage: " << argv[0] << " n_agents prefix [n_threads] [parameter_file]" << std::endl;
+		return 1;
+	}
+	const int n_threads = (argc > 3) ? std::stoi(argv[3]) 
+							: std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	PopulationGenerator::Parameters par;
+	if (argc > 4) {
+		par = PopulationGenerator::load_parameters(argv[4]);
+	}
+	par.n_agents = std::stoi(argv[1]);
+
+	const auto begin = std::chrono::steady_clock::now();
+	PopulationGenerator generator(par);
+	generator.generate(argv[2], n_threads);
+	const auto end = std::chrono::steady_clock::now();
+
+	std::cout << "Town " << argv[2] << " with " << generator.number_of_agents() << " agents, "
+			  << generator.number_of_households() << " households, "
+			  << generator.number_of_schools() << " schools, and "
+			  << generator.number_of_workplaces() << " workplaces in "
+			  << std::chrono::duration<double>(end - begin).count() << " s" << std::endl;
+}
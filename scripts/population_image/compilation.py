@@ -0,0 +1,21 @@
+import subprocess
+
+#
+# Input 
+#
+
+# Path to the main directory
+path = '../../src/'
+# Compiler options
+cx = 'g++'
+std = '-std=c++11'
+opt = '-O3'
+# Source files
+src_files = path + 'io_operations/FileHandler.cpp'
+
+# Name of the executable
+exe_name = 'compile_population'
+# Files needed only for this build
+spec_files = 'compile_population.cpp '
+compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, src_files])
+subprocess.call([compile_com], shell=True)
@@ -0,0 +1,44 @@
+#include "../../include/io_operations/population_image.h"
+
+/***************************************************** 
+ *
+ * Compiles the text population files of a town into 
+ * one binary population image for ABM::create_population
+ *
+ * Run as
+ *
+ * 		./compile_population input_dir prefix image_file
+ *
+ * e.g. ./compile_population input_data NR input_data/NR_population.bin
+ * reads input_data/NR_households.txt, NR_retirement_homes.txt,
+ * NR_schools.txt, NR_workplaces.txt, NR_hospitals.txt, 
+ * NR_carpool.txt, NR_public.txt, NR_leisure.txt, and 
+ * NR_agents.txt; missing place files are stored as empty
+ *
+ ******************************************************/
+
+int main(int argc, char** argv)
+{
+	if (argc != 4) {
+		std::cerr << "Usage: " << argv[0] << " input_dir prefix image_file" << std::endl;
+		return 1;
+	}
+	const std::string path = std::string(argv[1]) + "/" + argv[2] + "_";
+	
+	// Files in the order of PopulationImage::Table
+	std::array<std::string, PopulationImage::n_tables> files = 
+		{{ path + "households.txt", path + "retirement_homes.txt", path + "schools.txt",
+		   path + "workplaces.txt", path + "hospitals.txt", path + "carpool.txt",
+		   path + "public.txt", path + "leisure.txt", path + "agents.txt" }};
+	for (unsigned t = 0; t < PopulationImage::agents; ++t) {
+		if (!std::ifstream(files.at(t)).good()) {
+			std::cout << "No file " << files.at(t) << ", no such places in the image" << std::endl;
+			files.at(t).clear();
+		}
+	}
+
+	PopulationImage::compile(files, argv[3]);
+	const PopulationImage image(argv[3]);
+	std::cout << "Population image " << argv[3] << " with " 
+			  << image.agent_table().size() << " agents" << std::endl;
+}
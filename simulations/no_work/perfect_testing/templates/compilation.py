@@ -10,6 +10,8 @@ path = '../../../../src/'
 cx = 'g++'
 std = '-std=c++11'
 opt = '-O3'
+# Threading support
+thr = '-pthread'
 
 # Common source files
 src_files = path + 'abm.cpp' 
@@ -43,7 +45,7 @@ src_files += ' ' + path + 'io_operations/load_parameters.cpp'
 exe_name = 'covid_exe'
 # Files needed only for this build
 spec_files = 'covid_model.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, src_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files])
 subprocess.call([compile_com], shell=True)
 
 
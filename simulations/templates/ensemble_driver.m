@@ -0,0 +1,19 @@
+%% Run a number of COVID simulations in one process and store results
+
+clear
+close all
+
+num_sim = 400;
+num_steps = 360;
+dt = 0.25;
+time=0:dt:dt*num_steps;
+
+% Town is loaded once, realizations run on all cores
+system(['./ensemble_exe ' num2str(num_sim) ' >> output/simulation.log']);
+
+% All the collected data, one realization per row
+cur_infected = load('output/infected_with_time.txt');
+tot_infected = load('output/total_infected.txt');
+tot_deaths = load('output/dead_with_time.txt');
+
+save('fixed_vac_var_reopening.mat')
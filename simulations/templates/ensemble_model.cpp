@@ -0,0 +1,108 @@
+#include "../../../../include/ensemble.h"
+#include <chrono>
+#include <thread>
+
+/*****************************************************
+ *
+ * Ensemble of ABM runs of COVID-19 SEIR in New Rochelle, NY
+ *
+ * Town is loaded once and all realizations run in
+ * this process; run as
+ *
+ * 		./ensemble_exe [num_sim] [num_threads] [first_seed]
+ *
+ * Each output file has one realization per line
+ *
+ ******************************************************/
+
+int main(int argc, char** argv)
+{
+	// Number of realizations, threads, and seed of the first one
+	int num_sim = argc > 1 ? std::stoi(argv[1]) : 100;
+	int num_threads = argc > 2 ? std::stoi(argv[2]) : std::thread::hardware_concurrency();
+	uint64_t seed_0 = argc > 3 ? std::stoull(argv[3]) : std::random_device()();
+
+	// Time in days, space in km
+	double dt = 0.25;
+	// Max number of steps to simulate
+	int tmax = 360;
+	// Number of initially infected
+	int inf0 = 16;
+	// Number of agents in different stages of COVID-19
+	int N_covid = 187;
+
+	// Input files
+	std::string fin("input_data/NR_agents.txt");
+	std::string hfile("input_data/NR_households.txt");
+	std::string sfile("input_data/NR_schools.txt");
+	std::string wfile("input_data/NR_workplaces.txt");
+	std::string hsp_file("input_data/NR_hospitals.txt");
+	std::string rh_file("input_data/NR_retirement_homes.txt");
+	std::string cp_file("input_data/NR_carpool.txt");
+	std::string pt_file("input_data/NR_public.txt");
+	std::string ls_file("input_data/NR_leisure.txt");
+
+	// File with infection parameters
+	std::string pfname("input_data/infection_parameters.txt");
+	// Files with age-dependent distributions
+	std::string dexp_name("input_data/age_dist_exposed_never_sy.txt");
+	std::string dh_name("input_data/age_dist_hospitalization.txt");
+	std::string dhicu_name("input_data/age_dist_hosp_ICU.txt");
+	std::string dmort_name("input_data/age_dist_mortality.txt");
+	// Map for abm loading of distributions
+	std::map<std::string, std::string> dfiles =
+		{ {"exposed never symptomatic", dexp_name}, {"hospitalization", dh_name},
+		  {"ICU", dhicu_name}, {"mortality", dmort_name} };
+	// File with time dependent testing
+	std::string tfname("input_data/tests_with_time.txt");
+
+	// For time measurement
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+	ABM abm(dt, pfname, dfiles, tfname);
+	abm.set_seed(seed_0);
+	abm.set_parallel_mobility(num_threads);
+
+	// First the places
+	abm.create_households(hfile);
+	abm.create_schools(sfile);
+	abm.create_workplaces(wfile);
+	abm.create_hospitals(hsp_file);
+	abm.create_retirement_homes(rh_file);
+	abm.create_carpools(cp_file);
+	abm.create_public_transit(pt_file);
+	abm.create_leisure_locations(ls_file);
+	abm.initialize_mobility();
+
+	// Then the agents
+	abm.create_agents(fin, inf0);
+
+	// Initialization for vaccination reopening studies
+	abm.initialize_vac_and_reopening();
+	abm.initialize_active_cases(N_covid);
+
+	// Realizations start from this state
+	Ensemble ensemble(abm);
+	ensemble.set_number_of_threads(num_threads);
+	ensemble.set_step_function(&ABM::transmit_ideal_testing_vac_reopening);
+
+	std::chrono::steady_clock::time_point ready = std::chrono::steady_clock::now();
+
+	std::vector<uint64_t> seeds(num_sim);
+	for (int i = 0; i < num_sim; ++i){
+		seeds.at(i) = seed_0 + i + 1;
+	}
+	// Steps 0 to tmax, as in single runs
+	const std::vector<Ensemble::Series> results = ensemble.run(seeds, tmax);
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	std::cout << "Setup time = " << std::chrono::duration_cast<std::chrono::milliseconds>(ready - begin).count() << "[ms]" << std::endl;
+	std::cout << "Ensemble time = " << std::chrono::duration_cast<std::chrono::seconds>(end - ready).count() << "[s]" << std::endl;
+
+	// Active at the current step - all, detected and not
+	Ensemble::print_series("output/infected_with_time.txt", results, &Ensemble::Series::infected);
+	// Cumulative
+	Ensemble::print_series("output/total_infected.txt", results, &Ensemble::Series::total_infected);
+	Ensemble::print_series("output/dead_with_time.txt", results, &Ensemble::Series::total_dead);
+	Ensemble::print_series("output/recovered_with_time.txt", results, &Ensemble::Series::total_recovered);
+}
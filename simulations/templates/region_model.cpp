@@ -0,0 +1,116 @@
+#include "../../../../include/region.h"
+#include <chrono>
+#include <thread>
+
+/*****************************************************
+ *
+ * ABM runs of COVID-19 SEIR in several coupled towns
+ *
+ * All towns are loaded and run in this process, the
+ * places outside of each town see the prevalence of
+ * the towns its commuters travel to; run as
+ *
+ * 		./region_exe num_threads flows_file town_1 [town_2 ...]
+ *
+ * where each town is the path and prefix of its input
+ * files, e.g. input_data/NR for input_data/NR_agents.txt;
+ * infection parameters and distributions are read from
+ * the directory of the town. Flows file has one row per
+ * town, entry j of row i is the fraction of outside
+ * contacts of town i in town j.
+ *
+ ******************************************************/
+
+ABM create_town(const std::string& town, const double dt, const int inf0,
+					const int N_covid, const uint64_t seed, const int num_threads);
+
+int main(int argc, char** argv)
+{
+	if (argc < 4){
+		std::cerr << "Usage: ./region_exe num_threads flows_file town_1 [town_2 ...]" << std::endl;
+		return 1;
+	}
+	int num_threads = std::stoi(argv[1]);
+	std::string flows_file(argv[2]);
+
+	// Time in days, space in km
+	double dt = 0.25;
+	// Max number of steps to simulate
+	int tmax = 360;
+	// Number of initially infected
+	int inf0 = 16;
+	// Number of agents in different stages of COVID-19
+	int N_covid = 187;
+
+	// For time measurement
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+	Region region;
+	region.set_number_of_threads(num_threads);
+	region.set_step_function(&ABM::transmit_ideal_testing_vac_reopening);
+	uint64_t seed = std::random_device()();
+	for (int i = 3; i < argc; ++i){
+		const std::string town(argv[i]);
+		region.add_town(create_town(town, dt, inf0, N_covid, seed + i, num_threads), town);
+	}
+	region.load_commuter_flows(flows_file);
+
+	std::chrono::steady_clock::time_point ready = std::chrono::steady_clock::now();
+
+	// Active infections in each town, one line per step
+	std::ofstream out("output/infected_with_time.txt");
+	for (int ti = 0; ti <= tmax; ++ti){
+		for (size_t i = 0; i < region.number_of_towns(); ++i){
+			out << region.get_town(i).get_num_infected() << " ";
+		}
+		out << "\n";
+		region.step();
+	}
+	region.print_prevalence("output/prevalence.txt");
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	std::cout << "Setup time = " << std::chrono::duration_cast<std::chrono::milliseconds>(ready - begin).count() << "[ms]" << std::endl;
+	std::cout << "Region time = " << std::chrono::duration_cast<std::chrono::seconds>(end - ready).count() << "[s]" << std::endl;
+}
+
+// Load and initialize one town
+ABM create_town(const std::string& town, const double dt, const int inf0,
+					const int N_covid, const uint64_t seed, const int num_threads)
+{
+	const size_t sep = town.find_last_of('/');
+	const std::string dir = (sep == std::string::npos) ? std::string("./") : town.substr(0, sep + 1);
+
+	// File with infection parameters
+	std::string pfname(dir + "infection_parameters.txt");
+	// Files with age-dependent distributions
+	std::map<std::string, std::string> dfiles =
+		{ {"exposed never symptomatic", dir + "age_dist_exposed_never_sy.txt"},
+		  {"hospitalization", dir + "age_dist_hospitalization.txt"},
+		  {"ICU", dir + "age_dist_hosp_ICU.txt"},
+		  {"mortality", dir + "age_dist_mortality.txt"} };
+	// File with time dependent testing
+	std::string tfname(dir + "tests_with_time.txt");
+
+	ABM abm(dt, pfname, dfiles, tfname);
+	abm.set_seed(seed);
+	abm.set_parallel_mobility(num_threads);
+
+	// First the places
+	abm.create_households(town + "_households.txt");
+	abm.create_schools(town + "_schools.txt");
+	abm.create_workplaces(town + "_workplaces.txt");
+	abm.create_hospitals(town + "_hospitals.txt");
+	abm.create_retirement_homes(town + "_retirement_homes.txt");
+	abm.create_carpools(town + "_carpool.txt");
+	abm.create_public_transit(town + "_public.txt");
+	abm.create_leisure_locations(town + "_leisure.txt");
+	abm.initialize_mobility();
+
+	// Then the agents
+	abm.create_agents(town + "_agents.txt", inf0);
+
+	// Initialization for vaccination reopening studies
+	abm.initialize_vac_and_reopening();
+	abm.initialize_active_cases(N_covid);
+	return abm;
+}
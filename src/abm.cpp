@@ -53,21 +53,27 @@ void ABM::load_infection_parameters(const std::string infile)
 	// Load parameters
 	LoadParameters ldparam;
 	infection_parameters = ldparam.load_parameter_map(infile);
+	// Fields used in the simulation, all need to be present
+	infection_params = InfectionParameters(infection_parameters);
 
 	// Set infection distributions
-	infection.set_latency_distribution(infection_parameters.at("latency log-normal mean"),
-					infection_parameters.at("latency log-normal standard deviation"));	
-	infection.set_inf_variability_distribution(infection_parameters.at("agent variability gamma shape"),
-					infection_parameters.at("agent variability gamma scale"));
-	infection.set_onset_to_death_distribution(infection_parameters.at("otd logn mean"), 
-					infection_parameters.at("otd logn std"));
-	infection.set_onset_to_hospitalization_distribution(infection_parameters.at("oth gamma shape"), infection_parameters.at("oth gamma scale"));
-	infection.set_hospitalization_to_death_distribution(infection_parameters.at("htd wbl shape"), infection_parameters.at("htd wbl scale"));
+	infection.set_latency_distribution(infection_params.latency_log_normal_mean,
+					infection_params.latency_log_normal_standard_deviation);	
+	infection.set_inf_variability_distribution(infection_params.agent_variability_gamma_shape,
+					infection_params.agent_variability_gamma_scale);
+	infection.set_onset_to_death_distribution(infection_params.otd_logn_mean, 
+					infection_params.otd_logn_std);
+	infection.set_onset_to_hospitalization_distribution(infection_params.oth_gamma_shape, infection_params.oth_gamma_scale);
+	infection.set_hospitalization_to_death_distribution(infection_params.htd_wbl_shape, infection_params.htd_wbl_scale);
 
 	// Set single-number probabilities
-	infection.set_other_probabilities(infection_parameters.at("average fraction to get tested"),
-									  infection_parameters.at("probability of death in ICU"), 
-								  infection_parameters.at("probability dying if needing but not admitted to icu"));
+	infection.set_other_probabilities(infection_params.average_fraction_to_get_tested,
+									  infection_params.probability_of_death_in_icu, 
+								  infection_params.probability_dying_if_needing_but_not_admitted_to_icu);
+
+	// Closures and reopenings
+	open_leisure_fraction = infection_params.leisure_fraction;
+	set_default_policy_schedule();
 }
 
 // Load age-dependent distributions, store in a map of maps
@@ -94,105 +100,195 @@ void ABM::load_age_dependent_distributions(const std::map<std::string, std::stri
 void ABM::load_testing(const std::string fname) 
 {
 	// Regular properties
-	testing.initialize_testing(infection_parameters.at("start testing"),
-					infection_parameters.at("negative tests fraction"),
-					infection_parameters.at("fraction false negative"),
-					infection_parameters.at("fraction false positive"),
-					infection_parameters.at("fraction to get tested"),
-					infection_parameters.at("exposed fraction to get tested"));	
+	testing.initialize_testing(infection_params.start_testing,
+					infection_params.negative_tests_fraction,
+					infection_params.fraction_false_negative,
+					infection_params.fraction_false_positive,
+					infection_params.fraction_to_get_tested,
+					infection_params.exposed_fraction_to_get_tested);	
 	// Time-dependent test fractions
-	std::vector<std::vector<std::string>> file = read_object(fname);
 	std::vector<std::vector<double>> fractions_times = {};
-	std::vector<double> temp(3,0.0);
-	for (auto& entry : file){
-		for (int i=0; i<3; ++i){
-			temp.at(i) = std::stod(entry.at(i));
-		}
-		fractions_times.push_back(temp);
-	}
+	AbmIO(fname, " ", true, {0,0,0}).for_each_line(
+		[&fractions_times](const std::vector<TextReader::Token>& entry){
+			std::vector<double> temp(3,0.0);
+			for (int i=0; i<3; ++i){
+				temp.at(i) = entry.at(i).as<double>();
+			}
+			fractions_times.push_back(temp);
+		});
 	testing.set_time_varying(fractions_times);
 }
 
+// Closures and reopenings from infection parameters
+void ABM::set_default_policy_schedule()
+{
+	policy_schedule.clear();
+	policy_schedule.add(infection_params.school_closure, "schools", 0.0);
+	policy_schedule.add(infection_params.lockdown, "workplace absenteeism", 
+							infection_params.lockdown_absenteeism);
+	policy_schedule.add(infection_params.lockdown, "businesses", 
+							infection_params.fraction_of_ld_businesses);
+	policy_schedule.add(infection_params.reopening_phase_1, "businesses", 
+							infection_params.fraction_of_phase_1_businesses);
+	policy_schedule.add(infection_params.reopening_phase_2, "businesses", 
+							infection_params.fraction_of_phase_2_businesses);
+	policy_schedule.add(infection_params.reopening_phase_3, "businesses", 
+							infection_params.fraction_of_phase_3_businesses);
+}
+
+// Replace the closures and reopenings with a schedule from a file
+void ABM::load_policy_schedule(const std::string& fname)
+{
+	PolicySchedule schedule;
+	AbmIO(fname, " ", true, {0,0,0}).for_each_line(
+		[&schedule](const std::vector<TextReader::Token>& entry){
+			if (entry.empty()) {
+				return;
+			}
+			if (entry.size() < 3) {
+				throw std::invalid_argument("Policy event needs a time, target, and value");
+			}
+			// Target can have more than one word
+			std::string target = entry.at(1).str();
+			for (size_t i = 2; i < entry.size() - 1; ++i) {
+				target += " " + entry.at(i).str();
+			}
+			schedule.add(entry.front().as<double>(), target, entry.back().as<double>());
+		});
+	policy_schedule = schedule;
+}
+
 // Generate and store household objects
 void ABM::create_households(const std::string fname)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One household per line
-	for (auto& house : file){
+	add_households(PopulationImage::place_records(fname, PopulationImage::households));
+}
+
+// Generate and store retirement home objects
+void ABM::create_retirement_homes(const std::string fname)
+{
+	add_retirement_homes(PopulationImage::place_records(fname, PopulationImage::retirement_homes));
+}
+
+// Generate and store school objects
+void ABM::create_schools(const std::string fname)
+{
+	add_schools(PopulationImage::place_records(fname, PopulationImage::schools));
+}
+
+// Generate and store workplace objects
+void ABM::create_workplaces(const std::string fname)
+{
+	add_workplaces(PopulationImage::place_records(fname, PopulationImage::workplaces));
+}
+
+// Create hospitals based on information in a file
+void ABM::create_hospitals(const std::string fname)
+{
+	add_hospitals(PopulationImage::place_records(fname, PopulationImage::hospitals));
+}
+
+// Generate and store carpool objects
+void ABM::create_carpools(const std::string fname)
+{
+	add_carpools(PopulationImage::place_records(fname, PopulationImage::carpools));
+}
+
+// Generate and store public transit objects
+void ABM::create_public_transit(const std::string fname)
+{
+	add_public_transit(PopulationImage::place_records(fname, PopulationImage::public_transit));
+}
+
+// Generate and store leisure locations/weekend objects
+void ABM::create_leisure_locations(const std::string fname)
+{
+	add_leisure_locations(PopulationImage::place_records(fname, PopulationImage::leisure_locations));
+}
+
+// Create places, mobility, and agents from a population image
+void ABM::create_population(const std::string fname, const int ninf0)
+{
+	const PopulationImage image(fname);
+	add_households(image.place_table(PopulationImage::households));
+	add_schools(image.place_table(PopulationImage::schools));
+	add_workplaces(image.place_table(PopulationImage::workplaces));
+	add_hospitals(image.place_table(PopulationImage::hospitals));
+	add_retirement_homes(image.place_table(PopulationImage::retirement_homes));
+	add_carpools(image.place_table(PopulationImage::carpools));
+	add_public_transit(image.place_table(PopulationImage::public_transit));
+	add_leisure_locations(image.place_table(PopulationImage::leisure_locations));
+	initialize_mobility();
+	add_agents(image.agent_table(), ninf0);
+	attach_agents_to_store();
+	register_agents();
+}
+
+// Store households, one per record
+void ABM::add_households(const place_range& records)
+{
+	for (const auto& house : records){
 		// Extract properties, add infection parameters
-		Household temp_house(std::stoi(house.at(0)), 
-			std::stod(house.at(1)), std::stod(house.at(2)),
-			infection_parameters.at("household scaling parameter"),
-			infection_parameters.at("severity correction"),
-			infection_parameters.at("household transmission rate"),
-			infection_parameters.at("transmission rate of home isolated"));
+		Household temp_house(house.ID, house.x, house.y,
+			infection_params.household_scaling_parameter,
+			infection_params.severity_correction,
+			infection_params.household_transmission_rate,
+			infection_params.transmission_rate_of_home_isolated);
 		// Store 
 		households.push_back(temp_house);
 	}
 }
 
-// Generate and store retirement homes objects
-void ABM::create_retirement_homes(const std::string fname)
+// Store retirement homes, one per record
+void ABM::add_retirement_homes(const place_range& records)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One household per line
-	for (auto& rh : file){
+	for (const auto& rh : records){
 		// Extract properties, add infection parameters
-		RetirementHome temp_RH(std::stoi(rh.at(0)), 
-			std::stod(rh.at(1)), std::stod(rh.at(2)),
-			infection_parameters.at("severity correction"),
-			infection_parameters.at("RH employee absenteeism factor"),
-			infection_parameters.at("RH employee transmission rate"),
-			infection_parameters.at("RH resident transmission rate"),
-			infection_parameters.at("RH transmission rate of home isolated"));
+		RetirementHome temp_RH(rh.ID, rh.x, rh.y,
+			infection_params.severity_correction,
+			infection_params.rh_employee_absenteeism_factor,
+			infection_params.rh_employee_transmission_rate,
+			infection_params.rh_resident_transmission_rate,
+			infection_params.rh_transmission_rate_of_home_isolated);
 		// Store 
 		retirement_homes.push_back(temp_RH);
 	}
 }
 
-// Generate and store school objects
-void ABM::create_schools(const std::string fname)
+// Store schools, one per record
+void ABM::add_schools(const place_range& records)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One workplace per line
-	for (auto& school : file){
+	for (const auto& school : records){
 		// Extract properties, add infection parameters
 		// School-type dependent absenteeism
 		double psi = 0.0;
-		std::string school_type = school.at(3);
+		const std::string school_type = PopulationImage::text(school.type);
 		if (school_type == "daycare")
- 			psi = infection_parameters.at("daycare absenteeism correction");
+ 			psi = infection_params.daycare_absenteeism_correction;
 		else if (school_type == "primary" || school_type == "middle")
- 			psi = infection_parameters.at("primary and middle school absenteeism correction");
+ 			psi = infection_params.primary_and_middle_school_absenteeism_correction;
 		else if (school_type == "high")
- 			psi = infection_parameters.at("high school absenteeism correction");
+ 			psi = infection_params.high_school_absenteeism_correction;
 		else if (school_type == "college")
- 			psi = infection_parameters.at("college absenteeism correction");
+ 			psi = infection_params.college_absenteeism_correction;
 		else
 			throw std::invalid_argument("Wrong school type: " + school_type);
-		School temp_school(std::stoi(school.at(0)), 
-			std::stod(school.at(1)), std::stod(school.at(2)),
-			infection_parameters.at("severity correction"),	
-			infection_parameters.at("school employee absenteeism correction"), psi,
-			infection_parameters.at("school employee transmission rate"), 
-			infection_parameters.at("school transmission rate"));
+		School temp_school(school.ID, school.x, school.y,
+			infection_params.severity_correction,	
+			infection_params.school_employee_absenteeism_correction, psi,
+			infection_params.school_employee_transmission_rate, 
+			infection_params.school_transmission_rate);
 		// Store 
 		schools.push_back(temp_school);
 	}
 }
 
-// Generate and store workplace objects
-void ABM::create_workplaces(const std::string fname)
+// Store workplaces, one per record
+void ABM::add_workplaces(const place_range& records)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One workplace per line
-	for (auto& work : file){
+	for (const auto& work : records){
 		// Get the occupation type of the workplace
-		std::string work_type = work.at(3);
+		const std::string work_type = PopulationImage::text(work.type);
 		std::string rate_by_type = "outside";
 		double work_rate = 0.0;	 
 		if (work_type == "A") { 
@@ -213,88 +309,73 @@ void ABM::create_workplaces(const std::string fname)
 			work_rate = 1.0;
 		}
 		// Extract properties, add infection parameters
-        Workplace temp_work(std::stoi(work.at(0)),
-            std::stod(work.at(1)), std::stod(work.at(2)),
-            infection_parameters.at("severity correction"),
-            infection_parameters.at("work absenteeism correction"),
-            work_rate, work.at(3));
+        Workplace temp_work(work.ID, work.x, work.y,
+            infection_params.severity_correction,
+            infection_params.work_absenteeism_correction,
+            work_rate, work_type);
 		// Store 
 		workplaces.push_back(temp_work);
 	}
 	set_outside_workplace_transmission();
 }
 
-// Create hospitals based on information in a file
-void ABM::create_hospitals(const std::string fname)
+// Store hospitals, one per record
+void ABM::add_hospitals(const place_range& records)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One hospital per line
-	for (auto& hospital : file){
+	for (const auto& hospital : records){
 		// Make a map of transmission rates for different 
 		// hospital-related categories
 		std::map<const std::string, const double> betas = 
-			{{"hospital employee", infection_parameters.at("healthcare employees transmission rate")}, 
-			 {"hospital non-COVID patient", infection_parameters.at("hospital patients transmission rate")},
-			 {"hospital testee", infection_parameters.at("hospital tested transmission rate")},
-			 {"hospitalized", infection_parameters.at("hospitalized transmission rate")}, 
-			 {"hospitalized ICU", infection_parameters.at("hospitalized ICU transmission rate")}};
-		Hospital temp_hospital(std::stoi(hospital.at(0)), 
-			std::stod(hospital.at(1)), std::stod(hospital.at(2)),
-			infection_parameters.at("severity correction"), betas);
+			{{"hospital employee", infection_params.healthcare_employees_transmission_rate}, 
+			 {"hospital non-COVID patient", infection_params.hospital_patients_transmission_rate},
+			 {"hospital testee", infection_params.hospital_tested_transmission_rate},
+			 {"hospitalized", infection_params.hospitalized_transmission_rate}, 
+			 {"hospitalized ICU", infection_params.hospitalized_icu_transmission_rate}};
+		Hospital temp_hospital(hospital.ID, hospital.x, hospital.y,
+			infection_params.severity_correction, betas);
 		// Store 
 		hospitals.push_back(temp_hospital);
 	}
 }
 
-// Generate and store carpool objects
-void ABM::create_carpools(const std::string fname)
+// Store carpools, one per record
+void ABM::add_carpools(const place_range& records)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One carpool per line
-	for (auto& cpl : file) {
+	for (const auto& cpl : records) {
 		// Extract properties, add infection parameters
-		Transit temp_transit(std::stoi(cpl.at(0)), 
-			infection_parameters.at("carpool transmission rate"),
-			infection_parameters.at("severity correction"),  cpl.at(1));
+		Transit temp_transit(cpl.ID, 
+			infection_params.carpool_transmission_rate,
+			infection_params.severity_correction, PopulationImage::text(cpl.type));
 		// Store 
 		carpools.push_back(temp_transit);
 	}
 }
 
-// Generate and store public transit objects
-void ABM::create_public_transit(const std::string fname)
+// Store public transit, one per record
+void ABM::add_public_transit(const place_range& records)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
 	// Transmission rate based on current capacity
-	double beta_T = infection_parameters.at("public transit beta0") 
-					+ infection_parameters.at("public transit beta full")
-						*infection_parameters.at("public transit current capacity");
-	// One public transit per line
-	for (auto& pbt : file) {
+	double beta_T = infection_params.public_transit_beta0 
+					+ infection_params.public_transit_beta_full
+						*infection_params.public_transit_current_capacity;
+	for (const auto& pbt : records) {
 		// Extract properties, add infection parameters
-		Transit temp_transit(std::stoi(pbt.at(0)),
-			beta_T, infection_parameters.at("severity correction"),  pbt.at(1));
+		Transit temp_transit(pbt.ID, beta_T, 
+			infection_params.severity_correction, PopulationImage::text(pbt.type));
 		// Store 
 		public_transit.push_back(temp_transit);
 	}
 }
 
-// Generate and store leisure locations/weekend objects
-void ABM::create_leisure_locations(const std::string fname)
+// Store leisure locations, one per record
+void ABM::add_leisure_locations(const place_range& records)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
-	// One leisure location per line
-	for (auto& lsr : file) {
+	for (const auto& lsr : records) {
 		// Extract properties, add infection parameters
-		Leisure temp_lsr(std::stoi(lsr.at(0)), 
-			std::stod(lsr.at(1)), std::stod(lsr.at(2)),
-			infection_parameters.at("severity correction"), 
-			infection_parameters.at("leisure locations transmission rate"),
-			lsr.at(3));
+		Leisure temp_lsr(lsr.ID, lsr.x, lsr.y,
+			infection_params.severity_correction, 
+			infection_params.leisure_locations_transmission_rate,
+			PopulationImage::text(lsr.type));
 		// Store 
 		leisure_locations.push_back(temp_lsr);
 	}
@@ -304,7 +385,7 @@ void ABM::create_leisure_locations(const std::string fname)
 // Initialize Mobility and assignment of leisure locations
 void ABM::initialize_mobility()
 {
-	mobility.set_probability_parameters(infection_parameters.at("leisure - dr0"), infection_parameters.at("leisure - beta"), infection_parameters.at("leisure - kappa"));
+	mobility.set_probability_parameters(infection_params.leisure_dr0, infection_params.leisure_beta, infection_params.leisure_kappa);
 	mobility.construct_public_probabilities(households, leisure_locations);
 }
 
@@ -312,28 +393,68 @@ void ABM::initialize_mobility()
 void ABM::create_agents(const std::string fname, const int ninf0)
 {
 	load_agents(fname, ninf0);
+	attach_agents_to_store();
 	register_agents();
 }
 
+// Columnar copy of the agents, updated by the agents from then on
+void ABM::attach_agents_to_store()
+{
+	agent_store.resize(agents.size());
+	for (size_t i = 0; i < agents.size(); ++i){
+		agents[i].attach_to_store(agent_store.row(i));
+	}
+
+	// Slots of agents in places, by the ID columns 
+	// that link an agent to each type of place
+	const unsigned home = 1u << AgentStore::household;
+	const unsigned work = 1u << AgentStore::work;
+	link_to_store(households, home | (1u << AgentStore::leisure));
+	link_to_store(retirement_homes, home | work);
+	link_to_store(schools, (1u << AgentStore::school) | work);
+	link_to_store(workplaces, work);
+	link_to_store(hospitals, (1u << AgentStore::hospital) | work);
+	link_to_store(carpools, 1u << AgentStore::carpool);
+	link_to_store(public_transit, 1u << AgentStore::public_transit);
+	link_to_store(leisure_locations, 1u << AgentStore::leisure);
+}
+
+// True if each agent updates its own row of the store
+bool ABM::agents_attached()
+{
+	if (agent_store.size() != agents.size()){
+		return false;
+	}
+	for (size_t i = 0; i < agents.size(); ++i){
+		if (!agents[i].attached_to(agent_store.row(i))){
+			return false;
+		}
+	}
+	return true;
+}
+
 // Retrieve agent information from a file
 void ABM::load_agents(const std::string fname, const int ninf0)
 {
-	// Read the whole file
-	std::vector<std::vector<std::string>> file = read_object(fname);
+	add_agents(PopulationImage::agent_records(fname), ninf0);
+}
 
+// Create agents, one per record
+void ABM::add_agents(const PopulationImage::Records<PopulationImage::AgentRecord>& records, const int ninf0)
+{
 	// Flu settings
 	// Set fraction of flu (non-covid symptomatic)
-	flu.set_fraction(infection_parameters.at("fraction with flu"));
-	flu.set_fraction_tested_false_positive(infection_parameters.at("fraction false positive"));
+	flu.set_fraction(infection_params.fraction_with_flu);
+	flu.set_fraction_tested_false_positive(infection_params.fraction_false_positive);
 	// Time interval for testing
-	flu.set_testing_duration(infection_parameters.at("flu testing duration"));
+	flu.set_testing_duration(infection_params.flu_testing_duration);
 
 	// For custom generation of initially infected
 	std::vector<int> infected_IDs(ninf0);
 	bool not_unique = true;
 	int inf_ID = 0;
 	if (ninf0 != 0){
-		int nIDs = file.size();
+		int nIDs = records.size();
 		// Random choice of IDs
 		for (int i=0; i<ninf0; ++i){
 			not_unique = true;
@@ -349,8 +470,8 @@ void ABM::load_agents(const std::string fname, const int ninf0)
 	// Counter for agent IDs
 	int agent_ID = 1;
 	
-	// One agent per line, with properties as defined in the line
-	for (auto agent : file){
+	// One agent per record, with properties as defined in the record
+	for (const auto& agent : records){
 		// Agent status
 		bool student = false, works = false, livesRH = false, worksRH = false,  
 			 worksSch = false, patient = false, hospital_staff = false,
@@ -361,22 +482,22 @@ void ABM::load_agents(const std::string fname, const int ninf0)
 				
 		// Household ID only if not hospitalized with condition
 		// different than COVID-19
-		if (std::stoi(agent.at(6)) == 1){
+		if (agent.hospital_non_covid_patient == 1){
 			patient = true;
 			house_ID = 0;
 		}else{
-			house_ID = std::stoi(agent.at(5));
+			house_ID = agent.household_ID;
 		}
 
 		// No school or work if patient with condition other than COVID
-		if (std::stoi(agent.at(12)) == 1 && !patient){
+		if (agent.hospital_employee == 1 && !patient){
 			hospital_staff = true;
 		}
-		if (std::stoi(agent.at(0)) == 1 && !patient){
+		if (agent.student == 1 && !patient){
 			student = true;
 		}
 	   	// No work flag if a hospital employee	
-		if (std::stoi(agent.at(1)) == 1 && !(patient || hospital_staff)){
+		if (agent.works == 1 && !(patient || hospital_staff)){
 			works = true; 
 		}
 			
@@ -390,59 +511,58 @@ void ABM::load_agents(const std::string fname, const int ninf0)
 				n_infected_tot++;
 			}
 		} else {
-			if (std::stoi(agent.at(14)) == 1){
+			if (agent.infected == 1){
 				infected = true;
 				n_infected_tot++;
 			}
 		}
 
 		// Retirement home resident
-		if (std::stoi(agent.at(8)) == 1){
+		if (agent.retirement_home_resident == 1){
 			 livesRH = true;
 		}
 		// Retirement home or school employee
-		if (std::stoi(agent.at(9)) == 1){
+		if (agent.retirement_home_employee == 1){
 			 worksRH = true;
 		}
-		if (std::stoi(agent.at(10)) == 1){
+		if (agent.school_employee == 1){
 			 worksSch = true;
 		}
 
 		// Select correct work ID for special employment types
 		// Hospital ID is set separately, but for consistency
 		if (worksRH || worksSch || hospital_staff) {
-			workID = std::stoi(agent.at(18));
+			workID = agent.special_work_ID;
 		} else if (works) {
-			workID = std::stoi(agent.at(11));
+			workID = agent.work_ID;
 		}
 
 		// Transit information
-		if (std::stoi(agent.at(15)) == 1) {
+		if (agent.works_from_home == 1) {
 			works_from_home = true;
-			work_travel_mode = agent.at(17);
+			work_travel_mode = PopulationImage::text(agent.work_travel_mode);
 		} else {
 			if (!(works || hospital_staff)) {
 				work_travel_mode = "None";
 			} else {
-				work_travel_mode = agent.at(17);
+				work_travel_mode = PopulationImage::text(agent.work_travel_mode);
 				if (work_travel_mode == "carpool") {
-					cpID = std::stoi(agent.at(19));
+					cpID = agent.carpool_ID;
 				}
 				if (work_travel_mode == "public") {
-					ptID = std::stoi(agent.at(20));
+					ptID = agent.public_transit_ID;
 				}
-				work_travel_time = std::stod(agent.at(16));
+				work_travel_time = agent.work_travel_time;
 			}
 		}
-		Agent temp_agent(student, works, std::stoi(agent.at(2)), 
-			std::stod(agent.at(3)), std::stod(agent.at(4)), house_ID,
-			patient, std::stoi(agent.at(7)), livesRH, worksRH,
-		    worksSch, workID, hospital_staff, std::stoi(agent.at(13)), 
+		Agent temp_agent(student, works, agent.age, agent.x, agent.y, house_ID,
+			patient, agent.school_ID, livesRH, worksRH,
+		    worksSch, workID, hospital_staff, agent.hospital_ID, 
 			infected, work_travel_mode, work_travel_time, cpID, ptID, 
 			works_from_home);
 	
         // Set agent occupation
-        std::string work_type = agent.at(21);
+        const std::string work_type = PopulationImage::text(agent.occupation);
         std::string rate_by_type;
         temp_agent.set_occupation(work_type);
         // And the corresponding transmission rate
@@ -556,10 +676,10 @@ void ABM::initial_exposed(Agent& agent)
 	// Total latency period
 	double latency = infection.latency();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(infection_params.time_from_exposed_to_infectiousness, latency);
 	if (never_sy){
 		// Set to total latency + infectiousness duration
-		double rec_time = infection_parameters.at("recovery time");
+		double rec_time = infection_params.recovery_time;
 		agent.set_latency_duration(latency + rec_time);
 		agent.set_latency_end_time(time);
 		agent.set_infectiousness_start_time(time, dt_ninf);
@@ -578,64 +698,42 @@ void ABM::initial_exposed(Agent& agent)
 void ABM::initialize_vac_and_reopening()
 {
 	// Flu and initial vaccination
-	n_vaccinated = static_cast<int>(infection_parameters.at("initially vaccinated"));
+	n_vaccinated = static_cast<int>(infection_params.initially_vaccinated);
 	random_vaccines = true;
 	// To invoke flu, testing, and vaccinations
-	infection_parameters.at("start testing") = 0.0;
+	infection_params.start_testing = 0.0;
+	infection_parameters.at("start testing") = infection_params.start_testing;
 	start_testing_flu_and_vaccination();
 	
 	// Schools - constant reduction
-	double sch_rate_students =  infection_parameters.at("school transmission rate")
-									*infection_parameters.at("school transmission reduction");	
-	double sch_rate_emp =  infection_parameters.at("school employee transmission rate")
-									*infection_parameters.at("school transmission reduction");	
-	for (auto& school : schools){
-		school.change_transmission_rate(sch_rate_students);
-		school.change_employee_transmission_rate(sch_rate_emp);
-	}
+	place_policy.schools = infection_params.school_transmission_reduction;
 
 	// Workplaces - phase 4, constant
-	double work_tr_rate = infection_parameters.at("fraction of phase 4 businesses");
-	for (auto& workplace : workplaces) {
-		if (workplace.outside_town()) {
-			workplace.adjust_outside_lambda(infection_parameters.at("fraction of phase 4 businesses"));
-		} else {
-			workplace.change_transmission_rate(workplace.get_transmission_rate()*work_tr_rate);
-		}
-	}
+	const double fraction = infection_params.fraction_of_phase_4_businesses;
+	place_policy.workplaces = fraction;
+	place_policy.outside_workplaces = fraction;
 	
 	// Carpools - reduction proportional to workplaces
-	double new_tr_rate = infection_parameters.at("carpool transmission rate")
-							*infection_parameters.at("fraction of phase 4 businesses");
-	for (auto& car  : carpools) {
-		car.change_transmission_rate(new_tr_rate);
-	}
+	place_policy.carpools = fraction;
 
 	// Public transit
- 	new_tr_rate = infection_parameters.at("public transit beta0") 
-				+ infection_parameters.at("public transit beta full")
-				*infection_parameters.at("public transit current capacity")
-				*infection_parameters.at("fraction of phase 4 businesses");
-	for (auto& pt  : public_transit) {
-		pt.change_transmission_rate(new_tr_rate);
-	}
+	place_policy.public_transit = public_transit_multiplier(fraction);
 	
-	// Public leisure locations
- 	new_tr_rate = infection_parameters.at("leisure locations transmission rate") * 
-			infection_parameters.at("fraction of phase 4 businesses");
-	ini_beta_les = new_tr_rate;
-	del_beta_les = infection_parameters.at("leisure locations transmission rate") - new_tr_rate;
-	ini_frac_les = infection_parameters.at("leisure - fraction - initial");
-	del_frac_les = infection_parameters.at("leisure - fraction - final")
-					-infection_parameters.at("leisure - fraction - initial");
-	infection_parameters.at("leisure - fraction") = ini_frac_les;
+	// Public leisure locations - outside the town scale with 
+	// the leisure transmission rate, then all reopen gradually
 	for (auto& leisure_location : leisure_locations) {
 		if (leisure_location.outside_town()) {
-			leisure_location.set_outside_lambda(ini_beta_les*infection_parameters.at("fraction estimated infected"));
-		} else {
-			leisure_location.change_transmission_rate(ini_beta_les);
+			leisure_location.set_outside_lambda(infection_params.leisure_locations_transmission_rate
+								*infection_params.required(&InfectionParameters::fraction_estimated_infected));
 		}
 	} 
+	place_policy.leisure_locations = fraction;
+	place_policy.outside_leisure_locations = fraction;
+	ini_frac_les = infection_params.leisure_fraction_initial;
+	del_frac_les = infection_params.leisure_fraction_final
+					-infection_params.leisure_fraction_initial;
+	infection_params.leisure_fraction = ini_frac_les;
+	infection_parameters.at("leisure - fraction") = infection_params.leisure_fraction;
 }
 
 // Start with N_inf agents that have COVID-19 in various stages
@@ -694,9 +792,9 @@ void ABM::process_initial_asymptomatic(Agent& agent)
 	// Total latency period offset with a random number from 0 to 1
 	double latency = infection.latency()*infection.get_uniform();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(infection_params.time_from_exposed_to_infectiousness, latency);
 	// Set to total latency + infectiousness duration, also offset
-	double rec_time = infection_parameters.at("recovery time")*infection.get_uniform();
+	double rec_time = infection_params.recovery_time*infection.get_uniform();
 	agent.set_latency_duration(latency + rec_time);
 	agent.set_latency_end_time(time);
 	agent.set_infectiousness_start_time(time, dt_ninf);
@@ -711,12 +809,12 @@ void ABM::process_initial_asymptomatic(Agent& agent)
 	if (testing.started(time)) {
 		if (agent.hospital_employee()) {
 			hsp_employee_transitions.set_testing_status(agent, infection, time, schools, 
-							hospitals, infection_parameters, testing);
+							hospitals, infection_params, testing);
 		} else if (agent.hospital_non_covid_patient()) {
-			hsp_patient_transitions.set_testing_status(agent, infection, time, hospitals, infection_parameters, testing);
+			hsp_patient_transitions.set_testing_status(agent, infection, time, hospitals, infection_params, testing);
 		} else {
     		regular_transitions.set_testing_status(agent, infection, time, schools,
-        		workplaces, hospitals, retirement_homes, carpools, public_transit, infection_parameters, testing);
+        		workplaces, hospitals, retirement_homes, carpools, public_transit, infection_params, testing);
 		}
 
 		// If tested, randomly choose if pre-test, being tested now, or waiting for results
@@ -783,12 +881,12 @@ void ABM::process_initial_symptomatic(Agent& agent)
 		} else {
 			agent.set_dying(false);
 			agent.set_recovering(true);			
-			agent.set_recovery_duration(infection_parameters.at("recovery time")*infection.get_uniform());
+			agent.set_recovery_duration(infection_params.recovery_time*infection.get_uniform());
 			agent.set_recovery_time(time);		
 		}
 		if (testing.started(time)) {
 			hsp_employee_transitions.set_testing_status(agent, infection, time, schools,
-                        hospitals, infection_parameters, testing);
+                        hospitals, infection_params, testing);
 		}
 	} else if (agent.hospital_non_covid_patient()) {
 		// Removal settings
@@ -801,16 +899,16 @@ void ABM::process_initial_symptomatic(Agent& agent)
 		} else {
 			states_manager.set_recovering_symptomatic(agent);			
 			// This may change if treatment is ICU
-			agent.set_recovery_duration(infection_parameters.at("recovery time"));
+			agent.set_recovery_duration(infection_params.recovery_time);
 			agent.set_recovery_time(time);		
 		}
 		if (testing.started(time)) {
-			hsp_patient_transitions.set_testing_status(agent, infection, time, hospitals, infection_parameters, testing);
+			hsp_patient_transitions.set_testing_status(agent, infection, time, hospitals, infection_params, testing);
 		}
 	} else {
     	regular_transitions.untested_sy_setup(agent, infection, time, dt, households, 
                 schools, workplaces, hospitals, retirement_homes,
-                carpools, public_transit, infection_parameters, testing);
+                carpools, public_transit, infection_params, testing);
 	}
 
 	// If tested, randomly choose if pre-test, being tested now, or waiting for results
@@ -862,9 +960,10 @@ void ABM::process_initial_symptomatic(Agent& agent)
 void ABM::vaccinate_random()
 {
 	std::vector<int> can_be_vaccinated;
-	// Select qualifying agents
+	// Select qualifying agents of this process
 	for (auto& agent : agents) {
-		if (!agent.symptomatic_non_covid() && !agent.infected()
+		if (local_agent(agent.get_ID() - 1)
+				&& !agent.symptomatic_non_covid() && !agent.infected()
 				&& !agent.exposed() && !agent.symptomatic() 
 				&& !agent.removed() && !agent.vaccinated()) {
 			can_be_vaccinated.push_back(agent.get_ID());
@@ -872,17 +971,19 @@ void ABM::vaccinate_random()
 	}
 	// Shuffle randomly
 	infection.vector_shuffle(can_be_vaccinated);
-	// Remove first n_vaccinated
-	if (n_vaccinated > can_be_vaccinated.size()) {
+	// Remove first n_vaccinated, or its part if split between processes
+	int n_vac = local_share(n_vaccinated);
+	if (n_vac > can_be_vaccinated.size()) {
 		std::cerr << "Requested number of agents to vaccinate larger than number of available agents" 
 				  << std::endl;
 		if (can_be_vaccinated.size() > 0) {
-			n_vaccinated = can_be_vaccinated.size();
+			n_vac = can_be_vaccinated.size();
+			n_vaccinated = n_vac;
 		} else {
 			return;
 		}
 	}
-	for (int i=0; i<n_vaccinated; ++i) {
+	for (int i=0; i<n_vac; ++i) {
 		agents.at(can_be_vaccinated.at(i)-1).set_vaccinated(true);
 	}	
 }
@@ -908,7 +1009,7 @@ void ABM::implement_group_vaccination(type_getter atype)
 {
 	int v_final = 0;
 	for (auto& agent : agents){
-		if ((agent.*atype)() == true && !agent.infected()
+		if (local_agent(agent.get_ID() - 1) && (agent.*atype)() == true && !agent.infected()
 				&& !agent.exposed() && !agent.symptomatic()
 				&& !agent.removed()){
 			agent.set_vaccinated(true);
@@ -928,24 +1029,48 @@ void ABM::implement_group_vaccination(type_getter atype)
 // Transmit infection 
 void ABM::transmit_infection() 
 {
+	profiler.begin_step(time);
+	start_phase(StepProfiler::testing_and_events);
 	testing.check_switch_time(time);	
 	check_events(schools, workplaces);
+	stop_phase();
+	start_phase(StepProfiler::leisure);
 	distribute_leisure();
+	stop_phase();
+	start_phase(StepProfiler::contributions);
 	compute_place_contributions();	
+	stop_phase();
+	start_phase(StepProfiler::transitions);
 	compute_state_transitions();
+	stop_phase();
+	start_phase(StepProfiler::reset);
 	reset_contributions();
+	stop_phase();
 	advance_in_time();	
 }
 
 // Perfect testing, vaccination, and reopening 
 void ABM::transmit_ideal_testing_vac_reopening() 
 {
+	profiler.begin_step(time);
+	start_phase(StepProfiler::reopening);
 	reopen_leisure_locations();
+	stop_phase();
+	start_phase(StepProfiler::vaccination);
 	vaccinate();
+	stop_phase();
+	start_phase(StepProfiler::leisure);
 	distribute_leisure();
+	stop_phase();
+	start_phase(StepProfiler::contributions);
 	compute_place_contributions();	
+	stop_phase();
+	start_phase(StepProfiler::transitions);
 	compute_state_transitions();
+	stop_phase();
+	start_phase(StepProfiler::reset);
 	reset_contributions();
+	stop_phase();
 	advance_in_time();	
 }
 
@@ -953,7 +1078,7 @@ void ABM::transmit_ideal_testing_vac_reopening()
 void ABM::vaccinate()
 {
 	// Adjust n_vaccinated 
-	n_vaccinated = static_cast<int>(infection_parameters.at("vaccination rate")*dt);
+	n_vaccinated = static_cast<int>(infection_params.vaccination_rate*dt);
 	// Apply at random to susceptible and unvaccinated agents
 	vaccinate_random();				
 }
@@ -961,22 +1086,18 @@ void ABM::vaccinate()
 // Increase transmission rate and visiting frequency of leisure locations 
 void ABM::reopen_leisure_locations()
 {
-	double new_tr_rate = 0.0;
-	new_tr_rate = ini_beta_les + infection_parameters.at("leisure reopening rate")*del_beta_les*time;
-	new_tr_rate = std::min(new_tr_rate, infection_parameters.at("leisure locations transmission rate"));
-	// Increase transmission rate, or the (highest) normal rate 
-	for (auto& leisure_location : leisure_locations) {
-		if (leisure_location.outside_town()) {
-			leisure_location.set_outside_lambda(new_tr_rate*infection_parameters.at("fraction estimated infected"));
-		} else {
-			leisure_location.change_transmission_rate(new_tr_rate);
-		}
-	}
+	// Increase transmission rate from phase 4 level, up to the normal rate 
+	const double fraction = infection_params.fraction_of_phase_4_businesses;
+	double mult = fraction + infection_params.leisure_reopening_rate*(1.0 - fraction)*time;
+	mult = std::min(mult, 1.0);
+	place_policy.leisure_locations = mult;
+	place_policy.outside_leisure_locations = mult;
 	// Fraction of people going to leisure locations - same approach
 	double new_frac = 0.0;
-	new_frac = ini_frac_les + infection_parameters.at("leisure reopening rate")*del_frac_les*time;
-	new_frac = std::min(new_frac, infection_parameters.at("leisure - fraction - final"));
-	infection_parameters.at("leisure - fraction") = new_frac;
+	new_frac = ini_frac_les + infection_params.leisure_reopening_rate*del_frac_les*time;
+	new_frac = std::min(new_frac, infection_params.leisure_fraction_final);
+	infection_params.leisure_fraction = new_frac;
+	infection_parameters.at("leisure - fraction") = infection_params.leisure_fraction;
 }
 
 // Assign leisure locations for this step
@@ -987,6 +1108,10 @@ void ABM::distribute_leisure()
 	// This includes all agents, passed as well
 	int old_loc_ID = 0;
 	for (auto& agent : agents) {
+		// Agents of other processes are not in the places
+		if (!local_agent(agent.get_ID() - 1)) {
+			continue;
+		}
 		old_loc_ID = agent.get_leisure_ID();
 		if ( old_loc_ID > 0) {
 			if (agent.get_leisure_type() == "household") {
@@ -1007,11 +1132,19 @@ void ABM::distribute_leisure()
 	// whole household - automatically excludes hospital patients (including non-COVID ones)
 	// and retirement home residents; also passed agents, alive and removed participate
 	int loc_ID = 0, house_ID = 0;
+	size_t n_assigned = 0;
+	const bool split = !domain.agent_ranks.empty();
+	domain.leisure_ghosts.clear();
 	for (auto& house : households) {
+		// Households of other processes are assigned there
+		if (split && (domain.owners[PopulationImage::households][house.get_ID() - 1] != domain.rank)) {
+			continue;
+		}
 		// Not having one assigned this step
-		if (infection.get_uniform() > infection_parameters.at("leisure - fraction")) {
+		if (infection.get_uniform() > infection_params.leisure_fraction) {
 			continue;
 		}
+		++n_assigned;
 		
 		// Assign location
 		bool is_public = false;
@@ -1020,6 +1153,9 @@ void ABM::distribute_leisure()
 		loc_ID = mobility.assign_leisure_location(infection, house_ID, is_house, is_public);
 		assert(loc_ID > 0);
 		assert((is_house == true) || (is_public == true));
+		if (split) {
+			add_leisure_ghost(is_house, loc_ID);
+		}
 
 		// Looping through households automatically excludes 
 		// agents that died and that are hospitalized
@@ -1041,196 +1177,103 @@ void ABM::distribute_leisure()
 				continue;
 			}	
 			// Register each agent in the household
+			// ID first, it links the agent to its slot in the place
 			if (is_house) {
-				households.at(loc_ID-1).add_agent(aID);
 				agents.at(aID-1).set_leisure_type("household");
 				agents.at(aID-1).set_leisure_ID(loc_ID);
+				households.at(loc_ID-1).add_agent(aID);
 			} else if (is_public) {
+				agents.at(aID-1).set_leisure_type("public");
+				agents.at(aID-1).set_leisure_ID(loc_ID);
    		        // Only add if leisure location is within town
    		        if(!leisure_locations.at(loc_ID-1).outside_town()){
    		            leisure_locations.at(loc_ID-1).add_agent(aID);
    		        }
-				agents.at(aID-1).set_leisure_type("public");
-				agents.at(aID-1).set_leisure_ID(loc_ID);
 			}
 		}
 	}
+	// Each ghost is exchanged once
+	std::sort(domain.leisure_ghosts.begin(), domain.leisure_ghosts.end());
+	domain.leisure_ghosts.erase(std::unique(domain.leisure_ghosts.begin(), 
+						domain.leisure_ghosts.end()), domain.leisure_ghosts.end());
+	// All agents are checked for old assignments
+	profiler.count(StepProfiler::agents_visited, agents.size());
+	profiler.count(StepProfiler::places_touched, n_assigned);
 }
 
 // Verify if anything that requires parameter changes happens at this step 
-void ABM::check_events(std::vector<School>& schools, std::vector<Workplace>& workplaces)
+void ABM::check_events(std::vector<School>&, std::vector<Workplace>& workplaces)
 {
 	double tol = 1e-3;
-	double new_tr_rate = 0.0;
 
 	start_testing_flu_and_vaccination();
 
-	// Closures
-	if (equal_floats<double>(time, infection_parameters.at("school closure"), tol)){
-		new_tr_rate = 0.0;
-		for (auto& school : schools){
-			school.change_transmission_rate(new_tr_rate);
-			school.change_employee_transmission_rate(new_tr_rate);
-		}
-	}
-	if (equal_floats<double>(time, infection_parameters.at("lockdown"), tol)){
-		new_tr_rate = infection_parameters.at("workplace transmission rate")*infection_parameters.at("fraction of ld businesses");
-		for (auto& workplace : workplaces){
-			if (workplace.outside_town()) {
-				workplace.adjust_outside_lambda(infection_parameters.at("fraction of ld businesses"));
-			} else {
-				workplace.change_transmission_rate(new_tr_rate);
-				workplace.change_absenteeism_correction(infection_parameters.at("lockdown absenteeism"));
-			}
-		}
-		// Leisure locations
-		new_tr_rate = infection_parameters.at("leisure locations transmission rate")
-				*infection_parameters.at("fraction of ld businesses");
-		for (auto& leisure_location : leisure_locations) {
-			if (leisure_location.outside_town()){
-				leisure_location.adjust_outside_lambda(infection_parameters.at("fraction of ld businesses"));
-			}else{
-				leisure_location.change_transmission_rate(new_tr_rate);
-			}
-		}
-		// Fraction of people going to leisure locations
-		infection_parameters.at("leisure - fraction") *= infection_parameters.at("fraction of ld businesses");
-		// Carpools
-		new_tr_rate = infection_parameters.at("carpool transmission rate")*infection_parameters.at("fraction of ld businesses");
-		for (auto& car  : carpools) {
-			car.change_transmission_rate(new_tr_rate);
-		}
-		// Public transit
-		new_tr_rate = infection_parameters.at("public transit beta0") 
-					+ infection_parameters.at("public transit beta full")
-					*infection_parameters.at("public transit current capacity")*infection_parameters.at("fraction of ld businesses");
-		for (auto& pt  : public_transit) {
-			pt.change_transmission_rate(new_tr_rate);
-		}
-	}
-
-	// Reopening, phase 1
-	if (equal_floats<double>(time, infection_parameters.at("reopening phase 1"), tol)){
-		new_tr_rate = infection_parameters.at("workplace transmission rate") * 
-				infection_parameters.at("fraction of phase 1 businesses");
-		for (auto& workplace : workplaces){
-			if (workplace.outside_town()) {
-				workplace.adjust_outside_lambda(infection_parameters.at("fraction of phase 1 businesses")
-								/infection_parameters.at("fraction of ld businesses"));	
-			} else {
-				workplace.change_transmission_rate(new_tr_rate);
-				workplace.change_absenteeism_correction(infection_parameters.at("lockdown absenteeism"));
-			}
-		}
-		// Leisure locations
-		new_tr_rate = infection_parameters.at("leisure locations transmission rate") * 
-				infection_parameters.at("fraction of phase 1 businesses");
-		for (auto& leisure_location : leisure_locations) {
-			if (leisure_location.outside_town()) {
-				leisure_location.adjust_outside_lambda(infection_parameters.at("fraction of phase 1 businesses")
-								/infection_parameters.at("fraction of ld businesses"));	
-			} else {
-				leisure_location.change_transmission_rate(new_tr_rate);
-			}
-		}
-		// Fraction of people going to leisure locations
-		infection_parameters.at("leisure - fraction") 
-				*= (infection_parameters.at("fraction of phase 1 businesses")/infection_parameters.at("fraction of ld businesses"));
-		// Carpools
-		new_tr_rate = infection_parameters.at("carpool transmission rate")*infection_parameters.at("fraction of phase 1 businesses");
-		for (auto& car  : carpools) {
-			car.change_transmission_rate(new_tr_rate);
-		}
-		// Public transit
- 		new_tr_rate = infection_parameters.at("public transit beta0") 
-					+ infection_parameters.at("public transit beta full")
-					*infection_parameters.at("public transit current capacity")*infection_parameters.at("fraction of phase 1 businesses");
-		for (auto& pt  : public_transit) {
-			pt.change_transmission_rate(new_tr_rate);
-		}
-	}
-
-	// Reopening, phase 2
-	if (equal_floats<double>(time, infection_parameters.at("reopening phase 2"), tol)){
-		new_tr_rate = infection_parameters.at("workplace transmission rate") * 
-				infection_parameters.at("fraction of phase 2 businesses");
-		for (auto& workplace : workplaces){
-			if (workplace.outside_town()) {
-				workplace.adjust_outside_lambda(infection_parameters.at("fraction of phase 2 businesses")
-								/infection_parameters.at("fraction of phase 1 businesses"));	
-			} else {
-				workplace.change_transmission_rate(new_tr_rate);
-				workplace.change_absenteeism_correction(infection_parameters.at("lockdown absenteeism"));
-			}
-		}
-		// Leisure locations
-		new_tr_rate = infection_parameters.at("leisure locations transmission rate") * 
-				infection_parameters.at("fraction of phase 2 businesses");
-		for (auto& leisure_location : leisure_locations) {
-			if (leisure_location.outside_town()) {
-				leisure_location.adjust_outside_lambda(infection_parameters.at("fraction of phase 2 businesses")
-								/infection_parameters.at("fraction of phase 1 businesses"));	
-			} else {
-				leisure_location.change_transmission_rate(new_tr_rate);
+	// Closures and reopenings due at this time
+	policy_schedule.apply_due(time, tol, 
+		[this, &workplaces](const PolicySchedule::Event& event){ 
+			apply_policy_event(event, workplaces); 
+		});
+}
+
+// Apply a single closure or reopening
+void ABM::apply_policy_event(const PolicySchedule::Event& event, std::vector<Workplace>& workplaces)
+{
+	const double value = event.value;
+	if (event.target == "businesses") {
+		// Only a fraction of businesses open - all places 
+		// related to work and leisure; workplaces in town 
+		// transmit at the generic workplace rate, not by occupation
+		for (auto& workplace : workplaces) {
+			if (!workplace.outside_town()) {
+				workplace.change_transmission_rate(infection_params.workplace_transmission_rate);
 			}
 		}
+		place_policy.workplaces = value;
+		place_policy.outside_workplaces = value;
+		place_policy.leisure_locations = value;
+		place_policy.outside_leisure_locations = value;
+		place_policy.carpools = value;
+		place_policy.public_transit = public_transit_multiplier(value);
 		// Fraction of people going to leisure locations
-		infection_parameters.at("leisure - fraction") 
-				*= (infection_parameters.at("fraction of phase 2 businesses")/infection_parameters.at("fraction of phase 1 businesses"));
-		// Carpools
-		new_tr_rate = infection_parameters.at("carpool transmission rate")*infection_parameters.at("fraction of phase 2 businesses");
-		for (auto& car  : carpools) {
-			car.change_transmission_rate(new_tr_rate);
-		}
-		// Public transit 
-		new_tr_rate = infection_parameters.at("public transit beta0") 
-					+ infection_parameters.at("public transit beta full")
-					*infection_parameters.at("public transit current capacity")*infection_parameters.at("fraction of phase 2 businesses");
-		for (auto& pt  : public_transit) {
-			pt.change_transmission_rate(new_tr_rate);
-		}
-	}
-
-	// Reopening, phase 3
-	if (equal_floats<double>(time, infection_parameters.at("reopening phase 3"), tol)){
-		new_tr_rate = infection_parameters.at("workplace transmission rate") * 
-				infection_parameters.at("fraction of phase 3 businesses");
-		for (auto& workplace : workplaces){
-			if (workplace.outside_town()) {
-				workplace.adjust_outside_lambda(infection_parameters.at("fraction of phase 3 businesses")
-								/infection_parameters.at("fraction of phase 2 businesses"));	
-			} else {
-				workplace.change_transmission_rate(new_tr_rate);
-				workplace.change_absenteeism_correction(infection_parameters.at("lockdown absenteeism"));
+		infection_params.leisure_fraction = open_leisure_fraction*value;
+		infection_parameters.at("leisure - fraction") = infection_params.leisure_fraction;
+	} else if (event.target == "workplace absenteeism") {
+		// Enters contributions of each symptomatic agent
+		for (auto& workplace : workplaces) {
+			if (!workplace.outside_town()) {
+				workplace.change_absenteeism_correction(value);
 			}
 		}
-		// Leisure locations
-		new_tr_rate = infection_parameters.at("leisure locations transmission rate") * 
-				infection_parameters.at("fraction of phase 3 businesses");
-		for (auto& leisure_location : leisure_locations) {
-			if (leisure_location.outside_town()) {
-				leisure_location.adjust_outside_lambda(infection_parameters.at("fraction of phase 3 businesses")
-								/infection_parameters.at("fraction of phase 2 businesses"));	
-			} else {
-				leisure_location.change_transmission_rate(new_tr_rate);
-			}
-		}
-		// Fraction of people going to leisure locations
-		infection_parameters.at("leisure - fraction") 
-				*= (infection_parameters.at("fraction of phase 3 businesses")/infection_parameters.at("fraction of phase 2 businesses"));
-		// Carpools
-		new_tr_rate = infection_parameters.at("carpool transmission rate")*infection_parameters.at("fraction of phase 3 businesses");
-		for (auto& car  : carpools) {
-			car.change_transmission_rate(new_tr_rate);
-		}
-		// Public transit 
-		new_tr_rate = infection_parameters.at("public transit beta0") 
-					+ infection_parameters.at("public transit beta full")
-					*infection_parameters.at("public transit current capacity")*infection_parameters.at("fraction of phase 3 businesses");
-		for (auto& pt  : public_transit) {
-			pt.change_transmission_rate(new_tr_rate);
-		}
+	} else if (event.target == "schools") {
+		place_policy.schools = value;
+	} else if (event.target == "workplaces") {
+		place_policy.workplaces = value;
+	} else if (event.target == "outside workplaces") {
+		place_policy.outside_workplaces = value;
+	} else if (event.target == "leisure locations") {
+		place_policy.leisure_locations = value;
+	} else if (event.target == "outside leisure locations") {
+		place_policy.outside_leisure_locations = value;
+	} else if (event.target == "carpools") {
+		place_policy.carpools = value;
+	} else if (event.target == "public transit") {
+		place_policy.public_transit = value;
+	} else {
+		throw std::invalid_argument("Unsupported policy target: " + event.target);
+	}
+}
+
+// Multiplier of public transit contributions when a fraction of businesses is open
+double ABM::public_transit_multiplier(const double fraction) const
+{
+	// Only the capacity-dependent part of the rate changes
+	const double beta_full = infection_params.public_transit_beta_full
+								*infection_params.public_transit_current_capacity;
+	const double beta_T = infection_params.public_transit_beta0 + beta_full;
+	if (beta_T == 0.0) {
+		return 1.0;
 	}
+	return (infection_params.public_transit_beta0 + beta_full*fraction)/beta_T;
 }
 
 // Update transmission dynamics in wokplaces outside of the town
@@ -1238,7 +1281,7 @@ void ABM::set_outside_workplace_transmission()
 {
 	for (auto& workplace : workplaces) {
 		if (workplace.outside_town()) {
-			workplace.set_outside_lambda(infection_parameters.at("fraction estimated infected"));
+			workplace.set_outside_lambda(infection_params.required(&InfectionParameters::fraction_estimated_infected));
 		}
 	}
 }
@@ -1248,7 +1291,23 @@ void ABM::set_outside_leisure_transmission()
 {
 	for (auto& leisure_location : leisure_locations) {
 		if (leisure_location.outside_town()) {
-			leisure_location.set_outside_lambda(infection_parameters.at("out-of-town leisure transmission"));
+			leisure_location.set_outside_lambda(infection_params.required(&InfectionParameters::out_of_town_leisure_transmission));
+		}
+	}
+}
+
+// Set transmission in places outside of the town from a prevalence
+void ABM::set_outside_prevalence(const double prevalence)
+{
+	for (auto& workplace : workplaces) {
+		if (workplace.outside_town()) {
+			workplace.set_outside_lambda(prevalence);
+		}
+	}
+	for (auto& leisure_location : leisure_locations) {
+		if (leisure_location.outside_town()) {
+			leisure_location.set_outside_lambda(infection_params.leisure_locations_transmission_rate
+								*prevalence);
 		}
 	}
 }
@@ -1256,59 +1315,480 @@ void ABM::set_outside_leisure_transmission()
 // Count contributions of all infectious agents in each place
 void ABM::compute_place_contributions()
 {
-	for (const auto& agent : agents){
+	// Agents added or removed after the store was built
+	assert(agents_attached());
+	if (n_contribution_threads > 1){
+		// Each thread stores its contributions, these are 
+		// then added to places in the order of agents
+		contribution_buffers.resize(n_contribution_threads);
+		std::vector<size_t> n_visited(n_contribution_threads, 0);
+		parallel_chunks(agent_store.n_blocks(), n_contribution_threads, 
+			[this, &n_visited](int chunk, size_t first, size_t last){
+				std::vector<DeferredContribution>& buffer = contribution_buffers.at(chunk);
+				buffer.clear();
+				Contributions contr;
+				contr.set_deferred_buffer(&buffer);
+				size_t visited = 0;
+				agent_store.for_each_in(contributing_compartments(), inactive_compartments(), 
+					first, last, [this, &contr, &visited](size_t i){
+						if (adds_contributions(agent_store.view(i))){
+							compute_agent_contributions(agents[i], contr);
+							++visited;
+						}
+					});
+				n_visited.at(chunk) = visited;
+			});
+		for (const auto& buffer : contribution_buffers){
+			contributions.apply_deferred(buffer);
+		}
+		for (const auto& visited : n_visited){
+			profiler.count(StepProfiler::agents_visited, visited);
+		}
+	} else {
+		// Only the infected and the susceptible tested in hospitals
+		size_t visited = 0;
+		agent_store.for_each_in(contributing_compartments(), inactive_compartments(), 
+			[this, &visited](size_t i){
+				if (adds_contributions(agent_store.view(i))){
+					compute_agent_contributions(agents[i], contributions);
+					++visited;
+				}
+			});
+		profiler.count(StepProfiler::agents_visited, visited);
+	}
+	if (domain.ranks != nullptr){
+		exchange_place_sums();
+	}
+	contributions.total_place_contributions(households, schools, 
+											workplaces, hospitals, retirement_homes,
+											carpools, public_transit, leisure_locations,
+											place_policy);
+	// Places with infected are also the places touched in the profile
+	if (place_driven_susceptibles || profiler.enabled()){
+		collect_hot_places();
+		profiler.count(StepProfiler::places_touched, hot_places.count);
+	}
+}
 
-		// Removed and vaccinated don't contribute
-		if (agent.removed() == true || agent.vaccinated() == true){
+// Split the model between local processes
+void ABM::set_domain(LocalRanks& ranks)
+{
+	assert(agents_attached());
+	const int n_ranks = ranks.size();
+	const int rank = ranks.rank();
+	// Residents of each home, households then retirement homes; non-COVID 
+	// patients go with their home since they can be moved there
+	const size_t n_houses = households.size();
+	std::vector<int> home_of_agent(agents.size(), -1);
+	std::vector<long> residents(n_houses + retirement_homes.size(), 0);
+	for (size_t i = 0; i < agents.size(); ++i){
+		const Agent& agent = agents[i];
+		if (agent.get_household_ID() <= 0){
 			continue;
 		}
+		const int home = agent.retirement_home_resident() ? 
+							n_houses + agent.get_household_ID() - 1 
+							: agent.get_household_ID() - 1;
+		home_of_agent[i] = home;
+		++residents.at(home);
+	}
+	// Contiguous ranges of homes with similar numbers of residents
+	long n_total = 0;
+	for (const auto& n : residents){
+		n_total += n;
+	}
+	std::vector<int> home_ranks(residents.size(), 0);
+	long n_before = 0;
+	for (size_t h = 0; h < residents.size(); ++h){
+		home_ranks[h] = n_total > 0 ? static_cast<int>(n_before*n_ranks/n_total) : 0;
+		n_before += residents[h];
+	}
+	std::vector<int>& agent_ranks = domain.agent_ranks;
+	agent_ranks.assign(agents.size(), 0);
+	domain.rank_offsets.assign(n_ranks + 1, 0);
+	for (size_t i = 0; i < agents.size(); ++i){
+		agent_ranks[i] = home_of_agent[i] >= 0 ? home_ranks.at(home_of_agent[i]) 
+							: static_cast<int>(i % n_ranks);
+		++domain.rank_offsets.at(agent_ranks[i] + 1);
+	}
+	std::partial_sum(domain.rank_offsets.begin(), domain.rank_offsets.end(), 
+						domain.rank_offsets.begin());
+	domain.rank = rank;
+
+	// Homes are owned by the rank of their residents, other 
+	// places by the rank of most of their agents or by ID
+	const std::array<size_t, PopulationImage::agents> n_places = {{ households.size(), 
+		retirement_homes.size(), schools.size(), workplaces.size(), hospitals.size(), 
+		carpools.size(), public_transit.size(), leisure_locations.size() }};
+	std::array<std::vector<int>, PopulationImage::agents> n_linked;
+	for (unsigned t = 0; t < n_places.size(); ++t){
+		n_linked[t].assign(n_places[t]*n_ranks, 0);
+	}
+	std::vector<Domain::PlaceKey> keys;
+	for (size_t i = 0; i < agents.size(); ++i){
+		keys.clear();
+		linked_places(agents[i], keys);
+		for (const auto& key : keys){
+			++n_linked[key.type].at(key.index*n_ranks + agent_ranks[i]);
+		}
+	}
+	for (unsigned t = 0; t < n_places.size(); ++t){
+		std::vector<int>& owners = domain.owners[t];
+		owners.assign(n_places[t], 0);
+		for (size_t p = 0; p < n_places[t]; ++p){
+			if (t == PopulationImage::households){
+				owners[p] = home_ranks[p];
+			} else if (t == PopulationImage::retirement_homes){
+				owners[p] = home_ranks[n_houses + p];
+			} else {
+				const auto first = n_linked[t].begin() + p*n_ranks;
+				const auto most = std::max_element(first, first + n_ranks);
+				owners[p] = *most > 0 ? static_cast<int>(most - first) 
+										: static_cast<int>(p % n_ranks);
+			}
+		}
+	}
 
-		// If susceptible and being tested - add to hospital's
-		// total number of people present at this time step
-		if (agent.infected() == false){
-			if ((agent.tested() == true) && 
-				(agent.tested_in_hospital() == true) &&
-				(agent.get_time_of_test() <= time) && 
-		 		(agent.tested_awaiting_test() == true)){
-					hospitals.at(agent.get_hospital_ID() - 1).increase_total_tested();
-			}			
+	// Ghosts of this rank other than in leisure; patients
+	// and testees of any rank can come to any hospital
+	domain.linked_ghosts.clear();
+	for (size_t i = 0; i < agents.size(); ++i){
+		if (agent_ranks[i] != rank){
 			continue;
 		}
+		keys.clear();
+		linked_places(agents[i], keys);
+		for (const auto& key : keys){
+			if (domain.owners[key.type][key.index] != rank){
+				domain.linked_ghosts.push_back(key);
+			}
+		}
+	}
+	for (size_t p = 0; p < hospitals.size(); ++p){
+		if (domain.owners[PopulationImage::hospitals][p] != rank){
+			domain.linked_ghosts.push_back({PopulationImage::hospitals, static_cast<int>(p)});
+		}
+	}
+	std::sort(domain.linked_ghosts.begin(), domain.linked_ghosts.end());
+	domain.linked_ghosts.erase(std::unique(domain.linked_ghosts.begin(), 
+						domain.linked_ghosts.end()), domain.linked_ghosts.end());
+
+	// Places keep only agents of this rank, including 
+	// guests, and the store only counts and visits them
+	keep_local_agents(households);
+	keep_local_agents(retirement_homes);
+	keep_local_agents(schools);
+	keep_local_agents(workplaces);
+	keep_local_agents(hospitals);
+	keep_local_agents(carpools);
+	keep_local_agents(public_transit);
+	keep_local_agents(leisure_locations);
+	const bool scheduled = transition_calendar.size() == agents.size();
+	for (size_t i = 0; i < agents.size(); ++i){
+		if (agent_ranks[i] == rank){
+			continue;
+		}
+		agent_store.set_remote(i);
+		agent_store.unmark(i, AgentStore::due_mark);
+		agent_store.unmark(i, AgentStore::changed_mark);
+		if (scheduled){
+			transition_calendar.cancel(i);
+		}
+	}
+	const std::vector<int> susceptible_IDs = flu.get_susceptible_IDs();
+	for (const auto& aID : susceptible_IDs){
+		if (!local_agent(aID - 1)){
+			flu.remove_susceptible_agent(aID);
+		}
+	}
+	const std::vector<int> flu_IDs = flu.get_flu_IDs();
+	for (const auto& aID : flu_IDs){
+		if (!local_agent(aID - 1)){
+			flu.remove_flu_agent(aID);
+		}
+	}
+
+	// Leisure tables of other households are not needed
+	std::vector<char> own_houses(n_houses, 0);
+	for (size_t h = 0; h < n_houses; ++h){
+		own_houses[h] = (home_ranks[h] == rank);
+	}
+	mobility.keep_tables(own_houses);
+
+	// Places visited in leisure at this step
+	domain.leisure_ghosts.clear();
+	for (size_t i = 0; i < agents.size(); ++i){
+		const int loc_ID = agents[i].get_leisure_ID();
+		if (agent_ranks[i] == rank && loc_ID > 0){
+			add_leisure_ghost(agents[i].get_leisure_type() == "household", loc_ID);
+		}
+	}
+	std::sort(domain.leisure_ghosts.begin(), domain.leisure_ghosts.end());
+	domain.leisure_ghosts.erase(std::unique(domain.leisure_ghosts.begin(), 
+						domain.leisure_ghosts.end()), domain.leisure_ghosts.end());
+
+	// Ranks draw different numbers
+	infection.set_stream(rank, 0, RNG::rank_general);
+	flu.set_rank_stream(rank);
+	domain.messages.assign(n_ranks, std::vector<double>());
+	domain.ranks = &ranks;
+}
+
+// Part of n for this process, in proportion to its agents
+int ABM::local_share(const int n) const
+{
+	if (domain.agent_ranks.empty()){
+		return n;
+	}
+	const long long n_total = domain.rank_offsets.back();
+	if (n_total == 0){
+		return 0;
+	}
+	// Parts of all ranks add up to n
+	const long long first = n*domain.rank_offsets.at(domain.rank)/n_total;
+	const long long last = n*domain.rank_offsets.at(domain.rank + 1)/n_total;
+	return static_cast<int>(last - first);
+}
+
+// Places an agent is linked to other than in leisure, as registered
+void ABM::linked_places(const Agent& agent, std::vector<Domain::PlaceKey>& keys) const
+{
+	auto add = [&keys](const PopulationImage::Table type, const int ID)
+		{ if (ID > 0) { keys.push_back({type, ID - 1}); } };
+	if (!agent.hospital_non_covid_patient()){
+		add(agent.retirement_home_resident() ? PopulationImage::retirement_homes 
+							: PopulationImage::households, agent.get_household_ID());
+	}
+	if (agent.student()){
+		add(PopulationImage::schools, agent.get_school_ID());
+	}
+	if (agent.works() && !agent.works_from_home() && !agent.hospital_employee()){
+		add(agent.retirement_home_employee() ? PopulationImage::retirement_homes 
+				: agent.school_employee() ? PopulationImage::schools 
+				: PopulationImage::workplaces, agent.get_work_ID());
+	}
+	if (agent.hospital_employee() || agent.hospital_non_covid_patient()){
+		add(PopulationImage::hospitals, agent.get_hospital_ID());
+	}
+	if (agent.get_work_travel_mode() == "carpool"){
+		add(PopulationImage::carpools, agent.get_carpool_ID());
+	}
+	if (agent.get_work_travel_mode() == "public"){
+		add(PopulationImage::public_transit, agent.get_public_transit_ID());
+	}
+}
+
+// Place with this key
+Place& ABM::place_at(const Domain::PlaceKey& key)
+{
+	switch (key.type){
+		case PopulationImage::households:
+			return households.at(key.index);
+		case PopulationImage::retirement_homes:
+			return retirement_homes.at(key.index);
+		case PopulationImage::schools:
+			return schools.at(key.index);
+		case PopulationImage::workplaces:
+			return workplaces.at(key.index);
+		case PopulationImage::hospitals:
+			return hospitals.at(key.index);
+		case PopulationImage::carpools:
+			return carpools.at(key.index);
+		case PopulationImage::public_transit:
+			return public_transit.at(key.index);
+		case PopulationImage::leisure_locations:
+			return leisure_locations.at(key.index);
+		default:
+			throw std::invalid_argument("Not a type of place: " + std::to_string(key.type));
+	}
+}
+
+// List a place visited in leisure at this step if it is a ghost
+void ABM::add_leisure_ghost(const bool is_house, const int loc_ID)
+{
+	// Agents are not registered in places outside the town
+	if (!is_house && leisure_locations.at(loc_ID - 1).outside_town()){
+		return;
+	}
+	const Domain::PlaceKey key = {is_house ? PopulationImage::households 
+									: PopulationImage::leisure_locations, loc_ID - 1};
+	if (domain.owners[key.type].at(key.index) != domain.rank){
+		domain.leisure_ghosts.push_back(key);
+	}
+}
+
+// Send sums of ghosts to their owners, replace them with totals sent back
+void ABM::exchange_place_sums()
+{
+	// Type and index, sum, infected, agents, and tested for each place
+	const size_t n_values = 6;
+	std::vector<std::vector<double>>& messages = domain.messages;
+	for (auto& message : messages){
+		message.clear();
+	}
+	for (const auto& ghosts : {&domain.linked_ghosts, &domain.leisure_ghosts}){
+		for (const auto& key : *ghosts){
+			const Place& place = place_at(key);
+			const int n_tested = key.type == PopulationImage::hospitals ? 
+									hospitals[key.index].get_n_tested() : 0;
+			std::vector<double>& message = messages.at(domain.owners[key.type][key.index]);
+			message.insert(message.end(), {static_cast<double>(key.type), 
+				static_cast<double>(key.index), place.get_lambda_sum(), 
+				static_cast<double>(place.get_total_infected()), 
+				static_cast<double>(place.get_number_of_agents()), static_cast<double>(n_tested)});
+		}
+	}
+	domain.ranks->exchange(messages);
+
+	// Owner adds sums of all ghosts first, then returns the totals
+	auto key_at = [](const std::vector<double>& message, const size_t i)
+		{ return Domain::PlaceKey{static_cast<unsigned>(message[i]), static_cast<int>(message[i + 1])}; };
+	auto as_int = [](const double val) { return static_cast<int>(std::lround(val)); };
+	for (const auto& message : messages){
+		for (size_t i = 0; i < message.size(); i += n_values){
+			const Domain::PlaceKey key = key_at(message, i);
+			place_at(key).add_remote_sums(message[i + 2], as_int(message[i + 3]), as_int(message[i + 4]));
+			if (key.type == PopulationImage::hospitals){
+				Hospital& hospital = hospitals.at(key.index);
+				hospital.set_n_tested(hospital.get_n_tested() + as_int(message[i + 5]));
+			}
+		}
+	}
+	for (auto& message : messages){
+		for (size_t i = 0; i < message.size(); i += n_values){
+			const Domain::PlaceKey key = key_at(message, i);
+			const Place& place = place_at(key);
+			message[i + 2] = place.get_lambda_sum();
+			message[i + 3] = place.get_total_infected();
+			message[i + 4] = place.get_number_of_agents() + place.get_number_of_remote_agents();
+			if (key.type == PopulationImage::hospitals){
+				message[i + 5] = hospitals[key.index].get_n_tested();
+			}
+		}
+	}
+	domain.ranks->exchange(messages);
+
+	// Ghosts take the totals
+	for (const auto& message : messages){
+		for (size_t i = 0; i < message.size(); i += n_values){
+			const Domain::PlaceKey key = key_at(message, i);
+			place_at(key).set_sums(message[i + 2], as_int(message[i + 3]), as_int(message[i + 4]));
+			if (key.type == PopulationImage::hospitals){
+				hospitals.at(key.index).set_n_tested(as_int(message[i + 5]));
+			}
+		}
+	}
+}
+
+// Collect places with nonzero infected contribution
+void ABM::collect_hot_places()
+{
+	hot_places.count = mark_hot_places(households, hot_places.households)
+						+ mark_hot_places(schools, hot_places.schools)
+						+ mark_hot_places(workplaces, hot_places.workplaces)
+						+ mark_hot_places(hospitals, hot_places.hospitals)
+						+ mark_hot_places(retirement_homes, hot_places.retirement_homes)
+						+ mark_hot_places(carpools, hot_places.carpools)
+						+ mark_hot_places(public_transit, hot_places.public_transit)
+						+ mark_hot_places(leisure_locations, hot_places.leisure_locations);
+}
+
+// True if the agent has no transitions since no place can infect it
+bool ABM::skips_transitions(const AgentStore::View& agent) const
+{
+	// Flu has testing and isolation transitions
+	if (!place_driven_susceptibles || agent.disease_stage() != AgentState::susceptible
+			|| agent.symptomatic_non_covid()){
+		return false;
+	}
+	if (hot_places.count == 0){
+		return true;
+	}
+	// IDs start with 1, 0 is no place; the same ID is 
+	// checked in every type of place it can refer to
+	auto hot = [](const std::vector<char>& places, const int ID)
+		{ return ID > 0 && static_cast<size_t>(ID) <= places.size() && places[ID-1]; };
+	const int house_ID = agent.get_household_ID();
+	const int work_ID = agent.get_work_ID();
+	const int leisure_ID = agent.get_leisure_ID();
+	return !(hot(hot_places.households, house_ID) 
+				|| hot(hot_places.retirement_homes, house_ID)
+				|| hot(hot_places.schools, agent.get_school_ID())
+				|| hot(hot_places.workplaces, work_ID) 
+				|| hot(hot_places.schools, work_ID)
+				|| hot(hot_places.retirement_homes, work_ID)
+				|| hot(hot_places.hospitals, agent.get_hospital_ID())
+				|| hot(hot_places.carpools, agent.get_carpool_ID())
+				|| hot(hot_places.public_transit, agent.get_public_transit_ID())
+				|| hot(hot_places.leisure_locations, leisure_ID)
+				|| hot(hot_places.households, leisure_ID));
+}
+
+// Compartments of agents that can contribute to places
+uint64_t ABM::contributing_compartments()
+{
+	return AgentStore::compartment_mask({AgentStore::exposed_set, AgentStore::symptomatic_set,
+				AgentStore::invalid_set, AgentStore::hospital_testing_set});
+}
+
+// Compartments of agents that have no contributions and transitions 
+uint64_t ABM::inactive_compartments()
+{
+	return AgentStore::compartment_mask({AgentStore::removed_set, AgentStore::vaccinated_set});
+}
+
+// True if the agent adds to places or to hospital testing counts
+bool ABM::adds_contributions(const AgentStore::View& agent) const
+{
+	if (agent.removed() || agent.vaccinated()){
+		return false;
+	}
+	if (agent.infected()){
+		return true;
+	}
+	// Susceptible tested in a hospital at this step
+	return agent.tested() && agent.tested_in_hospital() 
+			&& agent.tested_awaiting_test() && (agent.get_time_of_test() <= time);
+}
+
+// Count contributions of a single agent to places using contr
+void ABM::compute_agent_contributions(const Agent& agent, Contributions& contr)
+{
+	// Removed and vaccinated don't contribute
+	if (agent.vaccinated() == true){
+		return;
+	}
 
-		// Consider all infectious cases, raise 
-		// exception if no existing case
-		if (agent.exposed() == true){
-			contributions.compute_exposed_contributions(agent, time, households, 
+	// Consider all infectious cases, raise 
+	// exception if no existing case
+	switch (agent.get_state().disease_stage()){
+		case AgentState::removed_stage:
+			return;
+		case AgentState::susceptible:
+			// If susceptible and being tested - add to hospital's
+			// total number of people present at this time step
+			contr.compute_susceptible_contributions(agent, time, hospitals);
+			return;
+		case AgentState::exposed_stage:
+			contr.compute_exposed_contributions(agent, time, households, 
 							schools, workplaces, hospitals, retirement_homes,
 							carpools, public_transit, leisure_locations);
-		}else if (agent.symptomatic() == true){
-			contributions.compute_symptomatic_contributions(agent, time, households, 
+			return;
+		case AgentState::symptomatic_stage:
+			contr.compute_symptomatic_contributions(agent, time, households, 
 							schools, workplaces, hospitals, retirement_homes,
 							carpools, public_transit, leisure_locations);
-		}else{
+			return;
+		default:
 			throw std::runtime_error("Agent does not have any state");
-		}
 	}
-	contributions.total_place_contributions(households, schools, 
-											workplaces, hospitals, retirement_homes,
-											carpools, public_transit, leisure_locations);
 }
 
 // Determine infection propagation and
 // state changes 
 void ABM::compute_state_transitions()
 {
-	int newly_infected = 0, is_recovered = 0;
-	// Infected state change flags: 
-	// recovered - healthy, recovered - dead, tested at this step,
-	// tested positive at this step, tested false negative
-	std::vector<int> state_changes = {0, 0, 0, 0, 0};
-	// Susceptible state changes
-	// infected, tested, tested negative, tested false positive
-	std::vector<int> s_state_changes = {0, 0, 0, 0};
-	// First entry is one if agent recovered, second if agent died
-	std::vector<int> removed = {0,0};
-
+	assert(agents_attached());
 	// Store information for that day
 	n_infected_day.push_back(0);
 	tested_day.push_back(0);
@@ -1317,89 +1797,267 @@ void ABM::compute_state_transitions()
 	tested_false_pos_day.push_back(0);
 	tested_false_neg_day.push_back(0);
 
-	for (auto& agent : agents){
+	// Susceptible are evaluated at every step, infected only at 
+	// steps when one of their timers is due; removed and vaccinated
+	// have no transitions
+	const long step = std::lround(time/dt);
+	mark_due_transitions(step);
+	const uint64_t every_step = AgentStore::compartment_mask({AgentStore::susceptible_set,
+										AgentStore::invalid_set});
+	const uint64_t due = uint64_t(1) << AgentStore::due_mark;
+
+	if (n_transition_threads > 0){
+		// Each thread has its own counters and buffer of changes 
+		// to places and flu; the changes are applied in the order 
+		// of agents after all threads are done; each agent draws 
+		// from its own random number stream for this step
+		if (thread_infections.size() != static_cast<size_t>(n_transition_threads)){
+			thread_infections.assign(n_transition_threads, infection);
+		}
+		for (auto& inf : thread_infections){
+			inf.copy_generator(infection);
+		}
+		const uint64_t copied_draws = infection.get_rng_draws();
+		std::vector<TransitionCounts> thread_counts(n_transition_threads);
+		change_buffers.resize(n_transition_threads);
+		parallel_chunks(agent_store.n_blocks(), n_transition_threads, 
+			[this, step, every_step, due, &thread_counts](int chunk, size_t first, size_t last){
+				std::vector<SharedChange>& buffer = change_buffers.at(chunk);
+				buffer.clear();
+				Transitions tr;
+				tr.set_deferred_buffer(&buffer);
+				Infection& inf = thread_infections.at(chunk);
+				TransitionCounts& counts = thread_counts.at(chunk);
+				agent_store.for_each_in(every_step, inactive_compartments(), due,
+					first, last, [this, step, &tr, &inf, &counts](size_t i){
+						const AgentStore::View view = agent_store.view(i);
+						if (skips_transitions(view)){
+							return;
+						}
+						inf.set_stream(view.get_ID(), static_cast<int>(step), RNG::transitions);
+						compute_agent_transitions(agents[i], tr, inf, counts);
+						// Scheduled again at the next step
+						if (view.infected()){
+							agent_store.mark(i, AgentStore::changed_mark);
+						}
+					});
+			});
+		apply_shared_changes(change_buffers);
+		for (const auto& counts : thread_counts){
+			add_transition_counts(counts);
+		}
+		// Copies started from the draws of the shared object
+		for (const auto& inf : thread_infections){
+			profiler.count(StepProfiler::rng_draws, inf.get_rng_draws() - copied_draws);
+		}
+	} else {
+		TransitionCounts counts;
+		agent_store.for_each_in(every_step, inactive_compartments(), due,
+			0, agent_store.n_blocks(), [this, &counts](size_t i){
+				const AgentStore::View view = agent_store.view(i);
+				if (skips_transitions(view)){
+					return;
+				}
+				compute_agent_transitions(agents[i], transitions, infection, counts);
+				// Scheduled again at the next step
+				if (view.infected()){
+					agent_store.mark(i, AgentStore::changed_mark);
+				}
+			});
+		add_transition_counts(counts);
+	}
+	agent_store.clear(AgentStore::due_mark);
+}
 
-		// Skip the removed and the vaccinated 
-		if (agent.removed() == true || agent.vaccinated() == true){
-			continue;
+// Mark infected agents with transitions due at this step
+void ABM::mark_due_transitions(const long step)
+{
+	const uint64_t infected = AgentStore::compartment_mask({AgentStore::exposed_set, 
+										AgentStore::symptomatic_set});
+	if (transition_calendar.size() != agents.size() 
+			|| transition_calendar.get_step() != step - 1){
+		transition_calendar.reset(agents.size(), step - 1);
+		agent_store.for_each_in(infected, 0, 
+			[this](size_t i){ agent_store.mark(i, AgentStore::changed_mark); });
+	}
+	agent_store.clear(AgentStore::due_mark);
+	transition_calendar.advance([this](size_t i){ agent_store.mark(i, AgentStore::due_mark); });
+
+	// Agents with new or changed timers and states
+	agent_store.for_each_marked(AgentStore::changed_mark, [this, step, infected](size_t i){
+		transition_calendar.cancel(i);
+		const AgentStore::View view = agent_store.view(i);
+		if ((AgentStore::compartments(view.flags()) & infected) == 0 || view.vaccinated()){
+			return;
 		}
-		
-		std::fill(state_changes.begin(), state_changes.end(), 0);
-		std::fill(s_state_changes.begin(), s_state_changes.end(), 0);
+		const double t_next = Transitions::next_transition_time(agents[i], dt);
+		if (t_next <= time){
+			agent_store.mark(i, AgentStore::due_mark);
+		} else if (t_next < std::numeric_limits<double>::infinity()){
+			// First step with time at the timer; time is accumulated so 
+			// it can be slightly below then, the agent is visited with 
+			// no changes and scheduled again for the next step
+			const long t_step = static_cast<long>(std::ceil(t_next/dt - 1e-6));
+			transition_calendar.schedule(i, std::max(step + 1, t_step));
+		}
+	});
+	agent_store.clear(AgentStore::changed_mark);
+}
+
+// Transitions of a single agent, changes in counters stored in counts
+void ABM::compute_agent_transitions(Agent& agent, Transitions& tr, 
+							Infection& inf, TransitionCounts& counts)
+{
+	// Infected state change flags: 
+	// recovered - healthy, recovered - dead, tested at this step,
+	// tested positive at this step, tested false negative
+	std::vector<int> state_changes = {0, 0, 0, 0, 0};
+	// Susceptible state changes
+	// infected, tested, tested negative, tested false positive
+	std::vector<int> s_state_changes = {0, 0, 0, 0};
+	++counts.visited;
+	const uint64_t old_state = agent.get_state().flags();
 
-		if (agent.infected() == false){
-			s_state_changes = transitions.susceptible_transitions(agent, time,
-							dt, infection, households, schools, workplaces, 
+	// Skip the removed and the vaccinated 
+	if (agent.vaccinated() == true){
+		return;
+	}
+
+	switch (agent.get_state().disease_stage()){
+		case AgentState::removed_stage:
+			return;
+		case AgentState::susceptible:
+			s_state_changes = tr.susceptible_transitions(agent, time,
+							dt, inf, households, schools, workplaces, 
 							hospitals, retirement_homes, carpools, public_transit,
-						   	leisure_locations, infection_parameters, 
+							leisure_locations, infection_params, 
 							agents, flu, testing);
-			n_infected_tot += s_state_changes.at(0);
 			// True infected by timestep, from the first time step
 			if (s_state_changes.at(0) == 1){
-				++n_infected_day.back();
+				++counts.infected;
 				// Saving infected information
 				if (collect_data) {
-					collect_infected_properties(agent);
+					counts.infected_IDs.push_back(agent.get_ID());
 				}
 			}
-		}else if (agent.exposed() == true){
-			state_changes = transitions.exposed_transitions(agent, infection, time, dt, 
+			break;
+		case AgentState::exposed_stage:
+			state_changes = tr.exposed_transitions(agent, inf, time, dt, 
 										households, schools, workplaces, hospitals,
 										retirement_homes, carpools, public_transit,
-						   				infection_parameters, testing);
-			n_recovering_exposed += state_changes.at(0);
-			n_recovered_tot += state_changes.at(0);
-		}else if (agent.symptomatic() == true){
-			state_changes = transitions.symptomatic_transitions(agent, time, dt,
-						infection, households, schools, workplaces, hospitals,
+										infection_params, testing);
+			counts.recovering_exposed += state_changes.at(0);
+			counts.recovered += state_changes.at(0);
+			break;
+		case AgentState::symptomatic_stage:
+			state_changes = tr.symptomatic_transitions(agent, time, dt,
+						inf, households, schools, workplaces, hospitals,
 							retirement_homes, carpools, public_transit,
-						   	infection_parameters);
-			n_recovered_tot += state_changes.at(0);
+							infection_params);
+			counts.recovered += state_changes.at(0);
 			// Collect only after a specified time
-			if (time >= infection_parameters.at("time to start data collection")){
+			if (time >= infection_params.time_to_start_data_collection){
 				if (state_changes.at(1) == 1){
 					// Dead after testing
-					++n_dead_tested;
-					++n_dead_tot;
+					++counts.dead_tested;
 				} else if (state_changes.at(1) == 2){
 					// Dead with no testing
-					++n_dead_not_tested;
-					++n_dead_tot;
+					++counts.dead_not_tested;
 				}
 			}
-		}else{
+			break;
+		default:
 			throw std::runtime_error("Agent does not have any infection-related state");
+	}
+
+	// Recording testing changes for this agent
+	if (time >= infection_params.time_to_start_data_collection){
+		if (agent.exposed() || agent.symptomatic()){
+			if (state_changes.at(2) == 1){
+				++counts.tested;
+			}
+			if (state_changes.at(3) == 1){
+				++counts.tested_pos;
+			}
+			if (state_changes.at(4) == 1){
+				++counts.tested_false_neg;
+			}
+		} else {
+			// Susceptible
+			if (s_state_changes.at(1) == 1){
+				++counts.tested;
+			}
+			if (s_state_changes.at(2) == 1){
+				++counts.tested_neg;
+			}
+			if (s_state_changes.at(3) == 1){
+				++counts.tested_false_pos;
+			}
 		}
+	}
+	if (agent.get_state().flags() != old_state){
+		++counts.fired;
+	}
+}
 
-		// Recording testing changes for this agent
-		if (time >= infection_parameters.at("time to start data collection")){
-			if (agent.exposed() || agent.symptomatic()){
-				if (state_changes.at(2) == 1){
-					++tested_day.back();
-					++tot_tested;
-				}
-				if (state_changes.at(3) == 1){
-					++tested_pos_day.back();
-					++tot_tested_pos;
-				}
-				if (state_changes.at(4) == 1){
-					++tested_false_neg_day.back();
-					++tot_tested_false_neg;
-				}
-			} else {
-				// Susceptible
-				if (s_state_changes.at(1) == 1){
-					++tested_day.back();
-					++tot_tested;
-				}
-				if (s_state_changes.at(2) == 1){
-					++tested_neg_day.back();
-					++tot_tested_neg;
-				}
-				if (s_state_changes.at(3) == 1){
-					++tested_false_pos_day.back();
-					++tot_tested_false_pos;
-				}
+// Add changes from one step of transitions to totals and daily data
+void ABM::add_transition_counts(const TransitionCounts& counts)
+{
+	n_infected_tot += counts.infected;
+	n_infected_day.back() += counts.infected;
+	n_recovering_exposed += counts.recovering_exposed;
+	n_recovered_tot += counts.recovered;
+	n_dead_tested += counts.dead_tested;
+	n_dead_not_tested += counts.dead_not_tested;
+	n_dead_tot += counts.dead_tested + counts.dead_not_tested;
+
+	tested_day.back() += counts.tested;
+	tot_tested += counts.tested;
+	tested_pos_day.back() += counts.tested_pos;
+	tot_tested_pos += counts.tested_pos;
+	tested_neg_day.back() += counts.tested_neg;
+	tot_tested_neg += counts.tested_neg;
+	tested_false_pos_day.back() += counts.tested_false_pos;
+	tot_tested_false_pos += counts.tested_false_pos;
+	tested_false_neg_day.back() += counts.tested_false_neg;
+	tot_tested_false_neg += counts.tested_false_neg;
+	profiler.count(StepProfiler::agents_visited, counts.visited);
+	profiler.count(StepProfiler::transitions_fired, counts.fired);
+
+	for (const auto& aID : counts.infected_IDs){
+		collect_infected_properties(agents.at(aID-1));
+	}
+}
+
+// Apply changes to places and flu stored during transitions
+void ABM::apply_shared_changes(const std::vector<std::vector<SharedChange>>& buffers)
+{
+	// Places and susceptible agents
+	for (const auto& buffer : buffers){
+		for (const auto& change : buffer){
+			if (change.type == SharedChange::add_agent){
+				change.place->add_agent(change.agent_ID);
+			} else if (change.type == SharedChange::remove_agent){
+				change.place->remove_agent(change.agent_ID);
+			} else if (change.type == SharedChange::remove_susceptible){
+				flu.remove_susceptible_agent(change.agent_ID);
+			}
+		}
+	}
+	// Flu agents replaced with the remaining susceptible
+	const int n_hospitals = hospitals.size();
+	for (const auto& buffer : buffers){
+		for (const auto& change : buffer){
+			if (change.type != SharedChange::swap_flu){
+				continue;
+			}
+			int new_flu = flu.swap_flu_agent(change.agent_ID);
+			// If still available
+			if (new_flu != -1){
+				transitions.process_new_flu(agents.at(new_flu-1), n_hospitals, time,
+					   		 schools, workplaces, retirement_homes,
+							 carpools, public_transit, infection, 
+							 infection_params, flu, testing);
 			}
 		}
 	}
@@ -1411,7 +2069,7 @@ void ABM::start_testing_flu_and_vaccination()
 	double tol = 1e-3;
 	// Initialize agents with flu the time step the testing starts 
 	// Optionally also vaccinate part of the population or/and specific groups
-	if (equal_floats<double>(time, infection_parameters.at("start testing"), tol)){
+	if (equal_floats<double>(time, infection_params.start_testing, tol)){
 		// Vaccinate
 		if (random_vaccines == true){
 			vaccinate_random();
@@ -1423,9 +2081,10 @@ void ABM::start_testing_flu_and_vaccination()
 			vaccinate_random();
 			vaccinate_group();
 		}
-		// Initialize flu agents
+		// Initialize flu agents of this process
 		for (const auto& agent : agents){
-			if (!agent.infected() && !agent.removed() && !agent.vaccinated()){
+			if (local_agent(agent.get_ID() - 1) 
+					&& !agent.infected() && !agent.removed() && !agent.vaccinated()){
 				// If not patient or hospital employee
 				// Add to potential flu group
 				if (!agent.hospital_employee() && !agent.hospital_non_covid_patient()){
@@ -1442,7 +2101,7 @@ void ABM::start_testing_flu_and_vaccination()
 			transitions.process_new_flu(agent, n_hospitals, time,
 					   		 schools, workplaces, retirement_homes,
 							 carpools, public_transit, infection, 
-							 infection_parameters, flu, testing);
+							 infection_params, flu, testing);
 		}
 	}
 }
@@ -1454,36 +2113,41 @@ void ABM::start_testing_flu_and_vaccination()
 // Retrieve number of infected agents at this time step
 int ABM::get_num_infected() const
 {
-	int infected_count = 0;
-	for (const auto& agent : agents){
-		if (agent.infected())
-			++infected_count;
-	}
-	return infected_count;
+	return agent_store.count(AgentStore::exposed_set) 
+			+ agent_store.count(AgentStore::symptomatic_set)
+			+ agent_store.count(AgentStore::invalid_set);
 }
 
 // Retrieve number of exposed agents at this time step
 int ABM::get_num_exposed() const
 {
-	int exposed_count = 0;
-	for (const auto& agent : agents){
-		if (agent.exposed())
-			++exposed_count;
+	return agent_store.count(AgentStore::exposed_set);
+}
+
+// Fraction of infected among agents that are alive
+double ABM::get_prevalence() const
+{
+	const int n_alive = static_cast<int>(agents.size()) - n_dead_tot;
+	if (n_alive <= 0) {
+		return 0.0;
 	}
-	return exposed_count;
+	return static_cast<double>(get_num_infected())/n_alive;
 }
 
 // Number of infected - confirmed
 int ABM::get_num_active_cases() const
 {
 	int active_count = 0;
-	for (const auto& agent : agents){
-		if ((agent.infected() && agent.tested_covid_positive())
-			 || (agent.symptomatic_non_covid() && agent.home_isolated()
-					 && agent.tested_false_positive())){
-			++active_count;
-		}
-	}
+	// Removed are neither infected nor flu 
+	agent_store.for_each_in(~AgentStore::compartment_mask({AgentStore::removed_set}), 0, 
+		[this, &active_count](size_t i){
+			const AgentStore::View agent = agent_store.view(i);
+			if ((agent.infected() && agent.tested_covid_positive())
+				 || (agent.symptomatic_non_covid() && agent.home_isolated()
+						 && agent.tested_false_positive())){
+				++active_count;
+			}
+		});
 	return active_count;
 }
 
@@ -1492,13 +2156,19 @@ std::vector<int> ABM::get_treatment_data() const
 {
 	// IH, HN, ICU
 	std::vector<int> treatments(3,0);
-	for (const auto& agent : agents){
-		if (agent.home_isolated()){
-			++treatments.at(0);
-		}else if (agent.hospitalized()){
-			++treatments.at(1);
-		}else if (agent.hospitalized_ICU()){
-			++treatments.at(2);
+	for (size_t i = 0; i < agent_store.size(); ++i){
+		switch (agent_store.view(i).treatment_stage()){
+			case AgentState::home_isolation:
+				++treatments.at(0);
+				break;
+			case AgentState::hospitalization:
+				++treatments.at(1);
+				break;
+			case AgentState::intensive_care:
+				++treatments.at(2);
+				break;
+			default:
+				break;
 		}
 	}
 	return treatments;
@@ -1576,7 +2246,7 @@ void ABM::collect_contacts()
 			// This also includes private guests (just don't count them double)
 			n_tot += households.at(agent.get_household_ID()-1).get_number_of_agents();
 			if (agent.student()) {
-				if (time < infection_parameters.at("school closure")) { 
+				if (time < infection_params.school_closure) { 
 					n_tot += schools.at(agent.get_school_ID()-1).get_number_of_agents();
 				}
 			}
@@ -1591,7 +2261,7 @@ void ABM::collect_contacts()
 			}
 
 			if (agent.student()) {
-				if (time < infection_parameters.at("school closure")) {
+				if (time < infection_params.school_closure) {
 					n_tot += schools.at(agent.get_school_ID()-1).get_number_of_agents();
 				}
 			}
@@ -1600,7 +2270,7 @@ void ABM::collect_contacts()
 				if (agent.retirement_home_employee()) {
 					n_tot += retirement_homes.at(agent.get_work_ID()-1).get_number_of_agents();
 				} else if (agent.school_employee()) {
-					if (time < infection_parameters.at("school closure")) {
+					if (time < infection_params.school_closure) {
 						n_tot += schools.at(agent.get_work_ID()-1).get_number_of_agents();
 					}
 				} else {
@@ -1645,45 +2315,45 @@ double ABM::get_average_contacts()
 			n_tot += households.at(agent.get_household_ID()-1).get_number_of_agents();
 			
 		if (agent.student()) {
-				if (time < infection_parameters.at("school closure")) { 
+				if (time < infection_params.school_closure) { 
 					n_tot += std::min(schools.at(agent.get_school_ID()-1).get_number_of_agents(),
-									static_cast<int>(infection_parameters.at("max contacts at school")));
+									static_cast<int>(infection_params.required(&InfectionParameters::max_contacts_at_school)));
 				}
 			}
 
 			n_tot += std::min(hospitals.at(agent.get_hospital_ID()-1).get_number_of_agents(),
-								static_cast<int>(infection_parameters.at("max contacts at hospital")));
+								static_cast<int>(infection_params.required(&InfectionParameters::max_contacts_at_hospital)));
 		} else if (agent.hospital_non_covid_patient()) {
 			n_tot += std::min(hospitals.at(agent.get_hospital_ID()-1).get_number_of_agents(),
-								static_cast<int>(infection_parameters.at("max contacts at hospital")));
+								static_cast<int>(infection_params.required(&InfectionParameters::max_contacts_at_hospital)));
 		} else {
 			if (agent.retirement_home_resident()) {
 				n_tot += std::min(retirement_homes.at(agent.get_household_ID()-1).get_number_of_agents(),
-									static_cast<int>(infection_parameters.at("max contacts at RH")));
+									static_cast<int>(infection_params.required(&InfectionParameters::max_contacts_at_rh)));
 			} else {
 				n_tot += households.at(agent.get_household_ID()-1).get_number_of_agents();
 			}
 
 			if (agent.student()) {
-				if (time < infection_parameters.at("school closure")) {
+				if (time < infection_params.school_closure) {
 					n_tot += std::min(schools.at(agent.get_school_ID()-1).get_number_of_agents(),
-									static_cast<int>(infection_parameters.at("max contacts at school")));
+									static_cast<int>(infection_params.required(&InfectionParameters::max_contacts_at_school)));
 				}
 			}
 
 			if (agent.works()) {
 				if (agent.retirement_home_employee()) {
 					n_tot +=  std::min(retirement_homes.at(agent.get_work_ID()-1).get_number_of_agents(),
-									static_cast<int>(infection_parameters.at("max contacts at RH")));
+									static_cast<int>(infection_params.required(&InfectionParameters::max_contacts_at_rh)));
 				} else if (agent.school_employee()) {
-					if (time < infection_parameters.at("school closure")) {
+					if (time < infection_params.school_closure) {
 						n_tot += std::min(schools.at(agent.get_work_ID()-1).get_number_of_agents(),
-									static_cast<int>(infection_parameters.at("max contacts at school")));
+									static_cast<int>(infection_params.required(&InfectionParameters::max_contacts_at_school)));
 					}
 				} else {
 					if (!agent.works_from_home()) {
 						n_tot +=  std::min(workplaces.at(agent.get_work_ID()-1).get_number_of_agents(),
-							static_cast<int>(infection_parameters.at("max contacts at workplace")));
+							static_cast<int>(infection_params.required(&InfectionParameters::max_contacts_at_workplace)));
 					}
 				}
 			}
@@ -1709,29 +2379,6 @@ double ABM::get_average_contacts()
 	return (static_cast<double>(n_tot))/(static_cast<double>(agents.size()));
 }
 
-//
-// I/O
-//
-
-// General function for reading an object from a file
-std::vector<std::vector<std::string>> ABM::read_object(std::string fname)
-{
-	// AbmIO settings
-	std::string delim(" ");
-	bool sflag = true;
-	std::vector<size_t> dims = {0,0,0};
-
-	// 2D vector with a parsed line in each inner
-	// vector
-	std::vector<std::vector<std::string>> obj_vec_2D;
-
-	// Read and return a copy
-	AbmIO abm_io(fname, delim, sflag, dims);
-	obj_vec_2D = abm_io.read_vector<std::string>();
-
-	return obj_vec_2D;
-}
-
 //
 // Saving simulation state
 //
@@ -1847,6 +2494,17 @@ void ABM::print_agents(const std::string fname) const
 	abm_io.write_vector<Agent>(agents);	
 }
 
+// Save current agent information in the thread of the writer
+void ABM::print_agents(const std::string& fname, AsyncWriter<Agent::Snapshot>& writer) const
+{
+	std::vector<Agent::Snapshot> snapshots = writer.buffer();
+	snapshots.reserve(agents.size());
+	for (const auto& agent : agents) {
+		snapshots.push_back(agent.snapshot());
+	}
+	writer.write(fname, std::move(snapshots));
+}
+
 // Save information on the newly infected agent
 void ABM::collect_infected_properties(const Agent& agent)
 {
@@ -2009,3 +2667,42 @@ void ABM::save_infected_data(const std::string& filename) const
 	// Clear vector
 	infected_agents.clear();
 }
+
+//
+// Checkpoints
+//
+
+const std::string ABM::checkpoint_kind = "ABM checkpoint";
+
+// Save the full simulation state to a binary file
+void ABM::save_checkpoint(const std::string& fname) const
+{
+	BinaryArchive ar(fname, BinaryArchive::save, checkpoint_kind, checkpoint_version);
+	// Members are only read when saving
+	const_cast<ABM*>(this)->serialize(ar);
+}
+
+// Restore the simulation state saved with save_checkpoint()
+void ABM::load_checkpoint(const std::string& fname)
+{
+	BinaryArchive ar(fname, BinaryArchive::load, checkpoint_kind, checkpoint_version);
+	serialize(ar);
+	attach_agents_to_store();
+	thread_infections.clear();
+}
+
+// Save the full simulation state to a stream
+void ABM::save_checkpoint(std::ostream& out) const
+{
+	BinaryArchive ar(out, checkpoint_kind, checkpoint_version);
+	const_cast<ABM*>(this)->serialize(ar);
+}
+
+// Restore the simulation state from a stream
+void ABM::load_checkpoint(std::istream& in)
+{
+	BinaryArchive ar(in, checkpoint_kind, checkpoint_version);
+	serialize(ar);
+	attach_agents_to_store();
+	thread_infections.clear();
+}
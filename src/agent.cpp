@@ -14,12 +14,35 @@
 // Print Agent information 
 void Agent::print_basic(std::ostream& where) const
 {
-	where << ID << " " << is_student << " " << is_working  
-		  << " " << age << " " << x << " " << y << " "
-		  << house_ID << " " << is_non_covid_patient << " " << school_ID 
-		  << " " << work_ID << " " << works_at_hospital 
-		  << " " << hospital_ID << " " << worksRH 
-		  << " " << worksSch << " " << livesRH << " "<< is_infected;	
+	where << snapshot();
+}
+
+//
+// Columnar store
+//
+
+// Copy the attributes to the store row and keep it for updates
+void Agent::attach_to_store(AgentStore::Row row)
+{
+	store_row.attach(row);
+
+	store_row.set_flags(state.flags());
+	store_row.set_ID(AgentStore::agent, ID);
+	store_row.set_ID(AgentStore::household, house_ID);
+	store_row.set_ID(AgentStore::school, school_ID);
+	store_row.set_ID(AgentStore::work, work_ID);
+	store_row.set_ID(AgentStore::hospital, hospital_ID);
+	store_row.set_ID(AgentStore::carpool, carpool_ID);
+	store_row.set_ID(AgentStore::public_transit, public_transit_ID);
+	store_row.set_ID(AgentStore::leisure, leisure_location_ID);
+
+	store_row.set_timer(AgentStore::infectiousness_start, infectiousness_start);
+	store_row.set_timer(AgentStore::latency_end, latency_end_time);
+	store_row.set_timer(AgentStore::time_of_test, time_of_test);
+	store_row.set_timer(AgentStore::time_of_results, time_of_results);
+	store_row.set_timer(AgentStore::recovery_time, recovery_time);
+	store_row.set_timer(AgentStore::death_time, death_time);
+	store_row.set_timer(AgentStore::inf_variability, inf_var);
 }
 
 //
@@ -37,4 +60,16 @@ std::ostream& operator<< (std::ostream& out, const Agent& agent)
 	return out;
 }
 
+// Print the fields of a snapshot, same as print_basic
+std::ostream& operator<< (std::ostream& out, const Agent::Snapshot& agent)
+{
+	out << agent.ID << " " << agent.student << " " << agent.works  
+		<< " " << agent.age << " " << agent.x << " " << agent.y << " "
+		<< agent.house_ID << " " << agent.hospital_non_covid_patient << " " << agent.school_ID 
+		<< " " << agent.work_ID << " " << agent.hospital_employee 
+		<< " " << agent.hospital_ID << " " << agent.retirement_home_employee 
+		<< " " << agent.school_employee << " " << agent.retirement_home_resident << " " << agent.infected;	
+	return out;
+}
+
 
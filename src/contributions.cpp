@@ -9,6 +9,18 @@
  * 
  ******************************************************/
 
+// Count a susceptible agent that is being tested in a hospital
+void Contributions::compute_susceptible_contributions(const Agent& agent, const double time,	
+				std::vector<Hospital>& hospitals)
+{
+	if ((agent.tested() == true) && 
+		(agent.tested_in_hospital() == true) &&
+		(agent.get_time_of_test() <= time) && 
+		(agent.tested_awaiting_test() == true)){
+			add_tested_count(hospitals.at(agent.get_hospital_ID() - 1));
+	}
+}
+
 // Count contributions of an exposed agent
 void Contributions::compute_exposed_contributions(const Agent& agent, const double time,	
 				std::vector<Household>& households, std::vector<School>& schools,
@@ -44,37 +56,37 @@ void Contributions::compute_exposed_contributions(const Agent& agent, const doub
 				compute_home_isolated_contributions(agent, inf_var, households, retirement_homes);
 			} else if (agent.hospital_non_covid_patient()){
 				Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
-				hospital.add_exposed_patient(inf_var);
+				add_contribution(hospital, &Hospital::add_exposed_patient, inf_var);
 			} else if (agent.hospital_employee()){
 				Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
-				hospital.add_exposed(inf_var);
+				add_contribution(hospital, &Hospital::add_exposed, inf_var);
 				// Household
 				Household& household = households.at(agent.get_household_ID()-1);
-				household.add_exposed(inf_var);
+				add_contribution(household, &Household::add_exposed, inf_var);
 				// Other places
 				if (agent.student() == true){
 					School& school = schools.at(agent.get_school_ID()-1);
-					school.add_exposed(inf_var);	
+					add_contribution(school, &School::add_exposed, inf_var);	
 				}
 				// Transit
 				if (agent.get_work_travel_mode() == "carpool") {
 					Transit& carpool = carpools.at(agent.get_carpool_ID()-1);
-					carpool.add_exposed(inf_var);
+					add_contribution(carpool, &Transit::add_exposed, inf_var);
 				}
 				if (agent.get_work_travel_mode() == "public") {
 					Transit& bus = public_transit.at(agent.get_public_transit_ID()-1);
-					bus.add_exposed(inf_var);
+					add_contribution(bus, &Transit::add_exposed, inf_var);
 				}
 				// Leisure
 				if (agent.get_leisure_ID() > 0) {
 					if (agent.get_leisure_type() == "public") {
 						Leisure& les_loc = leisure_locations.at(agent.get_leisure_ID()-1);
 						if (!les_loc.outside_town()){
-							les_loc.add_exposed(inf_var);
+							add_contribution(les_loc, &Leisure::add_exposed, inf_var);
 						}
 					} else if (agent.get_leisure_type() == "household") {
 						Household& household = households.at(agent.get_leisure_ID()-1);
-						household.add_exposed(inf_var);
+						add_contribution(household, &Household::add_exposed, inf_var);
 					} else {
 						throw std::invalid_argument("Wrong leisure type: " + agent.get_leisure_type());
 					}
@@ -87,7 +99,7 @@ void Contributions::compute_exposed_contributions(const Agent& agent, const doub
 		if (agent.hospital_non_covid_patient() == true &&
 				agent.tested_covid_positive() == false){
 			Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
-			hospital.add_exposed_patient(inf_var);
+			add_contribution(hospital, &Hospital::add_exposed_patient, inf_var);
 			return;
 		}
 	
@@ -100,54 +112,54 @@ void Contributions::compute_exposed_contributions(const Agent& agent, const doub
 		// Household or retirement home
 		if (agent.retirement_home_resident()){
 			RetirementHome& rh = retirement_homes.at(agent.get_household_ID()-1);
-			rh.add_exposed(inf_var);
+			add_contribution(rh, &RetirementHome::add_exposed, inf_var);
 		} else {
 			Household& household = households.at(agent.get_household_ID()-1);
-			household.add_exposed(inf_var);
+			add_contribution(household, &Household::add_exposed, inf_var);
 		}
 
 		// Other places
 		if (agent.student() == true){
 			School& school = schools.at(agent.get_school_ID()-1);
-			school.add_exposed(inf_var);	
+			add_contribution(school, &School::add_exposed, inf_var);	
 		}
 		if (agent.works() && !agent.works_from_home()) {
 			if (agent.retirement_home_employee()){
 				RetirementHome& rh = retirement_homes.at(agent.get_work_ID()-1);
-				rh.add_exposed_employee(inf_var);
+				add_contribution(rh, &RetirementHome::add_exposed_employee, inf_var);
 			} else if (agent.school_employee()){
 				School& sch = schools.at(agent.get_work_ID()-1);
-				sch.add_exposed_employee(inf_var);
+				add_contribution(sch, &School::add_exposed_employee, inf_var);
 			} else {
 				Workplace& workplace = workplaces.at(agent.get_work_ID()-1);
 				if (!workplace.outside_town()) {
-					workplace.add_exposed(inf_var);
+					add_contribution(workplace, &Workplace::add_exposed, inf_var);
 				}
 			}
 		}
 		if (agent.hospital_employee() == true){
 			Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
-			hospital.add_exposed(inf_var);
+			add_contribution(hospital, &Hospital::add_exposed, inf_var);
 		}
 		// Transit
 		if (agent.get_work_travel_mode() == "carpool") {
 			Transit& carpool = carpools.at(agent.get_carpool_ID()-1);
-			carpool.add_exposed(inf_var);
+			add_contribution(carpool, &Transit::add_exposed, inf_var);
 		}
 		if (agent.get_work_travel_mode() == "public") {
 			Transit& bus = public_transit.at(agent.get_public_transit_ID()-1);
-			bus.add_exposed(inf_var);
+			add_contribution(bus, &Transit::add_exposed, inf_var);
 		}
 		// Leisure
 		if (agent.get_leisure_ID() > 0) {
 			if (agent.get_leisure_type() == "public") {
 				Leisure& les_loc = leisure_locations.at(agent.get_leisure_ID()-1);
 				if (!les_loc.outside_town()){
-					les_loc.add_exposed(inf_var);
+					add_contribution(les_loc, &Leisure::add_exposed, inf_var);
 				}
 			} else if (agent.get_leisure_type() == "household") {
 				Household& household = households.at(agent.get_leisure_ID()-1);
-				household.add_exposed(inf_var);
+				add_contribution(household, &Household::add_exposed, inf_var);
 			} else {
 				throw std::invalid_argument("Wrong leisure type: " + agent.get_leisure_type());
 			}
@@ -201,7 +213,7 @@ void Contributions::compute_symptomatic_contributions(const Agent& agent, const
 		if ((agent.tested_false_negative() && (agent.hospital_non_covid_patient()))
 						|| (agent.hospital_non_covid_patient())){
 			Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
-			hospital.add_symptomatic_patient(inf_var);	
+			add_contribution(hospital, &Hospital::add_symptomatic_patient, inf_var);	
 		} else {
 			// If regular symptomatic
 			compute_regular_symptomatic_contributions(agent, inf_var, households,
@@ -217,18 +229,33 @@ void Contributions::total_place_contributions(std::vector<Household>& households
 					std::vector<Hospital>& hospitals, 
 					std::vector<RetirementHome>& retirement_homes,
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-					std::vector<Leisure>& leisure_locations)
+					std::vector<Leisure>& leisure_locations, const PlacePolicy& policy)
 {	
 	auto infected_contribution = [](Place& place){ place.compute_infected_contribution(); };
+	// Same multiplier for all places of a type
+	auto scaled_contribution = [](Place& place, const double mult)
+		{ place.compute_infected_contribution(); place.scale_infected_contribution(mult); };
 
 	std::for_each(households.begin(), households.end(), infected_contribution);
 	std::for_each(retirement_homes.begin(), retirement_homes.end(), infected_contribution);
-	std::for_each(schools.begin(), schools.end(), infected_contribution);
-	std::for_each(workplaces.begin(), workplaces.end(), infected_contribution);
+	for (auto& school : schools) {
+		scaled_contribution(school, policy.schools);
+	}
+	for (auto& workplace : workplaces) {
+		scaled_contribution(workplace, workplace.outside_town() ? 
+								policy.outside_workplaces : policy.workplaces);
+	}
 	std::for_each(hospitals.begin(), hospitals.end(), infected_contribution);
-	std::for_each(carpools.begin(), carpools.end(), infected_contribution);
-	std::for_each(public_transit.begin(), public_transit.end(), infected_contribution);
-	std::for_each(leisure_locations.begin(), leisure_locations.end(), infected_contribution);
+	for (auto& car : carpools) {
+		scaled_contribution(car, policy.carpools);
+	}
+	for (auto& pt : public_transit) {
+		scaled_contribution(pt, policy.public_transit);
+	}
+	for (auto& leisure_location : leisure_locations) {
+		scaled_contribution(leisure_location, leisure_location.outside_town() ? 
+								policy.outside_leisure_locations : policy.leisure_locations);
+	}
 }
 
 // Count contributions of a untreated and not tested symptomatic agent
@@ -242,50 +269,50 @@ void Contributions::compute_regular_symptomatic_contributions(const Agent& agent
 	// Household or retirement home
 	if (agent.retirement_home_resident()){
 		RetirementHome& rh = retirement_homes.at(agent.get_household_ID()-1);
-		rh.add_symptomatic(inf_var);
+		add_contribution(rh, &RetirementHome::add_symptomatic, inf_var);
 	} else {
 		Household& household = households.at(agent.get_household_ID()-1);
-		household.add_symptomatic(inf_var);
+		add_contribution(household, &Household::add_symptomatic, inf_var);
 	}
 
 	// Other places
 	if (agent.student() == true){
 		School& school = schools.at(agent.get_school_ID()-1);
-		school.add_symptomatic_student(inf_var);	
+		add_contribution(school, &School::add_symptomatic_student, inf_var);	
 	}
 	if (agent.works() && !agent.works_from_home()) {
 		if (agent.retirement_home_employee()){
 			RetirementHome& rh = retirement_homes.at(agent.get_work_ID()-1);
-			rh.add_symptomatic_employee(inf_var);
+			add_contribution(rh, &RetirementHome::add_symptomatic_employee, inf_var);
 		} else if (agent.school_employee()){
 			School& sch = schools.at(agent.get_work_ID()-1);
-			sch.add_symptomatic_employee(inf_var);
+			add_contribution(sch, &School::add_symptomatic_employee, inf_var);
 		} else {
 			Workplace& workplace = workplaces.at(agent.get_work_ID()-1);
 			if (!workplace.outside_town()) {
-				workplace.add_symptomatic(inf_var);
+				add_contribution(workplace, &Workplace::add_symptomatic, inf_var);
 			}
 		}
 	}
 	// Transit
 	if (agent.get_work_travel_mode() == "carpool") {
 		Transit& carpool = carpools.at(agent.get_carpool_ID()-1);
-		carpool.add_symptomatic(inf_var);
+		add_contribution(carpool, &Transit::add_symptomatic, inf_var);
 	}
 	if (agent.get_work_travel_mode() == "public") {
 		Transit& bus = public_transit.at(agent.get_public_transit_ID()-1);
-		bus.add_symptomatic(inf_var);
+		add_contribution(bus, &Transit::add_symptomatic, inf_var);
 	}
 	// Leisure
 	if (agent.get_leisure_ID() > 0) {
 		if (agent.get_leisure_type() == "public") {
 			Leisure& les_loc = leisure_locations.at(agent.get_leisure_ID()-1);
 			if (!les_loc.outside_town()){
-				les_loc.add_symptomatic(inf_var);
+				add_contribution(les_loc, &Leisure::add_symptomatic, inf_var);
 			}
 		} else if (agent.get_leisure_type() == "household") {
 			Household& household = households.at(agent.get_leisure_ID()-1);
-			household.add_symptomatic(inf_var);
+			add_contribution(household, &Household::add_symptomatic, inf_var);
 		} else {
 			throw std::invalid_argument("Wrong leisure type: " + agent.get_leisure_type());
 		}
@@ -299,12 +326,12 @@ void Contributions::compute_hospital_tested_contributions(const Agent& agent,
 {
 	Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
 	if (agent.exposed()){
-		hospital.add_exposed_hospital_tested(inf_var);
+		add_contribution(hospital, &Hospital::add_exposed_hospital_tested, inf_var);
 	}else{
-		hospital.add_hospital_tested(inf_var);
+		add_contribution(hospital, &Hospital::add_hospital_tested, inf_var);
 	}
 	if (agent.home_isolated()){
-		hospital.increase_total_tested();
+		add_tested_count(hospital);
 	}
 }
 
@@ -316,16 +343,16 @@ void Contributions::compute_home_isolated_contributions(const Agent& agent,
 	if (agent.retirement_home_resident()){
 		RetirementHome& rh = retirement_homes.at(agent.get_household_ID()-1);
 		if (agent.exposed()){
-			rh.add_exposed_home_isolated(inf_var);
+			add_contribution(rh, &RetirementHome::add_exposed_home_isolated, inf_var);
 		}else{
-			rh.add_symptomatic_home_isolated(inf_var);
+			add_contribution(rh, &RetirementHome::add_symptomatic_home_isolated, inf_var);
 		}			
 	} else {
 		Household& household = households.at(agent.get_household_ID()-1);
 		if (agent.exposed()){
-			household.add_exposed_home_isolated(inf_var);
+			add_contribution(household, &Household::add_exposed_home_isolated, inf_var);
 		}else{
-			household.add_symptomatic_home_isolated(inf_var);
+			add_contribution(household, &Household::add_symptomatic_home_isolated, inf_var);
 		}	
 	}
 }
@@ -335,7 +362,7 @@ void Contributions::compute_hospitalized_contributions(const Agent& agent,
 				const double inf_var, std::vector<Hospital>& hospitals)   
 {
 	Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
-	hospital.add_hospitalized(inf_var);
+	add_contribution(hospital, &Hospital::add_hospitalized, inf_var);
 }
 
 /// \brief Count contributions of an agent hospitalized in ICU
@@ -343,7 +370,7 @@ void Contributions::compute_hospitalized_ICU_contributions(const Agent& agent,
 				const double inf_var, std::vector<Hospital>& hospitals)   
 {
 	Hospital& hospital = hospitals.at(agent.get_hospital_ID()-1);
-	hospital.add_hospitalized_ICU(inf_var);
+	add_contribution(hospital, &Hospital::add_hospitalized_ICU, inf_var);
 }
 
 /// \brief Set contributions/sums from all agents in places to 0.0 
@@ -365,4 +392,24 @@ void Contributions::reset_sums(std::vector<Household>& households, std::vector<S
 	std::for_each(leisure_locations.begin(), leisure_locations.end(), reset_contributions);
 }
 
+// Add all stored contributions to their places in the stored order
+void Contributions::apply_deferred(const std::vector<DeferredContribution>& buffer) const
+{
+	for (const auto& contribution : buffer){
+		if (contribution.add == nullptr){
+			static_cast<Hospital*>(contribution.place)->increase_total_tested();
+		} else {
+			(contribution.place->*contribution.add)(contribution.inf_var);
+		}
+	}
+}
 
+/// \brief Increase the number of tested in a hospital or store it if deferred
+void Contributions::add_tested_count(Hospital& hospital)
+{
+	if (deferred == nullptr){
+		hospital.increase_total_tested();
+	} else {
+		deferred->push_back({&hospital, nullptr, 0.0});
+	}
+}
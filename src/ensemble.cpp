@@ -0,0 +1,90 @@
+#include "../include/ensemble.h"
+
+/*****************************************************
+ * class: Ensemble
+ *
+ * Independent realizations of one initialized model
+ * run concurrently in a single process
+ *
+ ******************************************************/
+
+namespace {
+	// Reads a string in place, istringstream would copy it
+	class StateBuffer : public std::streambuf {
+	public:
+		explicit StateBuffer(const std::string& state)
+		{
+			char* first = const_cast<char*>(state.data());
+			setg(first, first, first + state.size());
+		}
+	};
+}
+
+// Store the state of an initialized model
+Ensemble::Ensemble(const ABM& abm)
+{
+	std::ostringstream out(std::ios::out | std::ios::binary);
+	abm.save_checkpoint(out);
+	state = out.str();
+}
+
+// Restore a copy of the stored model
+void Ensemble::restore(ABM& abm) const
+{
+	// Shared by all threads, only read
+	StateBuffer buffer(state);
+	std::istream in(&buffer);
+	abm.load_checkpoint(in);
+}
+
+// Run one realization for each seed
+std::vector<Ensemble::Series> Ensemble::run(const std::vector<uint64_t>& seeds, const int n_steps) const
+{
+	if (n_steps < 0){
+		throw std::invalid_argument("Number of steps in an ensemble run cannot be negative");
+	}
+	std::vector<Series> results(seeds.size());
+	const int n_threads = std::min(n_ensemble_threads, static_cast<int>(seeds.size()));
+	parallel_chunks(seeds.size(), n_threads,
+		[&](const int, const size_t first, const size_t last){
+			for (size_t i = first; i < last; ++i){
+				ABM abm;
+				restore(abm);
+				abm.set_seed(seeds.at(i));
+				if (prepare){
+					prepare(abm);
+				}
+				Series& series = results.at(i);
+				for (int ti = 0; ti < n_steps; ++ti){
+					collect(abm, series);
+					(abm.*propagate)();
+				}
+				collect(abm, series);
+			}
+		});
+	return results;
+}
+
+// Save one quantity of all realizations, one realization per line
+void Ensemble::print_series(const std::string& fname, const std::vector<Series>& results,
+					std::vector<int> Series::* quantity)
+{
+	std::vector<std::vector<int>> rows;
+	rows.reserve(results.size());
+	for (const auto& series : results){
+		rows.push_back(series.*quantity);
+	}
+	const size_t n_cols = rows.empty() ? 0 : rows.front().size();
+	AbmIO io(fname, " ", true, {rows.size(), n_cols});
+	io.write_vector(rows);
+}
+
+// Append values of the current step to the series
+void Ensemble::collect(const ABM& abm, Series& series)
+{
+	series.infected.push_back(abm.get_num_infected());
+	series.total_infected.push_back(abm.get_total_infected());
+	series.total_dead.push_back(abm.get_total_dead());
+	series.total_recovered.push_back(abm.get_total_recovered());
+	series.total_tested.push_back(abm.get_total_tested());
+}
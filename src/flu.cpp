@@ -8,29 +8,11 @@
  * 
  *****************************************************/
 
-// Remove a susceptible agent 
-void Flu::remove_susceptible_agent(const int index)
-{
-	std::vector<int> new_agent_IDs = {};
-	std::remove_copy(susceptible_agent_IDs.begin(), susceptible_agent_IDs.end(),
-					std::back_insert_iterator<std::vector<int>>(new_agent_IDs), index);
-	std::swap(new_agent_IDs, susceptible_agent_IDs);	
-}
-
-// Remove a flu agent 
-void Flu::remove_flu_agent(const int index)
-{
-	std::vector<int> new_agent_IDs = {};
-	std::remove_copy(flu_agent_IDs.begin(), flu_agent_IDs.end(),
-					std::back_insert_iterator<std::vector<int>>(new_agent_IDs), index);
-	std::swap(new_agent_IDs, flu_agent_IDs);	
-}
-
 // Remove recovered from flu, add new chosen randomly
 int Flu::swap_flu_agent(const int index)
 {
 	remove_flu_agent(index);
-	int n_susceptible = susceptible_agent_IDs.size();
+	int n_susceptible = susceptible_agents.size();
 	if (n_susceptible == 0){
 //		std::cout << "No susceptible left for modeling flu - returning"
 //				  << std::endl;
@@ -38,9 +20,9 @@ int Flu::swap_flu_agent(const int index)
 	}
 	// Pick from available susceptible
 	int ind = rng.get_random_int(0, n_susceptible - 1);
-	int agent_ind = susceptible_agent_IDs.at(ind);
+	int agent_ind = susceptible_agents.at(ind);
 	remove_susceptible_agent(agent_ind);
-	flu_agent_IDs.push_back(agent_ind);
+	flu_agents.add(agent_ind);
 	// Actual agent ID
 	return agent_ind;
 }
@@ -48,14 +30,14 @@ int Flu::swap_flu_agent(const int index)
 // Create initial flu population
 std::vector<int> Flu::generate_flu()
 {
-	int n_flu = nc_sy_frac*susceptible_agent_IDs.size();
+	int n_flu = nc_sy_frac*susceptible_agents.size();
 	for (int i=0; i<n_flu; ++i){
-		int ind = rng.get_random_int(0, susceptible_agent_IDs.size() - 1);
-		int agent_ind = susceptible_agent_IDs.at(ind);
+		int ind = rng.get_random_int(0, susceptible_agents.size() - 1);
+		int agent_ind = susceptible_agents.at(ind);
 		remove_susceptible_agent(agent_ind);
-		flu_agent_IDs.push_back(agent_ind);
+		flu_agents.add(agent_ind);
 	}
-	return flu_agent_IDs;
+	return flu_agents.get_IDs();
 }
 
 
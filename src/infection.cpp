@@ -43,13 +43,7 @@ double Infection::inf_variability()
 bool Infection::recovering_exposed(const int age)
 {
 	// Probability of recovery without symptoms
-	double prob = 0;
-	for (const auto& pxp : expN2sy_fractions){
-		if ( age >= std::get<0>(pxp.second) &&
-			 age <= std::get<1>(pxp.second)){
-			prob = std::get<2>(pxp.second);
-		}
-	}
+	const double prob = at_age(prob_exposed_never_sy, age);
 	if (rng.get_random(0.0, 1.0) <= prob)
 		return true;
 	else
@@ -84,13 +78,7 @@ bool Infection::false_positive_test_result(const double prob)
 bool Infection::agent_hospitalized(const int age)
 {
 	// Probability of hospitalization 
-	double prob = 0;
-	for (const auto& hsp : hospitalization_rates){
-		if ( age >= std::get<0>(hsp.second) &&
-			 age <= std::get<1>(hsp.second)){
-			prob = std::get<2>(hsp.second);
-		}
-	}
+	const double prob = at_age(prob_hospitalized, age);
 
 	// true if going to be hospitalized 
 	if (rng.get_random(0.0, 1.0) <= prob)
@@ -103,13 +91,7 @@ bool Infection::agent_hospitalized(const int age)
 bool Infection::agent_hospitalized_ICU(const int age)
 {
 	// Probability of hospitalization in ICU
-	double prob = 0;
-	for (const auto& icu : ICU_rates){
-		if ( age >= std::get<0>(icu.second) &&
-			 age <= std::get<1>(icu.second)){
-			prob = std::get<2>(icu.second);
-		}
-	}
+	const double prob = at_age(prob_hospitalized_ICU, age);
 
 	// true if going to be hospitalized in ICU
 	if (rng.get_random(0.0, 1.0) <= prob)
@@ -121,54 +103,8 @@ bool Infection::agent_hospitalized_ICU(const int age)
 // Determine if agent will die 
 bool Infection::will_die_non_icu(const int age, const bool is_hsp)
 {
-	double tot_prob = 0.0, non_icu_prob =0.0;
-	double prob_hsp = 0.0, prob_hsp_icu = 0.0;
-	double prob_need_icu = 0.0, prob_die_need_icu = 0.0;
-	double exp_never_sy_age = 0.0;
-
-	// Probability exposed never symptomatic
-	for (const auto& pxp : expN2sy_fractions){
-		if ( age >= std::get<0>(pxp.second) &&
-			 age <= std::get<1>(pxp.second)){
-			exp_never_sy_age = std::get<2>(pxp.second);
-		}
-	}
-
-	// Probability of death (corrected IFR) 
-	for (const auto& mrt : mortality_rates){
-		if ( age >= std::get<0>(mrt.second) &&
-			 age <= std::get<1>(mrt.second)){
-			tot_prob = std::get<2>(mrt.second)/(1-exp_never_sy_age);
-		}
-	}
-	// Probability of hospitalization
-	for (const auto& hsp : hospitalization_rates){
-		if ( age >= std::get<0>(hsp.second) &&
-			 age <= std::get<1>(hsp.second)){
-			prob_hsp = std::get<2>(hsp.second);
-		}
-	}
-	// Probability of hospitalization in ICU
-	for (const auto& icu : ICU_rates){
-		if ( age >= std::get<0>(icu.second) &&
-			 age <= std::get<1>(icu.second)){
-			prob_hsp_icu = std::get<2>(icu.second);
-		}
-	}
-
-	prob_need_icu = prob_hsp*prob_hsp_icu;
-	
-	if (is_hsp == false){
-		prob_die_need_icu = prob_death_icu*prob_sy_tested + prob_death_not_admitted*(1-prob_sy_tested);
-	} else {
-		prob_die_need_icu = prob_death_icu;
-	}
-
-	if (equal_floats<double>(prob_need_icu, 1.0, 1e-5)){
-		non_icu_prob = 0.0;
-	}else{
-		non_icu_prob = (tot_prob - prob_die_need_icu*prob_need_icu)/(1-prob_need_icu); 
-	}
+	const double non_icu_prob = is_hsp ? at_age(prob_death_non_icu_hsp, age) 
+										: at_age(prob_death_non_icu, age);
 
 	// true if going to die
 	if (rng.get_random(0.0, 1.0) <= non_icu_prob){
@@ -240,6 +176,7 @@ void Infection::set_expN2sy_fractions(const std::map<std::string, double> raw_ra
 		ages = parse_age_group(rr.first);
 		expN2sy_fractions[rr.first] = std::make_tuple(ages[0], ages[1], rr.second);
 	}
+	compute_age_tables();
 }
 
 // Process and store the age-dependent mortality rate distribution
@@ -251,6 +188,7 @@ void Infection::set_mortality_rates(const std::map<std::string, double> raw_rate
 		ages = parse_age_group(rr.first);
 		mortality_rates[rr.first] = std::make_tuple(ages[0], ages[1], rr.second);
 	}
+	compute_age_tables();
 }
 
 // Process and store the age-dependent hospitalization fraction distribution
@@ -262,6 +200,7 @@ void Infection::set_hospitalized_fractions(const std::map<std::string, double> r
 		ages = parse_age_group(rr.first);
 		hospitalization_rates[rr.first] = std::make_tuple(ages[0], ages[1], rr.second);
 	}
+	compute_age_tables();
 }
 
 // Process and store the age-dependent ICU hospitalization fraction distribution
@@ -273,6 +212,7 @@ void Infection::set_hospitalized_ICU_fractions(const std::map<std::string, doubl
 		ages = parse_age_group(rr.first);
 		ICU_rates[rr.first] = std::make_tuple(ages[0], ages[1], rr.second);
 	}
+	compute_age_tables();
 }
 
 //
@@ -296,6 +236,56 @@ std::vector<int> Infection::parse_age_group(const std::string group_range)
 	return ages;
 }
 
+// Recompute the per-age probability tables
+void Infection::compute_age_tables()
+{
+	// Oldest age in any group
+	int max_age = -1;
+	for (const auto& dist : {&expN2sy_fractions, &mortality_rates, &hospitalization_rates, &ICU_rates}){
+		for (const auto& group : *dist){
+			max_age = std::max(max_age, std::get<1>(group.second));
+		}
+	}
+	const size_t n_ages = static_cast<size_t>(max_age + 1);
+
+	// If age groups overlap, the last one in the 
+	// map applies, same as when searching them
+	auto fill_table = [n_ages](const std::map<std::string, std::tuple<int, int, double>>& dist, 
+							std::vector<double>& table){
+		table.assign(n_ages, 0.0);
+		for (const auto& group : dist){
+			for (int age = std::max(0, std::get<0>(group.second)); age <= std::get<1>(group.second); ++age){
+				table.at(age) = std::get<2>(group.second);
+			}
+		}
+	};
+	fill_table(expN2sy_fractions, prob_exposed_never_sy);
+	fill_table(hospitalization_rates, prob_hospitalized);
+	fill_table(ICU_rates, prob_hospitalized_ICU);
+
+	// Probability of death (corrected IFR), 0 if not in any group 
+	std::vector<double> tot_prob(n_ages, 0.0);
+	for (const auto& mrt : mortality_rates){
+		for (int age = std::max(0, std::get<0>(mrt.second)); age <= std::get<1>(mrt.second); ++age){
+			tot_prob.at(age) = std::get<2>(mrt.second)/(1-prob_exposed_never_sy.at(age));
+		}
+	}
+
+	// Split into mortality of those that need ICU and the rest
+	const double prob_die_need_icu = prob_death_icu*prob_sy_tested + prob_death_not_admitted*(1-prob_sy_tested);
+	const double prob_die_need_icu_hsp = prob_death_icu;
+	prob_death_non_icu.assign(n_ages, 0.0);
+	prob_death_non_icu_hsp.assign(n_ages, 0.0);
+	for (size_t age = 0; age < n_ages; ++age){
+		const double prob_need_icu = prob_hospitalized.at(age)*prob_hospitalized_ICU.at(age);
+		if (equal_floats<double>(prob_need_icu, 1.0, 1e-5)){
+			continue;
+		}
+		prob_death_non_icu.at(age) = (tot_prob.at(age) - prob_die_need_icu*prob_need_icu)/(1-prob_need_icu); 
+		prob_death_non_icu_hsp.at(age) = (tot_prob.at(age) - prob_die_need_icu_hsp*prob_need_icu)/(1-prob_need_icu); 
+	}
+}
+
 // Compute if agent got infected
 bool Infection::infected(const double lambda)
 {
@@ -10,66 +10,52 @@
 // Read parameters from file, store the as a map
 std::map<std::string, double> LoadParameters::load_parameter_map(const std::string infile)
 {
-	FileHandler file(infile);
-	std::fstream &in = file.get_stream();
-	std::string line;
-
 	std::map<std::string, double> parameters;
+	std::string tag = {};
 
-	std::string tag = {}, word = {};
-
-	while (std::getline(in, line)){
-		
-		std::istringstream data_row(line);
+	TextReader reader(infile);
+	reader.for_each_line([&](const std::vector<TextReader::Token>& line){
+		if (line.empty()) {
+			return;
+		}
 
 		// If a comment with a tag, save all words
-		if (line.find("//") != std::string::npos){
-			// Skip the // entry and blank line, 
-			// then collect the rest
-			data_row >> word;
-			while (data_row >> word)
-				tag += (word + " ");
+		const bool comment = std::any_of(line.begin(), line.end(),
+				[](const TextReader::Token& word){ 
+					return std::search(word.begin(), word.end(), "//", "//" + 2) != word.end(); });
+		if (comment) {
+			// Skip the // entry, then collect the rest
+			for (size_t i = 1; i < line.size(); ++i) {
+				tag.append(line[i].begin(), line[i].end());
+				tag += ' ';
+			}
 			// Remove the extra blank character
 			if (!tag.empty())
 				tag.pop_back();
-			continue;
+			return;
 		}
 
 		// If not - collect the number, make a map entry,
 		// and reset the tag
-		data_row >> word;
-		parameters[tag] = std::stod(word);
+		parameters[tag] = line.front().as<double>();
 		tag.clear();
-	}
+	});
 	return parameters;
 }
 
 // Read age-dependent distributions as map, store the as a map
 std::map<std::string, double> LoadParameters::load_age_dependent(const std::string infile)
 {
-	FileHandler file(infile);
-	std::fstream &in = file.get_stream();
-	std::string line;
-
 	std::map<std::string, double> age_distribution;
 
-	std::string tag = {}, word = {};
-	double value = 0.0;
-
-	while (std::getline(in, line)){
-		std::istringstream data_row(line);
-
-		// Read the key
-		data_row >> word;
-		tag = word;
-
-		// And the value
-		data_row >> word;
-		value = std::stod(word);
-
-		// Assign
-		age_distribution[tag] = value;
-	}
+	TextReader reader(infile);
+	reader.for_each_line([&](const std::vector<TextReader::Token>& line){
+		if (line.empty()) {
+			return;
+		}
+		// Key, then the value
+		age_distribution[line.at(0).str()] = line.at(1).as<double>();
+	});
 
 	return age_distribution;
 }
@@ -0,0 +1,542 @@
+#include "../../include/io_operations/population_generator.h"
+
+/***************************************************************
+ * class: PopulationGenerator
+ *
+ * Synthetic towns of any size, written in the formats
+ * of the ABM::create_ functions
+ *
+ **************************************************************/
+
+namespace {
+	// Appends a number to a line
+	void append(std::string& line, const int value)
+	{
+		line += std::to_string(value);
+		line += ' ';
+	}
+	void append(std::string& line, const double value, const int precision)
+	{
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%.*f ", precision, value);
+		line += buffer;
+	}
+	// Writes lines formatted in blocks, in the order of blocks
+	void write_blocks(const std::string& fname, const std::vector<std::string>& blocks)
+	{
+		std::ofstream out(fname);
+		if (!out.is_open()){
+			throw std::runtime_error("Error opening file " + fname);
+		}
+		for (const auto& block : blocks){
+			out << block;
+		}
+	}
+}
+
+PopulationGenerator::PopulationGenerator(const Parameters& par_in) : par(par_in)
+{
+	check_parameters();
+	// Same density as New Rochelle, 80000 agents in about 0.1 x 0.1 degrees
+	side = (par.side > 0.0) ? par.side : 0.1*std::sqrt(par.n_agents/80000.0);
+}
+
+// Read town properties from file
+PopulationGenerator::Parameters PopulationGenerator::load_parameters(const std::string& fname)
+{
+	Parameters par;
+	std::map<std::string, double*> values = {
+		{"center x", &par.center_x}, {"center y", &par.center_y}, {"side", &par.side},
+		{"school size mean", &par.school_size_mean}, {"school size sd", &par.school_size_sd},
+		{"workplace size mean", &par.workplace_size_mean},
+		{"workplace size sd", &par.workplace_size_sd},
+		{"retirement home size", &par.retirement_home_size},
+		{"carpool size", &par.carpool_size},
+		{"agents per hospital", &par.agents_per_hospital},
+		{"agents per public transit", &par.agents_per_public_transit},
+		{"agents per leisure location", &par.agents_per_leisure_location},
+		{"fraction leisure outside", &par.fraction_leisure_outside},
+		{"fraction hospital patients", &par.fraction_hospital_patients},
+		{"fraction retirement home residents", &par.fraction_retirement_home_residents},
+		{"fraction students", &par.fraction_students},
+		{"fraction employed", &par.fraction_employed},
+		{"fraction hospital staff", &par.fraction_hospital_staff},
+		{"fraction retirement home staff", &par.fraction_retirement_home_staff},
+		{"fraction school staff", &par.fraction_school_staff},
+		{"fraction working outside", &par.fraction_working_outside},
+		{"fraction working from home", &par.fraction_working_from_home},
+		{"min travel time", &par.min_travel_time},
+		{"max travel time", &par.max_travel_time},
+		{"fraction infected", &par.fraction_infected} };
+	std::map<std::string, std::vector<double>*> distributions = {
+		{"age groups", &par.age_groups}, {"household sizes", &par.household_sizes},
+		{"travel modes", &par.travel_modes} };
+
+	std::string tag = {};
+	TextReader reader(fname);
+	reader.for_each_line([&](const std::vector<TextReader::Token>& line){
+		if (line.empty()) {
+			return;
+		}
+		// Property name, all words after the //
+		if (line.front() == "//") {
+			tag.clear();
+			for (size_t i = 1; i < line.size(); ++i) {
+				tag.append(line[i].begin(), line[i].end());
+				tag += ' ';
+			}
+			if (!tag.empty())
+				tag.pop_back();
+			return;
+		}
+		if (tag == "n agents") {
+			par.n_agents = line.front().as<int>();
+		} else if (tag == "seed") {
+			par.seed = line.front().as<uint64_t>();
+		} else if (values.count(tag)) {
+			*values.at(tag) = line.front().as<double>();
+		} else if (distributions.count(tag)) {
+			std::vector<double>& dist = *distributions.at(tag);
+			dist.clear();
+			for (const auto& entry : line) {
+				dist.push_back(entry.as<double>());
+			}
+		} else {
+			throw std::invalid_argument("Unknown town property: " + tag);
+		}
+		tag.clear();
+	});
+	return par;
+}
+
+// Generate the town and write all its files
+void PopulationGenerator::generate(const std::string& prefix, const int n_threads)
+{
+	draw_agents(n_threads);
+	create_places(n_threads);
+
+	write_places(prefix + "_households.txt", households, n_threads,
+		[](const GeneratedPlace&){ return std::string(); });
+	write_places(prefix + "_retirement_homes.txt", retirement_homes, n_threads,
+		[](const GeneratedPlace&){ return std::string(); });
+	write_places(prefix + "_hospitals.txt", hospitals, n_threads,
+		[](const GeneratedPlace&){ return std::string(); });
+	write_places(prefix + "_schools.txt", schools, n_threads,
+		[](const GeneratedPlace& place){ return school_types().at(place.type); });
+	// Type is "outside" for workplaces outside of town
+	write_places(prefix + "_workplaces.txt", workplaces, n_threads,
+		[](const GeneratedPlace& place){ return (place.type < 0 ? std::string("outside")
+						: occupations().at(place.type)) + " 0"; });
+	write_places(prefix + "_leisure.txt", leisure_locations, n_threads,
+		[](const GeneratedPlace& place){ return std::string(place.type == 0 ? "intown" : "outside"); });
+	write_transit(prefix + "_carpool.txt", n_carpools, "32.0 10010");
+	write_transit(prefix + "_public.txt", n_public, "17.0 10701");
+	write_agents(prefix + "_agents.txt", n_threads);
+}
+
+//
+// Parameters
+//
+
+// Checks the parameters, throws if not valid
+void PopulationGenerator::check_parameters() const
+{
+	if (par.n_agents < 1) {
+		throw std::invalid_argument("Town needs at least one agent");
+	}
+	if (par.side < 0.0) {
+		throw std::invalid_argument("Side of the town cannot be negative");
+	}
+	const std::vector<double> positive = {par.school_size_mean, par.school_size_sd,
+		par.workplace_size_mean, par.workplace_size_sd, par.retirement_home_size,
+		par.carpool_size, par.agents_per_hospital, par.agents_per_public_transit,
+		par.agents_per_leisure_location};
+	if (std::any_of(positive.begin(), positive.end(), [](const double v){ return v <= 0.0; })) {
+		throw std::invalid_argument("Place sizes need to be positive");
+	}
+	const std::vector<double> fractions = {par.fraction_leisure_outside,
+		par.fraction_hospital_patients, par.fraction_retirement_home_residents,
+		par.fraction_students, par.fraction_employed, par.fraction_working_outside,
+		par.fraction_working_from_home, par.fraction_infected,
+		par.fraction_hospital_staff + par.fraction_retirement_home_staff + par.fraction_school_staff};
+	if (std::any_of(fractions.begin(), fractions.end(), [](const double v){ return v < 0.0 || v > 1.0; })
+			|| par.fraction_hospital_staff < 0.0 || par.fraction_retirement_home_staff < 0.0
+			|| par.fraction_school_staff < 0.0) {
+		throw std::invalid_argument("Fractions of agents need to be between 0 and 1");
+	}
+	if (par.age_groups.size() > 10) {
+		throw std::invalid_argument("Age groups cover at most 0-99");
+	}
+	if (par.travel_modes.size() != travel_modes().size()) {
+		throw std::invalid_argument("Travel mode fractions need one value per mode");
+	}
+	for (const auto dist : {&par.age_groups, &par.household_sizes, &par.travel_modes}) {
+		if (dist->empty() || std::any_of(dist->begin(), dist->end(), [](const double v){ return v < 0.0; })
+				|| std::accumulate(dist->begin(), dist->end(), 0.0) <= 0.0) {
+			throw std::invalid_argument("Size distributions need non-negative fractions with a positive sum");
+		}
+	}
+	if (par.min_travel_time < 0.0 || par.max_travel_time < par.min_travel_time) {
+		throw std::invalid_argument("Wrong range of travel times");
+	}
+}
+
+//
+// Agents
+//
+
+// Draws agent properties other than the place IDs
+void PopulationGenerator::draw_agents(const int n_threads)
+{
+	agents.assign(par.n_agents, GeneratedAgent());
+	const size_t n_agent_blocks = n_blocks(agents.size());
+	parallel_chunks(n_agent_blocks, n_threads, [this](int, size_t first, size_t last){
+		RNG rng(par.seed);
+		for (size_t b = first; b < last; ++b) {
+			rng.set_stream(b, agent_stage, RNG::general);
+			const size_t end = std::min(agents.size(), (b + 1)*block_size);
+			for (size_t i = b*block_size; i < end; ++i) {
+				draw_agent(agents[i], rng);
+			}
+		}
+	});
+}
+
+void PopulationGenerator::draw_agent(GeneratedAgent& agent, RNG& rng) const
+{
+	agent.age = 10*draw_index(par.age_groups, rng) + rng.get_random_int(0, 9);
+	agent.infected = rng.get_random(0.0, 1.0) < par.fraction_infected;
+
+	// Non-COVID hospital patients and retirement home
+	// residents do not go to school or work
+	if (rng.get_random(0.0, 1.0) < par.fraction_hospital_patients) {
+		agent.residence = hospital;
+		return;
+	}
+	if (agent.age >= 65 && rng.get_random(0.0, 1.0) < par.fraction_retirement_home_residents) {
+		agent.residence = retirement_home;
+		return;
+	}
+
+	// Students, school type by age
+	if (agent.age <= 22 && rng.get_random(0.0, 1.0) < par.fraction_students) {
+		if (agent.age < 5)
+			agent.school_type = 0;
+		else if (agent.age < 11)
+			agent.school_type = 1;
+		else if (agent.age < 14)
+			agent.school_type = 2;
+		else if (agent.age < 18)
+			agent.school_type = 3;
+		else
+			agent.school_type = 4;
+	}
+
+	// Workers
+	if (agent.age < 18 || agent.age >= 70 || rng.get_random(0.0, 1.0) >= par.fraction_employed) {
+		return;
+	}
+	const double role = rng.get_random(0.0, 1.0);
+	if (role < par.fraction_hospital_staff) {
+		agent.role = hospital_staff;
+	} else if (role < par.fraction_hospital_staff + par.fraction_retirement_home_staff) {
+		agent.role = retirement_home_staff;
+	} else if (role < par.fraction_hospital_staff + par.fraction_retirement_home_staff
+						+ par.fraction_school_staff) {
+		agent.role = school_staff;
+	} else {
+		agent.role = (rng.get_random(0.0, 1.0) < par.fraction_working_outside) ? outside : regular;
+		agent.works_from_home = rng.get_random(0.0, 1.0) < par.fraction_working_from_home;
+	}
+	// Staff have occupation A, in-town workers that of their
+	// workplace once assigned
+	if (agent.role == outside) {
+		agent.occupation = rng.get_random_int(0, occupations().size() - 1);
+	} else if (agent.role != regular) {
+		agent.occupation = 0;
+	}
+	if (!agent.works_from_home) {
+		agent.travel_mode = draw_index(par.travel_modes, rng);
+		agent.travel_time = rng.get_random(par.min_travel_time, par.max_travel_time);
+	}
+}
+
+//
+// Places
+//
+
+// Creates places and assigns agents to them
+void PopulationGenerator::create_places(const int n_threads)
+{
+	// Members of places filled to drawn sizes
+	int n_residents = 0, n_rh_residents = 0, n_regular = 0, n_outside = 0,
+		n_carpool = 0;
+	std::array<int, n_school_types> n_students = {{}};
+	for (const auto& agent : agents) {
+		n_residents += (agent.residence == household);
+		n_rh_residents += (agent.residence == retirement_home);
+		n_regular += (agent.role == regular);
+		n_outside += (agent.role == outside);
+		n_carpool += (agent.travel_mode == 1);
+		if (agent.school_type >= 0) {
+			++n_students.at(agent.school_type);
+		}
+	}
+
+	// Sizes are drawn in sequence from a single stream
+	RNG rng(par.seed);
+	rng.set_stream(0, sizes_stage, RNG::general);
+	households.clear();
+	const std::vector<int> house_IDs = fill_households(n_residents, rng);
+	schools.clear();
+	std::array<std::vector<int>, n_school_types> school_IDs;
+	for (int t = 0; t < n_school_types; ++t) {
+		school_IDs.at(t) = fill_places(n_students.at(t), schools, t,
+								par.school_size_mean, par.school_size_sd, rng);
+	}
+	// School staff need a school even if there are no students
+	if (schools.empty()) {
+		schools.push_back(GeneratedPlace{0.0, 0.0, 1});
+	}
+	workplaces.clear();
+	const std::vector<int> work_IDs = fill_places(n_regular, workplaces, 0,
+								par.workplace_size_mean, par.workplace_size_sd, rng);
+	for (auto& work : workplaces) {
+		work.type = rng.get_random_int(0, occupations().size() - 1);
+	}
+	const std::vector<int> outside_IDs = fill_places(n_outside, workplaces, -1,
+								par.workplace_size_mean, par.workplace_size_sd, rng);
+
+	// Places with a number set by the population
+	retirement_homes.assign(std::max(1, static_cast<int>(std::ceil(n_rh_residents/par.retirement_home_size))),
+								GeneratedPlace());
+	hospitals.assign(std::max(1, static_cast<int>(std::round(par.n_agents/par.agents_per_hospital))),
+								GeneratedPlace());
+	const int n_leisure = std::max(1, static_cast<int>(std::round(par.n_agents/par.agents_per_leisure_location)));
+	const int n_leisure_outside = std::round(n_leisure*par.fraction_leisure_outside);
+	leisure_locations.assign(n_leisure, GeneratedPlace());
+	for (int i = n_leisure - n_leisure_outside; i < n_leisure; ++i) {
+		leisure_locations.at(i).type = 1;
+	}
+	n_carpools = std::max(1, static_cast<int>(std::ceil(n_carpool/par.carpool_size)));
+	n_public = std::max(1, static_cast<int>(std::round(par.n_agents/par.agents_per_public_transit)));
+
+	// Places filled to their sizes, in order of agents
+	size_t i_house = 0, i_work = 0, i_outside = 0;
+	std::array<size_t, n_school_types> i_school = {{}};
+	for (auto& agent : agents) {
+		if (agent.residence == household) {
+			agent.home_ID = house_IDs.at(i_house++);
+		}
+		if (agent.school_type >= 0) {
+			agent.school_ID = school_IDs.at(agent.school_type).at(i_school.at(agent.school_type)++);
+		}
+		if (agent.role == regular) {
+			agent.work_ID = work_IDs.at(i_work++);
+			agent.occupation = workplaces.at(agent.work_ID - 1).type;
+		} else if (agent.role == outside) {
+			agent.work_ID = outside_IDs.at(i_outside++);
+		}
+	}
+
+	// Uniformly chosen places
+	parallel_chunks(n_blocks(agents.size()), n_threads, [this](int, size_t first, size_t last){
+		RNG rng(par.seed);
+		for (size_t b = first; b < last; ++b) {
+			rng.set_stream(b, assignment_stage, RNG::general);
+			const size_t end = std::min(agents.size(), (b + 1)*block_size);
+			for (size_t i = b*block_size; i < end; ++i) {
+				GeneratedAgent& agent = agents[i];
+				if (agent.residence == retirement_home) {
+					agent.home_ID = rng.get_random_int(1, retirement_homes.size());
+				} else if (agent.residence == hospital) {
+					agent.home_ID = rng.get_random_int(1, hospitals.size());
+				}
+				if (agent.role == hospital_staff) {
+					agent.work_ID = rng.get_random_int(1, hospitals.size());
+				} else if (agent.role == retirement_home_staff) {
+					agent.work_ID = rng.get_random_int(1, retirement_homes.size());
+				} else if (agent.role == school_staff) {
+					agent.work_ID = rng.get_random_int(1, schools.size());
+				}
+				if (agent.travel_mode == 1) {
+					agent.transit_ID = rng.get_random_int(1, n_carpools);
+				} else if (agent.travel_mode == 2) {
+					agent.transit_ID = rng.get_random_int(1, n_public);
+				}
+			}
+		}
+	});
+
+	// Coordinates
+	locate_places(households, 0, n_threads);
+	locate_places(retirement_homes, 1, n_threads);
+	locate_places(hospitals, 2, n_threads);
+	locate_places(schools, 3, n_threads);
+	locate_places(workplaces, 4, n_threads);
+	locate_places(leisure_locations, 5, n_threads);
+}
+
+// Places filled to lognormal sizes until they fit all members
+std::vector<int> PopulationGenerator::fill_places(const int n_members, std::vector<GeneratedPlace>& places,
+						const int type, const double mean, const double sd, RNG& rng) const
+{
+	// Parameters of the underlying normal distribution
+	const double s2 = std::log(1.0 + sd*sd/(mean*mean));
+	const double mu = std::log(mean) - s2/2.0;
+	std::vector<int> slots;
+	while (static_cast<int>(slots.size()) < n_members) {
+		const int size = std::max(1, static_cast<int>(std::round(rng.get_random_lognormal(mu, std::sqrt(s2)))));
+		places.push_back(GeneratedPlace{0.0, 0.0, type});
+		slots.insert(slots.end(), size, places.size());
+	}
+	// Random members of each place, the last places are
+	// not full on average
+	rng.vector_shuffle(slots);
+	slots.resize(n_members);
+	return slots;
+}
+
+// Households filled in order, the last may be smaller than drawn
+std::vector<int> PopulationGenerator::fill_households(const int n_members, RNG& rng)
+{
+	std::vector<int> slots;
+	slots.reserve(n_members);
+	while (static_cast<int>(slots.size()) < n_members) {
+		const int size = std::min(draw_index(par.household_sizes, rng) + 1,
+								n_members - static_cast<int>(slots.size()));
+		households.push_back(GeneratedPlace());
+		slots.insert(slots.end(), size, households.size());
+	}
+	return slots;
+}
+
+// Random coordinates of places in the town
+void PopulationGenerator::locate_places(std::vector<GeneratedPlace>& places, const uint32_t table,
+						const int n_threads) const
+{
+	parallel_chunks(n_blocks(places.size()), n_threads, [this, &places, table](int, size_t first, size_t last){
+		RNG rng(par.seed);
+		for (size_t b = first; b < last; ++b) {
+			rng.set_stream(b, place_stage + table, RNG::general);
+			const size_t end = std::min(places.size(), (b + 1)*block_size);
+			for (size_t i = b*block_size; i < end; ++i) {
+				places[i].x = par.center_x + (rng.get_random(0.0, 1.0) - 0.5)*side;
+				places[i].y = par.center_y + (rng.get_random(0.0, 1.0) - 0.5)*side;
+			}
+		}
+	});
+}
+
+//
+// Output
+//
+
+// ID x y [type]
+void PopulationGenerator::write_places(const std::string& fname, const std::vector<GeneratedPlace>& places,
+						const int n_threads, const std::function<std::string(const GeneratedPlace&)>& type) const
+{
+	std::vector<std::string> blocks(n_blocks(places.size()));
+	parallel_chunks(blocks.size(), n_threads, [&](int, size_t first, size_t last){
+		for (size_t b = first; b < last; ++b) {
+			std::string& text = blocks.at(b);
+			const size_t end = std::min(places.size(), (b + 1)*block_size);
+			for (size_t i = b*block_size; i < end; ++i) {
+				append(text, static_cast<int>(i + 1));
+				append(text, places[i].x, 6);
+				append(text, places[i].y, 6);
+				text += type(places[i]);
+				// No trailing space
+				if (text.back() == ' ')
+					text.pop_back();
+				text += '\n';
+			}
+		}
+	});
+	write_blocks(fname, blocks);
+}
+
+// ID type travel information
+void PopulationGenerator::write_transit(const std::string& fname, const int n, const std::string& info) const
+{
+	std::string text;
+	for (int i = 1; i <= n; ++i) {
+		append(text, i);
+		text += "outside " + info + '\n';
+	}
+	write_blocks(fname, {text});
+}
+
+// One agent per line, columns as read by ABM::create_agents
+void PopulationGenerator::write_agents(const std::string& fname, const int n_threads) const
+{
+	std::vector<std::string> blocks(n_blocks(agents.size()));
+	parallel_chunks(blocks.size(), n_threads, [&](int, size_t first, size_t last){
+		for (size_t b = first; b < last; ++b) {
+			std::string& text = blocks.at(b);
+			const size_t end = std::min(agents.size(), (b + 1)*block_size);
+			for (size_t i = b*block_size; i < end; ++i) {
+				const GeneratedAgent& agent = agents[i];
+				const GeneratedPlace& home = (agent.residence == household) ? households.at(agent.home_ID - 1)
+						: (agent.residence == retirement_home) ? retirement_homes.at(agent.home_ID - 1)
+						: hospitals.at(agent.home_ID - 1);
+				const bool in_hospital = (agent.residence == hospital);
+				const bool works = (agent.role != none && agent.role != hospital_staff);
+				const bool special = (agent.role == hospital_staff || agent.role == retirement_home_staff
+										|| agent.role == school_staff);
+				// student works age x y hID
+				append(text, static_cast<int>(agent.school_type >= 0));
+				append(text, static_cast<int>(works));
+				append(text, agent.age);
+				append(text, home.x, 6);
+				append(text, home.y, 6);
+				append(text, in_hospital ? 0 : agent.home_ID);
+				// hsp_patient sID rh_res rh_emp school_emp wID
+				append(text, static_cast<int>(in_hospital));
+				append(text, agent.school_ID);
+				append(text, static_cast<int>(agent.residence == retirement_home));
+				append(text, static_cast<int>(agent.role == retirement_home_staff));
+				append(text, static_cast<int>(agent.role == school_staff));
+				append(text, works ? agent.work_ID : 0);
+				// hsp_emp hspID infected wfh travel_time mode
+				append(text, static_cast<int>(agent.role == hospital_staff));
+				append(text, in_hospital ? agent.home_ID : (agent.role == hospital_staff ? agent.work_ID : 0));
+				append(text, static_cast<int>(agent.infected));
+				append(text, static_cast<int>(agent.works_from_home));
+				if (agent.travel_mode >= 0) {
+					append(text, agent.travel_time, 2);
+					text += travel_modes().at(agent.travel_mode) + ' ';
+				} else {
+					text += agent.works_from_home ? "0 wfh " : "0 None ";
+				}
+				// special_wID carpoolID publicID occupation
+				append(text, special ? agent.work_ID : 0);
+				append(text, agent.travel_mode == 1 ? agent.transit_ID : 0);
+				append(text, agent.travel_mode == 2 ? agent.transit_ID : 0);
+				text += (agent.occupation >= 0) ? occupations().at(agent.occupation) : "none";
+				text += '\n';
+			}
+		}
+	});
+	write_blocks(fname, blocks);
+}
+
+// Samples an index from a distribution of fractions
+int PopulationGenerator::draw_index(const std::vector<double>& fractions, RNG& rng)
+{
+	const double total = std::accumulate(fractions.begin(), fractions.end(), 0.0);
+	double value = rng.get_random(0.0, total);
+	for (size_t i = 0; i < fractions.size(); ++i) {
+		value -= fractions[i];
+		if (value < 0.0) {
+			return i;
+		}
+	}
+	// Rounding at the upper end, the last nonzero fraction
+	for (size_t i = fractions.size(); i > 0; --i) {
+		if (fractions[i-1] > 0.0) {
+			return i - 1;
+		}
+	}
+	return 0;
+}
@@ -21,24 +21,167 @@ void Mobility::construct_public_probabilities(const std::vector<Household>& hous
 		kappa = 400.0;
 		beta = 1.75;
 	}
-	// Compute the ditances and probabilities for all locations
-	double dij = 0.0, pij = 0.0;
+	// Sines and cosines of all locations, so that distances 
+	// of each pair need no trigonometric functions
+	HalfAngles houses, leisure;
 	for (const auto& house : households) {
-		std::vector<double> probs = {};
-		for (const auto& leisure : leisure_locations) {
-			dij = compute_distance(house, leisure);
-			pij = compute_probability(dij);
-			probs.push_back(pij);	
+		houses.add(house, pi/180.0);
+	}
+	for (const auto& location : leisure_locations) {
+		leisure.add(location, pi/180.0);
+	}
+
+	// Compute the ditances and probabilities for all locations
+	// and store the locations each household can visit
+	n_public_locations = leisure_locations.size();
+	public_probabilities.clear();
+	public_probabilities.resize(households.size());
+	std::vector<double> errors(households.size(), 0.0);
+	parallel_chunks(households.size(), n_construction_threads, 
+		[&](int, size_t first, size_t last) {
+			std::vector<double> probs(leisure_locations.size(), 0.0);
+			for (size_t ih=first; ih<last; ++ih) {
+				compute_probabilities(houses, ih, leisure, probs);
+				public_probabilities.at(ih) = make_table(probs, errors.at(ih));
+			}
+		});
+
+	max_truncation_error = 0.0;
+	total_truncation_error = 0.0;
+	for (const auto& error : errors) {
+		max_truncation_error = std::max(max_truncation_error, error);
+		total_truncation_error += error;
+	}
+}
+
+// Free the tables of households that are not kept
+void Mobility::keep_tables(const std::vector<char>& kept)
+{
+	// Not constructed yet
+	if (public_probabilities.empty()) {
+		return;
+	}
+	if (kept.size() != public_probabilities.size()) {
+		throw std::invalid_argument("Households to keep do not match the leisure tables, " 
+						+ std::to_string(kept.size()) + " instead of " 
+						+ std::to_string(public_probabilities.size()));
+	}
+	for (size_t ih=0; ih<kept.size(); ++ih) {
+		if (!kept.at(ih)) {
+			public_probabilities.at(ih) = LeisureTable();
+		}
+	}
+}
+
+// Store sines and cosines of half of the coordinates of a location
+void Mobility::HalfAngles::add(const Place& place, const double to_rad)
+{
+	const double lat = place.get_x()*to_rad;
+	const double lon = place.get_y()*to_rad;
+	sin_lat.push_back(std::sin(lat/2.0));
+	cos_lat.push_back(std::cos(lat/2.0));
+	sin_lon.push_back(std::sin(lon/2.0));
+	cos_lon.push_back(std::cos(lon/2.0));
+	cos_full_lat.push_back(std::cos(lat));
+}
+
+// Probabilities of visiting all locations in leisure for household house
+void Mobility::compute_probabilities(const HalfAngles& houses, const size_t house, 
+				const HalfAngles& leisure, std::vector<double>& probs) const
+{
+	// Haversine formula with sines of half of the differences 
+	// from sin(x - y) = sin(x)cos(y) - cos(x)sin(y); no branches 
+	// or function calls so that the compiler can vectorize it
+	const double s_lat = houses.sin_lat[house], c_lat = houses.cos_lat[house];
+	const double s_lon = houses.sin_lon[house], c_lon = houses.cos_lon[house];
+	const double c_full_lat = houses.cos_full_lat[house];
+	const size_t n = probs.size();
+	const double* l_s_lat = leisure.sin_lat.data();
+	const double* l_c_lat = leisure.cos_lat.data();
+	const double* l_s_lon = leisure.sin_lon.data();
+	const double* l_c_lon = leisure.cos_lon.data();
+	const double* l_c_full_lat = leisure.cos_full_lat.data();
+	double* a = probs.data();
+	for (size_t i=0; i<n; ++i) {
+		const double s_dlat = l_s_lat[i]*c_lat - l_c_lat[i]*s_lat;
+		const double s_dlon = l_s_lon[i]*c_lon - l_c_lon[i]*s_lon;
+		a[i] = s_dlat*s_dlat + c_full_lat*l_c_full_lat[i]*s_dlon*s_dlon;
+	}
+
+	// Distances in km and probabilities
+	const double radius = 6371.0; 
+	for (size_t i=0; i<n; ++i) {
+		const double ai = std::min(1.0, a[i]);
+		const double dij = radius*2.0*std::atan2(std::sqrt(ai), std::sqrt(1.0 - ai));
+		// Same as compute_probability(dij) with one exponential
+		a[i] = std::exp(-beta*std::log(dij + dr0) - dij/kappa);
+	}
+}
+
+// Set the tail of the probability mass to drop for each household
+void Mobility::set_truncation_tail(const double tail)
+{
+	if ((tail < 0.0) || (tail >= 1.0)) {
+		throw std::invalid_argument("Leisure probability truncation tail needs to be in [0.0, 1.0), requested " + std::to_string(tail));
+	}
+	truncation_tail = tail;
+}
+
+// Build the table of a household from location probabilities
+Mobility::LeisureTable Mobility::make_table(const std::vector<double>& probs, double& error) const
+{
+	LeisureTable table;
+	const double total = std::accumulate(probs.begin(), probs.end(), 0.0);
+
+	// Locations with zero probability are never visited,
+	// least probable ones are dropped up to the tail 
+	std::vector<char> keep(probs.size(), 0);
+	for (size_t i=0; i<probs.size(); ++i) {
+		keep.at(i) = (probs.at(i) > 0.0);
+	}
+	double dropped = 0.0;
+	if ((truncation_tail > 0.0) && (total > 0.0)) {
+		std::vector<size_t> order(probs.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), 
+			[&probs](const size_t i, const size_t j) 
+				{ return probs[i] < probs[j] || (probs[i] == probs[j] && i > j); });
+		// Always keep the most probable location
+		for (size_t k=0; k+1<order.size(); ++k) {
+			const double pk = probs.at(order.at(k));
+			if (dropped + pk > truncation_tail*total) {
+				break;
+			}
+			dropped += pk;
+			keep.at(order.at(k)) = 0;
 		}
-		// Cumulative sum for the CDF
-		std::partial_sum(probs.begin(), probs.end(), probs.begin());
-		// Normalize
-		double max_p = probs.back();
-		if (max_p > 0.0){
-			std::for_each(probs.begin(), probs.end(), [&max_p](double &x) { x /= max_p; });
+	}
+	const size_t n_kept = std::count(keep.begin(), keep.end(), 1);
+
+	// Cumulative sum for the CDF in order of location IDs
+	table.cdf.reserve(n_kept);
+	if (n_kept < probs.size()) {
+		table.IDs.reserve(n_kept);
+	}
+	double cumulative = 0.0;
+	for (size_t i=0; i<probs.size(); ++i) {
+		if (!keep.at(i)) {
+			continue;
 		}
-		public_probabilities.push_back(probs);
-	}	
+		cumulative += probs.at(i);
+		table.cdf.push_back(cumulative);
+		if (n_kept < probs.size()) {
+			table.IDs.push_back(i+1);
+		}
+	}
+	// Normalize
+	if (cumulative > 0.0) {
+		std::for_each(table.cdf.begin(), table.cdf.end(), [&cumulative](double &x) { x /= cumulative; });
+	}
+
+	error = (total > 0.0) ? dropped/total : 0.0;
+
+	return table;
 }
 
 // Computes distances between two locations based
@@ -67,7 +210,7 @@ double Mobility::compute_distance(const Place& loc1, const Place& loc2)
 }
 
 // Computes and returns probabilities based on distance
-double Mobility::compute_probability(const double dist)
+double Mobility::compute_probability(const double dist) const
 {
 	const double pdij = std::pow((dist + dr0), -beta)*std::exp(-dist/kappa); 
 	return pdij;
@@ -95,20 +238,59 @@ int Mobility::assign_leisure_location(Infection& infection, const int& house_ID,
 		int pub_ID = 0;
 		in_public = true;
 		const double prob = infection.get_uniform();
-		const std::vector<double>& a_house = public_probabilities.at(house_ID-1);
+		const LeisureTable& a_house = public_probabilities.at(house_ID-1);
 			
 		// Iterator to the first element with probability >= to prob, 
 		// or one past last if no such element
-		const auto& iter = std::find_if(a_house.cbegin(), a_house.cend(), 
-						[&prob](const double x) { return x >= prob; });
+		const auto iter = std::lower_bound(a_house.cdf.cbegin(), a_house.cdf.cend(), prob);
 		// Find and return the ID
-		pub_ID = std::distance(a_house.cbegin(), iter) + 1;
+		const size_t ind = std::distance(a_house.cdf.cbegin(), iter);
+		if (a_house.IDs.empty() || (ind == a_house.IDs.size())) {
+			pub_ID = ind + 1;
+		} else {
+			pub_ID = a_house.IDs.at(ind);
+		}
 		in_public = true;
 		return pub_ID;
 	}
 	return 0;
 }
 
+// Cumulative probabilities of all public locations for each household
+std::vector<std::vector<double>> Mobility::get_public_probabilities() const
+{
+	std::vector<std::vector<double>> dense_probabilities;
+	dense_probabilities.reserve(public_probabilities.size());
+	for (const auto& table : public_probabilities) {
+		if (table.IDs.empty() && (static_cast<int>(table.cdf.size()) == n_public_locations)) {
+			dense_probabilities.push_back(table.cdf);
+			continue;
+		}
+		// Dropped locations add no probability
+		std::vector<double> probs(n_public_locations, 0.0);
+		double cumulative = 0.0;
+		size_t k = 0;
+		for (int i=0; i<n_public_locations; ++i) {
+			if ((k < table.IDs.size()) && (table.IDs.at(k) == i+1)) {
+				cumulative = table.cdf.at(k++);
+			}
+			probs.at(i) = cumulative;
+		}
+		dense_probabilities.push_back(probs);
+	}
+	return dense_probabilities;
+}
+
+// Number of stored household - public location probabilities
+size_t Mobility::get_number_of_stored_probabilities() const
+{
+	size_t n_stored = 0;
+	for (const auto& table : public_probabilities) {
+		n_stored += table.cdf.size();
+	}
+	return n_stored;
+}
+
 // Save the matrix of probabilities to file	
 void Mobility::print_probabilities(const std::string fname)
 {
@@ -119,5 +301,5 @@ void Mobility::print_probabilities(const std::string fname)
 
 	// Write data to file
 	AbmIO abm_io(fname, delim, sflag, dims);
-	abm_io.write_vector<double>(public_probabilities);
+	abm_io.write_vector<double>(get_public_probabilities());
 }
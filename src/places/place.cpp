@@ -15,7 +15,7 @@
 void Place::register_agent(const int agent_ID, const bool is_infected)
 {
 	// Store ID
-	agent_IDs.push_back(agent_ID);
+	agent_IDs.add(agent_ID);
 	// Update total
 	++num_tot;
 	// Update infected if agent is infected
@@ -32,7 +32,7 @@ void Place::register_agent(const int agent_ID, const bool is_infected)
 // from exposed and symptoamtic agents if any 
 void Place::compute_infected_contribution()
 {
-	num_tot = agent_IDs.size();
+	num_tot = agent_IDs.size() + n_remote;
 	
 	if (num_tot == 0){
 		lambda_tot = 0.0;
@@ -53,19 +53,6 @@ void Place::print_basic(std::ostream& where) const
 		  << ck << " " << beta_j;	
 }
 
-//
-// Initialization and update
-//
-
-// Remove an agent from this place
-void Place::remove_agent(const int index)
-{
-	std::vector<int> new_agent_IDs = {};
-	std::remove_copy(agent_IDs.begin(), agent_IDs.end(),
-					std::back_insert_iterator<std::vector<int>>(new_agent_IDs), index);
-	std::swap(new_agent_IDs, agent_IDs);
-}
-
 //
 // Supporting functions
 //
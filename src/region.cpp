@@ -0,0 +1,118 @@
+#include "../include/region.h"
+
+/*****************************************************
+ * class: Region
+ *
+ * Several towns simulated together in one process
+ * and coupled through commuter flows
+ *
+ ******************************************************/
+
+// Add an initialized town
+size_t Region::add_town(ABM&& abm, const std::string& name)
+{
+	towns.emplace_back(new ABM(std::move(abm)));
+	names.push_back(name);
+	// New town has no flows to or from other towns
+	for (auto& row : commuter_flows){
+		row.push_back(0.0);
+	}
+	commuter_flows.push_back(std::vector<double>(towns.size(), 0.0));
+	outside_prevalence.push_back(0.0);
+	return towns.size() - 1;
+}
+
+// Set fractions of commuters between towns
+void Region::set_commuter_flows(const std::vector<std::vector<double>>& flows)
+{
+	if (flows.size() != towns.size()){
+		throw std::invalid_argument("Commuter flows need one row per town");
+	}
+	for (size_t i = 0; i < flows.size(); ++i){
+		if (flows.at(i).size() != towns.size()){
+			throw std::invalid_argument("Commuter flows need one column per town");
+		}
+		double row_sum = 0.0;
+		for (size_t j = 0; j < flows.at(i).size(); ++j){
+			const double flow = flows.at(i).at(j);
+			if (flow < 0.0){
+				throw std::invalid_argument("Commuter flows cannot be negative");
+			}
+			if (i == j && flow != 0.0){
+				throw std::invalid_argument("Commuter flow from a town to itself should be 0");
+			}
+			row_sum += flow;
+		}
+		if (row_sum > 1.0 + 1e-10){
+			throw std::invalid_argument("Commuter flows from " + names.at(i)
+							+ " add up to more than 1");
+		}
+	}
+	commuter_flows = flows;
+}
+
+// Load commuter flows from a file
+void Region::load_commuter_flows(const std::string& fname)
+{
+	AbmIO io(fname, " ", true, {});
+	set_commuter_flows(io.read_vector<double>());
+}
+
+// Set the outside prevalence of each town from the current prevalences
+void Region::couple()
+{
+	std::vector<double> prevalence(towns.size(), 0.0);
+	for (size_t j = 0; j < towns.size(); ++j){
+		prevalence.at(j) = towns.at(j)->get_prevalence();
+	}
+	for (size_t i = 0; i < towns.size(); ++i){
+		// Rest of the flow leaves the modeled region
+		double p_out = 0.0, f_region = 0.0;
+		for (size_t j = 0; j < towns.size(); ++j){
+			p_out += commuter_flows.at(i).at(j)*prevalence.at(j);
+			f_region += commuter_flows.at(i).at(j);
+		}
+		p_out += std::max(0.0, 1.0 - f_region)
+					*towns.at(i)->get_infection_params().required(&InfectionParameters::fraction_estimated_infected);
+		outside_prevalence.at(i) = p_out;
+		towns.at(i)->set_outside_prevalence(p_out);
+	}
+}
+
+// Couple the towns and propagate all of them by one step
+void Region::step()
+{
+	couple();
+	const int n_threads = std::min(n_region_threads, static_cast<int>(towns.size()));
+	// Threads join before the next coupling
+	parallel_chunks(towns.size(), n_threads,
+		[this](const int, const size_t first, const size_t last){
+			for (size_t i = first; i < last; ++i){
+				(towns.at(i).get()->*propagate)();
+			}
+		});
+}
+
+// Propagate all towns by a number of steps
+void Region::run(const int n_steps)
+{
+	if (n_steps < 0){
+		throw std::invalid_argument("Number of steps in a region run cannot be negative");
+	}
+	for (int ti = 0; ti < n_steps; ++ti){
+		step();
+	}
+}
+
+// Save prevalence of each town and outside of it
+void Region::print_prevalence(const std::string& fname) const
+{
+	std::ofstream out(fname);
+	if (!out.is_open()){
+		throw std::runtime_error("Error opening file " + fname);
+	}
+	for (size_t i = 0; i < towns.size(); ++i){
+		out << names.at(i) << " " << towns.at(i)->get_prevalence()
+			<< " " << outside_prevalence.at(i) << "\n";
+	}
+}
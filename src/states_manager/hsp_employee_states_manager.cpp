@@ -8,224 +8,237 @@
  * 
  ******************************************************/
 
+//
+// Transition table
+//
+
+// Testing flags of this agent type, with tested exposed
+static const uint64_t testing = AgentState::testing_flags() | AgentState::bit(AgentState::tested_exposed);
+
+const AgentState::Transition HspEmployeeStatesManager::to_exposed = {"susceptible to exposed",
+	// Set, clear
+	AgentState::mask({AgentState::infected, AgentState::exposed}),
+	AgentState::mask({AgentState::recovering_exposed, AgentState::symptomatic, AgentState::dying, AgentState::recovering, AgentState::removed}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected, AgentState::removed})};
+
+const AgentState::Transition HspEmployeeStatesManager::to_exposed_never_sy = {"susceptible to exposed never symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::infected, AgentState::exposed, AgentState::recovering_exposed, AgentState::recovering}),
+	AgentState::mask({AgentState::symptomatic, AgentState::dying, AgentState::removed}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected, AgentState::removed})};
+
+const AgentState::Transition HspEmployeeStatesManager::exposed_to_removed = {"exposed never symptomatic to removed",
+	// Set, clear
+	AgentState::mask({AgentState::removed}),
+	AgentState::mask({AgentState::dying, AgentState::recovering, AgentState::infected, AgentState::exposed, AgentState::recovering_exposed, AgentState::symptomatic}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected, AgentState::exposed}),
+	0};
+
+const AgentState::Transition HspEmployeeStatesManager::exposed_to_symptomatic = {"exposed to symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::infected, AgentState::symptomatic}),
+	AgentState::mask({AgentState::exposed, AgentState::recovering_exposed, AgentState::tested_false_negative, AgentState::dying, AgentState::recovering, AgentState::removed}),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected, AgentState::exposed}),
+	0};
+
+const AgentState::Transition HspEmployeeStatesManager::dying_symptomatic = {"dying symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::dying}),
+	AgentState::mask({AgentState::recovering}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition HspEmployeeStatesManager::recovering_symptomatic = {"recovering symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::recovering}),
+	AgentState::mask({AgentState::dying}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition HspEmployeeStatesManager::waiting_in_hospital = {"waiting for test in hospital",
+	// Set, clear
+	AgentState::mask({AgentState::tested, AgentState::tested_in_hospital, AgentState::tested_awaiting_test, AgentState::home_isolated}),
+	AgentState::mask({AgentState::tested_in_car, AgentState::tested_awaiting_results}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition HspEmployeeStatesManager::exposed_waiting_in_hospital = {"exposed waiting for test in hospital",
+	// Set, clear
+	AgentState::mask({AgentState::tested, AgentState::tested_exposed, AgentState::tested_in_hospital, AgentState::tested_awaiting_test}),
+	AgentState::mask({AgentState::tested_in_car, AgentState::tested_awaiting_results, AgentState::home_isolated}),
+	// Required, forbidden
+	AgentState::mask({AgentState::exposed}),
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition HspEmployeeStatesManager::awaiting_results = {"tested to awaiting results",
+	// Set, clear
+	AgentState::mask({AgentState::tested_awaiting_results}),
+	AgentState::mask({AgentState::tested_in_car, AgentState::tested_in_hospital, AgentState::tested_awaiting_test}),
+	// Required, forbidden
+	AgentState::mask({AgentState::tested}),
+	0};
+
+const AgentState::Transition HspEmployeeStatesManager::false_negative = {"tested false negative",
+	// Set, clear
+	AgentState::mask({AgentState::tested_false_negative}),
+	testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition HspEmployeeStatesManager::icu_dying = {"ICU dying",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::hospitalized_ICU, AgentState::dying}),
+	AgentState::mask({AgentState::home_isolated, AgentState::hospitalized, AgentState::recovering}) | testing,
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition HspEmployeeStatesManager::icu_recovering = {"ICU recovering",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::hospitalized_ICU, AgentState::recovering}),
+	AgentState::mask({AgentState::home_isolated, AgentState::hospitalized, AgentState::dying}) | testing,
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition HspEmployeeStatesManager::hospitalized = {"hospitalized",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::hospitalized}),
+	AgentState::mask({AgentState::home_isolated, AgentState::hospitalized_ICU}) | testing,
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition HspEmployeeStatesManager::home_isolation = {"home isolation",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::home_isolated}),
+	AgentState::mask({AgentState::hospitalized_ICU, AgentState::hospitalized}) | testing,
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition HspEmployeeStatesManager::any_to_removed = {"any to removed",
+	// Set, clear
+	AgentState::mask({AgentState::removed}),
+	AgentState::mask({AgentState::dying, AgentState::recovering, AgentState::infected, AgentState::exposed, AgentState::recovering_exposed, AgentState::symptomatic}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition HspEmployeeStatesManager::negative = {"tested negative",
+	// Set, clear
+	AgentState::mask({AgentState::tested_covid_negative}),
+	AgentState::mask({AgentState::tested_covid_positive}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected})};
+
+//
+// State changes
+//
+
 // Set all states for transition from susceptible to exposed
 void HspEmployeeStatesManager::set_susceptible_to_exposed(Agent& agent)
 {
-	agent.set_infected(true);
-	agent.set_exposed(true);
-	agent.set_recovering_exposed(false);	
-	agent.set_symptomatic(false);
-	
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-	
-	agent.set_dying(false);
-	agent.set_recovering(false);	
-	agent.set_removed(false);
+	agent.change_state(to_exposed);
 }
 
 // Set all states for transition from susceptible to exposed that will never become symptomatic
 void HspEmployeeStatesManager::set_susceptible_to_exposed_never_symptomatic(Agent& agent)
 {
-	agent.set_infected(true);
-	agent.set_exposed(true);
-	agent.set_recovering_exposed(true);	
-	agent.set_symptomatic(false);
-	
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-	
-	agent.set_dying(false);
-	agent.set_recovering(true);	
-	agent.set_removed(false);
+	agent.change_state(to_exposed_never_sy);
 }
 
 // Set exposed that never developed symptoms to removed
 void HspEmployeeStatesManager::set_exposed_never_symptomatic_to_removed(Agent& agent)
 {
-	set_any_to_removed(agent);
+	agent.change_state(exposed_to_removed);
 }
 
 // Set all states for transition from exposed to general symptomatic
 void HspEmployeeStatesManager::set_exposed_to_symptomatic(Agent& agent)
 {
-	agent.set_infected(true);
-	agent.set_exposed(false);
-	agent.set_recovering_exposed(false);	
-	agent.set_symptomatic(true);
-	agent.set_tested_false_negative(false);
-	agent.set_dying(false);
-	agent.set_recovering(false);	
-	agent.set_removed(false);
+	agent.change_state(exposed_to_symptomatic);
 }
 
-// Set testing in hospital, initial state 
-void HspEmployeeStatesManager::set_waiting_for_test_in_hospital(Agent& agent)
-{
-	agent.set_tested(true);
-
-	agent.set_tested_in_car(false); 
-	agent.set_tested_in_hospital(true); 
-	agent.set_tested_awaiting_results(false);
-	agent.set_tested_awaiting_test(true);
-
-	// Home isolation for symptomatic
-	agent.set_home_isolated(true);
-}
-
-// Set testing in hospital, initial state 
-void HspEmployeeStatesManager::set_exposed_waiting_for_test_in_hospital(Agent& agent)
-{
-	agent.set_tested(true);
-	agent.set_tested_exposed(true);
-
-	agent.set_tested_in_car(false); 
-	agent.set_tested_in_hospital(true); 
-	agent.set_tested_awaiting_results(false);
-	agent.set_tested_awaiting_test(true);
-
-	// No home isolation for an exposed hospital employee 
-	agent.set_home_isolated(false);
-}
-
-// Set all states relevant to agent that will die 
+// Set all states relevant to agent that will die
 void HspEmployeeStatesManager::set_dying_symptomatic(Agent& agent)
 {
-	agent.set_dying(true);
-	agent.set_recovering(false);	
+	agent.change_state(dying_symptomatic);
 }
 
-// Set all states relevant to agent that will recover 
+// Set all states relevant to agent that will recover
 void HspEmployeeStatesManager::set_recovering_symptomatic(Agent& agent)
 {
-	agent.set_dying(false);
-	agent.set_recovering(true);	
-}
-
-// Set all testing states to a single value 
-void HspEmployeeStatesManager::set_all_testing_states(Agent& agent, const bool val)
-{
-	agent.set_tested(val);
-	agent.set_tested_exposed(val);
-
-	// Testing results
-	agent.set_tested_covid_negative(val);
-	agent.set_tested_false_negative(val);
-	agent.set_tested_false_positive(val);
-
-	// Testing phases and types
-	agent.set_tested_in_car(val); 
-	agent.set_tested_in_hospital(val); 
-	agent.set_tested_awaiting_results(val);
-	agent.set_tested_awaiting_test(val);
+	agent.change_state(recovering_symptomatic);
 }
 
-// Set all treatment states to a single value 
-void HspEmployeeStatesManager::set_all_treatment_states(Agent& agent, const bool val)
+// Set testing in hospital, initial state
+void HspEmployeeStatesManager::set_waiting_for_test_in_hospital(Agent& agent)
 {
-	// Treatment types
-	agent.set_being_treated(val);
-	agent.set_home_isolated(val);
-	agent.set_hospitalized(val);
-	agent.set_hospitalized_ICU(val);
+	agent.change_state(waiting_in_hospital);
 }
 
-// Set all removed related states
-void HspEmployeeStatesManager::set_any_to_removed(Agent& agent)
+// Set testing in hospital for exposed, initial state
+void HspEmployeeStatesManager::set_exposed_waiting_for_test_in_hospital(Agent& agent)
 {
-	agent.set_removed(true);
-
-	agent.set_dying(false);
-	agent.set_recovering(false);	
-
-	agent.set_infected(false);
-	agent.set_exposed(false);
-	agent.set_recovering_exposed(false);	
-	agent.set_symptomatic(false);
-	
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
+	agent.change_state(exposed_waiting_in_hospital);
 }
 
-// Set all states for just tested 
+// Set all states for just tested
 void HspEmployeeStatesManager::set_tested_to_awaiting_results(Agent& agent)
 {
-	agent.set_tested_awaiting_results(true);
-	agent.set_tested_in_car(false);
-	agent.set_tested_in_hospital(false);
-	agent.set_tested_awaiting_test(false);
+	agent.change_state(awaiting_results);
 }
 
-// Set all states for transition from tested to false negative 
+// Set all states for transition from tested to false negative
 void HspEmployeeStatesManager::set_tested_false_negative(Agent& agent)
 {
-	set_all_treatment_states(agent, false);
-	// First set all false, just change this one
-	set_all_testing_states(agent, false);
-	agent.set_tested_false_negative(true);
+	agent.change_state(false_negative);
 }
 
 // States for hospitalized, ICU - dying
 void HspEmployeeStatesManager::set_icu_dying(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-
-	agent.set_being_treated(true);
-	agent.set_home_isolated(false);
-	agent.set_hospitalized(false);
-	agent.set_hospitalized_ICU(true);
-
-	agent.set_dying(true);
-	agent.set_recovering(false);
+	agent.change_state(icu_dying);
 }
 
-// States for hospitalized, ICU - recovering 
+// States for hospitalized, ICU - recovering
 void HspEmployeeStatesManager::set_icu_recovering(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-
-	agent.set_being_treated(true);
-	agent.set_home_isolated(false);
-	agent.set_hospitalized(false);
-	agent.set_hospitalized_ICU(true);
-
-	agent.set_dying(false);
-	agent.set_recovering(true);
+	agent.change_state(icu_recovering);
 }
 
-// States for hospitalized 
+// States for hospitalized
 void HspEmployeeStatesManager::set_hospitalized(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-
-	agent.set_being_treated(true);
-	agent.set_home_isolated(false);
-	agent.set_hospitalized_ICU(false);
-	agent.set_hospitalized(true);
+	agent.change_state(hospitalized);
 }
 
 // States for isolated at home
 void HspEmployeeStatesManager::set_home_isolation(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
+	agent.change_state(home_isolation);
+}
 
-	agent.set_being_treated(true);
-	agent.set_hospitalized_ICU(false);
-	agent.set_hospitalized(false);
-	agent.set_home_isolated(true);
+// Set all removed related states
+void HspEmployeeStatesManager::set_any_to_removed(Agent& agent)
+{
+	agent.change_state(any_to_removed);
 }
 
 // States for negative
 void HspEmployeeStatesManager::set_tested_negative(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-	agent.set_tested_covid_positive(false);
-	agent.set_tested_covid_negative(true);
+	agent.change_state(negative);
 }
-
@@ -8,283 +8,307 @@
  * 
  ******************************************************/
 
+//
+// Transition table
+//
+
+// Testing flags of this agent type, with tested exposed
+static const uint64_t testing = AgentState::testing_flags() | AgentState::bit(AgentState::tested_exposed);
+
+const AgentState::Transition RegularStatesManager::to_exposed = {"susceptible to exposed",
+	// Set, clear
+	AgentState::mask({AgentState::infected, AgentState::exposed}),
+	AgentState::mask({AgentState::recovering_exposed, AgentState::symptomatic, AgentState::dying, AgentState::recovering, AgentState::removed}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected, AgentState::removed})};
+
+const AgentState::Transition RegularStatesManager::to_exposed_never_sy = {"susceptible to exposed never symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::infected, AgentState::exposed, AgentState::recovering_exposed, AgentState::recovering}),
+	AgentState::mask({AgentState::symptomatic, AgentState::dying, AgentState::removed}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected, AgentState::removed})};
+
+const AgentState::Transition RegularStatesManager::exposed_to_removed = {"exposed never symptomatic to removed",
+	// Set, clear
+	AgentState::mask({AgentState::removed}),
+	AgentState::mask({AgentState::dying, AgentState::recovering, AgentState::infected, AgentState::exposed, AgentState::recovering_exposed, AgentState::symptomatic}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected, AgentState::exposed}),
+	0};
+
+const AgentState::Transition RegularStatesManager::exposed_to_symptomatic = {"exposed to symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::infected, AgentState::symptomatic}),
+	AgentState::mask({AgentState::exposed, AgentState::recovering_exposed, AgentState::dying, AgentState::recovering, AgentState::removed}),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected, AgentState::exposed}),
+	0};
+
+const AgentState::Transition RegularStatesManager::dying_symptomatic = {"dying symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::dying}),
+	AgentState::mask({AgentState::recovering}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition RegularStatesManager::recovering_symptomatic = {"recovering symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::recovering}),
+	AgentState::mask({AgentState::dying}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition RegularStatesManager::waiting_in_hospital = {"waiting for test in hospital",
+	// Set, clear
+	AgentState::mask({AgentState::tested, AgentState::tested_in_hospital, AgentState::tested_awaiting_test, AgentState::home_isolated}),
+	AgentState::mask({AgentState::tested_in_car, AgentState::tested_awaiting_results}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition RegularStatesManager::exposed_waiting_in_hospital = {"exposed waiting for test in hospital",
+	// Set, clear
+	AgentState::mask({AgentState::tested, AgentState::tested_exposed, AgentState::tested_in_hospital, AgentState::tested_awaiting_test, AgentState::home_isolated}),
+	AgentState::mask({AgentState::tested_in_car, AgentState::tested_awaiting_results}),
+	// Required, forbidden
+	AgentState::mask({AgentState::exposed}),
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition RegularStatesManager::waiting_in_car = {"waiting for test in car",
+	// Set, clear
+	AgentState::mask({AgentState::tested, AgentState::tested_in_car, AgentState::tested_awaiting_test, AgentState::home_isolated}),
+	AgentState::mask({AgentState::tested_in_hospital, AgentState::tested_awaiting_results}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition RegularStatesManager::exposed_waiting_in_car = {"exposed waiting for test in car",
+	// Set, clear
+	AgentState::mask({AgentState::tested, AgentState::tested_exposed, AgentState::tested_in_car, AgentState::tested_awaiting_test, AgentState::home_isolated}),
+	AgentState::mask({AgentState::tested_in_hospital, AgentState::tested_awaiting_results}),
+	// Required, forbidden
+	AgentState::mask({AgentState::exposed}),
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition RegularStatesManager::awaiting_results = {"tested to awaiting results",
+	// Set, clear
+	AgentState::mask({AgentState::tested_awaiting_results}),
+	AgentState::mask({AgentState::tested_in_car, AgentState::tested_in_hospital, AgentState::tested_awaiting_test}),
+	// Required, forbidden
+	AgentState::mask({AgentState::tested}),
+	0};
+
+const AgentState::Transition RegularStatesManager::false_negative = {"tested false negative",
+	// Set, clear
+	AgentState::mask({AgentState::tested_false_negative}),
+	testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition RegularStatesManager::icu_dying = {"ICU dying",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::hospitalized_ICU, AgentState::dying}),
+	AgentState::mask({AgentState::home_isolated, AgentState::hospitalized, AgentState::recovering}) | testing,
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition RegularStatesManager::icu_recovering = {"ICU recovering",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::hospitalized_ICU, AgentState::recovering}),
+	AgentState::mask({AgentState::home_isolated, AgentState::hospitalized, AgentState::dying}) | testing,
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition RegularStatesManager::hospitalized = {"hospitalized",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::hospitalized}),
+	AgentState::mask({AgentState::home_isolated, AgentState::hospitalized_ICU}) | testing,
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition RegularStatesManager::home_isolation = {"home isolation",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::home_isolated}),
+	AgentState::mask({AgentState::hospitalized_ICU, AgentState::hospitalized}) | testing,
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition RegularStatesManager::any_to_removed = {"any to removed",
+	// Set, clear
+	AgentState::mask({AgentState::removed}),
+	AgentState::mask({AgentState::dying, AgentState::recovering, AgentState::infected, AgentState::exposed, AgentState::recovering_exposed, AgentState::symptomatic}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition RegularStatesManager::former_flu = {"former flu",
+	// Set, clear
+	0,
+	AgentState::mask({AgentState::symptomatic_non_covid}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected, AgentState::removed})};
+
+const AgentState::Transition RegularStatesManager::false_positive = {"tested false positive",
+	// Set, clear
+	AgentState::mask({AgentState::tested_false_positive, AgentState::home_isolated}),
+	testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected})};
+
+const AgentState::Transition RegularStatesManager::negative = {"tested negative",
+	// Set, clear
+	AgentState::mask({AgentState::tested_covid_negative}),
+	AgentState::mask({AgentState::symptomatic_non_covid}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected})};
+
+const AgentState::Transition RegularStatesManager::returning_flu = {"returning flu",
+	// Set, clear
+	AgentState::mask({AgentState::tested_false_positive}),
+	AgentState::mask({AgentState::symptomatic_non_covid}) | testing | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::tested_false_positive}),
+	0};
+
+//
+// State changes
+//
+
 // Set all states for transition from susceptible to exposed
 void RegularStatesManager::set_susceptible_to_exposed(Agent& agent)
 {
-	agent.set_infected(true);
-	agent.set_exposed(true);
-	agent.set_recovering_exposed(false);	
-	agent.set_symptomatic(false);
-	
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-	
-	agent.set_dying(false);
-	agent.set_recovering(false);	
-	agent.set_removed(false);
+	agent.change_state(to_exposed);
 }
 
 // Set all states for transition from susceptible to exposed that will never become symptomatic
 void RegularStatesManager::set_susceptible_to_exposed_never_symptomatic(Agent& agent)
 {
-	agent.set_infected(true);
-	agent.set_exposed(true);
-	agent.set_recovering_exposed(true);	
-	agent.set_symptomatic(false);
-	
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-	
-	agent.set_dying(false);
-	agent.set_recovering(true);	
-	agent.set_removed(false);
+	agent.change_state(to_exposed_never_sy);
 }
 
 // Set exposed that never developed symptoms to removed
 void RegularStatesManager::set_exposed_never_symptomatic_to_removed(Agent& agent)
 {
-	set_any_to_removed(agent);
+	agent.change_state(exposed_to_removed);
 }
 
 // Set all states for transition from exposed to general symptomatic
 void RegularStatesManager::set_exposed_to_symptomatic(Agent& agent)
 {
-	agent.set_infected(true);
-	agent.set_exposed(false);
-	agent.set_recovering_exposed(false);	
-	agent.set_symptomatic(true);
-	agent.set_dying(false);
-	agent.set_recovering(false);	
-	agent.set_removed(false);
+	agent.change_state(exposed_to_symptomatic);
 }
 
-// Set testing in hospital, initial state 
-void RegularStatesManager::set_waiting_for_test_in_hospital(Agent& agent)
-{
-	agent.set_tested(true);
-
-	agent.set_tested_in_car(false); 
-	agent.set_tested_in_hospital(true); 
-	agent.set_tested_awaiting_results(false);
-	agent.set_tested_awaiting_test(true);
-
-	// All waiting agents undergo home isolation
-	// but not the official treatment yet
-	agent.set_home_isolated(true);
-}
-
-// Set testing in hospital, initial state 
-void RegularStatesManager::set_exposed_waiting_for_test_in_hospital(Agent& agent)
-{
-	agent.set_tested(true);
-	agent.set_tested_exposed(true);
-
-	agent.set_tested_in_car(false); 
-	agent.set_tested_in_hospital(true); 
-	agent.set_tested_awaiting_results(false);
-	agent.set_tested_awaiting_test(true);
-
-	// All waiting agents undergo home isolation
-	// but not the official treatment yet
-	agent.set_home_isolated(true);
-}
-
-// Set testing in a car, initial state 
-void RegularStatesManager::set_waiting_for_test_in_car(Agent& agent)
-{
-	agent.set_tested(true);
-
-	agent.set_tested_in_car(true); 
-	agent.set_tested_in_hospital(false); 
-	agent.set_tested_awaiting_results(false);
-	agent.set_tested_awaiting_test(true);
-
-	// All waiting agents undergo home isolation
-	// but not the official treatment yet
-	agent.set_home_isolated(true);
-}
-
-// Set testing in a car, initial state 
-void RegularStatesManager::set_exposed_waiting_for_test_in_car(Agent& agent)
+// Set all states relevant to agent that will die
+void RegularStatesManager::set_dying_symptomatic(Agent& agent)
 {
-	agent.set_tested(true);
-	agent.set_tested_exposed(true);
-
-	agent.set_tested_in_car(true); 
-	agent.set_tested_in_hospital(false); 
-	agent.set_tested_awaiting_results(false);
-	agent.set_tested_awaiting_test(true);
-
-	// All waiting agents undergo home isolation
-	// but not the official treatment yet
-	agent.set_home_isolated(true);
+	agent.change_state(dying_symptomatic);
 }
 
-// Set all states relevant to agent that will die 
-void RegularStatesManager::set_dying_symptomatic(Agent& agent)
+// Set all states relevant to agent that will recover
+void RegularStatesManager::set_recovering_symptomatic(Agent& agent)
 {
-	agent.set_dying(true);
-	agent.set_recovering(false);	
+	agent.change_state(recovering_symptomatic);
 }
 
-// Set all states relevant to agent that will recover 
-void RegularStatesManager::set_recovering_symptomatic(Agent& agent)
+// Set testing in hospital, initial state
+void RegularStatesManager::set_waiting_for_test_in_hospital(Agent& agent)
 {
-	agent.set_dying(false);
-	agent.set_recovering(true);	
+	agent.change_state(waiting_in_hospital);
 }
 
-// Set all testing states to a single value 
-void RegularStatesManager::set_all_testing_states(Agent& agent, const bool val)
+// Set testing in hospital for exposed, initial state
+void RegularStatesManager::set_exposed_waiting_for_test_in_hospital(Agent& agent)
 {
-	agent.set_tested(val);
-	agent.set_tested_exposed(val);
-
-	// Testing results
-	agent.set_tested_covid_negative(val);
-	agent.set_tested_false_negative(val);
-	agent.set_tested_false_positive(val);
-
-	// Testing phases and types
-	agent.set_tested_in_car(val); 
-	agent.set_tested_in_hospital(val); 
-	agent.set_tested_awaiting_results(val);
-	agent.set_tested_awaiting_test(val);
+	agent.change_state(exposed_waiting_in_hospital);
 }
 
-// Set all treatment states to a single value 
-void RegularStatesManager::set_all_treatment_states(Agent& agent, const bool val)
+// Set testing in a car, initial state
+void RegularStatesManager::set_waiting_for_test_in_car(Agent& agent)
 {
-	// Treatment types
-	agent.set_being_treated(val);
-	agent.set_home_isolated(val);
-	agent.set_hospitalized(val);
-	agent.set_hospitalized_ICU(val);
+	agent.change_state(waiting_in_car);
 }
 
-// Set all removed related states
-void RegularStatesManager::set_any_to_removed(Agent& agent)
+// Set testing in a car for exposed, initial state
+void RegularStatesManager::set_exposed_waiting_for_test_in_car(Agent& agent)
 {
-	agent.set_removed(true);
-
-	agent.set_dying(false);
-	agent.set_recovering(false);	
-
-	agent.set_infected(false);
-	agent.set_exposed(false);
-	agent.set_recovering_exposed(false);	
-	agent.set_symptomatic(false);
-	
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
+	agent.change_state(exposed_waiting_in_car);
 }
 
-// Set all states for just tested 
+// Set all states for just tested
 void RegularStatesManager::set_tested_to_awaiting_results(Agent& agent)
 {
-	agent.set_tested_awaiting_results(true);
-	agent.set_tested_in_car(false);
-	agent.set_tested_in_hospital(false);
-	agent.set_tested_awaiting_test(false);
+	agent.change_state(awaiting_results);
 }
 
-// Set all states for transition from tested to false negative 
+// Set all states for transition from tested to false negative
 void RegularStatesManager::set_tested_false_negative(Agent& agent)
 {
-	set_all_treatment_states(agent, false);
-	// First set all false, just change this one
-	set_all_testing_states(agent, false);
-	agent.set_tested_false_negative(true);
+	agent.change_state(false_negative);
 }
 
 // States for hospitalized, ICU - dying
 void RegularStatesManager::set_icu_dying(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-
-	agent.set_being_treated(true);
-	agent.set_home_isolated(false);
-	agent.set_hospitalized(false);
-	agent.set_hospitalized_ICU(true);
-
-	agent.set_dying(true);
-	agent.set_recovering(false);
+	agent.change_state(icu_dying);
 }
 
-// States for hospitalized, ICU - recovering 
+// States for hospitalized, ICU - recovering
 void RegularStatesManager::set_icu_recovering(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-
-	agent.set_being_treated(true);
-	agent.set_home_isolated(false);
-	agent.set_hospitalized(false);
-	agent.set_hospitalized_ICU(true);
-
-	agent.set_dying(false);
-	agent.set_recovering(true);
+	agent.change_state(icu_recovering);
 }
 
-// States for hospitalized 
+// States for hospitalized
 void RegularStatesManager::set_hospitalized(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-
-	agent.set_being_treated(true);
-	agent.set_home_isolated(false);
-	agent.set_hospitalized_ICU(false);
-	agent.set_hospitalized(true);
+	agent.change_state(hospitalized);
 }
 
 // States for isolated at home
 void RegularStatesManager::set_home_isolation(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
+	agent.change_state(home_isolation);
+}
 
-	agent.set_being_treated(true);
-	agent.set_hospitalized_ICU(false);
-	agent.set_hospitalized(false);
-	agent.set_home_isolated(true);
+// Set all removed related states
+void RegularStatesManager::set_any_to_removed(Agent& agent)
+{
+	agent.change_state(any_to_removed);
 }
 
 // Reset all non-covid symptomatic flags
 void RegularStatesManager::set_former_flu(Agent& agent)
 {
-	agent.set_symptomatic_non_covid(false);
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
+	agent.change_state(former_flu);
 }
 
 // States for false positive, isolated at home
 void RegularStatesManager::set_tested_false_positive(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-
-	agent.set_tested_false_positive(true);
-	agent.set_home_isolated(true);
+	agent.change_state(false_positive);
 }
 
 // States for negative
 void RegularStatesManager::set_tested_negative(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-	agent.set_symptomatic_non_covid(false);
-	agent.set_tested_covid_negative(true);
+	agent.change_state(negative);
 }
 
 // Reset flags for flu that is back to susceptible from IH
 void RegularStatesManager::reset_returning_flu(Agent& agent)
 {
-	set_all_treatment_states(agent, false);
-	set_all_testing_states(agent, false);
-	agent.set_tested_false_positive(true);
-	agent.set_symptomatic_non_covid(false);
+	agent.change_state(returning_flu);
 }
@@ -7,258 +7,276 @@
  * 
  ******************************************************/
 
+//
+// Transition table
+//
+
+const AgentState::Transition StatesManager::to_exposed = {"susceptible to exposed",
+	// Set, clear
+	AgentState::mask({AgentState::infected, AgentState::exposed}),
+	AgentState::mask({AgentState::recovering_exposed, AgentState::symptomatic, AgentState::dying, AgentState::recovering, AgentState::removed}) | AgentState::testing_flags() | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected, AgentState::removed})};
+
+const AgentState::Transition StatesManager::to_exposed_never_sy = {"susceptible to exposed never symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::infected, AgentState::exposed, AgentState::recovering_exposed, AgentState::recovering}),
+	AgentState::mask({AgentState::symptomatic, AgentState::dying, AgentState::removed}) | AgentState::testing_flags() | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected, AgentState::removed})};
+
+const AgentState::Transition StatesManager::exposed_to_removed = {"exposed never symptomatic to removed",
+	// Set, clear
+	AgentState::mask({AgentState::removed}),
+	AgentState::mask({AgentState::dying, AgentState::recovering, AgentState::infected, AgentState::exposed, AgentState::recovering_exposed, AgentState::symptomatic}) | AgentState::testing_flags() | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected, AgentState::exposed}),
+	0};
+
+const AgentState::Transition StatesManager::exposed_to_symptomatic = {"exposed to symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::infected, AgentState::symptomatic}),
+	AgentState::mask({AgentState::exposed, AgentState::recovering_exposed, AgentState::dying, AgentState::recovering, AgentState::removed}) | AgentState::testing_flags() | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected, AgentState::exposed}),
+	0};
+
+const AgentState::Transition StatesManager::dying_symptomatic = {"dying symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::dying}),
+	AgentState::mask({AgentState::recovering}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition StatesManager::recovering_symptomatic = {"recovering symptomatic",
+	// Set, clear
+	AgentState::mask({AgentState::recovering}),
+	AgentState::mask({AgentState::dying}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition StatesManager::waiting_in_hospital = {"waiting for test in hospital",
+	// Set, clear
+	AgentState::mask({AgentState::tested, AgentState::tested_in_hospital, AgentState::tested_awaiting_test, AgentState::home_isolated}),
+	AgentState::mask({AgentState::tested_in_car, AgentState::tested_awaiting_results}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition StatesManager::waiting_in_car = {"waiting for test in car",
+	// Set, clear
+	AgentState::mask({AgentState::tested, AgentState::tested_in_car, AgentState::tested_awaiting_test, AgentState::home_isolated}),
+	AgentState::mask({AgentState::tested_in_hospital, AgentState::tested_awaiting_results}),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::removed})};
+
+const AgentState::Transition StatesManager::awaiting_results = {"tested to awaiting results",
+	// Set, clear
+	AgentState::mask({AgentState::tested_awaiting_results}),
+	AgentState::mask({AgentState::tested_in_car, AgentState::tested_in_hospital, AgentState::tested_awaiting_test}),
+	// Required, forbidden
+	AgentState::mask({AgentState::tested}),
+	0};
+
+const AgentState::Transition StatesManager::false_negative = {"tested false negative",
+	// Set, clear
+	AgentState::mask({AgentState::tested_false_negative}),
+	AgentState::testing_flags() | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition StatesManager::icu_dying = {"ICU dying",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::hospitalized_ICU, AgentState::dying}),
+	AgentState::mask({AgentState::home_isolated, AgentState::hospitalized, AgentState::recovering}) | AgentState::testing_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition StatesManager::icu_recovering = {"ICU recovering",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::hospitalized_ICU, AgentState::recovering}),
+	AgentState::mask({AgentState::home_isolated, AgentState::hospitalized, AgentState::dying}) | AgentState::testing_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition StatesManager::hospitalized = {"hospitalized",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::hospitalized}),
+	AgentState::mask({AgentState::home_isolated, AgentState::hospitalized_ICU}) | AgentState::testing_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition StatesManager::home_isolation = {"home isolation",
+	// Set, clear
+	AgentState::mask({AgentState::being_treated, AgentState::home_isolated}),
+	AgentState::mask({AgentState::hospitalized_ICU, AgentState::hospitalized}) | AgentState::testing_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition StatesManager::any_to_removed = {"any to removed",
+	// Set, clear
+	AgentState::mask({AgentState::removed}),
+	AgentState::mask({AgentState::dying, AgentState::recovering, AgentState::infected, AgentState::exposed, AgentState::recovering_exposed, AgentState::symptomatic}) | AgentState::testing_flags() | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::infected}),
+	0};
+
+const AgentState::Transition StatesManager::former_flu = {"former flu",
+	// Set, clear
+	0,
+	AgentState::mask({AgentState::symptomatic_non_covid}) | AgentState::testing_flags() | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected, AgentState::removed})};
+
+const AgentState::Transition StatesManager::false_positive = {"tested false positive",
+	// Set, clear
+	AgentState::mask({AgentState::tested_false_positive, AgentState::home_isolated}),
+	AgentState::testing_flags() | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected})};
+
+const AgentState::Transition StatesManager::negative = {"tested negative",
+	// Set, clear
+	AgentState::mask({AgentState::tested_covid_negative}),
+	AgentState::testing_flags() | AgentState::treatment_flags(),
+	// Required, forbidden
+	0,
+	AgentState::mask({AgentState::infected})};
+
+const AgentState::Transition StatesManager::returning_flu = {"returning flu",
+	// Set, clear
+	0,
+	AgentState::mask({AgentState::tested_false_positive, AgentState::symptomatic_non_covid}) | AgentState::treatment_flags(),
+	// Required, forbidden
+	AgentState::mask({AgentState::tested_false_positive}),
+	0};
+
+//
+// State changes
+//
+
 // Set all states for transition from susceptible to exposed
 void StatesManager::set_susceptible_to_exposed(Agent& agent)
 {
-	agent.set_infected(true);
-	agent.set_exposed(true);
-
-	agent.set_recovering_exposed(false);	
-	agent.set_symptomatic(false);
-	
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-	
-	agent.set_dying(false);
-	agent.set_recovering(false);	
-	agent.set_removed(false);
+	agent.change_state(to_exposed);
 }
 
 // Set all states for transition from susceptible to exposed that will never become symptomatic
 void StatesManager::set_susceptible_to_exposed_never_symptomatic(Agent& agent)
 {
-	agent.set_infected(true);
-	agent.set_exposed(true);
-	agent.set_recovering_exposed(true);	
-
-	agent.set_symptomatic(false);
-	
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-	
-	agent.set_dying(false);
-	agent.set_recovering(true);	
-	agent.set_removed(false);
+	agent.change_state(to_exposed_never_sy);
 }
 
 // Set exposed that never developed symptoms to removed
 void StatesManager::set_exposed_never_symptomatic_to_removed(Agent& agent)
 {
-	set_any_to_removed(agent);
+	agent.change_state(exposed_to_removed);
 }
 
 // Set all states for transition from exposed to general symptomatic
 void StatesManager::set_exposed_to_symptomatic(Agent& agent)
 {
-	agent.set_infected(true);
-	agent.set_exposed(false);
-	agent.set_recovering_exposed(false);	
-
-	agent.set_symptomatic(true);
-
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-	
-	agent.set_dying(false);
-	agent.set_recovering(false);	
-	agent.set_removed(false);
-}
-
-// Set testing in hospital, initial state 
-void StatesManager::set_waiting_for_test_in_hospital(Agent& agent)
-{
-	agent.set_tested(true);
-
-	agent.set_tested_in_car(false); 
-	agent.set_tested_in_hospital(true); 
-	agent.set_tested_awaiting_results(false);
-	agent.set_tested_awaiting_test(true);
-
-	// All waiting agents undergo home isolation
-	// but not the official treatment yet
-	agent.set_home_isolated(true);
-}
-
-// Set testing in a car, initial state 
-void StatesManager::set_waiting_for_test_in_car(Agent& agent)
-{
-	agent.set_tested(true);
-
-	agent.set_tested_in_car(true); 
-	agent.set_tested_in_hospital(false); 
-	agent.set_tested_awaiting_results(false);
-	agent.set_tested_awaiting_test(true);
-
-	// All waiting agents undergo home isolation
-	// but not the official treatment yet
-	agent.set_home_isolated(true);
+	agent.change_state(exposed_to_symptomatic);
 }
 
-// Set all states relevant to agent that will die 
+// Set all states relevant to agent that will die
 void StatesManager::set_dying_symptomatic(Agent& agent)
 {
-	agent.set_dying(true);
-	agent.set_recovering(false);	
+	agent.change_state(dying_symptomatic);
 }
 
-// Set all states relevant to agent that will recover 
+// Set all states relevant to agent that will recover
 void StatesManager::set_recovering_symptomatic(Agent& agent)
 {
-	agent.set_dying(false);
-	agent.set_recovering(true);	
+	agent.change_state(recovering_symptomatic);
 }
 
-// Set all testing states to a single value 
-void StatesManager::set_all_testing_states(Agent& agent, const bool val)
-{
-	agent.set_tested(val);
-
-	// Testing results
-	agent.set_tested_covid_negative(val);
-	agent.set_tested_false_negative(val);
-	agent.set_tested_false_positive(val);
-
-	// Testing phases and types
-	agent.set_tested_in_car(val); 
-	agent.set_tested_in_hospital(val); 
-	agent.set_tested_awaiting_results(val);
-	agent.set_tested_awaiting_test(val);
-}
-
-// Set all treatment states to a single value 
-void StatesManager::set_all_treatment_states(Agent& agent, const bool val)
+// Set testing in hospital, initial state
+void StatesManager::set_waiting_for_test_in_hospital(Agent& agent)
 {
-	// Treatment types
-	agent.set_being_treated(val);
-	agent.set_home_isolated(val);
-	agent.set_hospitalized(val);
-	agent.set_hospitalized_ICU(val);
+	agent.change_state(waiting_in_hospital);
 }
 
-// Set all removed related states
-void StatesManager::set_any_to_removed(Agent& agent)
+// Set testing in a car, initial state
+void StatesManager::set_waiting_for_test_in_car(Agent& agent)
 {
-	agent.set_removed(true);
-
-	agent.set_dying(false);
-	agent.set_recovering(false);	
-
-	agent.set_infected(false);
-	agent.set_exposed(false);
-	agent.set_recovering_exposed(false);	
-
-	agent.set_symptomatic(false);
-	
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
+	agent.change_state(waiting_in_car);
 }
 
-// Set all states for just tested 
+// Set all states for just tested
 void StatesManager::set_tested_to_awaiting_results(Agent& agent)
 {
-	agent.set_tested_awaiting_results(true);
-	agent.set_tested_in_car(false);
-	agent.set_tested_in_hospital(false);
-	agent.set_tested_awaiting_test(false);
+	agent.change_state(awaiting_results);
 }
 
-// Set all states for transition from tested to false negative 
+// Set all states for transition from tested to false negative
 void StatesManager::set_tested_false_negative(Agent& agent)
 {
-	set_all_treatment_states(agent, false);
-	// First set all false, just change this one
-	set_all_testing_states(agent, false);
-	agent.set_tested_false_negative(true);
+	agent.change_state(false_negative);
 }
 
 // States for hospitalized, ICU - dying
 void StatesManager::set_icu_dying(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-
-	agent.set_being_treated(true);
-	agent.set_home_isolated(false);
-	agent.set_hospitalized(false);
-	agent.set_hospitalized_ICU(true);
-
-	agent.set_dying(true);
-	agent.set_recovering(false);
+	agent.change_state(icu_dying);
 }
 
-// States for hospitalized, ICU - recovering 
+// States for hospitalized, ICU - recovering
 void StatesManager::set_icu_recovering(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-
-	agent.set_being_treated(true);
-	agent.set_home_isolated(false);
-	agent.set_hospitalized(false);
-	agent.set_hospitalized_ICU(true);
-
-	agent.set_dying(false);
-	agent.set_recovering(true);
+	agent.change_state(icu_recovering);
 }
 
-// States for hospitalized 
+// States for hospitalized
 void StatesManager::set_hospitalized(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-
-	agent.set_being_treated(true);
-	agent.set_home_isolated(false);
-	agent.set_hospitalized_ICU(false);
-	agent.set_hospitalized(true);
+	agent.change_state(hospitalized);
 }
 
 // States for isolated at home
 void StatesManager::set_home_isolation(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
+	agent.change_state(home_isolation);
+}
 
-	agent.set_being_treated(true);
-	agent.set_hospitalized_ICU(false);
-	agent.set_hospitalized(false);
-	agent.set_home_isolated(true);
+// Set all removed related states
+void StatesManager::set_any_to_removed(Agent& agent)
+{
+	agent.change_state(any_to_removed);
 }
 
 // Reset all non-covid symptomatic flags
 void StatesManager::set_former_flu(Agent& agent)
 {
-	agent.set_symptomatic_non_covid(false);
-
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
+	agent.change_state(former_flu);
 }
 
 // States for false positive, isolated at home
 void StatesManager::set_tested_false_positive(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-
-	agent.set_tested_false_positive(true);
-	agent.set_home_isolated(true);
+	agent.change_state(false_positive);
 }
 
 // States for negative
 void StatesManager::set_tested_negative(Agent& agent)
 {
-	// Set all testing and treatment related flags to false
-	set_all_testing_states(agent, false);
-	set_all_treatment_states(agent, false);
-
-	agent.set_tested_covid_negative(true);
+	agent.change_state(negative);
 }
 
 // Reset flags for flu that is back to susceptible from IH
 void StatesManager::reset_returning_flu(Agent& agent)
 {
-	set_all_treatment_states(agent, false);
-	agent.set_tested_false_positive(false);
-	agent.set_symptomatic_non_covid(false);
+	agent.change_state(returning_flu);
 }
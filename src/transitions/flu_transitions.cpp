@@ -16,7 +16,7 @@ std::vector<int> FluTransitions::susceptible_transitions(Agent& agent, const dou
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
+				const InfectionParameters& infection_parameters, 
 				std::vector<Agent>& agents, Flu& flu, const Testing& testing, const double dt)
 {
 	double lambda_tot = 0.0;
@@ -27,7 +27,7 @@ std::vector<int> FluTransitions::susceptible_transitions(Agent& agent, const dou
 					hospitals, retirement_homes, carpools, public_transit, leisure_locations);
 	if (infection.infected(lambda_tot) == true){
 		state_changes.at(0) = 1;
-		int new_flu = flu.swap_flu_agent(agent.get_ID());
+		int new_flu = changes.swap_flu_agent(flu, agent.get_ID());
 		// If still available
 		if (new_flu != -1){
 			process_new_flu(agents.at(new_flu-1), hospitals.size(), time, schools, workplaces,
@@ -79,7 +79,7 @@ std::vector<int> FluTransitions::susceptible_transitions(Agent& agent, const dou
 			states_manager.reset_returning_flu(agent);
 			add_to_all_workplaces_and_schools(agent, schools, workplaces, 
 							retirement_homes, carpools, public_transit);
-			int new_flu = flu.swap_flu_agent(agent.get_ID());
+			int new_flu = changes.swap_flu_agent(flu, agent.get_ID());
 			// If still available
 			if (new_flu != -1){
 				process_new_flu(agents.at(new_flu-1), hospitals.size(), time, schools, workplaces, 
@@ -96,14 +96,14 @@ void FluTransitions::process_new_flu(Agent& agent, const int n_hospitals, const
 			   		std::vector<School>& schools, std::vector<Workplace>& workplaces,
 					std::vector<RetirementHome>& retirement_homes, std::vector<Transit>& carpools,
 					std::vector<Transit>& public_transit, Infection& infection, 
-					const std::map<std::string, double>& infection_parameters, 
+					const InfectionParameters& infection_parameters, 
 					Flu& flu, const Testing& testing)
 {
 	double test_time = 0.0;
 	agent.set_symptomatic_non_covid(true);
 	// Testing properties
 	if (flu.getting_tested(testing)){
-		if (infection.tested_in_hospital(infection_parameters.at("fraction tested in hospitals"))){
+		if (infection.tested_in_hospital(infection_parameters.fraction_tested_in_hospitals)){
 			states_manager.set_waiting_for_test_in_hospital(agent);
 			int hsp_ID = infection.get_random_hospital_ID(n_hospitals);
 			// Registration will happen only upon testing time step
@@ -112,13 +112,13 @@ void FluTransitions::process_new_flu(Agent& agent, const int n_hospitals, const
 			states_manager.set_waiting_for_test_in_car(agent);
 		}
 		// Set testing times
-		test_time = infection.wait_time_for_test(infection_parameters.at("flu testing duration"));
+		test_time = infection.wait_time_for_test(infection_parameters.flu_testing_duration);
 		agent.set_time_to_test(test_time);
 		agent.set_time_of_test(time);
 		// Delay home isolation until fixed number of days before test
 		agent.set_home_isolated(false);
 		// Time to start isolation 
-		agent.set_flu_isolation(infection_parameters.at("time from decision to test"));
+		agent.set_flu_isolation(infection_parameters.time_from_decision_to_test);
 	}
 }
 
@@ -236,7 +236,7 @@ double FluTransitions::compute_susceptible_lambda(const Agent& agent, const doub
 
 // Compte and set agent properties related to recovery without symptoms and incubation 
 void FluTransitions::recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				const std::map<std::string, double>& infection_parameters)
+				const InfectionParameters& infection_parameters)
 {
 	// Determine if agent will recover without
 	// becoming symptomatic and update corresponding states
@@ -245,12 +245,12 @@ void FluTransitions::recovery_and_incubation(Agent& agent, Infection& infection,
 	// Total latency period
 	double latency = infection.latency();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(infection_parameters.time_from_exposed_to_infectiousness, latency);
 
 	if (never_sy){
 		states_manager.set_susceptible_to_exposed_never_symptomatic(agent);
 		// Set to total latency + infectiousness duration
-		double rec_time = infection_parameters.at("recovery time");
+		double rec_time = infection_parameters.recovery_time;
 		agent.set_latency_duration(latency + rec_time);
 		agent.set_latency_end_time(time);
 		agent.set_infectiousness_start_time(time, dt_ninf);
@@ -268,7 +268,7 @@ void FluTransitions::set_testing_status(Agent& agent, Infection& infection, cons
 										std::vector<School>& schools, std::vector<Workplace>& workplaces, 
 										std::vector<Hospital>& hospitals, std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing)
 {
 	const int n_hospitals = hospitals.size();
@@ -279,7 +279,7 @@ void FluTransitions::set_testing_status(Agent& agent, Infection& infection, cons
  		will_be_tested = infection.will_be_tested(testing.get_exp_tested_prob());
 		if (will_be_tested == true){
 			// Determine type of testing
-			if (infection.tested_in_hospital(infection_parameters.at("fraction tested in hospitals"))){
+			if (infection.tested_in_hospital(infection_parameters.fraction_tested_in_hospitals)){
 				states_manager.set_exposed_waiting_for_test_in_hospital(agent);
 				int hsp_ID = infection.get_random_hospital_ID(n_hospitals);
 				// Registration will happen only upon testing time step
@@ -291,7 +291,7 @@ void FluTransitions::set_testing_status(Agent& agent, Infection& infection, cons
 			remove_from_all_workplaces_and_schools(agent, schools, workplaces, retirement_homes,
 							carpools, public_transit);
 			// Time to test
-			agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+			agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 			agent.set_time_of_test(time);
 		}
 	} 
@@ -299,10 +299,10 @@ void FluTransitions::set_testing_status(Agent& agent, Infection& infection, cons
 
 // Non-covid symptomatic testing changes
 void FluTransitions::testing_transitions_flu(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters)
+										const InfectionParameters& infection_parameters)
 {
 	// Determine the time agent gets results
-	agent.set_time_until_results(infection_parameters.at("time from test to results"));
+	agent.set_time_until_results(infection_parameters.time_from_test_to_results);
 	agent.set_time_of_results(time);
 	states_manager.set_tested_to_awaiting_results(agent);
 }
@@ -315,13 +315,13 @@ void FluTransitions::testing_results_transitions_flu(Agent& agent,
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters, const Testing& testing)
+			const InfectionParameters& infection_parameters, const Testing& testing)
 {
 	// If false positive, put under home isolation 
-	double fneg_prob = infection_parameters.at("fraction false positive");
+	double fneg_prob = infection_parameters.fraction_false_positive;
 	if (infection.false_positive_test_result(fneg_prob) == true){
 		states_manager.set_tested_false_positive(agent);
-		agent.set_recovery_duration(infection_parameters.at("recovery time"));
+		agent.set_recovery_duration(infection_parameters.recovery_time);
 		agent.set_recovery_time(time);	
 	} else { 		
 		// If confirmed negative, release the isolation	
@@ -329,7 +329,7 @@ void FluTransitions::testing_results_transitions_flu(Agent& agent,
 		states_manager.set_tested_negative(agent);
 		add_to_all_workplaces_and_schools(agent, schools, workplaces, retirement_homes,
 											carpools, public_transit);
-		int new_flu = flu.swap_flu_agent(agent.get_ID());
+		int new_flu = changes.swap_flu_agent(flu, agent.get_ID());
 		// If still available
 		if (new_flu != -1){
 			process_new_flu(agents.at(new_flu-1), hospitals.size(), time, schools, workplaces, 
@@ -348,24 +348,24 @@ void FluTransitions::remove_from_all_workplaces_and_schools(Agent& agent,
 	// Else remove depending on status	
 	int agent_ID = agent.get_ID();
 	if (agent.student()){
-		schools.at(agent.get_school_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(schools.at(agent.get_school_ID()-1), agent_ID);
 	}
 	if (agent.works()){
 		if (agent.works_from_home()) {
 			return;
 		}
 		if (agent.retirement_home_employee()){
-			retirement_homes.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(retirement_homes.at(agent.get_work_ID()-1), agent_ID);
 		} else if (agent.school_employee()){
-			schools.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(schools.at(agent.get_work_ID()-1), agent_ID);
 		} else {
-			workplaces.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(workplaces.at(agent.get_work_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "carpool") {
-			carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(carpools.at(agent.get_carpool_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "public") {
-			public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(public_transit.at(agent.get_public_transit_ID()-1), agent_ID);
 		}
 	}
 }
@@ -378,24 +378,24 @@ void FluTransitions::add_to_all_workplaces_and_schools(Agent& agent,
 {
 	int agent_ID = agent.get_ID();
 	if (agent.student()){
-		schools.at(agent.get_school_ID()-1).add_agent(agent_ID);
+		changes.add_agent(schools.at(agent.get_school_ID()-1), agent_ID);
 	}
 	if (agent.works()){
 		if (agent.works_from_home()) {
 			return;
 		}
 		if (agent.retirement_home_employee()){
-			retirement_homes.at(agent.get_work_ID()-1).add_agent(agent_ID);
+			changes.add_agent(retirement_homes.at(agent.get_work_ID()-1), agent_ID);
 		} else if (agent.school_employee()){
-			schools.at(agent.get_work_ID()-1).add_agent(agent_ID);
+			changes.add_agent(schools.at(agent.get_work_ID()-1), agent_ID);
 		} else {
-			workplaces.at(agent.get_work_ID()-1).add_agent(agent_ID);
+			changes.add_agent(workplaces.at(agent.get_work_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "carpool") {
-			carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
+			changes.add_agent(carpools.at(agent.get_carpool_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "public") {
-			public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
+			changes.add_agent(public_transit.at(agent.get_public_transit_ID()-1), agent_ID);
 		}
 	}
 }
@@ -15,7 +15,7 @@ int HspEmployeeTransitions::susceptible_transitions(Agent& agent, const double t
 				std::vector<Hospital>& hospitals,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
+				const InfectionParameters& infection_parameters, 
 				std::vector<Agent>& agents, const Testing& testing)
 {
 	double lambda_tot = 0.0;
@@ -84,7 +84,7 @@ double HspEmployeeTransitions::compute_susceptible_lambda(const Agent& agent, co
 
 // Compte and set agent properties related to recovery without symptoms and incubation 
 void HspEmployeeTransitions::recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				const std::map<std::string, double>& infection_parameters)
+				const InfectionParameters& infection_parameters)
 {
 	// Determine if agent will recover without
 	// becoming symptomatic and update corresponding states
@@ -93,12 +93,12 @@ void HspEmployeeTransitions::recovery_and_incubation(Agent& agent, Infection& in
 	// Total latency period
 	double latency = infection.latency();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(infection_parameters.time_from_exposed_to_infectiousness, latency);
 
 	if (never_sy){
 		states_manager.set_susceptible_to_exposed_never_symptomatic(agent);
 		// Set to total latency + infectiousness duration
-		double rec_time = infection_parameters.at("recovery time");
+		double rec_time = infection_parameters.recovery_time;
 		agent.set_latency_duration(latency + rec_time);
 		agent.set_latency_end_time(time);
 		agent.set_infectiousness_start_time(time, dt_ninf);
@@ -115,7 +115,7 @@ void HspEmployeeTransitions::recovery_and_incubation(Agent& agent, Infection& in
 std::vector<int> HspEmployeeTransitions::exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
 										std::vector<Household>& households, std::vector<School>& schools, std::vector<Hospital>& hospitals,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters, const Testing& testing)
+										const InfectionParameters& infection_parameters, const Testing& testing)
 {
 	std::vector<int> state_changes(5,0);
 	// Modified mortality for hospital emloyees
@@ -170,7 +170,7 @@ std::vector<int> HspEmployeeTransitions::exposed_transitions(Agent& agent, Infec
 			} else {
 				states_manager.set_recovering_symptomatic(agent);			
 				// This may change if treatment is ICU
-				agent.set_recovery_duration(infection_parameters.at("recovery time"));
+				agent.set_recovery_duration(infection_parameters.recovery_time);
 				agent.set_recovery_time(time);		
 			}
 
@@ -201,7 +201,7 @@ std::vector<int> HspEmployeeTransitions::exposed_transitions(Agent& agent, Infec
 // Determine any testing related properties
 void HspEmployeeTransitions::set_testing_status(Agent& agent, Infection& infection, const double time, 
 										std::vector<School>& schools, std::vector<Hospital>& hospitals,
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing)
 {
 	const int n_hospitals = hospitals.size();
@@ -215,7 +215,7 @@ void HspEmployeeTransitions::set_testing_status(Agent& agent, Infection& infecti
 			// Also - no home isolation until symptoms
 			states_manager.set_exposed_waiting_for_test_in_hospital(agent);
 			// Time to test
-			agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+			agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 			agent.set_time_of_test(time);
 		}
 	} else if (agent.symptomatic()) {
@@ -223,7 +223,7 @@ void HspEmployeeTransitions::set_testing_status(Agent& agent, Infection& infecti
 		// with home isolation set elsewhere
 		states_manager.set_waiting_for_test_in_hospital(agent);
 		// Testing-related events - will be adjusted based on other time-dependent scenarios
-		agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+		agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 		agent.set_time_of_test(time);
 	}
 }
@@ -234,7 +234,7 @@ std::vector<int> HspEmployeeTransitions::symptomatic_transitions(Agent& agent, c
 					std::vector<Household>& households, std::vector<School>& schools,
 					std::vector<Hospital>& hospitals,
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-					const std::map<std::string, double>& infection_parameters)
+					const InfectionParameters& infection_parameters)
 {
 	std::vector<int> state_changes(5,0);
 	int tested_pos = 0;
@@ -315,10 +315,10 @@ std::vector<int> HspEmployeeTransitions::check_agent_removal(Agent& agent, const
 
 // Agent transitions related to testing time
 void HspEmployeeTransitions::testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters)
+										const InfectionParameters& infection_parameters)
 {
 	// Determine the time agent gets results
-	agent.set_time_until_results(infection_parameters.at("time from test to results"));
+	agent.set_time_until_results(infection_parameters.time_from_test_to_results);
 	agent.set_time_of_results(time);
 	states_manager.set_tested_to_awaiting_results(agent);
 }
@@ -329,11 +329,11 @@ int HspEmployeeTransitions::testing_results_transitions(Agent& agent,
 			std::vector<Household>& households, std::vector<School>& schools,
 			std::vector<Hospital>& hospitals,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// If false negative, remove testing, put back to exposed
 	// No false negative symptomatic
-	double fneg_prob = infection_parameters.at("fraction false negative");
+	double fneg_prob = infection_parameters.fraction_false_negative;
 	int tested_pos = 0;
 	if (infection.false_negative_test_result(fneg_prob) == true
 				&& agent.exposed() == true){
@@ -362,7 +362,7 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 			std::vector<Household>& households, std::vector<School>& schools,
 			std::vector<Hospital>& hospitals,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	if (infection.agent_hospitalized(agent.get_age()) == true){
 		// Remove agent from all places, then add to a random
@@ -372,7 +372,7 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 
         // But then add to their own hospital 
         int hID = agent.get_hospital_ID();
-        hospitals.at(hID-1).add_agent(agent.get_ID());
+        changes.add_agent(hospitals.at(hID-1), agent.get_ID());
 
 		// ICU
 		if (infection.agent_hospitalized_ICU(agent.get_age()) == true){
@@ -385,8 +385,8 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 				// If recovering - set times and transitions
 				states_manager.set_icu_recovering(agent);
 				// Reset the recovery time to > ICU + hospitalization
-				double t_icu = infection_parameters.at("time in ICU");
-				double t_hsp_icu = infection_parameters.at("time in hospital after ICU");
+				double t_icu = infection_parameters.time_in_icu;
+				double t_hsp_icu = infection_parameters.time_in_hospital_after_icu;
 				agent.set_time_icu_to_hsp(time + t_icu);
 			   	agent.set_time_hsp_to_ih(time + t_icu + t_hsp_icu);	
 				agent.set_recovery_duration(t_icu + t_hsp_icu);
@@ -397,13 +397,13 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 			states_manager.set_hospitalized(agent);
 			// If dying, set transition to ICU
 			if (agent.dying() == true){
-				double dt_icu = infection_parameters.at("time before death to ICU");
+				double dt_icu = infection_parameters.time_before_death_to_icu;
 				double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 				agent.set_time_hsp_to_icu(t_icu);	
 			}else{
 				// If recovering, set transition to home
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -419,7 +419,7 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 		states_manager.set_home_isolation(agent);
 		// If dying, set transition to ICU
 		if (agent.dying() == true){
-			double dt_icu = infection_parameters.at("time before death to ICU");
+			double dt_icu = infection_parameters.time_before_death_to_icu;
 			double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 			agent.set_time_ih_to_icu(t_icu);	
 		}else{
@@ -442,7 +442,7 @@ void HspEmployeeTransitions::select_initial_treatment(Agent& agent,
 void HspEmployeeTransitions::treatment_transitions(Agent& agent, const double time, 
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// ICU - can only transition to hospitalization
 	// if not dying
@@ -466,9 +466,9 @@ void HspEmployeeTransitions::treatment_transitions(Agent& agent, const double ti
 				agent.set_home_isolated(true);
 				// Remove from hospital and add to household
 				int agent_ID = agent.get_ID();
-		        households.at(agent.get_household_ID()-1).add_agent(agent_ID);
+		        changes.add_agent(households.at(agent.get_household_ID()-1), agent_ID);
 		        // Remove agent from hospital
-		        hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+		        changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 			}
 		}
 	}else if (agent.home_isolated()){
@@ -477,9 +477,9 @@ void HspEmployeeTransitions::treatment_transitions(Agent& agent, const double ti
 			if (agent.get_time_ih_to_icu() <= time){
                 // Set hospital ID, add to hospital 
                 int hID = agent.get_hospital_ID();
-                hospitals.at(hID-1).add_agent(agent.get_ID());
+                changes.add_agent(hospitals.at(hID-1), agent.get_ID());
 				// Remove from home
-				households.at(agent.get_household_ID()-1).remove_agent(agent.get_ID());
+				changes.remove_agent(households.at(agent.get_household_ID()-1), agent.get_ID());
 				agent.set_home_isolated(false);
 				agent.set_hospitalized(false);
 				agent.set_hospitalized_ICU(true);	
@@ -494,12 +494,12 @@ void HspEmployeeTransitions::treatment_transitions(Agent& agent, const double ti
 				agent.set_hospitalized(true);
                 // Set hospital ID, add to hospital 
                 int hID = agent.get_hospital_ID();
-                hospitals.at(hID-1).add_agent(agent.get_ID());				
+                changes.add_agent(hospitals.at(hID-1), agent.get_ID());				
 				// Remove from home
-				households.at(agent.get_household_ID()-1).remove_agent(agent.get_ID());
+				changes.remove_agent(households.at(agent.get_household_ID()-1), agent.get_ID());
 				// Set transition back
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -524,19 +524,19 @@ void HspEmployeeTransitions::remove_agent_from_all_places(const Agent& agent,
 	int agent_ID = agent.get_ID();
 	int hs_ID = agent.get_household_ID();
 	if (hs_ID != 0){
-		households.at(hs_ID-1).remove_agent(agent_ID);
+		changes.remove_agent(households.at(hs_ID-1), agent_ID);
 	} else {
 		throw std::runtime_error("Symptomatic agent does not have a valid household ID");
 	}
 	if (agent.student()) {
-		schools.at(agent.get_school_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(schools.at(agent.get_school_ID()-1), agent_ID);
 	}
-	hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+	changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 	if (agent.get_work_travel_mode() == "carpool") {
-		carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(carpools.at(agent.get_carpool_ID()-1), agent_ID);
 	}
 	if (agent.get_work_travel_mode() == "public") {
-		public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(public_transit.at(agent.get_public_transit_ID()-1), agent_ID);
 	}
 }
 
@@ -554,18 +554,18 @@ void HspEmployeeTransitions::add_agent_to_all_places(const Agent& agent,
 		throw std::runtime_error("Attempting recovery of an agent directly from ICU");
 	}
 	if (agent.student()){
-		schools.at(agent.get_school_ID()-1).add_agent(agent_ID);
+		changes.add_agent(schools.at(agent.get_school_ID()-1), agent_ID);
 	}
 	if (agent.hospitalized()){
-		households.at(agent.get_household_ID()-1).add_agent(agent_ID);
-		hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+		changes.add_agent(households.at(agent.get_household_ID()-1), agent_ID);
+		changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 	}
-	hospitals.at(agent.get_hospital_ID()-1).add_agent(agent_ID);
+	changes.add_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 	if (agent.get_work_travel_mode() == "carpool") {
-		carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
+		changes.add_agent(carpools.at(agent.get_carpool_ID()-1), agent_ID);
 	}
 	if (agent.get_work_travel_mode() == "public") {
-		public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
+		changes.add_agent(public_transit.at(agent.get_public_transit_ID()-1), agent_ID);
 	}
 }
 
@@ -575,15 +575,15 @@ void HspEmployeeTransitions::remove_from_hospitals_and_schools(const Agent& agen
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit)
 {
 	int agent_ID = agent.get_ID();
-	hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+	changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 	if (agent.student()){
-		schools.at(agent.get_school_ID()-1).remove_agent(agent_ID);				
+		changes.remove_agent(schools.at(agent.get_school_ID()-1), agent_ID);				
 	}
 	if (agent.get_work_travel_mode() == "carpool") {
-		carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(carpools.at(agent.get_carpool_ID()-1), agent_ID);
 	}
 	if (agent.get_work_travel_mode() == "public") {
-		public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(public_transit.at(agent.get_public_transit_ID()-1), agent_ID);
 	}
 }
 
@@ -594,14 +594,14 @@ void HspEmployeeTransitions::add_to_hospitals_and_schools(const Agent& agent,
 {
 	int agent_ID = agent.get_ID();
 	if (agent.student()) {
-		schools.at(agent.get_school_ID()-1).add_agent(agent_ID);
+		changes.add_agent(schools.at(agent.get_school_ID()-1), agent_ID);
 	}
-	hospitals.at(agent.get_hospital_ID()-1).add_agent(agent_ID);
+	changes.add_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 	if (agent.get_work_travel_mode() == "carpool") {
-		carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
+		changes.add_agent(carpools.at(agent.get_carpool_ID()-1), agent_ID);
 	}
 	if (agent.get_work_travel_mode() == "public") {
-		public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
+		changes.add_agent(public_transit.at(agent.get_public_transit_ID()-1), agent_ID);
 	}
 }
 
@@ -12,7 +12,7 @@
 
 // Implement transitions relevant to susceptible
 int HspPatientTransitions::susceptible_transitions(Agent& agent, const double time, Infection& infection,	
-				std::vector<Hospital>& hospitals, const std::map<std::string, double>& infection_parameters, 
+				std::vector<Hospital>& hospitals, const InfectionParameters& infection_parameters, 
 				std::vector<Agent>& agents, const Testing& testing)
 {
 	double lambda_tot = 0.0;
@@ -48,7 +48,7 @@ double HspPatientTransitions::compute_susceptible_lambda(const Agent& agent, con
 
 // Compte and set agent properties related to recovery without symptoms and incubation 
 void HspPatientTransitions::recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				const std::map<std::string, double>& infection_parameters)
+				const InfectionParameters& infection_parameters)
 {
 	// Determine if agent will recover without
 	// becoming symptomatic and update corresponding states
@@ -57,12 +57,12 @@ void HspPatientTransitions::recovery_and_incubation(Agent& agent, Infection& inf
 	// Total latency period
 	double latency = infection.latency();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(infection_parameters.time_from_exposed_to_infectiousness, latency);
 
 	if (never_sy){
 		states_manager.set_susceptible_to_exposed_never_symptomatic(agent);
 		// Set to total latency + infectiousness duration
-		double rec_time = infection_parameters.at("recovery time");
+		double rec_time = infection_parameters.recovery_time;
 		agent.set_latency_duration(latency + rec_time);
 		agent.set_latency_end_time(time);
 		agent.set_infectiousness_start_time(time, dt_ninf);
@@ -78,7 +78,7 @@ void HspPatientTransitions::recovery_and_incubation(Agent& agent, Infection& inf
 // Implement transitions relevant to exposed 
 std::vector<int> HspPatientTransitions::exposed_transitions(Agent& agent, Infection& infection, const double time, const double dt, 
 										std::vector<Household>& households, std::vector<Hospital>& hospitals, 
-										const std::map<std::string, double>& infection_parameters, const Testing& testing)
+										const InfectionParameters& infection_parameters, const Testing& testing)
 {
 	std::vector<int> state_changes(5,0);
 	// Modified mortality rate for hospital patients
@@ -127,7 +127,7 @@ std::vector<int> HspPatientTransitions::exposed_transitions(Agent& agent, Infect
 			} else {
 				states_manager.set_recovering_symptomatic(agent);			
 				// This may change if treatment is ICU
-				agent.set_recovery_duration(infection_parameters.at("recovery time"));
+				agent.set_recovery_duration(infection_parameters.recovery_time);
 				agent.set_recovery_time(time);		
 			}
 			// Determine testing time and set home isolation - if not yet confirmed and IH
@@ -151,7 +151,7 @@ std::vector<int> HspPatientTransitions::exposed_transitions(Agent& agent, Infect
 // Determine any testing related properties
 void HspPatientTransitions::set_testing_status(Agent& agent, Infection& infection, const double time, 
 										std::vector<Hospital>& hospitals, 
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing)
 {
 	const int n_hospitals = hospitals.size();
@@ -166,7 +166,7 @@ void HspPatientTransitions::set_testing_status(Agent& agent, Infection& infectio
 			// Also - no home isolation until symptoms
 			states_manager.set_exposed_waiting_for_test_in_hospital(agent);
 			// Time to test
-			agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+			agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 			agent.set_time_of_test(time);
 		}
 	} else if (agent.symptomatic()) {
@@ -176,7 +176,7 @@ void HspPatientTransitions::set_testing_status(Agent& agent, Infection& infectio
 		// Will stay in the hospital
 		agent.set_home_isolated(false);
 		// Testing-related events - will be adjusted based on other time-dependent scenarios
-		agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+		agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 		agent.set_time_of_test(time);
 	}
 }
@@ -185,7 +185,7 @@ void HspPatientTransitions::set_testing_status(Agent& agent, Infection& infectio
 std::vector<int> HspPatientTransitions::symptomatic_transitions(Agent& agent, const double time, 
 				   	const double dt, Infection& infection,
 					std::vector<Household>& households, std::vector<Hospital>& hospitals,
-					const std::map<std::string, double>& infection_parameters)
+					const InfectionParameters& infection_parameters)
 {
 	std::vector<int> state_changes(5,0);
 	int tested_pos = 0;
@@ -263,10 +263,10 @@ std::vector<int> HspPatientTransitions::check_agent_removal(Agent& agent, const
 
 // Agent transitions related to testing time
 void HspPatientTransitions::testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters)
+										const InfectionParameters& infection_parameters)
 {
 	// Determine the time agent gets results
-	agent.set_time_until_results(infection_parameters.at("time from test to results"));
+	agent.set_time_until_results(infection_parameters.time_from_test_to_results);
 	agent.set_time_of_results(time);
 	states_manager.set_tested_to_awaiting_results(agent);
 }
@@ -275,11 +275,11 @@ void HspPatientTransitions::testing_transitions(Agent& agent, const double time,
 int HspPatientTransitions::testing_results_transitions(Agent& agent, 
 			const double time, const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// If false negative, remove testing, put back to exposed
 	// No false negative symptomatic
-	double fneg_prob = infection_parameters.at("fraction false negative");
+	double fneg_prob = infection_parameters.fraction_false_negative;
 	int tested_pos = 0;
 	if (infection.false_negative_test_result(fneg_prob) == true
 			&& agent.exposed() == true){
@@ -294,9 +294,9 @@ int HspPatientTransitions::testing_results_transitions(Agent& agent,
             agent.set_household_ID(hs_ID);
             // Register agent's ID
             int agent_ID = agent.get_ID();
-            households.at(hs_ID-1).add_agent(agent_ID);
+            changes.add_agent(households.at(hs_ID-1), agent_ID);
             // Remove agent from hospital
-            hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+            changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 			agent.set_tested_covid_positive(true);
 		} else {
 			// Symptomatic - identify treatment
@@ -316,7 +316,7 @@ int HspPatientTransitions::testing_results_transitions(Agent& agent,
 void HspPatientTransitions::select_initial_treatment(Agent& agent, 
 			const double time, const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	if (infection.agent_hospitalized(agent.get_age()) == true){
 		// Remove agent from all places, then add to a random
@@ -324,7 +324,7 @@ void HspPatientTransitions::select_initial_treatment(Agent& agent,
 		remove_agent_from_all_places(agent, households, hospitals);
 
         int hID = agent.get_hospital_ID();
-        hospitals.at(hID-1).add_agent(agent.get_ID());
+        changes.add_agent(hospitals.at(hID-1), agent.get_ID());
 		
 		// ICU
 		if (infection.agent_hospitalized_ICU(agent.get_age()) == true){
@@ -337,8 +337,8 @@ void HspPatientTransitions::select_initial_treatment(Agent& agent,
 				// If recovering - set times and transitions
 				states_manager.set_icu_recovering(agent);
 				// Reset the recovery time to > ICU + hospitalization
-				double t_icu = infection_parameters.at("time in ICU");
-				double t_hsp_icu = infection_parameters.at("time in hospital after ICU");
+				double t_icu = infection_parameters.time_in_icu;
+				double t_hsp_icu = infection_parameters.time_in_hospital_after_icu;
 				agent.set_time_icu_to_hsp(time + t_icu);
 			   	agent.set_time_hsp_to_ih(time + t_icu + t_hsp_icu);	
 				agent.set_recovery_duration(t_icu + t_hsp_icu);
@@ -349,13 +349,13 @@ void HspPatientTransitions::select_initial_treatment(Agent& agent,
 			states_manager.set_hospitalized(agent);
 			// If dying, set transition to ICU
 			if (agent.dying() == true){
-				double dt_icu = infection_parameters.at("time before death to ICU");
+				double dt_icu = infection_parameters.time_before_death_to_icu;
 				double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 				agent.set_time_hsp_to_icu(t_icu);	
 			}else{
 				// If recovering, set transition to home
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -374,13 +374,13 @@ void HspPatientTransitions::select_initial_treatment(Agent& agent,
     	    agent.set_household_ID(hs_ID);
     	    // Register agent's ID
     	    int agent_ID = agent.get_ID();
-    	    households.at(hs_ID-1).add_agent(agent_ID);
+    	    changes.add_agent(households.at(hs_ID-1), agent_ID);
     	    // Remove agent from hospital
-    	    hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+    	    changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 		}
 		// If dying, set transition to ICU
 		if (agent.dying() == true){
-			double dt_icu = infection_parameters.at("time before death to ICU");
+			double dt_icu = infection_parameters.time_before_death_to_icu;
 			double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 			agent.set_time_ih_to_icu(t_icu);	
 		}else{
@@ -400,7 +400,7 @@ void HspPatientTransitions::select_initial_treatment(Agent& agent,
 void HspPatientTransitions::treatment_transitions(Agent& agent, const double time, 
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// ICU - can only transition to hospitalization
 	// if not dying
@@ -426,9 +426,9 @@ void HspPatientTransitions::treatment_transitions(Agent& agent, const double tim
 		        agent.set_household_ID(hs_ID);
 		        // Register agent's ID
 		        int agent_ID = agent.get_ID();
-		        households.at(hs_ID-1).add_agent(agent_ID);
+		        changes.add_agent(households.at(hs_ID-1), agent_ID);
 		        // Remove agent from hospital
-		        hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+		        changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 			}
 		}
 	}else if (agent.home_isolated()){
@@ -437,9 +437,9 @@ void HspPatientTransitions::treatment_transitions(Agent& agent, const double tim
 			if (agent.get_time_ih_to_icu() <= time){
                 // Set hospital ID, add to hospital 
                 int hID = agent.get_hospital_ID();
-                hospitals.at(hID-1).add_agent(agent.get_ID());
+                changes.add_agent(hospitals.at(hID-1), agent.get_ID());
 				// Remove from home
-				households.at(agent.get_household_ID()-1).remove_agent(agent.get_ID());
+				changes.remove_agent(households.at(agent.get_household_ID()-1), agent.get_ID());
 				agent.set_home_isolated(false);
 				agent.set_hospitalized(false);
 				agent.set_hospitalized_ICU(true);	
@@ -454,12 +454,12 @@ void HspPatientTransitions::treatment_transitions(Agent& agent, const double tim
 				agent.set_hospitalized(true);
                 // Set hospital ID, add to hospital 
                 int hID = agent.get_hospital_ID();
-                hospitals.at(hID-1).add_agent(agent.get_ID());
+                changes.add_agent(hospitals.at(hID-1), agent.get_ID());
 				// Remove from home
-				households.at(agent.get_household_ID()-1).remove_agent(agent.get_ID());
+				changes.remove_agent(households.at(agent.get_household_ID()-1), agent.get_ID());
 				// Set transition back
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -482,12 +482,12 @@ void HspPatientTransitions::remove_agent_from_all_places(const Agent& agent,
 	if (agent.home_isolated()){
 		int hs_ID = agent.get_household_ID();
 		if (hs_ID != 0){
-			households.at(hs_ID-1).remove_agent(agent_ID);
+			changes.remove_agent(households.at(hs_ID-1), agent_ID);
 		} else {
 			throw std::runtime_error("Symptomatic home isolated agent does not have a valid household ID");
 		}
 	} else {
-		hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 	}
 }
 
@@ -504,8 +504,8 @@ void HspPatientTransitions::add_agent_to_all_places(const Agent& agent,
 		throw std::runtime_error("Attempting recovery of an agent directly from ICU");
 	
 	if (agent.home_isolated()){
-		households.at(agent.get_household_ID()-1).remove_agent(agent_ID);
-		hospitals.at(agent.get_hospital_ID()-1).add_agent(agent_ID);
+		changes.remove_agent(households.at(agent.get_household_ID()-1), agent_ID);
+		changes.add_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 	}
 }
 
@@ -16,7 +16,7 @@ int RegularTransitions::susceptible_transitions(Agent& agent, const double time,
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations,
-				const std::map<std::string, double>& infection_parameters, 
+				const InfectionParameters& infection_parameters, 
 				std::vector<Agent>& agents, Flu& flu, const Testing& testing)
 {
 	double lambda_tot = 0.0;
@@ -25,7 +25,7 @@ int RegularTransitions::susceptible_transitions(Agent& agent, const double time,
 					carpools, public_transit, leisure_locations);
 	if (infection.infected(lambda_tot) == true){
 		// Remove agent from potential flu population
-		flu.remove_susceptible_agent(agent.get_ID());
+		changes.remove_susceptible_agent(flu, agent.get_ID());
 		got_infected = 1;
 		agent.set_inf_variability_factor(infection.inf_variability());
 		// Infectiousness, latency, and possibility of never developing symptoms 
@@ -135,7 +135,7 @@ double RegularTransitions::compute_susceptible_lambda(const Agent& agent, const
 
 // Compute and set agent properties related to recovery without symptoms and incubation 
 void RegularTransitions::recovery_and_incubation(Agent& agent, Infection& infection, const double time,
-				const std::map<std::string, double>& infection_parameters)
+				const InfectionParameters& infection_parameters)
 {
 	// Determine if agent will recover without
 	// becoming symptomatic and update corresponding states
@@ -143,11 +143,11 @@ void RegularTransitions::recovery_and_incubation(Agent& agent, Infection& infect
 	// Total latency period
 	double latency = infection.latency();
 	// Portion of latency when the agent is not infectious
-	double dt_ninf = std::min(infection_parameters.at("time from exposed to infectiousness"), latency);
+	double dt_ninf = std::min(infection_parameters.time_from_exposed_to_infectiousness, latency);
 	if (never_sy){
 		states_manager.set_susceptible_to_exposed_never_symptomatic(agent);
 		// Set to total latency + infectiousness duration
-		double rec_time = infection_parameters.at("recovery time");
+		double rec_time = infection_parameters.recovery_time;
 		agent.set_latency_duration(latency + rec_time);
 		agent.set_latency_end_time(time);
 		agent.set_infectiousness_start_time(time, dt_ninf);
@@ -166,7 +166,7 @@ std::vector<int> RegularTransitions::exposed_transitions(Agent& agent, Infection
 										std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 										std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters, const Testing& testing)
+										const InfectionParameters& infection_parameters, const Testing& testing)
 {
 	// Recovered, dead (not applicable), tested, tested positive, tested false negative
 	std::vector<int> state_changes(5,0);
@@ -239,7 +239,7 @@ void RegularTransitions::untested_sy_setup(Agent& agent, Infection& infection, c
 										std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 										std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing)
 {
 		// Testing status
@@ -290,7 +290,7 @@ void RegularTransitions::untested_sy_setup(Agent& agent, Infection& infection, c
 
 // Determine if the agent is recovering or dying 
 void RegularTransitions::recovery_status(Agent& agent, Infection& infection, const double time,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	int agent_age = agent.get_age();
 	if (infection.will_die_non_icu(agent_age)){
@@ -299,14 +299,14 @@ void RegularTransitions::recovery_status(Agent& agent, Infection& infection, con
 		agent.set_death_time(time);
 	} else {
 		states_manager.set_recovering_symptomatic(agent);			
-		agent.set_recovery_duration(infection_parameters.at("recovery time"));
+		agent.set_recovery_duration(infection_parameters.recovery_time);
 		agent.set_recovery_time(time);		
 	}
 }
 
 // Determine if the agent is recovering or dying in ICU 
 void RegularTransitions::recovery_status_ICU(Agent& agent, Infection& infection, const double time,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	if (infection.will_die_ICU()){
 		states_manager.set_dying_symptomatic(agent);
@@ -314,7 +314,7 @@ void RegularTransitions::recovery_status_ICU(Agent& agent, Infection& infection,
 		agent.set_death_time(time);
 	} else {
 		states_manager.set_recovering_symptomatic(agent);			
-		agent.set_recovery_duration(infection_parameters.at("recovery time"));
+		agent.set_recovery_duration(infection_parameters.recovery_time);
 		agent.set_recovery_time(time);		
 	}
 }
@@ -325,7 +325,7 @@ bool RegularTransitions::set_testing_status(Agent& agent, Infection& infection,
 										std::vector<Hospital>& hospitals,
 										std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters,
+										const InfectionParameters& infection_parameters,
 										const Testing& testing)
 {
 	const int n_hospitals = hospitals.size();
@@ -336,7 +336,7 @@ bool RegularTransitions::set_testing_status(Agent& agent, Infection& infection,
  		will_be_tested = infection.will_be_tested(testing.get_exp_tested_prob());
 		if (will_be_tested == true){
 			// Determine type of testing
-			if (infection.tested_in_hospital(infection_parameters.at("fraction tested in hospitals"))){
+			if (infection.tested_in_hospital(infection_parameters.fraction_tested_in_hospitals)){
 				states_manager.set_exposed_waiting_for_test_in_hospital(agent);
 				int hsp_ID = infection.get_random_hospital_ID(n_hospitals);
 				// Registration will happen only upon testing time step
@@ -348,14 +348,14 @@ bool RegularTransitions::set_testing_status(Agent& agent, Infection& infection,
 			remove_from_all_workplaces_and_schools(agent, schools, workplaces, retirement_homes, 
 							carpools, public_transit);
 			// Time to test
-			agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+			agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 			agent.set_time_of_test(time);
 		}
 	} else if (agent.symptomatic()) {
  		will_be_tested = infection.will_be_tested(testing.get_sy_tested_prob());
 		if (will_be_tested == true){
 			// If agent is getting tested - determine type and properties of testing
-			if (infection.tested_in_hospital(infection_parameters.at("fraction tested in hospitals"))){
+			if (infection.tested_in_hospital(infection_parameters.fraction_tested_in_hospitals)){
 				states_manager.set_waiting_for_test_in_hospital(agent);
 				int hsp_ID = infection.get_random_hospital_ID(n_hospitals);
 				// Registration will happen only upon testing time step
@@ -365,7 +365,7 @@ bool RegularTransitions::set_testing_status(Agent& agent, Infection& infection,
 			}
 	
 			// Testing-related events - will be adjusted based on other time-dependent scenarios
-			agent.set_time_to_test(infection_parameters.at("time from decision to test"));
+			agent.set_time_to_test(infection_parameters.time_from_decision_to_test);
 			agent.set_time_of_test(time);
 	
 			// Home isolation - removal from all public places except hospitals for former
@@ -384,7 +384,7 @@ std::vector<int> RegularTransitions::symptomatic_transitions(Agent& agent, const
 					std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 					std::vector<RetirementHome>& retirement_homes,
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-					const std::map<std::string, double>& infection_parameters)
+					const InfectionParameters& infection_parameters)
 {
 	std::vector<int> state_changes(5,0);
 	int tested_pos = 0;
@@ -472,10 +472,10 @@ std::vector<int> RegularTransitions::check_agent_removal(Agent& agent, const dou
 
 // Agent transitions related to testing time
 void RegularTransitions::testing_transitions(Agent& agent, const double time,
-										const std::map<std::string, double>& infection_parameters)
+										const InfectionParameters& infection_parameters)
 {
 	// Determine the time agent gets results
-	agent.set_time_until_results(infection_parameters.at("time from test to results"));
+	agent.set_time_until_results(infection_parameters.time_from_test_to_results);
 	agent.set_time_of_results(time);
 	states_manager.set_tested_to_awaiting_results(agent);
 }
@@ -487,11 +487,11 @@ int RegularTransitions::testing_results_transitions(Agent& agent,
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// If false negative, remove testing, put back to exposed
 	// No false negative symptomatic 
-	double fneg_prob = infection_parameters.at("fraction false negative");
+	double fneg_prob = infection_parameters.fraction_false_negative;
 	int tested_pos = 0;
 	if (infection.false_negative_test_result(fneg_prob) == true
 		 && agent.exposed() == true){
@@ -531,7 +531,7 @@ void RegularTransitions::select_initial_treatment(Agent& agent,
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	if (infection.agent_hospitalized(agent.get_age()) == true){
 		
@@ -543,7 +543,7 @@ void RegularTransitions::select_initial_treatment(Agent& agent,
 		// Set hospital ID and add
 		int hID = infection.get_random_hospital_ID(hospitals.size());
 		agent.set_hospital_ID(hID);
-		hospitals.at(hID-1).add_agent(agent.get_ID());
+		changes.add_agent(hospitals.at(hID-1), agent.get_ID());
 		// ICU
 		if (infection.agent_hospitalized_ICU(agent.get_age()) == true){
 			// Retest for dying
@@ -555,8 +555,8 @@ void RegularTransitions::select_initial_treatment(Agent& agent,
 				// If recovering - set times and transitions
 				states_manager.set_icu_recovering(agent);
 				// Reset the recovery time to > ICU + hospitalization
-				double t_icu = infection_parameters.at("time in ICU");
-				double t_hsp_icu = infection_parameters.at("time in hospital after ICU");
+				double t_icu = infection_parameters.time_in_icu;
+				double t_hsp_icu = infection_parameters.time_in_hospital_after_icu;
 				agent.set_time_icu_to_hsp(time + t_icu);
 			   	agent.set_time_hsp_to_ih(time + t_icu + t_hsp_icu);	
 				agent.set_recovery_duration(t_icu + t_hsp_icu);
@@ -567,13 +567,13 @@ void RegularTransitions::select_initial_treatment(Agent& agent,
 			states_manager.set_hospitalized(agent);
 			// If dying, set transition to ICU
 			if (agent.dying() == true){
-				double dt_icu = infection_parameters.at("time before death to ICU");
+				double dt_icu = infection_parameters.time_before_death_to_icu;
 				double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 				agent.set_time_hsp_to_icu(t_icu);	
 			}else{
 				// If recovering, set transition to home
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -590,7 +590,7 @@ void RegularTransitions::select_initial_treatment(Agent& agent,
 		states_manager.set_home_isolation(agent);
 		// If dying, set transition to ICU
 		if (agent.dying() == true){
-			double dt_icu = infection_parameters.at("time before death to ICU");
+			double dt_icu = infection_parameters.time_before_death_to_icu;
 			double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 			agent.set_time_ih_to_icu(t_icu);	
 		}else{
@@ -616,7 +616,7 @@ void RegularTransitions::setup_initial_treatment(Agent& agent,
 			std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
 			std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	if (agent.get_will_be_hospitalized() || agent.get_will_be_hospitalized_ICU()){
 		// Remove agent from all places, then add to a random
@@ -627,7 +627,7 @@ void RegularTransitions::setup_initial_treatment(Agent& agent,
 		// Set hospital ID and add
 		int hID = infection.get_random_hospital_ID(hospitals.size());
 		agent.set_hospital_ID(hID);
-		hospitals.at(hID-1).add_agent(agent.get_ID());
+		changes.add_agent(hospitals.at(hID-1), agent.get_ID());
 		if (agent.get_will_be_hospitalized_ICU()){
 			if (agent.dying()){
 				states_manager.set_icu_dying(agent);
@@ -635,8 +635,8 @@ void RegularTransitions::setup_initial_treatment(Agent& agent,
 				// If recovering - set times and transitions
 				states_manager.set_icu_recovering(agent);
 				// Reset the recovery time to > ICU + hospitalization
-				double t_icu = infection_parameters.at("time in ICU");
-				double t_hsp_icu = infection_parameters.at("time in hospital after ICU");
+				double t_icu = infection_parameters.time_in_icu;
+				double t_hsp_icu = infection_parameters.time_in_hospital_after_icu;
 				agent.set_time_icu_to_hsp(time + t_icu);
 				agent.set_time_hsp_to_ih(time + t_icu + t_hsp_icu);	
 				agent.set_recovery_duration(t_icu + t_hsp_icu);
@@ -647,13 +647,13 @@ void RegularTransitions::setup_initial_treatment(Agent& agent,
 			states_manager.set_hospitalized(agent);
 			// If dying, set transition to ICU
 			if (agent.dying() == true){
-				double dt_icu = infection_parameters.at("time before death to ICU");
+				double dt_icu = infection_parameters.time_before_death_to_icu;
 				double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 				agent.set_time_hsp_to_icu(t_icu);	
 			}else{
 				// If recovering, set transition to home
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -670,7 +670,7 @@ void RegularTransitions::setup_initial_treatment(Agent& agent,
 		states_manager.set_home_isolation(agent);
 		// If dying, set transition to ICU
 		if (agent.dying() == true){
-			double dt_icu = infection_parameters.at("time before death to ICU");
+			double dt_icu = infection_parameters.time_before_death_to_icu;
 			double t_icu = std::max(agent.get_time_of_death() - dt_icu, time + dt_icu);
 			agent.set_time_ih_to_icu(t_icu);	
 		}else{
@@ -696,7 +696,7 @@ void RegularTransitions::treatment_transitions(Agent& agent, const double time,
 			const double dt, Infection& infection,
 			std::vector<Household>& households, std::vector<Hospital>& hospitals,
 			std::vector<RetirementHome>& retirement_homes,
-			const std::map<std::string, double>& infection_parameters)
+			const InfectionParameters& infection_parameters)
 {
 	// ICU - can only transition to hospitalization
 	// if not dying
@@ -720,12 +720,12 @@ void RegularTransitions::treatment_transitions(Agent& agent, const double time,
 				// Remove from hospital and add to household
 				int agent_ID = agent.get_ID();
 				if (agent.retirement_home_resident()){
-					retirement_homes.at(agent.get_household_ID()-1).add_agent(agent_ID);
+					changes.add_agent(retirement_homes.at(agent.get_household_ID()-1), agent_ID);
 				} else {
-			        households.at(agent.get_household_ID()-1).add_agent(agent_ID);
+			        changes.add_agent(households.at(agent.get_household_ID()-1), agent_ID);
 				}
 		        // Remove agent from hospital
-		        hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+		        changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 			}
 		}
 	}else if (agent.home_isolated()){
@@ -735,12 +735,12 @@ void RegularTransitions::treatment_transitions(Agent& agent, const double time,
 				// Set hospital ID, add to hospital 
 				int hID = infection.get_random_hospital_ID(hospitals.size());
 				agent.set_hospital_ID(hID);
-				hospitals.at(hID-1).add_agent(agent.get_ID());
+				changes.add_agent(hospitals.at(hID-1), agent.get_ID());
 				// Remove from home
 				if (agent.retirement_home_resident()){
-					retirement_homes.at(agent.get_household_ID()-1).remove_agent(agent.get_ID());
+					changes.remove_agent(retirement_homes.at(agent.get_household_ID()-1), agent.get_ID());
 				} else {
-			        households.at(agent.get_household_ID()-1).remove_agent(agent.get_ID());
+			        changes.remove_agent(households.at(agent.get_household_ID()-1), agent.get_ID());
 				}
 				agent.set_home_isolated(false);
 				agent.set_hospitalized(false);
@@ -757,16 +757,16 @@ void RegularTransitions::treatment_transitions(Agent& agent, const double time,
 				// Set hospital ID 
 				int hID = infection.get_random_hospital_ID(hospitals.size());
 				agent.set_hospital_ID(hID);
-				hospitals.at(hID-1).add_agent(agent.get_ID());
+				changes.add_agent(hospitals.at(hID-1), agent.get_ID());
 				// Remove from home
 				if (agent.retirement_home_resident()){
-					retirement_homes.at(agent.get_household_ID()-1).remove_agent(agent.get_ID());
+					changes.remove_agent(retirement_homes.at(agent.get_household_ID()-1), agent.get_ID());
 				} else {
-			        households.at(agent.get_household_ID()-1).remove_agent(agent.get_ID());
+			        changes.remove_agent(households.at(agent.get_household_ID()-1), agent.get_ID());
 				}
 				// Set transition back
 				double t_rh = agent.get_recovery_time();
-				double del_t_hsp = infection_parameters.at("time in hospital");
+				double del_t_hsp = infection_parameters.time_in_hospital;
 				double t_hsp = time + del_t_hsp; 
 				if (t_rh > t_hsp){
 					agent.set_time_hsp_to_ih(t_hsp);
@@ -793,34 +793,34 @@ void RegularTransitions::remove_agent_from_all_places(const Agent& agent,
 	int hs_ID = agent.get_household_ID();
 	if (hs_ID > 0){
 		if (agent.retirement_home_resident()){
-			retirement_homes.at(agent.get_household_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(retirement_homes.at(agent.get_household_ID()-1), agent_ID);
 		} else {
-		    households.at(agent.get_household_ID()-1).remove_agent(agent_ID);
+		    changes.remove_agent(households.at(agent.get_household_ID()-1), agent_ID);
 		}
 	} else {
 		throw std::runtime_error("Regular symptomatic agent does not have a valid household ID");
 	}
 	
 	if (agent.hospitalized() || agent.hospitalized_ICU()){
-		hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 	}
 
 	if (agent.student()){
-		schools.at(agent.get_school_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(schools.at(agent.get_school_ID()-1), agent_ID);
 	}
 	if (agent.works() && !agent.works_from_home()){
 		if (agent.retirement_home_employee()){
-			retirement_homes.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(retirement_homes.at(agent.get_work_ID()-1), agent_ID);
 		} else if (agent.school_employee()){
-			schools.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(schools.at(agent.get_work_ID()-1), agent_ID);
 		} else {
-			workplaces.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(workplaces.at(agent.get_work_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "carpool") {
-			carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(carpools.at(agent.get_carpool_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "public") {
-			public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(public_transit.at(agent.get_public_transit_ID()-1), agent_ID);
 		}
 	}
 }
@@ -833,23 +833,23 @@ void RegularTransitions::add_to_all_workplaces_and_schools(const Agent& agent,
 {
 	int agent_ID = agent.get_ID();
 	if (agent.student())
-		schools.at(agent.get_school_ID()-1).add_agent(agent_ID);
+		changes.add_agent(schools.at(agent.get_school_ID()-1), agent_ID);
 	if (agent.works()){
 		if (agent.works_from_home()) {
 			return;
 		}
 		if (agent.retirement_home_employee()){
-			retirement_homes.at(agent.get_work_ID()-1).add_agent(agent_ID);
+			changes.add_agent(retirement_homes.at(agent.get_work_ID()-1), agent_ID);
 		} else if (agent.school_employee()){
-			schools.at(agent.get_work_ID()-1).add_agent(agent_ID);
+			changes.add_agent(schools.at(agent.get_work_ID()-1), agent_ID);
 		} else {
-			workplaces.at(agent.get_work_ID()-1).add_agent(agent_ID);
+			changes.add_agent(workplaces.at(agent.get_work_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "carpool") {
-			carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
+			changes.add_agent(carpools.at(agent.get_carpool_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "public") {
-			public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
+			changes.add_agent(public_transit.at(agent.get_public_transit_ID()-1), agent_ID);
 		}
 	}
 }
@@ -862,23 +862,23 @@ void RegularTransitions::remove_from_all_workplaces_and_schools(const Agent& age
 {
 	int agent_ID = agent.get_ID();
 	if (agent.student())
-		schools.at(agent.get_school_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(schools.at(agent.get_school_ID()-1), agent_ID);
 	if (agent.works()){
 		if (agent.works_from_home()) {
 			return;
 		}
 		if (agent.retirement_home_employee()){
-			retirement_homes.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(retirement_homes.at(agent.get_work_ID()-1), agent_ID);
 		} else if (agent.school_employee()){
-			schools.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(schools.at(agent.get_work_ID()-1), agent_ID);
 		} else {
-			workplaces.at(agent.get_work_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(workplaces.at(agent.get_work_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "carpool") {
-			carpools.at(agent.get_carpool_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(carpools.at(agent.get_carpool_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "public") {
-			public_transit.at(agent.get_public_transit_ID()-1).remove_agent(agent_ID);
+			changes.remove_agent(public_transit.at(agent.get_public_transit_ID()-1), agent_ID);
 		}
 	}
 }
@@ -898,33 +898,33 @@ void RegularTransitions::add_agent_to_all_places(const Agent& agent,
 		throw std::runtime_error("Attempting recovery of an agent directly from ICU");
 	// Remove from all not to count twice
 	if (agent.hospitalized()){
-		hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
+		changes.remove_agent(hospitals.at(agent.get_hospital_ID()-1), agent_ID);
 	}
 	if (agent.student()){
-		schools.at(agent.get_school_ID()-1).add_agent(agent_ID);
+		changes.add_agent(schools.at(agent.get_school_ID()-1), agent_ID);
 	}
 	if (agent.works() && !agent.works_from_home()){
 		if (agent.retirement_home_employee()){
-			retirement_homes.at(agent.get_work_ID()-1).add_agent(agent_ID);
+			changes.add_agent(retirement_homes.at(agent.get_work_ID()-1), agent_ID);
 		} else if (agent.school_employee()){
-			schools.at(agent.get_work_ID()-1).add_agent(agent_ID);
+			changes.add_agent(schools.at(agent.get_work_ID()-1), agent_ID);
 		} else {
-			workplaces.at(agent.get_work_ID()-1).add_agent(agent_ID);
+			changes.add_agent(workplaces.at(agent.get_work_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "carpool") {
-			carpools.at(agent.get_carpool_ID()-1).add_agent(agent_ID);
+			changes.add_agent(carpools.at(agent.get_carpool_ID()-1), agent_ID);
 		}
 		if (agent.get_work_travel_mode() == "public") {
-			public_transit.at(agent.get_public_transit_ID()-1).add_agent(agent_ID);
+			changes.add_agent(public_transit.at(agent.get_public_transit_ID()-1), agent_ID);
 		}
 	}
 	// Hospitalized was the only possibility where infected agent was not
 	// associated with a household
 	if (agent.hospitalized()){
 		if (agent.retirement_home_resident()){
-			retirement_homes.at(agent.get_household_ID()-1).add_agent(agent_ID);
+			changes.add_agent(retirement_homes.at(agent.get_household_ID()-1), agent_ID);
 		} else {
-		    households.at(agent.get_household_ID()-1).add_agent(agent_ID);
+		    changes.add_agent(households.at(agent.get_household_ID()-1), agent_ID);
 		}
 	}
 }
@@ -16,7 +16,7 @@ std::vector<int> Transitions::susceptible_transitions(Agent& agent, const double
 				std::vector<RetirementHome>& retirement_homes,
 				std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
 				std::vector<Leisure>& leisure_locations, 
-				const std::map<std::string, double>& infection_parameters, 
+				const InfectionParameters& infection_parameters, 
 				std::vector<Agent>& agents, Flu& flu, const Testing& testing)
 {
 	// Ingected, tested, negative, false positive 
@@ -54,7 +54,7 @@ std::vector<int> Transitions::exposed_transitions(Agent& agent, Infection& infec
 										std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 										std::vector<RetirementHome>& retirement_homes,
 										std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-										const std::map<std::string, double>& infection_parameters, const Testing& testing)
+										const InfectionParameters& infection_parameters, const Testing& testing)
 {
 	// Recovered, dead, tested, tested positive, tested false negative
 	std::vector<int> state_changes(5,0);
@@ -80,7 +80,7 @@ std::vector<int> Transitions::symptomatic_transitions(Agent& agent, const double
 					std::vector<Workplace>& workplaces, std::vector<Hospital>& hospitals,
 					std::vector<RetirementHome>& retirement_homes,
 					std::vector<Transit>& carpools, std::vector<Transit>& public_transit,
-					const std::map<std::string, double>& infection_parameters)
+					const InfectionParameters& infection_parameters)
 {
 	// Recovered, dead, tested, tested positive, false negative
 	std::vector<int> state_changes(5,0);
@@ -102,4 +102,44 @@ std::vector<int> Transitions::symptomatic_transitions(Agent& agent, const double
 	return state_changes; 
 }
 
+// Earliest time a timer can trigger a transition of an infected agent
+double Transitions::next_transition_time(const Agent& agent, const double dt)
+{
+	double t_next = std::numeric_limits<double>::infinity();
+	auto consider = [&t_next](const double t){ t_next = std::min(t_next, t); };
+	
+	// Testing, in both stages
+	if (agent.tested() && agent.tested_awaiting_test()){
+		consider(agent.get_time_of_test());
+	}
+	if (agent.tested() && agent.tested_awaiting_results()){
+		consider(agent.get_time_of_results());
+	}
+	if (agent.exposed()){
+		consider(agent.get_latency_end_time());
+		return t_next;
+	}
 
+	// Removal
+	if (agent.dying()){
+		consider(agent.get_time_of_death());
+	}
+	if (agent.recovering()){
+		consider(agent.get_recovery_time());
+	}
+	// Treatment, same order of checks as in the transitions
+	if (agent.being_treated()){
+		if (agent.recovering() && agent.hospitalized_ICU()){
+			consider(agent.get_time_icu_to_hsp());
+		} else if (agent.hospitalized()){
+			consider(agent.dying() ? agent.get_time_hsp_to_icu() : agent.get_time_hsp_to_ih());
+		} else if (agent.home_isolated()){
+			if (agent.dying()){
+				consider(agent.get_time_ih_to_icu());
+			} else if (agent.get_time_ih_to_hsp() >= dt){
+				consider(agent.get_time_ih_to_hsp());
+			}
+		}
+	}
+	return t_next;
+}
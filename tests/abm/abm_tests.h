@@ -3,7 +3,10 @@
 
 #include <iterator>
 #include "../../include/abm.h"
+#include "../../include/ensemble.h"
+#include "../../include/region.h"
 #include "../../include/utils.h"
+#include "../../include/io_operations/population_generator.h"
 #include "../common/test_utils.h"
 
 template<typename T>
@@ -20,6 +20,9 @@ bool create_agents_test();
 bool create_agents_file_test();
 bool vac_reopen_setup_test();
 bool create_active_for_vac_reopen_test();
+bool create_population_image_test();
+bool infection_parameters_test();
+bool generated_population_test();
 
 // Supporting functions
 bool compare_places_files(std::string fname_in, std::string fname_out, 
@@ -36,6 +39,7 @@ bool correctly_registered(const ABM, const std::vector<std::vector<int>>,
 bool check_initially_infected(const Agent& agent, const Flu& flu, int& n_exposed_never_sy,
 								const std::map<std::string, double> infection_parameters);
 bool check_fractions(int, int, double, std::string);
+bool same_files(const std::string&, const std::string&);
 
 int main()
 {
@@ -52,6 +56,9 @@ int main()
 	test_pass(create_agents_file_test(), "Agent creation - file");
 	test_pass(vac_reopen_setup_test(), "Initialization for vaccination/reopening studies");
 	test_pass(create_active_for_vac_reopen_test(), "Initialization of active COVID-19 cases for vaccination/reopening studies");
+	test_pass(create_population_image_test(), "Creation from a population image");
+	test_pass(infection_parameters_test(), "Validated infection parameters");
+	test_pass(generated_population_test(), "Creation from a generated town");
 }
 
 // Checks household creation from file
@@ -922,6 +929,8 @@ bool vac_reopen_setup_test()
 	const std::vector<Transit>& carpools = abm.get_vector_of_carpools();
 	const std::vector<Transit>& public_transit = abm.get_vector_of_public_transit();
 	const std::vector<Leisure>& leisure = abm.get_vector_of_leisure_locations();
+	// Reductions scale contributions of each place type
+	const PlacePolicy& policy = abm.get_place_policy();
 
 	// Check relevant agent properties 
 	for (const auto& agent : agents) { 
@@ -961,18 +970,18 @@ bool vac_reopen_setup_test()
 
 	// Parameter check
 	for (const auto& school : schools) {
-		if (!float_equality<double>(school.get_transmission_rate(), exp_beta_sch_students, 1e-5)){
+		if (!float_equality<double>(school.get_transmission_rate()*policy.schools, exp_beta_sch_students, 1e-5)){
 			std::cerr << "Wrong school transmission rate for students" << std::endl;
 			return false;
 		}
-		if (!float_equality<double>(school.get_employee_transmission_rate(), exp_beta_sch_emp, 1e-5)){
+		if (!float_equality<double>(school.get_employee_transmission_rate()*policy.schools, exp_beta_sch_emp, 1e-5)){
 			std::cerr << "Wrong school transmission rate for employees" << std::endl;
 			return false;
 		}
 	}
 	for (const auto& work : workplaces) {
 		if (work.outside_town()) {
-			if (!float_equality<double>(work.get_outside_lambda(), exp_beta_work_out, 1e-5)){
+			if (!float_equality<double>(work.get_outside_lambda()*policy.outside_workplaces, exp_beta_work_out, 1e-5)){
 				std::cerr << "Wrong workplace transmission rate in an outside workplace" << std::endl;
 				return false;
 			}
@@ -995,35 +1004,35 @@ bool vac_reopen_setup_test()
 				return false;
 			}
 			occ_beta *= infection_parameters.at("fraction of phase 4 businesses");
-			if (!float_equality<double>(work.get_transmission_rate(), occ_beta, 1e-5)){
-				std::cerr << "Wrong workplace transmission rate in an in-town workplace " << work.get_transmission_rate() << " " << occ_beta << std::endl;
+			if (!float_equality<double>(work.get_transmission_rate()*policy.workplaces, occ_beta, 1e-5)){
+				std::cerr << "Wrong workplace transmission rate in an in-town workplace " << work.get_transmission_rate()*policy.workplaces << " " << occ_beta << std::endl;
 				return false;
 			}
 		}
 	}
 	for (const auto& cpool : carpools) {
-		if (!float_equality<double>(cpool.get_transmission_rate(), exp_beta_carpool, 1e-5)){
+		if (!float_equality<double>(cpool.get_transmission_rate()*policy.carpools, exp_beta_carpool, 1e-5)){
 			std::cerr << "Wrong carpool transmission rate" << std::endl;
 			return false;
 		}
 	}
 	for (const auto& transit : public_transit) {
-		if (!float_equality<double>(transit.get_transmission_rate(), exp_beta_transit, 1e-5)){
+		if (!float_equality<double>(transit.get_transmission_rate()*policy.public_transit, exp_beta_transit, 1e-5)){
 			std::cerr << "Wrong transit transmission rate" << std::endl;
 			return false;
 		}
 	}
 	for (const auto& les: leisure) {
 		if (les.outside_town()){
-			if (!float_equality<double>(les.get_outside_lambda(), exp_beta_leisure_out, 1e-5)){
+			if (!float_equality<double>(les.get_outside_lambda()*policy.outside_leisure_locations, exp_beta_leisure_out, 1e-5)){
 				std::cerr << "Wrong leisure transmission rate in an outside leisure location "
-					<< les.get_outside_lambda() << " " << exp_beta_leisure_out << std::endl;
+					<< les.get_outside_lambda()*policy.outside_leisure_locations << " " << exp_beta_leisure_out << std::endl;
 				return false;
 			}
 		}else{
-			if (!float_equality<double>(les.get_transmission_rate(), exp_beta_leisure, 1e-5)){
+			if (!float_equality<double>(les.get_transmission_rate()*policy.leisure_locations, exp_beta_leisure, 1e-5)){
 				std::cerr << "Wrong public leisure location transmission rate " 
-						  << les.get_transmission_rate() << " " << exp_beta_leisure << std::endl;
+						  << les.get_transmission_rate()*policy.leisure_locations << " " << exp_beta_leisure << std::endl;
 				return false;
 			}
 		}
@@ -1200,6 +1209,275 @@ bool create_active_for_vac_reopen_test()
 	return true;
 }
 
+// Checks that a population image creates the same town and agents as the text files
+bool create_population_image_test()
+{
+	double dt = 0.25;
+	const uint64_t seed = 2023;
+	const std::string image("test_data/NR_population.bin");
+	// Input files in the order of PopulationImage::Table
+	const std::array<std::string, PopulationImage::n_tables> files = 
+		{{"test_data/NR_households.txt", "test_data/NR_retirement_homes.txt", 
+		  "test_data/NR_schools.txt", "test_data/NR_workplaces.txt", 
+		  "test_data/NR_hospitals.txt", "test_data/NR_carpool.txt", 
+		  "test_data/NR_public.txt", "test_data/NR_leisure.txt", "test_data/NR_agents.txt"}};
+
+	// File with infection parameters
+	std::string pfname("test_data/infection_parameters.txt");
+	// Files with age-dependent distributions
+	std::map<std::string, std::string> dfiles = 
+		{ {"exposed never symptomatic", "test_data/age_dist_exposed_never_sy.txt"}, 
+		  {"hospitalization", "test_data/age_dist_hospitalization.txt"}, 
+		  {"ICU", "test_data/age_dist_hosp_ICU.txt"}, {"mortality", "test_data/age_dist_mortality.txt"} };
+	std::string tfname("test_data/tests_with_time.txt");
+
+	// From text files
+	ABM abm_text(dt, pfname, dfiles, tfname);
+	abm_text.set_seed(seed);
+	abm_text.create_households(files.at(PopulationImage::households));
+	abm_text.create_schools(files.at(PopulationImage::schools));
+	abm_text.create_workplaces(files.at(PopulationImage::workplaces));
+	abm_text.create_hospitals(files.at(PopulationImage::hospitals));
+	abm_text.create_retirement_homes(files.at(PopulationImage::retirement_homes));
+	abm_text.create_carpools(files.at(PopulationImage::carpools));
+	abm_text.create_public_transit(files.at(PopulationImage::public_transit));
+	abm_text.create_leisure_locations(files.at(PopulationImage::leisure_locations));
+	abm_text.initialize_mobility();
+	abm_text.create_agents(files.at(PopulationImage::agents));
+
+	// From the image
+	PopulationImage::compile(files, image);
+	ABM abm_image(dt, pfname, dfiles, tfname);
+	abm_image.set_seed(seed);
+	abm_image.create_population(image);
+
+	// Same objects
+	const std::vector<std::string> outputs = {"households", "retirement_homes", "schools", 
+		"workplaces", "hospitals", "leisure", "carpools", "public", "agents", 
+		"agents_in_households", "agents_in_schools", "agents_in_workplaces"};
+	for (int i = 0; i < 2; ++i) {
+		const ABM& abm = (i == 0) ? abm_text : abm_image;
+		const std::string tag = "test_data/image_test_" + std::to_string(i) + "_";
+		abm.print_households(tag + "households.txt");
+		abm.print_retirement_home(tag + "retirement_homes.txt");
+		abm.print_schools(tag + "schools.txt");
+		abm.print_workplaces(tag + "workplaces.txt");
+		abm.print_hospitals(tag + "hospitals.txt");
+		abm.print_leisure_locations(tag + "leisure.txt");
+		abm.print_transit(tag + "carpools.txt", "carpool");
+		abm.print_transit(tag + "public.txt", "public");
+		abm.print_agents(tag + "agents.txt");
+		abm.print_agents_in_households(tag + "agents_in_households.txt");
+		abm.print_agents_in_schools(tag + "agents_in_schools.txt");
+		abm.print_agents_in_workplaces(tag + "agents_in_workplaces.txt");
+	}
+	for (const auto& out : outputs) {
+		const std::string text_out = "test_data/image_test_0_" + out + ".txt"; 
+		const std::string image_out = "test_data/image_test_1_" + out + ".txt"; 
+		if (!same_files(text_out, image_out)) {
+			std::cerr << "Different " << out << " created from text files and from an image" << std::endl;
+			return false;
+		}
+		std::remove(text_out.c_str());
+		std::remove(image_out.c_str());
+	}
+	if (abm_text.get_num_infected() != abm_image.get_num_infected()) {
+		std::cerr << "Different number of infected created from an image" << std::endl;
+		return false;
+	}
+
+	// Not an image
+	const std::runtime_error rte("");
+	const bool verbose = false;
+	ABM abm_wrong(dt, pfname, dfiles, tfname);
+	if (!exception_test(verbose, &rte, &ABM::create_population, abm_wrong, pfname, 0)) {
+		std::cerr << "Loading a file that is not a population image should throw" << std::endl;
+		return false;
+	}
+	std::remove(image.c_str());
+	return true;
+}
+
+// Checks the parameter fields against the loaded map and that missing parameters are detected 
+bool infection_parameters_test()
+{
+	double dt = 0.25;
+	std::string pfname("test_data/infection_parameters.txt");
+	std::map<std::string, std::string> dfiles = 
+		{ {"exposed never symptomatic", "test_data/age_dist_exposed_never_sy.txt"}, 
+		  {"hospitalization", "test_data/age_dist_hospitalization.txt"}, 
+		  {"ICU", "test_data/age_dist_hosp_ICU.txt"}, {"mortality", "test_data/age_dist_mortality.txt"} };
+	std::string tfname("test_data/tests_with_time.txt");
+
+	// Same values as in the map
+	ABM abm(dt, pfname, dfiles, tfname);
+	const std::map<std::string, double>& loaded = abm.get_infection_parameters();
+	const InfectionParameters& params = abm.get_infection_params();
+	for (const auto& field : InfectionParameters::fields()) {
+		if (!float_equality<double>(params.*field.second, loaded.at(field.first), 1e-15)) {
+			std::cerr << "Wrong value of parameter " << field.first << std::endl;
+			return false;
+		}
+	}
+
+	// File without one of the parameters
+	const std::string missing_name("test_data/infection_parameters_missing.txt");
+	LoadParameters ldparam;
+	std::map<std::string, double> incomplete = ldparam.load_parameter_map(pfname);
+	incomplete.erase("recovery time");
+	{
+		std::ofstream out(missing_name);
+		for (const auto& entry : incomplete) {
+			out << "// " << entry.first << "\n" << entry.second << "\n";
+		}
+	}
+	const std::invalid_argument inv_arg("");
+	const bool verbose = false;
+	if (!exception_test(verbose, &inv_arg, 
+				[&](){ ABM abm_missing(dt, missing_name, dfiles, tfname); })) {
+		std::cerr << "Missing infection parameter should be detected when loading" << std::endl;
+		return false;
+	}
+	std::remove(missing_name.c_str());
+
+	// Shipped template without the optional parameters
+	const std::string template_name("../../simulations/complete_var_reopening_study/"
+							"mid_testing/templates/input_data/infection_parameters.txt");
+	ABM abm_template(dt, template_name, dfiles, tfname);
+	const InfectionParameters& template_params = abm_template.get_infection_params();
+	if (!float_equality<double>(template_params.recovery_time, 
+					abm_template.get_infection_parameters().at("recovery time"), 1e-15)) {
+		std::cerr << "Wrong value of parameter recovery time in the template" << std::endl;
+		return false;
+	}
+	if (!std::isnan(template_params.fraction_estimated_infected)) {
+		std::cerr << "Optional parameter not in the template should not be set" << std::endl;
+		return false;
+	}
+	if (!exception_test(verbose, &inv_arg, 
+			[&](){ template_params.required(&InfectionParameters::fraction_estimated_infected); })) {
+		std::cerr << "Missing optional parameter should be detected when used" << std::endl;
+		return false;
+	}
+
+	// Optional parameters that are present
+	for (const auto& field : InfectionParameters::optional_fields()) {
+		if (!float_equality<double>(params.required(field.second), loaded.at(field.first), 1e-15)) {
+			std::cerr << "Wrong value of optional parameter " << field.first << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// Checks that generated towns are the same with any number
+// of threads and can be loaded by the model
+bool generated_population_test()
+{
+	double dt = 0.25;
+	std::string pfname("test_data/infection_parameters.txt");
+	std::map<std::string, std::string> dfiles = 
+		{ {"exposed never symptomatic", "test_data/age_dist_exposed_never_sy.txt"}, 
+		  {"hospitalization", "test_data/age_dist_hospitalization.txt"}, 
+		  {"ICU", "test_data/age_dist_hosp_ICU.txt"}, {"mortality", "test_data/age_dist_mortality.txt"} };
+	std::string tfname("test_data/tests_with_time.txt");
+
+	// Households of at most two members in a small town
+	const std::string gen_name("test_data/generator_parameters.txt");
+	{
+		std::ofstream out(gen_name);
+		out << "// seed\n2024\n// side\n0.02\n// household sizes\n0.5 0.5\n" 
+			<< "// fraction infected\n0.1\n";
+	}
+	PopulationGenerator::Parameters par = PopulationGenerator::load_parameters(gen_name);
+	par.n_agents = 20000;
+	const std::vector<std::string> tables = {"households", "schools", "workplaces", "hospitals", 
+		"retirement_homes", "carpool", "public", "leisure", "agents"};
+	PopulationGenerator gen_1(par);
+	gen_1.generate("test_data/generated_1", 1);
+	PopulationGenerator gen_3(par);
+	gen_3.generate("test_data/generated_3", 3);
+	for (const auto& table : tables) {
+		if (!same_files("test_data/generated_1_" + table + ".txt", "test_data/generated_3_" + table + ".txt")) {
+			std::cerr << "Different " << table << " generated with one and three threads" << std::endl;
+			return false;
+		}
+	}
+
+	// Loaded by the model
+	const std::string town("test_data/generated_1_");
+	ABM abm(dt, pfname, dfiles, tfname);
+	abm.create_households(town + "households.txt");
+	abm.create_schools(town + "schools.txt");
+	abm.create_workplaces(town + "workplaces.txt");
+	abm.create_hospitals(town + "hospitals.txt");
+	abm.create_retirement_homes(town + "retirement_homes.txt");
+	abm.create_carpools(town + "carpool.txt");
+	abm.create_public_transit(town + "public.txt");
+	abm.create_leisure_locations(town + "leisure.txt");
+	abm.initialize_mobility();
+	abm.create_agents(town + "agents.txt");
+
+	const std::vector<Household>& households = abm.get_vector_of_households();
+	const std::vector<School>& schools = abm.get_vector_of_schools();
+	const std::vector<Agent>& agents = abm.get_vector_of_agents();
+	if (agents.size() != gen_1.number_of_agents() || households.size() != gen_1.number_of_households() 
+			|| schools.size() != gen_1.number_of_schools()
+			|| abm.get_vector_of_workplaces().size() != gen_1.number_of_workplaces()) {
+		std::cerr << "Wrong number of generated agents or places" << std::endl;
+		return false;
+	}
+	for (const auto& house : households) {
+		const size_t n_members = house.get_agent_IDs().size();
+		if (n_members < 1 || n_members > 2) {
+			std::cerr << "Household with " << n_members << " members" << std::endl;
+			return false;
+		}
+		// Coordinates are written with six decimals
+		if (std::fabs(house.get_x() - par.center_x) > 0.010001 
+				|| std::fabs(house.get_y() - par.center_y) > 0.010001) {
+			std::cerr << "Household outside of the town" << std::endl;
+			return false;
+		}
+	}
+	int n_infected = 0;
+	for (const auto& agent : agents) {
+		if (!agent.hospital_non_covid_patient() && !agent.retirement_home_resident()
+				&& !find_in_place(households, agent.get_ID(), agent.get_household_ID())) {
+			std::cerr << "Agent not registered in a household" << std::endl;
+			return false;
+		}
+		if (agent.student() && !find_in_place(schools, agent.get_ID(), agent.get_school_ID())) {
+			std::cerr << "Student not registered in a school" << std::endl;
+			return false;
+		}
+		n_infected += agent.infected();
+	}
+	if (!check_fractions(n_infected, agents.size(), 0.1, "Fraction of infected agents")) {
+		return false;
+	}
+
+	// Properties that do not exist
+	{
+		std::ofstream out(gen_name);
+		out << "// household size\n3\n";
+	}
+	const std::invalid_argument inv_arg("");
+	const bool verbose = false;
+	if (!exception_test(verbose, &inv_arg, 
+				[&](){ PopulationGenerator::load_parameters(gen_name); })) {
+		std::cerr << "Unknown town property should be detected" << std::endl;
+		return false;
+	}
+
+	std::remove(gen_name.c_str());
+	for (const auto& table : tables) {
+		std::remove(("test_data/generated_1_" + table + ".txt").c_str());
+		std::remove(("test_data/generated_3_" + table + ".txt").c_str());
+	}
+	return true;
+}
+
 // Test suite for agents that are infected at intialization
 bool check_initially_infected(const Agent& agent, const Flu& flu, int& n_exposed_never_sy,
 								const std::map<std::string, double> infection_parameters)
@@ -1680,3 +1958,13 @@ bool compare_workplaces_files(std::string fname_in, std::string fname_out,
 	}
 	return true;	
 }
+
+// True if two files have the same contents
+bool same_files(const std::string& fname_1, const std::string& fname_2)
+{
+	std::ifstream in_1(fname_1), in_2(fname_2);
+	std::stringstream contents_1, contents_2;
+	contents_1 << in_1.rdbuf();
+	contents_2 << in_2.rdbuf();
+	return in_1.is_open() && in_2.is_open() && contents_1.str() == contents_2.str();
+}
@@ -10,24 +10,55 @@
 bool abm_contributions_test();
 bool abm_leisure_dist_test();
 bool abm_events_test();
+bool abm_policy_schedule();
 bool abm_time_dependent_testing();
 bool abm_vaccination();
 bool abm_vac_reopening();
 bool abm_vac_reopening_seeded();
+bool abm_vac_reopening_seeded_parallel();
+bool check_vac_reopening_seeded(const int n_threads);
+bool abm_seeded_reproducibility();
+bool abm_place_driven_susceptibles();
+bool abm_checkpoint();
+bool abm_transition_calendar();
+bool abm_ensemble();
+bool abm_region();
+bool abm_domain_split();
+bool abm_step_profiler();
+bool abm_async_output();
 
 // Supporting functions
 bool abm_vaccination_random();
 bool abm_vaccination_group();
 ABM create_abm(const double dt, int i0);
+ABM create_vac_reopening_abm(const double dt, const int inf0, const int N_active, const uint64_t seed = 0);
+bool same_seeded_runs(const ABM&, const ABM&);
+void collect_contributions(const ABM&, std::vector<double>&);
+void collect_numbers_of_agents(const ABM&, std::vector<double>&);
+void collect_place_ranks(const ABM&, std::vector<int>&);
+bool only_agents_of_rank(const ABM&, const int);
+template <typename T>
+bool only_agents_of_rank(const ABM&, const std::vector<T>&, const int);
 
 int main()
 {
 	test_pass(abm_leisure_dist_test(), "Assigning leisure locations");
 	test_pass(abm_events_test(), "Testing and lockdown events");
+	test_pass(abm_policy_schedule(), "Closures and reopenings from a schedule file");
 	test_pass(abm_time_dependent_testing(), "Time dependent testing");
 	test_pass(abm_vaccination(), "Vaccination");
 	test_pass(abm_vac_reopening(), "Reopening and vaccination studies");
 	test_pass(abm_vac_reopening_seeded(), "Initializing with active COVID-19 cases");
+	test_pass(abm_vac_reopening_seeded_parallel(), "Active COVID-19 cases with multithreaded transitions");
+	test_pass(abm_seeded_reproducibility(), "Reproducibility of seeded runs");
+	test_pass(abm_place_driven_susceptibles(), "Evaluating only susceptible agents in places with infected");
+	test_pass(abm_checkpoint(), "Continuing a run from a checkpoint");
+	test_pass(abm_transition_calendar(), "Infected agents evaluated at steps with due timers");
+	test_pass(abm_ensemble(), "Multithreaded ensemble of realizations");
+	test_pass(abm_region(), "Towns coupled through commuter flows");
+	test_pass(abm_domain_split(), "Model split between local processes");
+	test_pass(abm_step_profiler(), "Time and work counters of each phase of a step");
+	test_pass(abm_async_output(), "Writing agent information in a separate thread");
 }
 
 bool abm_leisure_dist_test()
@@ -210,7 +241,9 @@ bool abm_events_test()
 	abm.create_agents(fin);
 
 	// Contains event times and properties
-	std::map<std::string, double>& infection_parameters = abm.get_infection_parameters(); 
+	const std::map<std::string, double>& infection_parameters = abm.get_infection_parameters(); 
+	// Closures and reopenings scale contributions of each place type
+	const PlacePolicy& policy = abm.get_place_policy();
 	double tol = 1e-3;
 	double time = 0.0;
 	const double leisure_fraction =  infection_parameters.at("leisure - fraction");
@@ -225,11 +258,11 @@ bool abm_events_test()
 		if (float_equality<double>(time, infection_parameters.at("school closure"), tol)){
 			const std::vector<School>& schools =  abm.get_vector_of_schools();
 			for (const auto& school : schools){
-				if (!float_equality<double>(school.get_transmission_rate(), 0.0, tol)){
+				if (!float_equality<double>(school.get_transmission_rate()*policy.schools, 0.0, tol)){
 					std::cerr << "Error in school closure - student transmission rate not 0.0" << std::endl; 
 					return false;	
 				}
-				if (!float_equality<double>(school.get_employee_transmission_rate(), 0.0, tol)){
+				if (!float_equality<double>(school.get_employee_transmission_rate()*policy.schools, 0.0, tol)){
 					std::cerr << "Error in school closure - employee transmission rate not 0.0" << std::endl; 
 					return false;	
 				}
@@ -249,7 +282,7 @@ bool abm_events_test()
 						std::cerr << "Error in lockdown - wrong workplace absenteeism correction" << std::endl; 
 						return false;	
 					}
-					if (!float_equality<double>(workplace.get_transmission_rate(), new_tr_rate, tol)){
+					if (!float_equality<double>(workplace.get_transmission_rate()*policy.workplaces, new_tr_rate, tol)){
 						std::cerr << "Error in lockdown - wrong workplace transmission rate" << std::endl; 
 						return false;	
 					}
@@ -268,12 +301,12 @@ bool abm_events_test()
 			double new_l_frac = leisure_fraction * infection_parameters.at("fraction of ld businesses"); 
 			for (const auto& lloc : leisure_locations) {
 				if (!lloc.outside_town()){
-					if (!float_equality<double>(lloc.get_transmission_rate(), new_tr_rate, tol)){
+					if (!float_equality<double>(lloc.get_transmission_rate()*policy.leisure_locations, new_tr_rate, tol)){
 						std::cerr << "Error in lockdown - wrong leisure location transmission rate" << std::endl; 
 						return false;	
 					}
 				}else{
-					if (!float_equality<double>(lloc.get_outside_lambda(), new_tr_rate_outside, tol)){
+					if (!float_equality<double>(lloc.get_outside_lambda()*policy.outside_leisure_locations, new_tr_rate_outside, tol)){
 						std::cerr << "Error in lockdown - wrong out of town leisure transmission rate" << std::endl; 
 						return false;	
 					}
@@ -288,7 +321,7 @@ bool abm_events_test()
 			new_tr_rate = infection_parameters.at("carpool transmission rate")
 							*infection_parameters.at("fraction of ld businesses");
 			for (const auto& cpl : carpools) {
-				if (!float_equality<double>(cpl.get_transmission_rate(), new_tr_rate, tol)){
+				if (!float_equality<double>(cpl.get_transmission_rate()*policy.carpools, new_tr_rate, tol)){
 					std::cerr << "Error in lockdown - wrong carpool transmission rate" << std::endl; 
 					return false;	
 				}
@@ -299,7 +332,7 @@ bool abm_events_test()
 						*infection_parameters.at("public transit current capacity")*infection_parameters.at("fraction of ld businesses");
 			const std::vector<Transit>& public_transit = abm.get_vector_of_public_transit();
 			for (auto& pt  : public_transit) {
-				if (!float_equality<double>(pt.get_transmission_rate(), new_tr_rate, tol)){
+				if (!float_equality<double>(pt.get_transmission_rate()*policy.public_transit, new_tr_rate, tol)){
 					std::cerr << "Error in lockdown - wrong public transit transmission rate" << std::endl; 
 					return false;	
 				}
@@ -319,7 +352,7 @@ bool abm_events_test()
 						std::cerr << "Error in reopening phase 1 - wrong workplace absenteeism correction" << std::endl; 
 						return false;	
 					}
-					if (!float_equality<double>(workplace.get_transmission_rate(), new_tr_rate, tol)){
+					if (!float_equality<double>(workplace.get_transmission_rate()*policy.workplaces, new_tr_rate, tol)){
 						std::cerr << "Error in reopening phase 1 - wrong workplace transmission rate" << std::endl; 
 						return false;	
 					}
@@ -338,12 +371,12 @@ bool abm_events_test()
 									infection_parameters.at("fraction of phase 1 businesses");						
 			for (const auto& lloc : leisure_locations) {
 				if (!lloc.outside_town()){
-					if (!float_equality<double>(lloc.get_transmission_rate(), new_tr_rate, tol)){
+					if (!float_equality<double>(lloc.get_transmission_rate()*policy.leisure_locations, new_tr_rate, tol)){
 						std::cerr << "Error in reopening phase 1 - wrong leisure location transmission rate" << std::endl; 
 						return false;	
 					}
 				}else{
-					if (!float_equality<double>(lloc.get_outside_lambda(), new_tr_rate_outside, tol)){
+					if (!float_equality<double>(lloc.get_outside_lambda()*policy.outside_leisure_locations, new_tr_rate_outside, tol)){
 						std::cerr << "Error in reopening phase 1 - wrong out of town leisure location transmission rate" << std::endl; 
 						return false;	
 					}
@@ -359,7 +392,7 @@ bool abm_events_test()
 			new_tr_rate = infection_parameters.at("carpool transmission rate")
 							*infection_parameters.at("fraction of phase 1 businesses");
 			for (const auto& cpl : carpools) {
-				if (!float_equality<double>(cpl.get_transmission_rate(), new_tr_rate, tol)){
+				if (!float_equality<double>(cpl.get_transmission_rate()*policy.carpools, new_tr_rate, tol)){
 					std::cerr << "Error in reopening phase 1 - wrong carpool transmission rate" << std::endl; 
 					return false;	
 				}
@@ -370,7 +403,7 @@ bool abm_events_test()
 					*infection_parameters.at("public transit current capacity")*infection_parameters.at("fraction of phase 1 businesses");
 			const std::vector<Transit>& public_transit = abm.get_vector_of_public_transit();
 			for (auto& pt  : public_transit) {
-				if (!float_equality<double>(pt.get_transmission_rate(), new_tr_rate, tol)){
+				if (!float_equality<double>(pt.get_transmission_rate()*policy.public_transit, new_tr_rate, tol)){
 					std::cerr << "Error in reopening phase 1 - wrong public transit transmission rate" << std::endl; 
 					return false;	
 				}
@@ -390,7 +423,7 @@ bool abm_events_test()
 						std::cerr << "Error in reopening phase 2 - wrong workplace absenteeism correction" << std::endl; 
 						return false;	
 					}
-					if (!float_equality<double>(workplace.get_transmission_rate(), new_tr_rate, tol)){
+					if (!float_equality<double>(workplace.get_transmission_rate()*policy.workplaces, new_tr_rate, tol)){
 						std::cerr << "Error in reopening phase 2 - wrong workplace transmission rate" << std::endl; 
 						return false;	
 					}
@@ -409,12 +442,12 @@ bool abm_events_test()
 									infection_parameters.at("fraction of phase 2 businesses");
 			for (const auto& lloc : leisure_locations) {
 				if (!lloc.outside_town()){
-					if (!float_equality<double>(lloc.get_transmission_rate(), new_tr_rate, tol)){
+					if (!float_equality<double>(lloc.get_transmission_rate()*policy.leisure_locations, new_tr_rate, tol)){
 						std::cerr << "Error in reopening phase 2 - wrong leisure location transmission rate" << std::endl; 
 						return false;	
 					}
 				}else{
-					if (!float_equality<double>(lloc.get_outside_lambda(), new_tr_rate_outside, tol)){
+					if (!float_equality<double>(lloc.get_outside_lambda()*policy.outside_leisure_locations, new_tr_rate_outside, tol)){
 						std::cerr << "Error in reopening phase 2 - wrong out of town leisure location transmission rate" << std::endl; 
 						return false;	
 					}
@@ -430,7 +463,7 @@ bool abm_events_test()
 			new_tr_rate = infection_parameters.at("carpool transmission rate")
 							*infection_parameters.at("fraction of phase 2 businesses");
 			for (const auto& cpl : carpools) {
-				if (!float_equality<double>(cpl.get_transmission_rate(), new_tr_rate, tol)){
+				if (!float_equality<double>(cpl.get_transmission_rate()*policy.carpools, new_tr_rate, tol)){
 					std::cerr << "Error in reopening phase 2 - wrong carpool transmission rate" << std::endl; 
 					return false;	
 				}
@@ -441,7 +474,7 @@ bool abm_events_test()
 					*infection_parameters.at("public transit current capacity")*infection_parameters.at("fraction of phase 2 businesses");
 			const std::vector<Transit>& public_transit = abm.get_vector_of_public_transit();
 			for (auto& pt  : public_transit) {
-				if (!float_equality<double>(pt.get_transmission_rate(), new_tr_rate, tol)){
+				if (!float_equality<double>(pt.get_transmission_rate()*policy.public_transit, new_tr_rate, tol)){
 					std::cerr << "Error in reopening phase 2 - wrong public transit transmission rate" << std::endl; 
 					return false;	
 				}
@@ -461,7 +494,7 @@ bool abm_events_test()
 						std::cerr << "Error in reopening phase 3 - wrong workplace absenteeism correction" << std::endl; 
 						return false;	
 					}
-					if (!float_equality<double>(workplace.get_transmission_rate(), new_tr_rate, tol)){
+					if (!float_equality<double>(workplace.get_transmission_rate()*policy.workplaces, new_tr_rate, tol)){
 						std::cerr << "Error in reopening phase 3 - wrong workplace transmission rate" << std::endl; 
 						return false;	
 					}
@@ -480,12 +513,12 @@ bool abm_events_test()
 									infection_parameters.at("fraction of phase 3 businesses");
 			for (const auto& lloc : leisure_locations) {
 				if (!lloc.outside_town()){
-					if (!float_equality<double>(lloc.get_transmission_rate(), new_tr_rate, tol)){
+					if (!float_equality<double>(lloc.get_transmission_rate()*policy.leisure_locations, new_tr_rate, tol)){
 						std::cerr << "Error in reopening phase 3 - wrong leisure location transmission rate" << std::endl; 
 						return false;	
 					}
 				}else{
-					if (!float_equality<double>(lloc.get_outside_lambda(), new_tr_rate_outside, tol)){
+					if (!float_equality<double>(lloc.get_outside_lambda()*policy.outside_leisure_locations, new_tr_rate_outside, tol)){
 						std::cerr << "Error in reopening phase 3 - wrong out of town leisure location transmission rate" << std::endl; 
 						return false;	
 					}
@@ -501,7 +534,7 @@ bool abm_events_test()
 			new_tr_rate = infection_parameters.at("carpool transmission rate")
 							*infection_parameters.at("fraction of phase 3 businesses");
 			for (const auto& cpl : carpools) {
-				if (!float_equality<double>(cpl.get_transmission_rate(), new_tr_rate, tol)){
+				if (!float_equality<double>(cpl.get_transmission_rate()*policy.carpools, new_tr_rate, tol)){
 					std::cerr << "Error in reopening phase 3 - wrong carpool transmission rate" << std::endl; 
 					return false;	
 				}
@@ -512,7 +545,7 @@ bool abm_events_test()
 					*infection_parameters.at("public transit current capacity")*infection_parameters.at("fraction of phase 3 businesses");
 			const std::vector<Transit>& public_transit = abm.get_vector_of_public_transit();
 			for (auto& pt  : public_transit) {
-				if (!float_equality<double>(pt.get_transmission_rate(), new_tr_rate, tol)){
+				if (!float_equality<double>(pt.get_transmission_rate()*policy.public_transit, new_tr_rate, tol)){
 					std::cerr << "Error in reopening phase 3 - wrong public transit transmission rate" << std::endl; 
 					return false;	
 				}
@@ -523,6 +556,75 @@ bool abm_events_test()
 	return true;
 }
 
+// Closures and reopenings loaded from a file replace the default phases
+bool abm_policy_schedule()
+{
+	const double dt = 0.25, tol = 1e-5;
+	const int tmax = 120, inf0 = 1;
+
+	ABM abm = create_abm(dt, inf0);
+	abm.load_policy_schedule("test_data/policy_schedule.txt");
+
+	const PlacePolicy& policy = abm.get_place_policy();
+	const std::map<std::string, double>& infection_parameters = abm.get_infection_parameters(); 
+	const double leisure_fraction = infection_parameters.at("leisure - fraction");
+	// Only the capacity-dependent part of the transit rate changes
+	const double pt_beta0 = infection_parameters.at("public transit beta0");
+	const double pt_beta_full = infection_parameters.at("public transit beta full")
+									*infection_parameters.at("public transit current capacity");
+	const double pt_ratio = (pt_beta0 + pt_beta_full*0.6)/(pt_beta0 + pt_beta_full);
+
+	for (int ti = 0; ti<=tmax; ++ti) {
+		const double time = abm.get_time();
+		abm.transmit_infection();
+
+		// Expected from the file
+		const double schools = time >= 18.0 ? 0.5 : (time >= 10.0 ? 0.0 : 1.0);
+		const double businesses = time >= 18.0 ? 0.6 : (time >= 12.0 ? 0.2 : 1.0);
+		const double transit = time >= 18.0 ? pt_ratio : (time >= 12.0 ? 0.5 : 1.0);
+		const double outside_leisure = time >= 18.0 ? 0.6 : (time >= 15.0 ? 0.8 : businesses);
+		
+		if (!float_equality<double>(policy.schools, schools, tol)) {
+			std::cerr << "Wrong school multiplier at time " << time << std::endl;
+			return false;
+		}
+		if (!float_equality<double>(policy.workplaces, businesses, tol) 
+				|| !float_equality<double>(policy.outside_workplaces, businesses, tol)
+				|| !float_equality<double>(policy.leisure_locations, businesses, tol)
+				|| !float_equality<double>(policy.carpools, businesses, tol)) {
+			std::cerr << "Wrong business multipliers at time " << time << std::endl;
+			return false;
+		}
+		if (!float_equality<double>(policy.outside_leisure_locations, outside_leisure, tol)) {
+			std::cerr << "Wrong out of town leisure multiplier at time " << time << std::endl;
+			return false;
+		}
+		if (!float_equality<double>(policy.public_transit, transit, tol)) {
+			std::cerr << "Wrong public transit multiplier at time " << time << std::endl;
+			return false;
+		}
+		if (!float_equality<double>(infection_parameters.at("leisure - fraction"), 
+										leisure_fraction*businesses, tol)) {
+			std::cerr << "Wrong leisure fraction at time " << time << std::endl;
+			return false;
+		}
+	}
+	if (abm.get_policy_schedule().number_applied() != 6) {
+		std::cerr << "Not all scheduled events were applied" << std::endl;
+		return false;
+	}
+
+	// Unsupported targets 
+	const std::invalid_argument inv_arg("");
+	const bool verbose = false;
+	if (!exception_test(verbose, &inv_arg, &ABM::load_policy_schedule, abm, 
+							std::string("test_data/policy_schedule_wrong.txt"))) {
+		std::cerr << "Unsupported policy target should throw" << std::endl;
+		return false;
+	}
+	return true;
+}
+
 bool abm_time_dependent_testing()
 {
 	// Agents 
@@ -1078,19 +1180,20 @@ bool abm_vac_reopening()
 		exp_beta_leisure_out = exp_beta*infection_parameters.at("fraction estimated infected");
 		exp_frac = frac_ini + les_rate*del_frac*abm.get_time();
 
-		// Check rate at each public leisure location
+		// Check rate at each public leisure location, scaled by the reopening
 		const std::vector<Leisure>& leisure = abm.get_vector_of_leisure_locations();
+		const PlacePolicy& policy = abm.get_place_policy();
 		for (const auto& les: leisure) {
 			if (les.outside_town()){
-				if (!float_equality<double>(les.get_outside_lambda(), exp_beta_leisure_out, 1e-3)){
+				if (!float_equality<double>(les.get_outside_lambda()*policy.outside_leisure_locations, exp_beta_leisure_out, 1e-3)){
 					std::cerr << "Wrong leisure transmission rate in an outside leisure location "
-						<< " "<< exp_beta << " " << les.get_outside_lambda() << " " << exp_beta_leisure_out << std::endl;
+						<< " "<< exp_beta << " " << les.get_outside_lambda()*policy.outside_leisure_locations << " " << exp_beta_leisure_out << std::endl;
 					return false;
 				}
 			}else{
-				if (!float_equality<double>(les.get_transmission_rate(), exp_beta, 1e-3)){
+				if (!float_equality<double>(les.get_transmission_rate()*policy.leisure_locations, exp_beta, 1e-3)){
 					std::cerr << "Wrong public leisure location transmission rate " 
-							  << les.get_transmission_rate() << " " << exp_beta << std::endl;
+							  << les.get_transmission_rate()*policy.leisure_locations << " " << exp_beta << std::endl;
 					return false;
 				}
 			}
@@ -1115,52 +1218,26 @@ bool abm_vac_reopening()
 // Vaccination and reopening with initial COVID-19 cases 
 bool abm_vac_reopening_seeded()
 {
-	double dt = 0.25;
-	int tmax = 5, inf0 = 1, N_active = 10000;
-
-	// Input files
-	std::string fin("test_data/NR_agents.txt");
-	std::string hfile("test_data/NR_households.txt");
-	std::string sfile("test_data/NR_schools.txt");
-	std::string wfile("test_data/NR_workplaces.txt");
-	std::string hsp_file("test_data/NR_hospitals.txt");
-	std::string rh_file("test_data/NR_retirement_homes.txt");
-	std::string cp_file("test_data/NR_carpool.txt");
-	std::string pt_file("test_data/NR_public.txt");
-	std::string ls_file("test_data/NR_leisure.txt");
+	return check_vac_reopening_seeded(0);
+}
 
-	// File with infection parameters
-	std::string pfname("test_data/vac_reopen_infection_parameters.txt");
-	// Files with age-dependent distributions
-	std::string dexp_name("test_data/age_dist_exposed_never_sy.txt");
-	std::string dh_name("test_data/age_dist_hospitalization.txt");
-	std::string dhicu_name("test_data/age_dist_hosp_ICU.txt");
-	std::string dmort_name("test_data/age_dist_mortality.txt");
-	// Map for abm loading of distributions
-	std::map<std::string, std::string> dfiles = 
-		{ {"exposed never symptomatic", dexp_name}, {"hospitalization", dh_name}, 
-		  {"ICU", dhicu_name}, {"mortality", dmort_name} };
-	// File with 	
-	std::string tfname("test_data/vac_reopen_tests_with_time.txt");
+// Vaccination and reopening with initial COVID-19 cases, 
+// contributions and transitions computed by multiple threads 
+bool abm_vac_reopening_seeded_parallel()
+{
+	return check_vac_reopening_seeded(4);
+}
 
-	ABM abm(dt, pfname, dfiles, tfname);
+// Common part of vaccination and reopening tests with initial COVID-19 cases 
+bool check_vac_reopening_seeded(const int n_threads)
+{
+	double dt = 0.25;
+	int tmax = 5, inf0 = 1, N_active = 10000;
 
-	// The places
-	abm.create_households(hfile);
-	abm.create_schools(sfile);
-	abm.create_workplaces(wfile);
-	abm.create_hospitals(hsp_file);
-	abm.create_retirement_homes(rh_file);
-	abm.create_carpools(cp_file);
-	abm.create_public_transit(pt_file);
-	abm.create_leisure_locations(ls_file);
-	abm.initialize_mobility();
-	// The agents
-	abm.create_agents(fin, inf0);
-	// Initialization for vaccination/reopening studies
-	abm.initialize_vac_and_reopening();
-	// Create a COVID-19 population
-	abm.initialize_active_cases(N_active);
+	ABM abm = create_vac_reopening_abm(dt, inf0, N_active);
+	// Threads 
+	abm.set_parallel_contributions(n_threads);
+	abm.set_parallel_transitions(n_threads);
 
 	std::vector<Agent>& agents = abm.get_vector_of_agents_non_const();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters();
@@ -1179,12 +1256,31 @@ bool abm_vac_reopening_seeded()
 				{"Symptomatic ICU", 0}};
 
 	for (int ti = 0; ti<=tmax; ++ti) {
-		
+
+		const int n_inf_0 = abm.get_total_infected(); 
+		const int n_tested_0 = abm.get_total_tested();
+
 		abm.transmit_ideal_testing_vac_reopening();
+
+		// Totals need to change by this step's counts
+		if ((abm.get_total_infected() - n_inf_0 != abm.get_infected_day().back()) 
+				|| (abm.get_total_tested() - n_tested_0 != abm.get_tested_day().back())) {
+			std::cerr << "Daily counts inconsistent with totals" << std::endl;
+			return false;
+		}
 	
 		// Check relevant agent properties 
+		const std::vector<Hospital>& hospitals = abm.get_vector_of_hospitals();
 		for (const auto& agent : agents) { 
 			const int aID = agent.get_ID();
+			// Hospitalized agents need to be registered in the hospital
+			if (agent.hospitalized() || agent.hospitalized_ICU()) {
+				const std::vector<int> hsp_IDs = hospitals.at(agent.get_hospital_ID()-1).get_agent_IDs();
+				if (std::find(hsp_IDs.begin(), hsp_IDs.end(), aID) == hsp_IDs.end()) {
+					std::cerr << "Hospitalized agent not registered in the hospital" << std::endl;
+					return false;
+				}
+			}
 			if (agent.infected()) {
 				// Count each state, check basic logic
 				if (agent.exposed()) {
@@ -1256,6 +1352,672 @@ bool abm_vac_reopening_seeded()
 	return true;
 }
 
+// Runs with the same seed need to be identical 
+// regardless of the number of threads
+bool abm_seeded_reproducibility()
+{
+	const double dt = 0.25;
+	const int tmax = 5, inf0 = 1, N_active = 10000;
+	const uint64_t seed = 2021;
+
+	ABM abm_1 = create_vac_reopening_abm(dt, inf0, N_active, seed);
+	abm_1.set_parallel_transitions(1);
+	ABM abm_3 = create_vac_reopening_abm(dt, inf0, N_active, seed);
+	abm_3.set_parallel_contributions(3);
+	abm_3.set_parallel_transitions(3);
+
+	for (int ti = 0; ti<=tmax; ++ti) {
+		abm_1.transmit_ideal_testing_vac_reopening();
+		abm_3.transmit_ideal_testing_vac_reopening();
+	}
+
+	return same_seeded_runs(abm_1, abm_3);
+}
+
+// Results are the same when susceptible agents with zero 
+// probability of infection are skipped
+bool abm_place_driven_susceptibles()
+{
+	const double dt = 0.25;
+	const int tmax = 5, inf0 = 1, N_active = 10000;
+	const uint64_t seed = 2022;
+
+	ABM abm_all = create_vac_reopening_abm(dt, inf0, N_active, seed);
+	abm_all.set_parallel_transitions(2);
+	ABM abm_hot = create_vac_reopening_abm(dt, inf0, N_active, seed);
+	abm_hot.set_parallel_transitions(2);
+	abm_hot.set_place_driven_susceptibles(true);
+
+	for (int ti = 0; ti<=tmax; ++ti) {
+		abm_all.transmit_ideal_testing_vac_reopening();
+		abm_hot.transmit_ideal_testing_vac_reopening();
+	}
+	return same_seeded_runs(abm_all, abm_hot);
+}
+
+// Run continued from a checkpoint is identical to the original
+bool abm_checkpoint()
+{
+	const double dt = 0.25;
+	const int tmax = 5, inf0 = 1, N_active = 10000;
+	const uint64_t seed = 2023;
+	const std::string fname("test_data/checkpoint_test.bin");
+
+	// Serial, single random number stream
+	ABM abm = create_vac_reopening_abm(dt, inf0, N_active, seed);
+	for (int ti = 0; ti<=tmax; ++ti) {
+		abm.transmit_ideal_testing_vac_reopening();
+	}
+	abm.save_checkpoint(fname);
+
+	ABM restored;
+	restored.load_checkpoint(fname);
+	if (!float_equality<double>(abm.get_time(), restored.get_time(), 1e-10)) {
+		std::cerr << "Wrong time after loading a checkpoint" << std::endl;
+		return false;
+	}
+	for (int ti = 0; ti<=tmax; ++ti) {
+		abm.transmit_ideal_testing_vac_reopening();
+		restored.transmit_ideal_testing_vac_reopening();
+	}
+	if (!same_seeded_runs(abm, restored)) {
+		return false;
+	}
+
+	// Same agents in places
+	const std::vector<Household>& houses = abm.get_vector_of_households();
+	const std::vector<Household>& restored_houses = restored.get_vector_of_households();
+	for (size_t i = 0; i < houses.size(); ++i) {
+		if (houses.at(i).get_agent_IDs() != restored_houses.at(i).get_agent_IDs()) {
+			std::cerr << "Household " << i+1 << " differs after loading a checkpoint" << std::endl;
+			return false;
+		}
+	}
+
+	// Not a checkpoint
+	const std::runtime_error rte("");
+	const bool verbose = false;
+	void (ABM::*load_file)(const std::string&) = &ABM::load_checkpoint;
+	if (!exception_test(verbose, &rte, load_file, restored, 
+				std::string("test_data/infection_parameters.txt"))) {
+		std::cerr << "Loading a file that is not a checkpoint should throw" << std::endl;
+		return false;
+	}
+	std::remove(fname.c_str());
+	return true;
+}
+
+// Same results when every infected agent is scheduled again 
+// at each step instead of only the changed ones
+bool abm_transition_calendar()
+{
+	const double dt = 0.25;
+	const int tmax = 40, inf0 = 1, N_active = 10000;
+	const uint64_t seed = 2024;
+
+	ABM abm_due = create_vac_reopening_abm(dt, inf0, N_active, seed);
+	ABM abm_all = create_vac_reopening_abm(dt, inf0, N_active, seed);
+	for (int ti = 0; ti<=tmax; ++ti) {
+		// Setting a treatment timer marks the agent as changed
+		for (auto& agent : abm_all.get_vector_of_agents_non_const()) {
+			agent.set_time_ih_to_hsp(agent.get_time_ih_to_hsp());
+		}
+		abm_due.transmit_ideal_testing_vac_reopening();
+		abm_all.transmit_ideal_testing_vac_reopening();
+	}
+	if (abm_due.get_total_recovered() == 0) {
+		std::cerr << "No recovered agents, timers not tested" << std::endl;
+		return false;
+	}
+	return same_seeded_runs(abm_due, abm_all);
+}
+
+bool abm_ensemble()
+{
+	const double dt = 0.25;
+	const int tmax = 5, inf0 = 1, N_active = 10000;
+	const std::vector<uint64_t> seeds = {11, 12, 13};
+	const std::string fname("test_data/ensemble_infected.txt");
+
+	ABM abm = create_vac_reopening_abm(dt, inf0, N_active, 2023);
+	Ensemble ensemble(abm);
+	const std::vector<Ensemble::Series> serial = ensemble.run(seeds, tmax);
+	ensemble.set_number_of_threads(3);
+	const std::vector<Ensemble::Series> threaded = ensemble.run(seeds, tmax);
+
+	// Realizations are independent of the number of threads
+	if (serial.size() != seeds.size() || threaded.size() != seeds.size()) {
+		std::cerr << "Wrong number of realizations in an ensemble" << std::endl;
+		return false;
+	}
+	for (size_t i = 0; i < seeds.size(); ++i) {
+		const Ensemble::Series& s1 = serial.at(i);
+		const Ensemble::Series& s3 = threaded.at(i);
+		if (s1.infected.size() != static_cast<size_t>(tmax + 1)) {
+			std::cerr << "Wrong length of ensemble series" << std::endl;
+			return false;
+		}
+		if (s1.infected != s3.infected || s1.total_infected != s3.total_infected
+				|| s1.total_dead != s3.total_dead || s1.total_recovered != s3.total_recovered
+				|| s1.total_tested != s3.total_tested) {
+			std::cerr << "Realization " << i << " differs between serial and multithreaded ensembles" << std::endl;
+			return false;
+		}
+	}
+
+	// Same as a seeded run of a copy, original model is not changed
+	ABM copy;
+	ensemble.restore(copy);
+	copy.set_seed(seeds.at(1));
+	if (copy.get_num_infected() != abm.get_num_infected() 
+			|| !float_equality<double>(copy.get_time(), abm.get_time(), 1e-10)) {
+		std::cerr << "Copy in an ensemble differs from the original model" << std::endl;
+		return false;
+	}
+	for (int ti = 0; ti<=tmax; ++ti) {
+		if (copy.get_num_infected() != serial.at(1).infected.at(ti) 
+				|| copy.get_total_tested() != serial.at(1).total_tested.at(ti)) {
+			std::cerr << "Ensemble realization differs from a single run at step " << ti << std::endl;
+			return false;
+		}
+		copy.transmit_ideal_testing_vac_reopening();
+	}
+
+	// Setup of each realization
+	std::atomic<int> n_setup(0);
+	ensemble.set_setup_function([&n_setup](ABM& model){ 
+			model.set_place_driven_susceptibles(true); ++n_setup; });
+	ensemble.run(seeds, 1);
+	if (n_setup != static_cast<int>(seeds.size())) {
+		std::cerr << "Setup function not called for each realization" << std::endl;
+		return false;
+	}
+
+	// Output, one realization per line
+	Ensemble::print_series(fname, serial, &Ensemble::Series::infected);
+	AbmIO io(fname, " ", true, {seeds.size(), tmax + 1});
+	const std::vector<std::vector<int>> saved = io.read_vector<int>();
+	for (size_t i = 0; i < seeds.size(); ++i) {
+		if (saved.at(i) != serial.at(i).infected) {
+			std::cerr << "Wrong ensemble output in line " << i + 1 << std::endl;
+			return false;
+		}
+	}
+	std::remove(fname.c_str());
+	return true;
+}
+
+// Outside places follow the prevalence of other towns, 
+// results do not depend on the number of threads
+bool abm_region()
+{
+	const double dt = 0.25, tol = 1e-10;
+	const int tmax = 4, inf0 = 1;
+	const std::vector<int> N_active = {10000, 100};
+	const std::vector<uint64_t> seeds = {31, 32};
+	const std::vector<std::vector<double>> flows = {{0.0, 0.4}, {0.7, 0.0}};
+
+	Region serial, threaded;
+	threaded.set_number_of_threads(2);
+	for (size_t i = 0; i < seeds.size(); ++i) {
+		const std::string name = "town_" + std::to_string(i);
+		serial.add_town(create_vac_reopening_abm(dt, inf0, N_active.at(i), seeds.at(i)), name);
+		threaded.add_town(create_vac_reopening_abm(dt, inf0, N_active.at(i), seeds.at(i)), name);
+	}
+	serial.set_commuter_flows(flows);
+	threaded.load_commuter_flows("test_data/commuter_flows.txt");
+	if (threaded.get_commuter_flows() != flows) {
+		std::cerr << "Wrong commuter flows loaded from a file" << std::endl;
+		return false;
+	}
+
+	// Outside prevalence of each town 
+	serial.couple();
+	for (size_t i = 0; i < seeds.size(); ++i) {
+		const ABM& town = serial.get_town(i);
+		const ABM& other = serial.get_town(1-i);
+		const double p_exp = flows.at(i).at(1-i)*other.get_prevalence() 
+					+ (1.0 - flows.at(i).at(1-i))*town.get_infection_params().fraction_estimated_infected;
+		if (!float_equality<double>(serial.get_outside_prevalence().at(i), p_exp, tol)) {
+			std::cerr << "Wrong outside prevalence of " << serial.get_town_name(i) << std::endl;
+			return false;
+		}
+		for (const auto& workplace : town.get_vector_of_workplaces()) {
+			if (workplace.outside_town() 
+					&& !float_equality<double>(workplace.get_outside_lambda(), p_exp, tol)) {
+				std::cerr << "Wrong contribution of an outside workplace" << std::endl;
+				return false;
+			}
+		}
+		const double beta_les = town.get_infection_params().leisure_locations_transmission_rate;
+		for (const auto& leisure : town.get_vector_of_leisure_locations()) {
+			if (leisure.outside_town() 
+					&& !float_equality<double>(leisure.get_outside_lambda(), beta_les*p_exp, tol)) {
+				std::cerr << "Wrong contribution of an outside leisure location" << std::endl;
+				return false;
+			}
+		}
+	}
+	// Town with more cases raises the outside prevalence of the other
+	if (serial.get_outside_prevalence().at(1) <= serial.get_outside_prevalence().at(0)) {
+		std::cerr << "Outside prevalence does not follow the coupled towns" << std::endl;
+		return false;
+	}
+
+	serial.run(tmax);
+	threaded.run(tmax);
+	for (size_t i = 0; i < seeds.size(); ++i) {
+		if (!same_seeded_runs(serial.get_town(i), threaded.get_town(i))) {
+			std::cerr << "Threaded region differs for " << serial.get_town_name(i) << std::endl;
+			return false;
+		}
+	}
+
+	// Wrong flows
+	const std::invalid_argument arg_err("");
+	const bool verbose = false;
+	void (Region::*set_flows)(const std::vector<std::vector<double>>&) = &Region::set_commuter_flows;
+	const std::vector<std::vector<std::vector<double>>> wrong_flows = 
+		{ {{0.0, 0.4}}, {{0.0, -0.1}, {0.2, 0.0}}, {{0.1, 0.4}, {0.2, 0.0}}, {{0.0, 1.2}, {0.2, 0.0}} };
+	for (const auto& wrong : wrong_flows) {
+		if (!exception_test(verbose, &arg_err, set_flows, serial, wrong)) {
+			std::cerr << "Wrong commuter flows should throw" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// Each process holds and computes only its own agents, 
+// shared places get the same totals as in one process
+bool abm_domain_split()
+{
+	const double dt = 0.25, tol = 1e-12;
+	const int inf0 = 1, N_active = 10000, n_ranks = 3, n_steps = 4;
+	const uint64_t seed = 2025;
+
+	ABM abm = create_vac_reopening_abm(dt, inf0, N_active, seed);
+	// Some agents in hospitals, testing, or home isolation
+	for (int ti = 0; ti < 10; ++ti) {
+		abm.transmit_ideal_testing_vac_reopening();
+	}
+	abm.compute_place_contributions();
+	std::vector<double> expected;
+	collect_contributions(abm, expected);
+	std::vector<int> expected_tested;
+	for (const auto& hospital : abm.get_vector_of_hospitals()) {
+		expected_tested.push_back(hospital.get_n_tested());
+	}
+	std::vector<double> expected_agents;
+	collect_numbers_of_agents(abm, expected_agents);
+	abm.reset_contributions();
+	const size_t n_tables = abm.get_mobility().get_number_of_stored_probabilities();
+
+	bool own = true, all = true, same = true, ghosts = true, separate = true;
+	std::vector<int> n_per_rank(n_ranks, 0);
+	{
+		LocalRanks ranks(n_ranks);
+		abm.set_domain(ranks);
+		const int rank = ranks.rank();
+
+		// Places hold only agents of this rank, copies of 
+		// a place together hold all of its agents
+		own = only_agents_of_rank(abm, rank);
+		std::vector<double> local_agents;
+		collect_numbers_of_agents(abm, local_agents);
+		std::vector<double> n_agents = local_agents;
+		ranks.allreduce_sum(n_agents);
+		all = (n_agents == expected_agents);
+		// Each rank keeps leisure tables of its own households
+		std::vector<double> stored(1, abm.get_mobility().get_number_of_stored_probabilities());
+		all = all && (stored.at(0) < n_tables);
+		ranks.allreduce_sum(stored);
+		all = all && (static_cast<size_t>(stored.at(0)) == n_tables);
+
+		// Places this rank owns or has agents in get the totals,
+		// including ghosts owned by other ranks
+		abm.compute_place_contributions();
+		std::vector<double> computed;
+		collect_contributions(abm, computed);
+		std::vector<int> owners;
+		collect_place_ranks(abm, owners);
+		int n_ghosts = 0;
+		for (size_t i = 0; i < expected.size(); ++i) {
+			if (owners.at(i) != rank && local_agents.at(i) > 0) {
+				++n_ghosts;
+			}
+			if ((owners.at(i) == rank || local_agents.at(i) > 0)
+					&& !float_equality<double>(expected.at(i), computed.at(i), tol)) {
+				same = false;
+			}
+		}
+		for (size_t i = 0; i < expected_tested.size(); ++i) {
+			if (abm.get_vector_of_hospitals().at(i).get_n_tested() != expected_tested.at(i)) {
+				same = false;
+			}
+		}
+		ghosts = (n_ghosts > 0) && (n_ghosts < static_cast<int>(expected.size()));
+		abm.reset_contributions();
+
+		// Transitions change only agents of this rank
+		std::vector<uint64_t> flags;
+		for (const auto& agent : abm.get_vector_of_agents()) {
+			flags.push_back(agent.get_state().flags());
+		}
+		for (int ti = 0; ti < n_steps; ++ti) {
+			abm.transmit_ideal_testing_vac_reopening();
+		}
+		int n_changed = 0;
+		for (const auto& agent : abm.get_vector_of_agents()) {
+			const bool changed = agent.get_state().flags() != flags.at(agent.get_ID() - 1);
+			if (abm.get_agent_rank(agent.get_ID()) != rank) {
+				separate = separate && !changed;
+			} else if (changed) {
+				++n_changed;
+			}
+		}
+		separate = separate && (n_changed > 0) && only_agents_of_rank(abm, rank);
+
+		if (!(own && all && same && ghosts && separate)) {
+			ranks.set_failed();
+		}
+		// Other ranks end with the group
+		ranks.wait_for_ranks();
+		own = own && ranks.ranks_succeeded();
+		for (const auto& agent : abm.get_vector_of_agents()) {
+			++n_per_rank.at(abm.get_agent_rank(agent.get_ID()));
+		}
+		abm.clear_domain();
+	}
+	if (!own) {
+		std::cerr << "Places hold agents of other processes, or a process failed" << std::endl;
+		return false;
+	}
+	if (!all) {
+		std::cerr << "Copies of places or leisure tables do not add up to the whole model" << std::endl;
+		return false;
+	}
+	if (!same) {
+		std::cerr << "Contributions differ when split between processes" << std::endl;
+		return false;
+	}
+	if (!ghosts) {
+		std::cerr << "Process should share some but not all places with others" << std::endl;
+		return false;
+	}
+	if (!separate) {
+		std::cerr << "Transitions should change only agents of the process" << std::endl;
+		return false;
+	}
+
+	// All ranks have agents, in contiguous ranges of households
+	const int n_agents = abm.get_vector_of_agents().size();
+	for (const auto& n : n_per_rank) {
+		if (std::abs(n - n_agents/n_ranks) > n_agents/(10*n_ranks)) {
+			std::cerr << "Unbalanced split of agents between processes" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+// Profile records each phase, switching it on does not change results
+bool abm_step_profiler()
+{
+	const double dt = 0.25;
+	const int tmax = 8, inf0 = 1, N_active = 10000;
+	const uint64_t seed = 2026;
+
+	ABM abm = create_vac_reopening_abm(dt, inf0, N_active, seed);
+	abm.set_parallel_transitions(2);
+	ABM reference = create_vac_reopening_abm(dt, inf0, N_active, seed);
+	reference.set_parallel_transitions(2);
+
+	// Recorded steps only while enabled
+	abm.transmit_ideal_testing_vac_reopening();
+	abm.set_profiling(true);
+	for (int ti = 1; ti < tmax; ++ti) {
+		abm.transmit_ideal_testing_vac_reopening();
+	}
+	abm.set_profiling(false);
+	abm.transmit_ideal_testing_vac_reopening();
+	for (int ti = 0; ti <= tmax; ++ti) {
+		reference.transmit_ideal_testing_vac_reopening();
+	}
+	if (!same_seeded_runs(abm, reference)) {
+		std::cerr << "Profiling changed the results" << std::endl;
+		return false;
+	}
+
+	const StepProfiler& profile = abm.get_profiler();
+	if (profile.number_of_steps() != tmax - 1) {
+		std::cerr << "Wrong number of profiled steps" << std::endl;
+		return false;
+	}
+	// Phases of this step function, all with some time
+	for (const auto& phase : {StepProfiler::reopening, StepProfiler::vaccination, 
+			StepProfiler::leisure, StepProfiler::contributions, StepProfiler::transitions,
+			StepProfiler::reset}) {
+		if (profile.total_time(phase) <= 0.0) {
+			std::cerr << "No time recorded for " << StepProfiler::phase_name(phase) << std::endl;
+			return false;
+		}
+	}
+	if (profile.total_time(StepProfiler::testing_and_events) != 0.0) {
+		std::cerr << "Time recorded for a phase that did not run" << std::endl;
+		return false;
+	}
+	// Counters of the main phases
+	const size_t n_agents = abm.get_vector_of_agents().size();
+	if (profile.total_count(StepProfiler::leisure, StepProfiler::agents_visited) != (tmax - 1)*n_agents
+			|| profile.total_count(StepProfiler::leisure, StepProfiler::membership_inserts) == 0
+			|| profile.total_count(StepProfiler::leisure, StepProfiler::membership_removes) == 0
+			|| profile.total_count(StepProfiler::leisure, StepProfiler::rng_draws) == 0) {
+		std::cerr << "Wrong leisure counters" << std::endl;
+		return false;
+	}
+	if (profile.total_count(StepProfiler::contributions, StepProfiler::agents_visited) == 0
+			|| profile.total_count(StepProfiler::contributions, StepProfiler::places_touched) == 0
+			|| profile.total_count(StepProfiler::contributions, StepProfiler::membership_inserts) != 0) {
+		std::cerr << "Wrong contribution counters" << std::endl;
+		return false;
+	}
+	// Susceptible agents are visited at every step
+	if (profile.total_count(StepProfiler::transitions, StepProfiler::agents_visited) < (tmax - 1)*(n_agents/2)
+			|| profile.total_count(StepProfiler::transitions, StepProfiler::transitions_fired) == 0
+			|| profile.total_count(StepProfiler::transitions, StepProfiler::rng_draws) == 0) {
+		std::cerr << "Wrong transition counters" << std::endl;
+		return false;
+	}
+
+	// Both output formats
+	const std::string json_file("test_data/profile_out.json");
+	const std::string trace_file("test_data/profile_trace_out.json");
+	abm.print_profile(json_file);
+	abm.print_profile_trace(trace_file);
+	for (const auto& fname : {json_file, trace_file}) {
+		std::ifstream in(fname);
+		const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		if (content.find("\"transitions\"") == std::string::npos
+				|| content.find("\"transitions_fired\"") == std::string::npos) {
+			std::cerr << "Missing phases or counters in " << fname << std::endl;
+			return false;
+		}
+	}
+	abm.get_profiler().clear();
+	if (abm.get_profiler().number_of_steps() != 0) {
+		std::cerr << "Profile not cleared" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+bool abm_async_output()
+{
+	const double dt = 0.25;
+	const int tmax = 4, inf0 = 1, N_active = 10000;
+	const std::string tag("test_data/async_agents_");
+
+	ABM abm = create_vac_reopening_abm(dt, inf0, N_active, 2023);
+	AsyncWriter<Agent::Snapshot> writer(1);
+	for (int ti = 0; ti<=tmax; ++ti) {
+		abm.print_agents(tag + "sync_" + std::to_string(ti) + ".txt");
+		abm.print_agents(tag + std::to_string(ti) + ".txt", writer);
+		abm.transmit_ideal_testing_vac_reopening();
+	}
+	writer.flush();
+
+	// Same as written directly, at the time of the call
+	for (int ti = 0; ti<=tmax; ++ti) {
+		const std::string fsync = tag + "sync_" + std::to_string(ti) + ".txt";
+		const std::string fasync = tag + std::to_string(ti) + ".txt";
+		const std::vector<std::vector<std::string>> expected = 
+			AbmIO(fsync, " ", true, {0,0,0}).read_vector<std::string>();
+		const std::vector<std::vector<std::string>> written = 
+			AbmIO(fasync, " ", true, {0,0,0}).read_vector<std::string>();
+		if (expected.empty() || written != expected) {
+			std::cerr << "Agents written in a separate thread differ at step " << ti << std::endl;
+			return false;
+		}
+		std::remove(fsync.c_str());
+		std::remove(fasync.c_str());
+	}
+
+	// Errors are reported to the simulation
+	abm.print_agents("no_such_directory/agents.txt", writer);
+	const std::runtime_error rte("");
+	const bool verbose = false;
+	if (!exception_test(verbose, &rte, [&writer](){ writer.flush(); })) {
+		std::cerr << "Writing to a wrong path should throw" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+// True if counts and agent states of two runs are the same
+bool same_seeded_runs(const ABM& abm_1, const ABM& abm_3)
+{
+	if (abm_1.get_infected_day() != abm_3.get_infected_day()
+			|| abm_1.get_tested_day() != abm_3.get_tested_day()
+			|| abm_1.get_total_dead() != abm_3.get_total_dead()
+			|| abm_1.get_total_recovered() != abm_3.get_total_recovered()
+			|| abm_1.get_total_tested_positive() != abm_3.get_total_tested_positive()) {
+		std::cerr << "Counts differ between seeded runs" << std::endl;
+		return false;
+	}
+
+	const std::vector<Agent>& agents_1 = abm_1.get_vector_of_agents();
+	const std::vector<Agent>& agents_3 = abm_3.get_vector_of_agents();
+	for (size_t i = 0; i < agents_1.size(); ++i) {
+		const Agent& a1 = agents_1.at(i);
+		const Agent& a3 = agents_3.at(i);
+		if (a1.infected() != a3.infected() || a1.exposed() != a3.exposed()
+				|| a1.symptomatic() != a3.symptomatic() || a1.removed() != a3.removed()
+				|| a1.tested() != a3.tested() || a1.home_isolated() != a3.home_isolated()
+				|| a1.hospitalized() != a3.hospitalized() || a1.vaccinated() != a3.vaccinated()
+				|| a1.symptomatic_non_covid() != a3.symptomatic_non_covid()
+				|| a1.get_latency_end_time() != a3.get_latency_end_time()
+				|| a1.get_time_of_test() != a3.get_time_of_test()) {
+			std::cerr << "Agent " << a1.get_ID() << " differs between seeded runs" << std::endl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Infected contributions of all places, in order of place types
+void collect_contributions(const ABM& abm, std::vector<double>& lambdas)
+{
+	for (const auto& place : abm.get_vector_of_households()) {
+		lambdas.push_back(place.get_infected_contribution());
+	}
+	for (const auto& place : abm.get_vector_of_schools()) {
+		lambdas.push_back(place.get_infected_contribution());
+	}
+	for (const auto& place : abm.get_vector_of_workplaces()) {
+		lambdas.push_back(place.get_infected_contribution());
+	}
+	for (const auto& place : abm.get_vector_of_hospitals()) {
+		lambdas.push_back(place.get_infected_contribution());
+	}
+	for (const auto& place : abm.get_vector_of_retirement_homes()) {
+		lambdas.push_back(place.get_infected_contribution());
+	}
+	for (const auto& place : abm.get_vector_of_carpools()) {
+		lambdas.push_back(place.get_infected_contribution());
+	}
+	for (const auto& place : abm.get_vector_of_public_transit()) {
+		lambdas.push_back(place.get_infected_contribution());
+	}
+	for (const auto& place : abm.get_vector_of_leisure_locations()) {
+		lambdas.push_back(place.get_infected_contribution());
+	}
+}
+
+// Number of agents in each place, in the order of collect_contributions
+void collect_numbers_of_agents(const ABM& abm, std::vector<double>& n_agents)
+{
+	auto add = [&n_agents](const Place& place){ n_agents.push_back(place.get_number_of_agents()); };
+	std::for_each(abm.get_vector_of_households().begin(), abm.get_vector_of_households().end(), add);
+	std::for_each(abm.get_vector_of_schools().begin(), abm.get_vector_of_schools().end(), add);
+	std::for_each(abm.get_vector_of_workplaces().begin(), abm.get_vector_of_workplaces().end(), add);
+	std::for_each(abm.get_vector_of_hospitals().begin(), abm.get_vector_of_hospitals().end(), add);
+	std::for_each(abm.get_vector_of_retirement_homes().begin(), 
+					abm.get_vector_of_retirement_homes().end(), add);
+	std::for_each(abm.get_vector_of_carpools().begin(), abm.get_vector_of_carpools().end(), add);
+	std::for_each(abm.get_vector_of_public_transit().begin(), 
+					abm.get_vector_of_public_transit().end(), add);
+	std::for_each(abm.get_vector_of_leisure_locations().begin(), 
+					abm.get_vector_of_leisure_locations().end(), add);
+}
+
+// Owner rank of each place, in the order of collect_contributions
+void collect_place_ranks(const ABM& abm, std::vector<int>& owners)
+{
+	const std::vector<std::pair<PopulationImage::Table, size_t>> types = {
+		{PopulationImage::households, abm.get_vector_of_households().size()},
+		{PopulationImage::schools, abm.get_vector_of_schools().size()},
+		{PopulationImage::workplaces, abm.get_vector_of_workplaces().size()},
+		{PopulationImage::hospitals, abm.get_vector_of_hospitals().size()},
+		{PopulationImage::retirement_homes, abm.get_vector_of_retirement_homes().size()},
+		{PopulationImage::carpools, abm.get_vector_of_carpools().size()},
+		{PopulationImage::public_transit, abm.get_vector_of_public_transit().size()},
+		{PopulationImage::leisure_locations, abm.get_vector_of_leisure_locations().size()} };
+	for (const auto& type : types) {
+		for (size_t i = 0; i < type.second; ++i) {
+			owners.push_back(abm.get_place_rank(type.first, i + 1));
+		}
+	}
+}
+
+// True if all places hold only agents of this rank
+bool only_agents_of_rank(const ABM& abm, const int rank)
+{
+	return only_agents_of_rank(abm, abm.get_vector_of_households(), rank)
+			&& only_agents_of_rank(abm, abm.get_vector_of_schools(), rank)
+			&& only_agents_of_rank(abm, abm.get_vector_of_workplaces(), rank)
+			&& only_agents_of_rank(abm, abm.get_vector_of_hospitals(), rank)
+			&& only_agents_of_rank(abm, abm.get_vector_of_retirement_homes(), rank)
+			&& only_agents_of_rank(abm, abm.get_vector_of_carpools(), rank)
+			&& only_agents_of_rank(abm, abm.get_vector_of_public_transit(), rank)
+			&& only_agents_of_rank(abm, abm.get_vector_of_leisure_locations(), rank);
+}
+
+// True if places of one type hold only agents of this rank
+template <typename T>
+bool only_agents_of_rank(const ABM& abm, const std::vector<T>& places, const int rank)
+{
+	for (const auto& place : places) {
+		for (const auto& aID : place.get_agent_IDs()) {
+			if (abm.get_agent_rank(aID) != rank) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 // Common operations for creating the ABM interface
 ABM create_abm(const double dt, int inf0)
 {
@@ -1301,3 +2063,58 @@ ABM create_abm(const double dt, int inf0)
 
 	return abm;	
 }
+
+// ABM for vaccination and reopening studies with initial COVID-19 cases,
+// seed 0 for seeding from a random device
+ABM create_vac_reopening_abm(const double dt, const int inf0, const int N_active, const uint64_t seed)
+{
+	// Input files
+	std::string fin("test_data/NR_agents.txt");
+	std::string hfile("test_data/NR_households.txt");
+	std::string sfile("test_data/NR_schools.txt");
+	std::string wfile("test_data/NR_workplaces.txt");
+	std::string hsp_file("test_data/NR_hospitals.txt");
+	std::string rh_file("test_data/NR_retirement_homes.txt");
+	std::string cp_file("test_data/NR_carpool.txt");
+	std::string pt_file("test_data/NR_public.txt");
+	std::string ls_file("test_data/NR_leisure.txt");
+
+	// File with infection parameters
+	std::string pfname("test_data/vac_reopen_infection_parameters.txt");
+	// Files with age-dependent distributions
+	std::string dexp_name("test_data/age_dist_exposed_never_sy.txt");
+	std::string dh_name("test_data/age_dist_hospitalization.txt");
+	std::string dhicu_name("test_data/age_dist_hosp_ICU.txt");
+	std::string dmort_name("test_data/age_dist_mortality.txt");
+	// Map for abm loading of distributions
+	std::map<std::string, std::string> dfiles = 
+		{ {"exposed never symptomatic", dexp_name}, {"hospitalization", dh_name}, 
+		  {"ICU", dhicu_name}, {"mortality", dmort_name} };
+	// File with 	
+	std::string tfname("test_data/vac_reopen_tests_with_time.txt");
+
+	ABM abm(dt, pfname, dfiles, tfname);
+	if (seed != 0) {
+		abm.set_seed(seed);
+	}
+
+	// The places
+	abm.create_households(hfile);
+	abm.create_schools(sfile);
+	abm.create_workplaces(wfile);
+	abm.create_hospitals(hsp_file);
+	abm.create_retirement_homes(rh_file);
+	abm.create_carpools(cp_file);
+	abm.create_public_transit(pt_file);
+	abm.create_leisure_locations(ls_file);
+	abm.initialize_mobility();
+	// The agents
+	abm.create_agents(fin, inf0);
+	// Initialization for vaccination/reopening studies
+	abm.initialize_vac_and_reopening();
+	// Create a COVID-19 population
+	abm.initialize_active_cases(N_active);
+
+	return abm;
+}
+
@@ -14,6 +14,12 @@ using getter = bool (Agent::*)() const;
 
 // Tests
 bool test_states_on_off();
+bool test_states_in_store();
+bool test_state_transitions();
+bool test_state_stages();
+bool test_store_compartments();
+bool test_store_marks();
+bool test_event_calendar();
 
 // Supporting functions
 bool set_and_get(setter, getter, Agent);
@@ -21,6 +27,12 @@ bool set_and_get(setter, getter, Agent);
 int main()
 {
 	test_pass(test_states_on_off(), "Agent class states - getters and setters");
+	test_pass(test_states_in_store(), "Agent states in the columnar store");
+	test_pass(test_state_transitions(), "Agent state transition table entries");
+	test_pass(test_state_stages(), "Agent disease, testing, and treatment stages");
+	test_pass(test_store_compartments(), "Compartment index sets of the columnar store");
+	test_pass(test_store_marks(), "Changed and due marks of the columnar store");
+	test_pass(test_event_calendar(), "Calendar of scheduled transitions");
 }
 
 bool test_states_on_off()
@@ -76,3 +88,391 @@ bool set_and_get(setter set_val, getter get_val, Agent agent)
 	return true;
 }
 
+// Setters of attached agents need to update the store, 
+// copies of agents should not
+bool test_states_in_store()
+{
+	const std::vector<std::pair<setter, AgentState::Flag>> flags = {
+		{&Agent::set_infected, AgentState::infected}, 
+		{&Agent::set_exposed, AgentState::exposed},
+		{&Agent::set_symptomatic, AgentState::symptomatic},
+		{&Agent::set_symptomatic_non_covid, AgentState::symptomatic_non_covid},
+		{&Agent::set_tested, AgentState::tested},
+		{&Agent::set_tested_in_hospital, AgentState::tested_in_hospital},
+		{&Agent::set_tested_awaiting_test, AgentState::tested_awaiting_test},
+		{&Agent::set_tested_covid_positive, AgentState::tested_covid_positive},
+		{&Agent::set_home_isolated, AgentState::home_isolated},
+		{&Agent::set_hospitalized_ICU, AgentState::hospitalized_ICU},
+		{&Agent::set_removed, AgentState::removed},
+		{&Agent::set_vaccinated, AgentState::vaccinated} };
+
+	std::vector<Agent> agents(3);
+	// Attributes copied when attaching 
+	agents.at(1).set_ID(2);
+	agents.at(1).set_exposed(true);
+	AgentStore store;
+	store.resize(agents.size());
+	for (size_t i = 0; i < agents.size(); ++i){
+		agents.at(i).attach_to_store(store.row(i));
+	}
+	if (store.view(1).get_ID() != 2 || !store.view(1).exposed()){
+		return false;
+	}
+
+	for (const auto& flag : flags){
+		(agents.at(2).*flag.first)(true);
+		if (!store.view(2).has(flag.second)){
+			return false;
+		}
+		(agents.at(2).*flag.first)(false);
+		if (store.view(2).has(flag.second)){
+			return false;
+		}
+	}
+	// Other rows unchanged
+	if (store.view(0).flags() != 0){
+		return false;
+	}
+
+	// IDs and timers
+	agents.at(0).set_leisure_ID(7);
+	agents.at(0).set_leisure_type("public");
+	agents.at(0).set_time_to_test(1.5);
+	agents.at(0).set_time_of_test(2.0);
+	agents.at(0).set_inf_variability_factor(0.3);
+	const AgentStore::View view = store.view(0);
+	if (view.get_leisure_ID() != 7 || !view.has(AgentState::leisure_public) 
+			|| view.has(AgentState::leisure_household)
+			|| !float_equality<double>(view.get_time_of_test(), 3.5, 1e-10)
+			|| !float_equality<double>(view.get_inf_variability_factor(), 0.3, 1e-10)){
+		return false;
+	}
+
+	// A copy is independent of the store
+	Agent copy = agents.at(0);
+	copy.set_removed(true);
+	copy.set_leisure_ID(3);
+	if (store.view(0).removed() || store.view(0).get_leisure_ID() != 7){
+		return false;
+	}
+
+	// Agents keep their rows when the vector reallocates, 
+	// a moved-from agent no longer writes to the store
+	agents.reserve(4*agents.capacity());
+	for (size_t i = 0; i < agents.size(); ++i){
+		if (!agents.at(i).attached_to(store.row(i))){
+			return false;
+		}
+	}
+	agents.at(1).set_removed(true);
+	Agent moved = std::move(agents.at(1));
+	agents.at(1).set_leisure_ID(5);
+	if (!store.view(1).removed() || store.view(1).get_leisure_ID() != 0 
+			|| !moved.attached_to(store.row(1))){
+		return false;
+	}
+	return true;
+}
+
+// Entries of a transition table change the flags 
+// at once and refuse illegal moves
+bool test_state_transitions()
+{
+	// All the flags fit in a single word
+	if (AgentState::n_flags > 64 || sizeof(AgentState) != sizeof(uint64_t)){
+		return false;
+	}
+
+	const AgentState::Transition to_exposed = {"to exposed",
+		AgentState::mask({AgentState::infected, AgentState::exposed}),
+		AgentState::mask({AgentState::symptomatic}) | AgentState::testing_flags(),
+		0, AgentState::mask({AgentState::infected, AgentState::removed})};
+	const AgentState::Transition to_removed = {"to removed",
+		AgentState::mask({AgentState::removed}),
+		AgentState::mask({AgentState::infected, AgentState::exposed}),
+		AgentState::mask({AgentState::infected}), 0};
+
+	Agent agent;
+	agent.set_tested(true);
+	agent.set_tested_in_car(true);
+	agent.set_vaccinated(true);
+	agent.change_state(to_exposed);
+	if (!agent.infected() || !agent.exposed() || agent.tested() 
+			|| agent.tested_in_car() || !agent.vaccinated()){
+		return false;
+	}
+
+	// Already infected 
+	bool thrown = false;
+	try {
+		agent.change_state(to_exposed);
+	} catch (const std::runtime_error& e) {
+		thrown = true;
+	}
+	if (!thrown){
+		return false;
+	}
+
+	agent.change_state(to_removed);
+	if (!agent.removed() || agent.infected() || agent.exposed()){
+		return false;
+	}
+
+	// Not infected anymore
+	thrown = false;
+	try {
+		agent.change_state(to_removed);
+	} catch (const std::runtime_error& e) {
+		thrown = true;
+	}
+	return thrown;
+}
+
+// Stages decoded from the flags
+bool test_state_stages()
+{
+	AgentState state;
+	if (state.disease_stage() != AgentState::susceptible 
+			|| state.testing_stage() != AgentState::not_tested
+			|| state.treatment_stage() != AgentState::not_treated){
+		return false;
+	}
+
+	state.set(AgentState::infected, true);
+	if (state.disease_stage() != AgentState::invalid_stage){
+		return false;
+	}
+	state.set(AgentState::exposed, true);
+	if (state.disease_stage() != AgentState::exposed_stage){
+		return false;
+	}
+	state.set(AgentState::exposed, false);
+	state.set(AgentState::symptomatic, true);
+	if (state.disease_stage() != AgentState::symptomatic_stage){
+		return false;
+	}
+	state.set(AgentState::removed, true);
+	if (state.disease_stage() != AgentState::removed_stage){
+		return false;
+	}
+
+	state.set(AgentState::tested, true);
+	state.set(AgentState::tested_awaiting_test, true);
+	if (state.testing_stage() != AgentState::waiting_for_test){
+		return false;
+	}
+	state.set(AgentState::tested_awaiting_test, false);
+	state.set(AgentState::tested_awaiting_results, true);
+	if (state.testing_stage() != AgentState::waiting_for_results){
+		return false;
+	}
+	state.set(AgentState::tested_awaiting_results, false);
+	if (state.testing_stage() != AgentState::test_completed){
+		return false;
+	}
+
+	state.set(AgentState::hospitalized_ICU, true);
+	if (state.treatment_stage() != AgentState::intensive_care){
+		return false;
+	}
+	state.set(AgentState::hospitalized, true);
+	if (state.treatment_stage() != AgentState::hospitalization){
+		return false;
+	}
+	state.set(AgentState::home_isolated, true);
+	if (state.treatment_stage() != AgentState::home_isolation){
+		return false;
+	}
+	return true;
+}
+
+// Compartment sets follow the changes of agent states
+bool test_store_compartments()
+{
+	// More than two blocks of agents
+	const size_t n = 150;
+	std::vector<Agent> agents(n);
+	AgentStore store;
+	store.resize(n);
+	for (size_t i = 0; i < n; ++i){
+		agents.at(i).attach_to_store(store.row(i));
+	}
+	if (store.n_blocks() != 3 || store.count(AgentStore::susceptible_set) != static_cast<int>(n)){
+		return false;
+	}
+
+	// Exposed, symptomatic, removed, vaccinated 
+	const std::vector<size_t> exp_IDs = {3, 64, 149};
+	const std::vector<size_t> sym_IDs = {0, 70};
+	for (const auto& i : exp_IDs){
+		agents.at(i).set_infected(true);
+		agents.at(i).set_exposed(true);
+	}
+	for (const auto& i : sym_IDs){
+		agents.at(i).set_infected(true);
+		agents.at(i).set_symptomatic(true);
+	}
+	agents.at(100).set_removed(true);
+	agents.at(101).set_vaccinated(true);
+	// Susceptible tested in a hospital
+	agents.at(5).set_tested(true);
+	agents.at(5).set_tested_in_hospital(true);
+	agents.at(5).set_tested_awaiting_test(true);
+
+	if (store.count(AgentStore::exposed_set) != 3 
+			|| store.count(AgentStore::symptomatic_set) != 2
+			|| store.count(AgentStore::removed_set) != 1
+			|| store.count(AgentStore::vaccinated_set) != 1
+			|| store.count(AgentStore::hospital_testing_set) != 1
+			|| store.count(AgentStore::invalid_set) != 0
+			|| store.count(AgentStore::susceptible_set) != static_cast<int>(n) - 6){
+		return false;
+	}
+
+	// Infected visited in order
+	std::vector<size_t> visited;
+	const std::vector<size_t> expected = {0, 3, 64, 70, 149};
+	store.for_each_in(AgentStore::compartment_mask({AgentStore::exposed_set, 
+		AgentStore::symptomatic_set}), 0, [&visited](size_t i){ visited.push_back(i); });
+	if (visited != expected){
+		return false;
+	}
+
+	// Everyone active, without the vaccinated
+	int n_active = 0;
+	store.for_each_in(~AgentStore::compartment_mask({AgentStore::removed_set}), 
+		AgentStore::compartment_mask({AgentStore::vaccinated_set}), 
+		[&n_active](size_t){ ++n_active; });
+	if (n_active != static_cast<int>(n) - 2){
+		return false;
+	}
+
+	// Moving out of a compartment
+	agents.at(64).set_exposed(false);
+	agents.at(64).set_infected(false);
+	agents.at(64).set_removed(true);
+	agents.at(5).set_tested_awaiting_test(false);
+	if (store.count(AgentStore::exposed_set) != 2 
+			|| store.count(AgentStore::removed_set) != 2
+			|| store.count(AgentStore::hospital_testing_set) != 0){
+		return false;
+	}
+	return true;
+}
+
+// Writes mark rows as changed, marks are independent of compartments
+bool test_store_marks()
+{
+	const size_t n = 130;
+	std::vector<Agent> agents(n);
+	AgentStore store;
+	store.resize(n);
+	for (size_t i = 0; i < n; ++i){
+		agents.at(i).attach_to_store(store.row(i));
+	}
+	// Attaching writes all the columns
+	if (store.count(AgentStore::changed_mark) != static_cast<int>(n)
+			|| store.count(AgentStore::due_mark) != 0){
+		return false;
+	}
+	store.clear(AgentStore::changed_mark);
+
+	// State, columns timer, and treatment timer
+	agents.at(2).set_infected(true);
+	agents.at(2).set_exposed(true);
+	agents.at(65).set_recovery_time(1.0);
+	agents.at(129).set_time_hsp_to_icu(2.0);
+	// Place IDs do not matter for transitions
+	agents.at(7).set_hospital_ID(3);
+	std::vector<size_t> visited;
+	const std::vector<size_t> expected = {2, 65, 129};
+	store.for_each_marked(AgentStore::changed_mark, 
+		[&visited](size_t i){ visited.push_back(i); });
+	if (visited != expected || store.count(AgentStore::changed_mark) != 3){
+		return false;
+	}
+
+	// Marked agents are visited in addition to compartments
+	store.mark(100, AgentStore::due_mark);
+	store.mark(100, AgentStore::due_mark);
+	store.mark(2, AgentStore::due_mark);
+	if (store.count(AgentStore::due_mark) != 2){
+		return false;
+	}
+	visited.clear();
+	const std::vector<size_t> expected_due = {2, 100};
+	store.for_each_in(AgentStore::compartment_mask({AgentStore::exposed_set}), 0, 
+		uint64_t(1) << AgentStore::due_mark, 0, store.n_blocks(),
+		[&visited](size_t i){ visited.push_back(i); });
+	if (visited != expected_due){
+		return false;
+	}
+	// Exclusion applies to marked agents too
+	agents.at(100).set_vaccinated(true);
+	visited.clear();
+	store.for_each_in(0, AgentStore::compartment_mask({AgentStore::vaccinated_set}), 
+		uint64_t(1) << AgentStore::due_mark, 0, store.n_blocks(),
+		[&visited](size_t i){ visited.push_back(i); });
+	if (visited != std::vector<size_t>{2}){
+		return false;
+	}
+	store.unmark(2, AgentStore::due_mark);
+	store.unmark(2, AgentStore::due_mark);
+	if (store.count(AgentStore::due_mark) != 1){
+		return false;
+	}
+	store.clear(AgentStore::due_mark);
+	if (store.count(AgentStore::due_mark) != 0){
+		return false;
+	}
+	return true;
+}
+
+// Agents come due at their scheduled step only
+bool test_event_calendar()
+{
+	// Small wheel so that steps wrap around
+	EventCalendar calendar(4);
+	calendar.reset(10, -1);
+	calendar.schedule(3, 1);
+	calendar.schedule(5, 1);
+	calendar.schedule(1, 6);
+	calendar.schedule(7, 2);
+	// Rescheduled, the first entry is dropped
+	calendar.schedule(7, 5);
+	calendar.schedule(2, 13);
+
+	std::vector<std::vector<size_t>> due(14);
+	for (long step = 0; step < 14; ++step){
+		calendar.advance([&due, step](size_t i){ due.at(step).push_back(i); });
+		if (calendar.get_step() != step){
+			return false;
+		}
+	}
+	std::vector<std::vector<size_t>> expected(14);
+	expected.at(1) = {3, 5};
+	expected.at(5) = {7};
+	expected.at(6) = {1};
+	expected.at(13) = {2};
+	if (due != expected){
+		return false;
+	}
+	// Unscheduled once due
+	if (calendar.scheduled_step(3) >= 0 || calendar.scheduled_step(2) >= 0){
+		return false;
+	}
+
+	// Cancelled and reset 
+	calendar.schedule(4, 15);
+	calendar.cancel(4);
+	calendar.schedule(6, 14);
+	calendar.reset(10, 13);
+	int n_due = 0;
+	for (int k = 0; k < 8; ++k){
+		calendar.advance([&n_due](size_t){ ++n_due; });
+	}
+	if (n_due != 0 || calendar.size() != 10){
+		return false;
+	}
+	return true;
+}
@@ -4,6 +4,7 @@
 #include "../../include/infection.h"
 #include "../../include/agent.h"
 #include "../../include/utils.h"
+#include "../../include/event_calendar.h"
 #include "../common/test_utils.h"
 
 #endif
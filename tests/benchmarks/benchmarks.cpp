@@ -0,0 +1,175 @@
+#include "../../include/abm.h"
+#include <chrono>
+
+/*****************************************************
+ *
+ * Benchmarks of the loaders and of each phase
+ * of a time step
+ *
+ * Run on a town generated with
+ * scripts/population_generator as
+ *
+ * 		./bench_exe prefix n_steps n_threads results_file [tail]
+ *
+ * tail is the fraction of the leisure probability mass
+ * dropped for each household, default 0.0 - every household
+ * stores a probability for every leisure location, about 30 GB
+ * for 1M agents; with the distance model of the test parameters
+ * small tails drop few locations and the stored IDs cost more
+ * than they save, e.g. for 100k agents peak memory is 360 MB
+ * with no tail, 500 MB with 1e-3, and 300 MB with 0.2
+ *
+ * Timings are appended to results_file, one line
+ * per phase:
+ *	n_agents | n_threads | phase | calls | total [s] |
+ *		mean [ms] | min [ms] | max [ms]
+ * lines starting with # are comments; the dropped 
+ * probability mass is in a comment line:
+ *	# n_agents | n_threads | leisure_truncation | tail |
+ *		max error | mean error
+ *
+ ******************************************************/
+
+/// Accumulated wall time of named phases, in order of first call
+class PhaseTimer{
+public:
+	/// Call func and add its wall time to the phase
+	template <typename F>
+	void time(const std::string& name, F func)
+	{
+		const auto begin = std::chrono::steady_clock::now();
+		func();
+		const auto end = std::chrono::steady_clock::now();
+		add(name, std::chrono::duration<double>(end - begin).count());
+	}
+
+	/// Add one call of a phase
+	void add(const std::string& name, const double seconds)
+	{
+		auto phase = std::find_if(phases.begin(), phases.end(),
+						[&name](const Phase& p){ return p.name == name; });
+		if (phase == phases.end()){
+			phases.push_back(Phase{name, 0, 0.0, seconds, seconds});
+			phase = phases.end() - 1;
+		}
+		++phase->calls;
+		phase->total += seconds;
+		phase->min = std::min(phase->min, seconds);
+		phase->max = std::max(phase->max, seconds);
+	}
+
+	/// Append all phases to a file and print them, note is a comment line before them
+	void print(const std::string& fname, const size_t n_agents, const int n_threads,
+					const std::string& note) const
+	{
+		std::ifstream existing(fname);
+		const bool header = !existing.good() || existing.peek() == std::ifstream::traits_type::eof();
+		existing.close();
+
+		std::ofstream out(fname, std::ios::app);
+		if (!out.is_open()){
+			throw std::runtime_error("Error opening file " + fname);
+		}
+		if (header){
+			out << "# n_agents n_threads phase calls total_s mean_ms min_ms max_ms\n";
+		}
+		out << "# " << note << "\n";
+		std::cout << note << std::endl;
+		for (const auto& p : phases){
+			std::ostringstream line;
+			line << n_agents << " " << n_threads << " " << p.name << " " << p.calls
+				 << " " << p.total << " " << 1000.0*p.total/p.calls
+				 << " " << 1000.0*p.min << " " << 1000.0*p.max;
+			out << line.str() << "\n";
+			std::cout << line.str() << std::endl;
+		}
+	}
+
+private:
+	struct Phase{
+		std::string name;
+		int calls;
+		double total;
+		double min;
+		double max;
+	};
+	std::vector<Phase> phases;
+};
+
+int main(int argc, char** argv)
+{
+	if (argc < 5){
+		std::cerr << "Usage: ./bench_exe prefix n_steps n_threads results_file [tail]" << std::endl;
+		return 1;
+	}
+	const std::string town(argv[1]);
+	const int n_steps = std::stoi(argv[2]);
+	const int n_threads = std::stoi(argv[3]);
+	const std::string results(argv[4]);
+	const double tail = argc > 5 ? std::stod(argv[5]) : 0.0;
+
+	// Parameters are the same for all sizes
+	const std::string data_dir("../abm/test_data/");
+	std::string pfname(data_dir + "infection_parameters.txt");
+	std::map<std::string, std::string> dfiles =
+		{ {"exposed never symptomatic", data_dir + "age_dist_exposed_never_sy.txt"},
+		  {"hospitalization", data_dir + "age_dist_hospitalization.txt"},
+		  {"ICU", data_dir + "age_dist_hosp_ICU.txt"},
+		  {"mortality", data_dir + "age_dist_mortality.txt"} };
+	std::string tfname(data_dir + "tests_with_time.txt");
+
+	// Time in days
+	const double dt = 0.25;
+	PhaseTimer timer;
+
+	//
+	// Loaders
+	//
+
+	std::unique_ptr<ABM> abm;
+	timer.time("load_parameters", [&](){ abm.reset(new ABM(dt, pfname, dfiles, tfname)); });
+	abm->set_seed(2020);
+	abm->set_parallel_contributions(n_threads);
+	abm->set_parallel_transitions(n_threads > 1 ? n_threads : 0);
+	abm->set_parallel_mobility(n_threads);
+	abm->set_leisure_truncation_tail(tail);
+
+	timer.time("create_households", [&](){ abm->create_households(town + "_households.txt"); });
+	timer.time("create_schools", [&](){ abm->create_schools(town + "_schools.txt"); });
+	timer.time("create_workplaces", [&](){ abm->create_workplaces(town + "_workplaces.txt"); });
+	timer.time("create_hospitals", [&](){ abm->create_hospitals(town + "_hospitals.txt"); });
+	timer.time("create_retirement_homes", [&](){ abm->create_retirement_homes(town + "_retirement_homes.txt"); });
+	timer.time("create_carpools", [&](){ abm->create_carpools(town + "_carpool.txt"); });
+	timer.time("create_public_transit", [&](){ abm->create_public_transit(town + "_public.txt"); });
+	timer.time("create_leisure_locations", [&](){ abm->create_leisure_locations(town + "_leisure.txt"); });
+	// Sets the distance parameters and calls Mobility::construct_public_probabilities
+	timer.time("construct_public_probabilities", [&](){ abm->initialize_mobility(); });
+	timer.time("create_agents", [&](){ abm->create_agents(town + "_agents.txt"); });
+	const size_t n_agents = abm->get_vector_of_agents().size();
+	// Active cases in all stages, 0.1% of the town
+	abm->initialize_active_cases(std::max(1, static_cast<int>(n_agents/1000)));
+
+	//
+	// Phases of transmit_infection
+	//
+
+	// Testing switch and closure events are constant time checks
+	// of transmit_infection() that are not exposed
+	for (int ti = 0; ti < n_steps; ++ti){
+		timer.time("step", [&](){
+			timer.time("distribute_leisure", [&](){ abm->distribute_leisure(); });
+			timer.time("compute_place_contributions", [&](){ abm->compute_place_contributions(); });
+			timer.time("compute_state_transitions", [&](){ abm->compute_state_transitions(); });
+			timer.time("reset_contributions", [&](){ abm->reset_contributions(); });
+			abm->advance_in_time();
+		});
+	}
+	std::cout << "Infected after " << n_steps << " steps: "
+			  << abm->get_num_infected() << std::endl;
+
+	const Mobility& mobility = abm->get_mobility();
+	std::ostringstream note;
+	note << n_agents << " " << n_threads << " leisure_truncation " << tail << " "
+		 << mobility.get_max_truncation_error() << " " << mobility.get_mean_truncation_error();
+	timer.print(results, n_agents, n_threads, note.str());
+}
@@ -0,0 +1,34 @@
+import sys
+
+#
+# Compare mean times of two benchmark results
+#
+# 	python3 compare_benchmarks.py base_results new_results
+#
+# Prints one line per phase and town size found in both,
+# ratio below 1 means the new results are faster
+#
+
+def load(fname):
+	''' Mean time in ms of each (n_agents, n_threads, phase) '''
+	times = {}
+	with open(fname, 'r') as fin:
+		for line in fin:
+			if line.startswith('#') or not line.strip():
+				continue
+			cols = line.split()
+			times[(int(cols[0]), int(cols[1]), cols[2])] = float(cols[5])
+	return times
+
+if len(sys.argv) < 3:
+	sys.exit('Usage: python3 compare_benchmarks.py base_results new_results')
+
+base = load(sys.argv[1])
+new = load(sys.argv[2])
+
+print('{:>9} {:>3} {:<32} {:>12} {:>12} {:>7}'.format('n_agents', 'thr', 'phase', 'base [ms]', 'new [ms]', 'ratio'))
+for key in sorted(base, key = lambda k: (k[0], k[1])):
+	if key not in new:
+		continue
+	ratio = new[key]/base[key] if base[key] > 0.0 else float('nan')
+	print('{:>9} {:>3} {:<32} {:>12.3f} {:>12.3f} {:>7.3f}'.format(key[0], key[1], key[2], base[key], new[key], ratio))
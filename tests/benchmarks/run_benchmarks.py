@@ -0,0 +1,64 @@
+import subprocess, os, sys
+
+py_path = '../../scripts/'
+sys.path.insert(0, py_path)
+
+import utils as ut
+from colors import *
+
+py_version = 'python3'
+
+#
+# Compile and run the benchmarks on towns of increasing size
+#
+# 	python3 run_benchmarks.py [n_threads] [n_steps] [sizes] [tail]
+#
+# with all cores used by default; sizes are comma separated
+# numbers of agents, default 10000,100000; tail is the leisure
+# probability mass dropped for each household, default 0.0, 
+# see benchmarks.cpp; towns are generated with 
+# scripts/population_generator; building the leisure
+# probabilities of the largest town dominates the run time
+#
+# 1M agents are not in the default sweep - without a tail
+# the leisure probabilities take about 30 GB, 403,929 households
+# times 9,091 locations; on a machine with enough memory run
+#
+# 	python3 run_benchmarks.py 8 20 10000,100000,1000000
+#
+# Results go to results/benchmarks_<commit>.txt, compare
+# two of them with compare_benchmarks.py
+#
+
+# Number of agents of each town
+n_threads = sys.argv[1] if len(sys.argv) > 1 else str(os.cpu_count())
+n_steps = sys.argv[2] if len(sys.argv) > 2 else '20'
+sizes = [int(n) for n in sys.argv[3].split(',')] if len(sys.argv) > 3 else [10000, 100000]
+tail = sys.argv[4] if len(sys.argv) > 4 else '0.0'
+
+# Directory with generated towns, kept between runs
+data_dir = 'bench_data/'
+res_dir = 'results/'
+for dname in [data_dir, res_dir]:
+	if not os.path.exists(dname):
+		os.mkdir(dname)
+
+# Results are labeled with the current commit
+commit = subprocess.run(['git', 'rev-parse', '--short', 'HEAD'],
+				stdout=subprocess.PIPE, universal_newlines=True).stdout.strip()
+results = res_dir + 'benchmarks_' + (commit if commit else 'local') + '.txt'
+if os.path.exists(results):
+	os.remove(results)
+
+# Compile the benchmarks and the town generator
+gen_dir = '../../scripts/population_generator/'
+subprocess.call([py_version + ' compilation.py'], shell=True)
+subprocess.call(['cd ' + gen_dir + ' && ' + py_version + ' compilation.py'], shell=True)
+
+for n in sizes:
+	town = data_dir + 'town_' + str(n)
+	if not os.path.exists(town + '_agents.txt'):
+		ut.msg('Generating a town with ' + str(n) + ' agents', CYAN)
+		subprocess.call([' '.join([gen_dir + 'generate_population', str(n), town, n_threads])], shell=True)
+	ut.msg('Benchmarks with ' + str(n) + ' agents', CYAN)
+	subprocess.call([' '.join(['./bench_exe', town, n_steps, n_threads, results, tail])], shell=True)
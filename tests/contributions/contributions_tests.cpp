@@ -10,9 +10,12 @@
 bool contributions_main_test();
 bool contributions_treatment_test();
 bool contributions_misc_test();
+bool contributions_parallel_test();
 
 // Supporting functions
 bool check_all_places(ABM&, const std::vector<Agent>&);
+template <typename T>
+bool same_contributions(const std::vector<T>&, const std::vector<T>&);
 void remove_agent_from_public_places(Agent& agent, std::vector<RetirementHome>& retirement_homes, 
 										std::vector<School>& schools, std::vector<Workplace>& workplaces, 
 										std::vector<Hospital>& hospitals);
@@ -34,6 +37,7 @@ int main()
 	test_pass(contributions_main_test(), "Computations of contributions, regular and tested");
 	test_pass(contributions_treatment_test(), "Computations of contributions, treated");
 	test_pass(contributions_misc_test(), "Computations of contributions, misc");
+	test_pass(contributions_parallel_test(), "Computations of contributions, multiple threads");
 }
 
 /// Test for correct computing of infection contributions
@@ -465,6 +469,121 @@ bool contributions_misc_test()
 	return true;
 }
 
+/// Test for identical contributions from serial and multithreaded computation
+bool contributions_parallel_test()
+{
+	// Create agents 
+	std::string fin("test_data/agents_test.txt");
+
+	// Files with place info
+	std::string hfile("test_data/houses_test.txt");
+	std::string sfile("test_data/schools_test.txt");
+	std::string wfile("test_data/workplaces_test.txt");
+	std::string hspfile("test_data/hospitals_test.txt");
+	std::string rh_file("test_data/rh_test.txt");
+	std::string cp_file("test_data/carpools.txt");
+	std::string pt_file("test_data/public_transit.txt");
+	std::string ls_file("test_data/public_leisure.txt");
+
+	// Model parameters
+	double dt = 0.5;
+	// File with infection parameters
+	std::string pfname("test_data/infection_parameters.txt");
+	// Files with age-dependent distributions
+	std::string dexp_name("test_data/age_dist_exposed_never_sy.txt");
+	std::string dh_name("test_data/age_dist_hospitalization.txt");
+	std::string dhicu_name("test_data/age_dist_hosp_ICU.txt");
+	std::string dmort_name("test_data/age_dist_mortality.txt");
+	// Map for abm loading of distrinutions
+	std::map<std::string, std::string> dfiles = 
+		{ {"exposed never symptomatic", dexp_name}, {"hospitalization", dh_name}, 
+		  {"ICU", dhicu_name}, {"mortality", dmort_name} };	
+	// File with time dependent testing parameters
+	std::string tfname("test_data/tests_with_time.txt");
+
+	ABM abm(dt, pfname, dfiles, tfname);
+
+	// First the places
+	abm.create_households(hfile);
+	abm.create_schools(sfile);
+	abm.create_workplaces(wfile);
+	abm.create_hospitals(hspfile);
+	abm.create_retirement_homes(rh_file);
+	abm.create_carpools(cp_file);
+	abm.create_public_transit(pt_file);
+	abm.create_leisure_locations(ls_file);
+
+	// Other initialization
+	abm.initialize_mobility();
+	abm.set_outside_workplace_transmission();
+	abm.set_outside_leisure_transmission();
+
+	// Then the agents
+	abm.create_agents(fin);
+	abm.distribute_leisure();
+
+	// Change ~50% of exposed to symptomatic, some of
+	// the infected start testing in the hospital
+	std::vector<Agent>& agents = abm.vector_of_agents();	
+	for (auto& agent : agents){
+		if (agent.hospital_employee() || agent.hospital_non_covid_patient()){
+			continue;
+		}
+		if (agent.exposed() && static_cast<double>(std::rand())/static_cast<double>(RAND_MAX)<0.5){
+			agent.set_exposed(false);
+			agent.set_symptomatic(true);
+		}
+		if (static_cast<double>(std::rand())/static_cast<double>(RAND_MAX)<0.25){
+			agent.set_tested(true);
+			agent.set_tested_in_hospital(true);
+			agent.set_tested_awaiting_test(true);
+			agent.set_home_isolated(true);
+			agent.set_time_of_test(0.0);
+			agent.set_hospital_ID(1);
+		}
+	}
+
+	// Serial 
+	abm.reset_contributions();
+	abm.compute_place_contributions();
+	const std::vector<Household> households = abm.get_copied_vector_of_households(); 
+	const std::vector<RetirementHome> retirement_homes = abm.get_copied_vector_of_retirement_homes();
+	const std::vector<School> schools = abm.get_copied_vector_of_schools(); 
+	const std::vector<Workplace> workplaces = abm.get_copied_vector_of_workplaces(); 
+	const std::vector<Hospital> hospitals = abm.get_copied_vector_of_hospitals();
+	const std::vector<Transit> carpools = abm.get_copied_vector_of_carpools();
+	const std::vector<Transit> public_transit = abm.get_copied_vector_of_public_transit();
+	const std::vector<Leisure> leisure_locations = abm.get_copied_vector_of_leisure_locations();
+
+	// Multithreaded, including more threads than agents 
+	for (int n_threads : {2, 3, 8, static_cast<int>(agents.size()) + 1}){
+		abm.set_parallel_contributions(n_threads);
+		abm.reset_contributions();
+		abm.compute_place_contributions();
+		if (!same_contributions<Household>(households, abm.get_vector_of_households()) 
+			|| !same_contributions<RetirementHome>(retirement_homes, abm.get_vector_of_retirement_homes())
+			|| !same_contributions<School>(schools, abm.get_vector_of_schools())
+			|| !same_contributions<Workplace>(workplaces, abm.get_vector_of_workplaces())
+			|| !same_contributions<Hospital>(hospitals, abm.get_vector_of_hospitals())
+			|| !same_contributions<Transit>(carpools, abm.get_vector_of_carpools())
+			|| !same_contributions<Transit>(public_transit, abm.get_vector_of_public_transit())
+			|| !same_contributions<Leisure>(leisure_locations, abm.get_vector_of_leisure_locations())){
+			std::cerr << "Multithreaded contributions differ from serial with " 
+					  << n_threads << " threads" << std::endl;
+			return false;
+		}
+		const std::vector<Hospital>& hospitals_par = abm.get_vector_of_hospitals();
+		for (size_t i = 0; i < hospitals.size(); ++i){
+			if (hospitals.at(i).get_n_tested() != hospitals_par.at(i).get_n_tested()){
+				std::cerr << "Wrong number of tested in a hospital with "
+						  << n_threads << " threads" << std::endl;
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
 bool check_all_places(ABM& abm, const std::vector<Agent>& agents)
 {
     // Infection parameters as loaded
@@ -543,3 +662,19 @@ void remove_agent_from_public_places(Agent& agent, std::vector<RetirementHome>&
 		hospitals.at(agent.get_hospital_ID()-1).remove_agent(agent_ID);
 	}
 }
+
+/// True if contributions and number of infected are exactly the same in both vectors
+template <typename T>
+bool same_contributions(const std::vector<T>& places_1, const std::vector<T>& places_2)
+{
+	if (places_1.size() != places_2.size()){
+		return false;
+	}
+	for (size_t i = 0; i < places_1.size(); ++i){
+		if (places_1.at(i).get_infected_contribution() != places_2.at(i).get_infected_contribution()
+			|| places_1.at(i).get_total_infected() != places_2.at(i).get_total_infected()){
+			return false;
+		}
+	}
+	return true;
+}
@@ -10,6 +10,8 @@ path = '../../src/'
 cx = 'g++'
 std = '-std=c++11'
 opt = '-O0'
+# Threading support
+thr = '-pthread'
 # Common source files
 src_files = path + 'flu.cpp'
 src_files += ' ' +path + 'testing.cpp'
@@ -27,6 +29,6 @@ tst_files = '../common/test_utils.cpp'
 exe_name = 'flu_test'
 # Files needed only for this build
 spec_files = 'flu_functionality_test.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files])
 subprocess.call([compile_com], shell=True)
 
@@ -11,12 +11,14 @@
 bool flu_generation();
 bool flu_transitions();
 bool flu_testing();
+bool flu_pools();
 
 int main()
 {
 	test_pass(flu_generation(), "Creation of flu agents");
 	test_pass(flu_transitions(), "Transitions of flu agents");
 	test_pass(flu_testing(), "Testing of flu agents");
+	test_pass(flu_pools(), "Removing and sampling agents from flu pools");
 }
 
 /// Checks if correctness of creating agents with flu
@@ -152,3 +154,61 @@ bool flu_testing()
 
 	return true;
 }
+
+/// Verifies that pools stay consistent over many removals and swaps
+bool flu_pools()
+{
+	int n_tot = 2000;
+	double fr_flu = 0.2;
+
+	Flu flu;
+	flu.set_seed(2022);
+	flu.set_fraction(fr_flu);
+	for (int i=1; i<=n_tot; ++i){
+		flu.add_susceptible_agent(i);
+	}
+	// Registering twice has no effect
+	flu.add_susceptible_agent(n_tot);
+	if (static_cast<int>(flu.get_susceptible_IDs().size()) != n_tot){
+		std::cerr << "Agent added twice to susceptible" << std::endl;
+		return false;
+	}
+	flu.generate_flu();
+
+	// Infected agents leave, flu agents recover and are replaced
+	std::vector<int> removed = {};
+	for (int i=1; i<=n_tot; i+=7){
+		flu.remove_susceptible_agent(i);
+		removed.push_back(i);
+	}
+	// Removing an agent not present has no effect
+	flu.remove_susceptible_agent(n_tot + 10);
+	flu.remove_flu_agent(n_tot + 10);
+	for (int i=0; i<500; ++i){
+		const int recovered = flu.get_flu_IDs().at(i % flu.get_flu_IDs().size());
+		if (flu.swap_flu_agent(recovered) < 0){
+			std::cerr << "No susceptible agents for swapping" << std::endl;
+			return false;
+		}
+		removed.push_back(recovered);
+	}
+
+	// Every agent is either susceptible, has flu, or was removed
+	std::vector<int> all_IDs = flu.get_susceptible_IDs();
+	const std::vector<int>& flu_IDs = flu.get_flu_IDs();
+	all_IDs.insert(all_IDs.end(), flu_IDs.begin(), flu_IDs.end());
+	std::sort(all_IDs.begin(), all_IDs.end());
+	if (std::adjacent_find(all_IDs.begin(), all_IDs.end()) != all_IDs.end()){
+		std::cerr << "Agent present more than once in the pools" << std::endl;
+		return false;
+	}
+	for (int i=1; i<=n_tot; ++i){
+		const bool in_pools = std::binary_search(all_IDs.begin(), all_IDs.end(), i);
+		const bool was_removed = (std::find(removed.begin(), removed.end(), i) != removed.end());
+		if (in_pools == was_removed){
+			std::cerr << "Agent " << i << " in the wrong pool" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
@@ -31,6 +31,7 @@ bool check_age_dependent_rates(age_rates_setter, age_rates_getter, age_rates_cal
 								std::map<std::string, std::tuple<int, int, double>>);
 bool check_exposed_never_sy(Infection&);
 bool check_non_icu_mortality(Infection&);
+bool check_age_group_limits(Infection&);
 bool check_distribution(dist_sampling, Infection&, double);
 bool check_simple_distributions(Infection&, std::vector<double>);
 bool check_random_ID(Infection&);
@@ -119,6 +120,10 @@ bool infection_transmission_test()
 		std::cerr << "Issue with non-ICU mortality" << std::endl;
 		return false;
 	}
+	if (!check_age_group_limits(infection)){
+		std::cerr << "Issue with ages on and outside age group limits" << std::endl;
+		return false;
+	}
 
 	// Check all single number distributions
 	std::vector<double> dist_probs = {0.25, 0.9, 0.05, 0.1};
@@ -482,6 +487,56 @@ bool check_non_icu_mortality(Infection& infection)
 	return true;	
 }
 
+/// Test rates on the limits of age groups, in overlapping groups, and outside all groups
+bool check_age_group_limits(Infection& infection)
+{
+	// In the overlap the group that is later in the map applies
+	std::map<std::string, double> hsp_rates = {{"0-9", 1.0}, {"5-20", 0.0}, {"21-40", 1.0}};
+	infection.set_hospitalized_fractions(hsp_rates);
+	const std::vector<int> always = {0, 4, 21, 40};
+	const std::vector<int> never = {5, 9, 20, 41, 200, -1};
+	const int n_tot = 1000;
+	for (int i=0; i<n_tot; ++i){
+		for (const auto& age : always){
+			if (!infection.agent_hospitalized(age)){
+				std::cerr << "Agent of age " << age << " should be hospitalized" << std::endl;
+				return false;
+			}
+		}
+		for (const auto& age : never){
+			if (infection.agent_hospitalized(age)){
+				std::cerr << "Agent of age " << age << " should not be hospitalized" << std::endl;
+				return false;
+			}
+		}
+	}
+
+	// Tables follow changes in other probabilities
+	std::map<std::string, double> icu_rates = {{"0-40", 0.5}};
+	std::map<std::string, double> mortality_rates = {{"0-40", 0.5}};
+	std::map<std::string, double> esy = {{"0-40", 0.0}};
+	infection.set_hospitalized_ICU_fractions(icu_rates);
+	infection.set_mortality_rates(mortality_rates);
+	infection.set_expN2sy_fractions(esy);
+	// Total 0.5, need ICU 0.5, die needing ICU 1.0 - none die outside ICU
+	infection.set_other_probabilities(0.5, 1.0, 1.0);
+	for (int i=0; i<n_tot; ++i){
+		if (infection.will_die_non_icu(30)){
+			std::cerr << "Should not die outside ICU" << std::endl;
+			return false;
+		}
+	}
+	// Nobody dies when needing ICU - all die outside  
+	infection.set_other_probabilities(0.5, 0.0, 0.0);
+	for (int i=0; i<n_tot; ++i){
+		if (!infection.will_die_non_icu(30) || !infection.will_die_non_icu(30, true)){
+			std::cerr << "Should die outside ICU" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
 /// \brief Function for checking different types of age-dependent rates
 bool check_age_dependent_rates(age_rates_setter set_rates, age_rates_getter get_rates,
 								age_rates_caller call, Infection& infection, 
@@ -47,6 +47,7 @@ bool custom_test_suite();
 bool default_test_suite();
 bool write_1D_vector_test_suite();
 bool write_object_test_suite(); 
+bool streaming_test_suite();
 
 // Files required to be present
 // ./test_data/r_bool.txt
@@ -64,6 +65,7 @@ bool write_object_test_suite();
 // ./test_data/wr_int_1D.txt
 // ./test_data/wr_string_1D.txt
 // ./test_data/wr_double_1D.txt
+// ./test_data/wr_stream.txt
 
 int main()
 {
@@ -72,6 +74,7 @@ int main()
 	test_pass(default_test_suite(), "AbmIO default properties");
 	test_pass(write_1D_vector_test_suite(), "AbmIO write and read for 1D vectors");
 	test_pass(write_object_test_suite(), "AbmIO for classes with ostream overload");
+	test_pass(streaming_test_suite(), "Streaming text reader");
 }
 
 /**
@@ -413,3 +416,64 @@ bool write_read_test(const vec1D<T> orig_vec, const AbmIO& io_obj,
 	// True if vectors are identical
 	return is_equal(orig_vec_2D, new_vec);
 }
+
+/**
+ * \brief Line by line reading with blocks shorter than the lines 
+ * \details Checks lines split across blocks, blank lines, a last line
+ *		without a newline, and invalid entries
+ */
+bool streaming_test_suite()
+{
+	const std::string fname("./test_data/wr_stream.txt");
+	vec2D<std::string> expected = {{"first", "line"}, {}, {}, {"1", "2.5", "-3e2"}};
+	std::string long_word(150, 'x');
+	expected.push_back({long_word, "end"});
+	expected.push_back({"10", "last"});
+
+	std::ofstream out(fname);
+	out << "first\tline\n\n  \t\r\n  1 2.5   -3e2\r\n" << long_word << " end\n10 last";
+	out.close();
+
+	// Block smaller than some lines 
+	vec2D<std::string> read;
+	TextReader reader(fname, 64);
+	reader.for_each_line([&read](const std::vector<TextReader::Token>& line){
+			read.emplace_back();
+			for (const auto& entry : line) {
+				read.back().push_back(entry.as<std::string>());
+			}
+		});
+	if (!is_equal_exact<std::string>(read, expected)) {
+		std::cerr << "Wrong lines read in blocks" << std::endl;
+		return false;
+	}
+
+	// Numbers, and the default block through AbmIO
+	double sum = 0.0;
+	int last = 0;
+	AbmIO io(fname, " ", true, {0,0,0});
+	io.for_each_line([&](const std::vector<TextReader::Token>& line){
+			if (line.size() == 3) {
+				for (const auto& entry : line) {
+					sum += entry.as<double>();
+				}
+			}
+			if (!line.empty() && line.front() == "10") {
+				last = line.front().as<int>();
+			}
+		});
+	if (!float_equality<double>(sum, -296.5, 1e-10) || last != 10) {
+		std::cerr << "Wrong numbers read" << std::endl;
+		return false;
+	}
+
+	// Not a number
+	bool verbose = true;
+	const std::invalid_argument inv_arg("Not a number");
+	if (!exception_test(verbose, &inv_arg, [&io](){ io.read_vector<int>(); })) {
+		std::cerr << "Reading words as numbers should throw" << std::endl;
+		return false;
+	}
+
+	return true;
+}
@@ -7,6 +7,8 @@ path = '../../src/'
 cx = 'g++'
 std = '-std=c++11'
 opt = '-O0'
+# Threading support
+thr = '-pthread'
 # Common source files
 src_files = path + 'io_operations/FileHandler.cpp'
 src_files += ' ' + path + 'utils.cpp'
@@ -23,13 +25,13 @@ if os.path.exists(f_app):
 exe_name = 'file_hdl_tests'
 # Files needed only for this build
 spec_files = 'file_handler_tests.cpp'
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, src_files, test_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files, test_files])
 subprocess.call([compile_com], shell=True)
 
 # abm_io.h tests
 # Remove these files if exist
 f_path = './test_data/'
-files_rm = ['wr_bool.txt', 'wr_int.txt', 'wr_string.txt', 'wr_double.txt', 'wr_bool_1D.txt', 'wr_int_1D.txt', 'wr_string_1D.txt', 'wr_double_1D.txt']
+files_rm = ['wr_bool.txt', 'wr_int.txt', 'wr_string.txt', 'wr_double.txt', 'wr_bool_1D.txt', 'wr_int_1D.txt', 'wr_string_1D.txt', 'wr_double_1D.txt', 'wr_stream.txt']
 files_rm = [f_path + x for x in files_rm]
 files_rm.append('./dflt_abm_io_file.txt')
 for frm in files_rm:
@@ -39,7 +41,7 @@ for frm in files_rm:
 exe_name = 'abm_io_tests'
 # Files needed only for this build
 spec_files = 'abm_io_tests.cpp'
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, src_files, spec_files, test_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, src_files, spec_files, test_files])
 subprocess.call([compile_com], shell=True)
 
 # utils.h tests
@@ -47,7 +49,7 @@ subprocess.call([compile_com], shell=True)
 exe_name = 'utils_tests'
 # Files needed only for this build
 spec_files = 'utils_tests.cpp'
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, src_files, spec_files, test_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, src_files, spec_files, test_files])
 subprocess.call([compile_com], shell=True)
 
 # load_parameters.h tests 
@@ -55,5 +57,5 @@ subprocess.call([compile_com], shell=True)
 exe_name = 'ld_params_tests'
 # Files needed only for this build
 spec_files = 'load_parameters_tests.cpp'
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, src_files, test_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, src_files, test_files])
 subprocess.call([compile_com], shell=True)
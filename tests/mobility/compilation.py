@@ -10,6 +10,8 @@ path = '../../src/'
 cx = 'g++'
 std = '-std=c++11'
 opt = '-O0'
+# Threading support
+thr = '-pthread'
 # Common source files
 src_files = path + 'mobility.cpp'
 src_files += ' ' + path + 'infection.cpp'
@@ -37,5 +39,5 @@ data_dir = './test_data/'
 exe_name = 'mb_tests'
 # Files needed only for this build
 spec_files = 'mobility_tests.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files])
 subprocess.call([compile_com], shell=True)
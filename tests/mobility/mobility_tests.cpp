@@ -12,6 +12,8 @@ bool distance_computation_test();
 bool constructing_probabilities_test();
 bool constructing_probabilities_default_test();
 bool assigning_locations_test();
+bool truncated_probabilities_test();
+bool multithreaded_probabilities_test();
 
 int main()
 {
@@ -19,6 +21,8 @@ int main()
 	test_pass(constructing_probabilities_test(), "Constructing probabilities");
 	test_pass(constructing_probabilities_default_test(), "Constructing probabilities - default settings");
 	test_pass(assigning_locations_test(), "Assigning locations");
+	test_pass(truncated_probabilities_test(), "Truncated probability tables");
+	test_pass(multithreaded_probabilities_test(), "Constructing probabilities - multiple threads");
 }
 
 bool distance_computation_test()
@@ -216,3 +220,193 @@ bool assigning_locations_test()
 	}
 	return true;
 }
+
+bool truncated_probabilities_test()
+{
+	double tol = 1e-5;
+	int n_households = 4, n_leisure = 3; 
+	double dr0 = 1.5, beta = 0.001, kappa = 400.0;
+	// In lats and lons first n_households refer to households
+	std::vector<double> lats = {80.0280, 14.1886, 42.1761, 91.5736, 79.2207, 95.9492, 65.5741};
+	std::vector<double> lons = {5.3568, 127.3694, 140.0990, 101.8103, 113.6610, 111.4699, 58.8341};
+	std::vector<Household> households;
+	std::vector<Leisure> leisure_locations;
+	for (int i=0; i<n_households; ++i) {
+		households.push_back(Household(i+1, lats.at(i), lons.at(i), 0.7, 2.0, 0.5, 0.8));		
+	}
+	int ind  = 0;
+	for (int i=n_households; i<n_households + n_leisure; ++i) {
+		leisure_locations.push_back(Leisure(++ind, lats.at(i), lons.at(i), 0.7, 2.0, "Zoo"));		
+	}
+
+	// Reference - no truncation
+	Mobility full;
+	full.set_probability_parameters(dr0, beta, kappa);
+	full.construct_public_probabilities(households, leisure_locations);
+	const std::vector<std::vector<double>> full_probs = full.get_public_probabilities();
+	if (full.get_number_of_stored_probabilities() != static_cast<size_t>(n_households*n_leisure)) {
+		std::cerr << "Locations dropped without truncation" << std::endl;
+		return false;
+	}
+	if (!float_equality<double>(full.get_max_truncation_error(), 0.0, tol)) {
+		std::cerr << "Nonzero truncation error without truncation" << std::endl;
+		return false;
+	}
+
+	// Invalid tail
+	Mobility mobility;
+	const bool verbose = false;
+	const std::invalid_argument invarg("");
+	if (!exception_test(verbose, &invarg, &Mobility::set_truncation_tail, mobility, 1.0)) {
+		std::cerr << "Tail of 1.0 accepted" << std::endl;
+		return false;
+	}
+	if (!exception_test(verbose, &invarg, &Mobility::set_truncation_tail, mobility, -0.1)) {
+		std::cerr << "Negative tail accepted" << std::endl;
+		return false;
+	}
+
+	// Drop up to 40% of the mass 
+	const double tail = 0.4;
+	mobility.set_probability_parameters(dr0, beta, kappa);
+	mobility.set_truncation_tail(tail);
+	mobility.construct_public_probabilities(households, leisure_locations);
+	const std::vector<std::vector<double>> probs = mobility.get_public_probabilities();
+	if (mobility.get_number_of_stored_probabilities() >= static_cast<size_t>(n_households*n_leisure)) {
+		std::cerr << "No locations dropped with truncation" << std::endl;
+		return false;
+	}
+	if ((mobility.get_max_truncation_error() > tail) 
+			|| (mobility.get_mean_truncation_error() > mobility.get_max_truncation_error())) {
+		std::cerr << "Wrong truncation error" << std::endl;
+		return false;
+	}
+
+	// Dropped mass per household and renormalized CDF
+	double max_error = 0.0, total_error = 0.0;
+	for (int ih=0; ih<n_households; ++ih) {
+		double dropped = 0.0, prev_full = 0.0, prev = 0.0;
+		std::vector<double> kept;
+		for (int il=0; il<n_leisure; ++il) {
+			const double p_full = full_probs.at(ih).at(il) - prev_full;
+			const double p = probs.at(ih).at(il) - prev;
+			prev_full = full_probs.at(ih).at(il);
+			prev = probs.at(ih).at(il);
+			if (float_equality<double>(p, 0.0, 1e-12)) {
+				dropped += p_full;
+			} else {
+				kept.push_back(p/p_full);
+			}
+		}
+		if (kept.empty() || dropped > tail + tol) {
+			std::cerr << "Wrong locations dropped for household " << ih+1 << std::endl;
+			return false;
+		}
+		// All kept probabilities scaled by the same factor
+		for (const auto& k : kept) {
+			if (!float_equality<double>(k, 1.0/(1.0 - dropped), tol)) {
+				std::cerr << "Kept probabilities not renormalized" << std::endl;
+				return false;
+			}
+		}
+		if (!float_equality<double>(probs.at(ih).back(), 1.0, tol)) {
+			std::cerr << "CDF does not end with 1.0" << std::endl;
+			return false;
+		}
+		max_error = std::max(max_error, dropped);
+		total_error += dropped;
+	}
+	if (!float_equality<double>(max_error, mobility.get_max_truncation_error(), tol)
+			|| !float_equality<double>(total_error/n_households, mobility.get_mean_truncation_error(), tol)) {
+		std::cerr << "Reported truncation error not equal the dropped mass" << std::endl;
+		return false;
+	}
+
+	// Dropped locations are never assigned
+	Infection infection;
+	int picked_ID = 0, house_ID = 0;
+  	bool is_public = false;
+	bool is_household = false;
+	for (int i=0; i<100000; ++i) {
+		house_ID = infection.get_random_household_ID(households.size());
+		picked_ID = mobility.assign_leisure_location(infection, house_ID, is_household, is_public);	
+		if (!is_public) {
+			continue;
+		}
+		if ((picked_ID < 1) || (picked_ID > n_leisure)) {
+			std::cerr << "Assigned ID is not valid" << std::endl;
+			return false;
+		}
+		const std::vector<double>& cdf = probs.at(house_ID-1);
+		const double p = cdf.at(picked_ID-1) - ((picked_ID > 1) ? cdf.at(picked_ID-2) : 0.0);
+		if (float_equality<double>(p, 0.0, 1e-12)) {
+			std::cerr << "Dropped location assigned" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool multithreaded_probabilities_test()
+{
+	double tol = 1e-10;
+	int n_households = 101, n_leisure = 37; 
+	double dr0 = 1.5, beta = 1.75, kappa = 400.0;
+
+	// Locations around a town and some far away
+	std::vector<Household> households;
+	std::vector<Leisure> leisure_locations;
+	for (int i=0; i<n_households; ++i) {
+		households.push_back(Household(i+1, 42.6 + 0.001*(i%17)*(i%5), 
+							-73.8 + 0.002*(i%13), 0.7, 2.0, 0.5, 0.8));		
+	}
+	for (int i=0; i<n_leisure; ++i) {
+		const double shift = (i%9 == 0) ? 20.0 : 0.0;
+		leisure_locations.push_back(Leisure(i+1, 42.6 + 0.003*(i%11) - shift, 
+							-73.8 + 0.001*(i%7) + shift, 0.7, 2.0, "Spomenik"));		
+	}
+
+	// Expected - distances and probabilities of each pair
+	Mobility mobility;
+	std::vector<std::vector<double>> exp_probs;
+	for (const auto& house : households) {
+		std::vector<double> probs = {};
+		for (const auto& leisure : leisure_locations) {
+			const double dij = mobility.compute_distance(house, leisure);
+			probs.push_back(std::pow(dij + dr0, -beta)*std::exp(-dij/kappa));
+		}
+		std::partial_sum(probs.begin(), probs.end(), probs.begin());
+		const double max_p = probs.back();
+		std::for_each(probs.begin(), probs.end(), [&max_p](double &x) { x /= max_p; });
+		exp_probs.push_back(probs);
+	}
+
+	for (int n_threads : {1, 2, 5}) {
+		Mobility threaded;
+		threaded.set_probability_parameters(dr0, beta, kappa);
+		threaded.set_number_of_threads(n_threads);
+		threaded.construct_public_probabilities(households, leisure_locations);
+		if (!is_equal_floats<double>(threaded.get_public_probabilities(), exp_probs, tol)) {
+			std::cerr << "Computed probabilities not equal expected with " 
+					  << n_threads << " threads" << std::endl;
+			return false;
+		}
+	}
+
+	// Tables and truncation errors independent of the number of threads
+	Mobility serial, threaded;
+	for (Mobility* mb : {&serial, &threaded}) {
+		mb->set_probability_parameters(dr0, beta, kappa);
+		mb->set_truncation_tail(0.05);
+	}
+	threaded.set_number_of_threads(4);
+	serial.construct_public_probabilities(households, leisure_locations);
+	threaded.construct_public_probabilities(households, leisure_locations);
+	if ((serial.get_public_probabilities() != threaded.get_public_probabilities())
+			|| (serial.get_max_truncation_error() != threaded.get_max_truncation_error())
+			|| (serial.get_mean_truncation_error() != threaded.get_mean_truncation_error())) {
+		std::cerr << "Truncated tables depend on the number of threads" << std::endl;
+		return false;
+	}
+	return true;
+}
@@ -10,6 +10,8 @@ path = '../../src/'
 cx = 'g++'
 std = '-std=c++11'
 opt = '-O0'
+# Threading support
+thr = '-pthread'
 # Common source files
 src_files = path + 'places/place.cpp' 
 src_files += ' ' + path + 'places/household.cpp'
@@ -33,7 +35,7 @@ tst_files = '../common/test_utils.cpp'
 exe_name = 'places_test'
 # Files needed only for this build
 spec_files = 'places_test.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files, src_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files, src_files])
 subprocess.call([compile_com], shell=True)
 
 
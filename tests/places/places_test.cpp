@@ -17,6 +17,8 @@ bool hospital_test();
 bool transit_test();
 bool leisure_test();
 bool school_and_workplace_transmission_changes();
+bool place_members_test();
+bool place_members_in_store_test();
 
 // Tests for contributions
 bool contribution_test_hospitals();
@@ -65,6 +67,9 @@ int main()
 
 	test_pass(leisure_test(), "Leisure class functionality");
 	test_pass(contribution_test_leisure(), "Contribution test for leisure");
+
+	test_pass(place_members_test(), "Adding and removing agents registered in a place");
+	test_pass(place_members_in_store_test(), "Slots of agents in a place kept in the agent store");
 }
 
 /// Tests all public functions from the Place class  
@@ -979,3 +984,158 @@ bool school_and_workplace_transmission_changes()
 }
 
 
+
+/// Order, size, and repeated entries after many additions and removals
+bool place_members_test()
+{
+	Place place(1, 0.0, 0.0, 1.0, 1.0);
+	std::vector<int> expected;
+	for (int i = 1; i <= 100; ++i){
+		place.add_agent(i);
+		expected.push_back(i);
+	}
+
+	// Every third, order of remaining stays the same
+	for (int i = 3; i <= 100; i += 3){
+		place.remove_agent(i);
+		expected.erase(std::find(expected.begin(), expected.end(), i));
+	}
+	if (place.get_agent_IDs() != expected 
+			|| place.get_number_of_agents() != static_cast<int>(expected.size())){
+		std::cerr << "Error removing every third agent" << std::endl;
+		return false;
+	}
+
+	// Removed agent added back is last
+	place.add_agent(3);
+	expected.push_back(3);
+	// Remove more than half, not present
+	for (int i = 1; i <= 80; ++i){
+		if (i % 3 == 0 && i != 3){
+			continue;
+		}
+		place.remove_agent(i);
+		expected.erase(std::find(expected.begin(), expected.end(), i));
+	}
+	place.remove_agent(1000);
+	if (place.get_agent_IDs() != expected 
+			|| place.get_number_of_agents() != static_cast<int>(expected.size())){
+		std::cerr << "Error removing most of the agents" << std::endl;
+		return false;
+	}
+
+	// Agent registered twice is removed completely
+	place.add_agent(82);
+	place.remove_agent(82);
+	expected.erase(std::find(expected.begin(), expected.end(), 82));
+	place.remove_agent(85);
+	expected.erase(std::find(expected.begin(), expected.end(), 85));
+	if (place.get_agent_IDs() != expected 
+			|| place.get_number_of_agents() != static_cast<int>(expected.size())){
+		std::cerr << "Error removing an agent registered twice" << std::endl;
+		return false;
+	}
+
+	// Changes are not counted unless a phase is recorded
+	const PlaceMembers::Changes before = PlaceMembers::thread_changes();
+	place.add_agent(2000);
+	place.remove_agent(2000);
+	if (PlaceMembers::thread_changes().inserts != before.inserts 
+			|| PlaceMembers::thread_changes().removes != before.removes){
+		std::cerr << "Membership changes counted without recording" << std::endl;
+		return false;
+	}
+
+	// Changes are counted per thread, including removals of absent agents
+	++PlaceMembers::recording();
+	place.add_agent(2000);
+	place.remove_agent(2000);
+	place.remove_agent(2000);
+	--PlaceMembers::recording();
+	const PlaceMembers::Changes& after = PlaceMembers::thread_changes();
+	if (after.inserts - before.inserts != 1 || after.removes - before.removes != 2){
+		std::cerr << "Wrong count of membership changes" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/// Slots in the store follow additions, removals, and compaction
+bool place_members_in_store_test()
+{
+	// Agents 1-100 work in place 1, 150 visits it, 160 is not linked
+	const int n_agents = 200;
+	AgentStore store;
+	store.resize(n_agents);
+	for (int i = 0; i < n_agents; ++i){
+		AgentStore::Row row = store.row(i);
+		row.set_ID(AgentStore::agent, i + 1);
+		row.set_ID(AgentStore::work, i < 100 ? 1 : 2);
+	}
+	store.row(149).set_ID(AgentStore::leisure, 1);
+	const AgentStore::Columns& cols = *store.place_links();
+	const std::vector<int>& work_slots = cols.slots[AgentStore::work];
+	const std::vector<int>& leisure_slots = cols.slots[AgentStore::leisure];
+
+	Place place(1, 0.0, 0.0, 1.0, 1.0);
+	place.link_to_store(store, (1u << AgentStore::work) | (1u << AgentStore::leisure));
+	std::vector<int> expected;
+	for (int i = 1; i <= 100; ++i){
+		place.add_agent(i);
+		expected.push_back(i);
+	}
+	place.add_agent(150);
+	expected.push_back(150);
+	place.add_agent(160);
+	expected.push_back(160);
+	if (work_slots.at(49) != 49 || leisure_slots.at(149) != 100 || work_slots.at(149) != -1
+			|| work_slots.at(159) != 101){
+		std::cerr << "Wrong slots of added agents" << std::endl;
+		return false;
+	}
+
+	// Copy is not bound, removal from it does not change the slots
+	Place copy(place);
+	copy.remove_agent(50);
+	if (work_slots.at(49) != 49 || place.get_agent_IDs() != expected){
+		std::cerr << "Copy of a place changed the slots in the store" << std::endl;
+		return false;
+	}
+
+	// Removal of the slot and of more than half of the agents
+	place.remove_agent(150);
+	expected.erase(std::find(expected.begin(), expected.end(), 150));
+	if (leisure_slots.at(149) != -1){
+		std::cerr << "Slot of a removed agent not cleared" << std::endl;
+		return false;
+	}
+	// Compacted at the last one, slots are positions in the list
+	for (int i = 1; i <= 51; ++i){
+		place.remove_agent(i);
+		expected.erase(std::find(expected.begin(), expected.end(), i));
+	}
+	const std::vector<int> IDs = place.get_agent_IDs();
+	if (IDs != expected){
+		std::cerr << "Wrong agents after removals" << std::endl;
+		return false;
+	}
+	for (size_t i = 0; i < IDs.size(); ++i){
+		if (work_slots.at(IDs.at(i) - 1) != static_cast<int>(i)){
+			std::cerr << "Slot of agent " << IDs.at(i) << " not updated after compaction" << std::endl;
+			return false;
+		}
+	}
+
+	// Agent with a slot in another place of the same role is still removed
+	store.row(79).set_ID(AgentStore::work, 2);
+	Place other(2, 0.0, 0.0, 1.0, 1.0);
+	other.link_to_store(store, 1u << AgentStore::work);
+	other.add_agent(80);
+	place.remove_agent(80);
+	expected.erase(std::find(expected.begin(), expected.end(), 80));
+	if (place.get_agent_IDs() != expected || other.get_agent_IDs() != std::vector<int>{80}){
+		std::cerr << "Error removing an agent whose slot is in another place" << std::endl;
+		return false;
+	}
+	return true;
+}
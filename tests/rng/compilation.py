@@ -8,6 +8,8 @@ import subprocess, glob, os
 cx = 'g++'
 std = '-std=c++11'
 opt = '-O0'
+# Threading support
+thr = '-pthread'
 tst_files = '../common/test_utils.cpp'
 
 #
@@ -20,7 +22,7 @@ tst_files = '../common/test_utils.cpp'
 exe_name = 'rng_test'
 # Files needed only for this build
 spec_files = 'rng_tests.cpp '
-compile_com = ' '.join([cx, std, opt, '-o', exe_name, spec_files, tst_files])
+compile_com = ' '.join([cx, std, opt, thr, '-o', exe_name, spec_files, tst_files])
 subprocess.call([compile_com], shell=True)
 
 
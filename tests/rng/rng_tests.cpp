@@ -15,6 +15,10 @@ bool gamma_test(double, double, double);
 bool lognormal_test(double, double, double);
 bool weibull_test(double, double, double);
 bool random_shuffle_test();
+bool philox_known_answer_test();
+bool seeded_reproducibility_test();
+bool keyed_stream_test();
+bool draw_count_test();
 
 int main()
 {
@@ -28,6 +32,10 @@ int main()
 	test_pass(lognormal_test(logn_meanx, logn_stx, logn_mean), "Lognormal distribution");
 	test_pass(weibull_test(wb_shape, wb_scale, wb_mean), "Weibull distribution");
 	test_pass(random_shuffle_test(), "Random shuffling");
+	test_pass(philox_known_answer_test(), "Philox known answers");
+	test_pass(seeded_reproducibility_test(), "Reproducibility with a seed");
+	test_pass(keyed_stream_test(), "Streams by agent, step, and purpose");
+	test_pass(draw_count_test(), "Counting numbers drawn");
 }
 
 /// Test if the uniform distribution generation is correct
@@ -165,3 +173,151 @@ bool random_shuffle_test()
 	rng.vector_shuffle(v2s);
 	return !(v2s == v_orig);
 }
+
+/// Philox4x32-10 blocks compared to the reference known answer vectors 
+bool philox_known_answer_test()
+{
+	const std::vector<Philox4x32::counter_type> counters = 
+		{ {{0, 0, 0, 0}}, {{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+		  {{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}} };
+	const std::vector<Philox4x32::key_type> keys = 
+		{ {{0, 0}}, {{0xffffffff, 0xffffffff}}, {{0xa4093822, 0x299f31d0}} };
+	const std::vector<Philox4x32::counter_type> expected = 
+		{ {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}},
+		  {{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}},
+		  {{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}} };
+
+	for (size_t i = 0; i < counters.size(); ++i){
+		if (Philox4x32::block(counters.at(i), keys.at(i)) != expected.at(i)){
+			std::cout << "Wrong output for known answer vector " << i << std::endl;
+			return false;
+		}
+	}
+
+	// Generator from a seed starts with the block of counter 0
+	Philox4x32 gen(0xffffffffffffffff);
+	Philox4x32::counter_type first_block = 
+		Philox4x32::block({{0, 0, 0, 0}}, {{0xffffffff, 0xffffffff}});
+	for (const auto& val : first_block){
+		if (gen() != val){
+			return false;
+		}
+	}
+	return true;
+}
+
+/// Generators with the same seed need to give the same numbers
+bool seeded_reproducibility_test()
+{
+	RNG rng_1(2021), rng_2(2021), rng_3(2022);
+	// Seed set after construction equivalent to the constructor
+	RNG rng_4;
+	rng_4.set_seed(2021);
+
+	std::vector<int> v_1 = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+	std::vector<int> v_2(v_1), v_4(v_1);
+	bool differ = false;
+	for (int i=0; i<1000; ++i){
+		const double x_1 = rng_1.get_random(0.0, 1.0);
+		const double x_3 = rng_3.get_random(0.0, 1.0);
+		if (x_1 != rng_2.get_random(0.0, 1.0) || x_1 != rng_4.get_random(0.0, 1.0)){
+			return false;
+		}
+		differ = differ || (x_1 != x_3);
+
+		const int n_1 = rng_1.get_random_int(0, 100);
+		const double g_1 = rng_1.get_random_gamma(0.7696, 3.4192);
+		const double l_1 = rng_1.get_random_lognormal(2.6696, 0.4760);
+		const double w_1 = rng_1.get_random_weibull(1.6726, 10.1237);
+		if (n_1 != rng_2.get_random_int(0, 100) 
+				|| g_1 != rng_2.get_random_gamma(0.7696, 3.4192)
+				|| l_1 != rng_2.get_random_lognormal(2.6696, 0.4760)
+				|| w_1 != rng_2.get_random_weibull(1.6726, 10.1237)){
+			return false;
+		}
+		rng_4.get_random_int(0, 100);
+		rng_4.get_random_gamma(0.7696, 3.4192);
+		rng_4.get_random_lognormal(2.6696, 0.4760);
+		rng_4.get_random_weibull(1.6726, 10.1237);
+
+		rng_1.vector_shuffle(v_1);
+		rng_2.vector_shuffle(v_2);
+		rng_4.vector_shuffle(v_4);
+		if (v_1 != v_2 || v_1 != v_4){
+			return false;
+		}
+	}
+	// Different seeds should give different numbers
+	if (!differ){
+		std::cout << "Different seeds give the same numbers" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/** 
+ * \brief Numbers of a stream depend only on the seed, agent, step, and purpose 
+ * \details Checks that the stream does not depend on numbers drawn 
+ *		before it and that streams of different keys differ
+ */
+bool keyed_stream_test()
+{
+	const int n_draws = 100;
+	RNG rng_1(7), rng_2(7);
+	
+	// Draws from rng_1 before switching to the stream
+	for (int i=0; i<357; ++i){
+		rng_1.get_random_gamma(0.7696, 3.4192);
+	}
+	rng_1.set_stream(42, 10, RNG::transitions);
+	rng_2.set_stream(42, 10, RNG::transitions);
+	std::vector<double> ref;
+	for (int i=0; i<n_draws; ++i){
+		const double x = rng_1.get_random(0.0, 1.0);
+		if (x != rng_2.get_random(0.0, 1.0)){
+			return false;
+		}
+		ref.push_back(x);
+	}
+
+	// Any other agent, step, purpose, or seed gives a different stream
+	std::vector<RNG> others(4, RNG(7));
+	others.at(0).set_stream(43, 10, RNG::transitions);
+	others.at(1).set_stream(42, 11, RNG::transitions);
+	others.at(2).set_stream(42, 10, RNG::flu);
+	others.at(3).set_seed(8);
+	others.at(3).set_stream(42, 10, RNG::transitions);
+	for (auto& other : others){
+		std::vector<double> vals;
+		for (int i=0; i<n_draws; ++i){
+			vals.push_back(other.get_random(0.0, 1.0));
+		}
+		if (vals == ref){
+			std::cout << "Streams with different keys are the same" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+/// Every sample and every shuffled element is counted, copies continue the count
+bool draw_count_test()
+{
+	RNG rng(11);
+	rng.get_random(0.0, 1.0);
+	rng.get_random_int(0, 5);
+	rng.get_random_gamma(1.0, 2.0);
+	rng.get_random_lognormal(1.0, 0.5);
+	rng.get_random_weibull(1.0, 2.0);
+	std::vector<int> v = {1, 2, 3, 4, 5, 6};
+	rng.vector_shuffle(v);
+	if (rng.get_draws() != 11){
+		std::cout << "Wrong number of draws " << rng.get_draws() << std::endl;
+		return false;
+	}
+	// Streams and seeds do not reset the count
+	RNG copy(rng);
+	copy.set_stream(3, 4, RNG::flu);
+	copy.get_random(0.0, 1.0);
+	return copy.get_draws() == 12;
+}
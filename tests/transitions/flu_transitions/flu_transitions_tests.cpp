@@ -49,6 +49,7 @@ bool test_susceptible_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+    const InfectionParameters& parameters = abm.get_infection_params();
     std::vector<int> state_changes(4,0);
 
 	FluTransitions flu_tr;
@@ -103,7 +104,7 @@ bool test_susceptible_transitions()
 				state_changes = flu_tr.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, retirement_homes,
 				   	carpools, public_transit, leisure_locations,	
-					infection_parameters, agents, flu, testing, dt);
+					parameters, agents, flu, testing, dt);
 			}
 			if (state_changes.at(0) == 0){
 				// Testing flags
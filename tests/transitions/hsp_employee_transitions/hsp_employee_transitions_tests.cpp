@@ -73,6 +73,7 @@ bool test_susceptible_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+    const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object();
 
 	HspEmployeeTransitions hsp_em;
@@ -101,7 +102,7 @@ bool test_susceptible_transitions()
 			if (agent.infected() == false){
 				got_infected = hsp_em.susceptible_transitions(agent, time, infection,
 					households, schools, hospitals, carpools, public_transit, 
-					leisure_locations, infection_parameters, agents, testing);
+					leisure_locations, parameters, agents, testing);
 				if (got_infected == 0){
 					continue;
 				}
@@ -219,6 +220,7 @@ bool test_exposed_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+    const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object(); 
 
 	HspEmployeeTransitions hsp_em;
@@ -253,11 +255,11 @@ bool test_exposed_transitions()
 			if (agent.infected() == false){
 				got_infected = hsp_em.susceptible_transitions(agent, time, infection,
 					households, schools, hospitals, carpools, public_transit, 
-					leisure_locations, infection_parameters, agents, testing);
+					leisure_locations, parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_em.exposed_transitions(agent, infection, time, dt, 
 					households, schools, hospitals, carpools, public_transit,
-					infection_parameters, testing);
+					parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households, schools, 
@@ -383,6 +385,7 @@ bool test_symptomatic_transitions()
 
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object();
 
 	HspEmployeeTransitions hsp_em;
@@ -416,14 +419,14 @@ bool test_symptomatic_transitions()
 			if (agent.infected() == false){
 				got_infected = hsp_em.susceptible_transitions(agent, time, infection,
 					households, schools, hospitals, carpools, public_transit, 
-				   	leisure_locations, infection_parameters, agents, testing);
+				   	leisure_locations, parameters, agents, testing);
 			} else if (agent.exposed() == true){
 				state_changes = hsp_em.exposed_transitions(agent, infection, time, dt, 
 					households, schools, hospitals, carpools, public_transit,
-					infection_parameters, testing);
+					parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = hsp_em.symptomatic_transitions(agent, time, dt, infection,  
-					households, schools, hospitals, carpools, public_transit, infection_parameters);
+					households, schools, hospitals, carpools, public_transit, parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, schools, hospitals, 
 							carpools, public_transit, state_changes, n_sy_recovering, n_sy_dying, time, dt)){
@@ -491,6 +494,7 @@ bool test_exposed_transitions_seeded()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+    const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object(); 
 
 	HspEmployeeTransitions hsp_em;
@@ -525,11 +529,11 @@ bool test_exposed_transitions_seeded()
 			if (agent.infected() == false){
 				got_infected = hsp_em.susceptible_transitions(agent, time, infection,
 					households, schools, hospitals, carpools, public_transit, 
-					leisure_locations, infection_parameters, agents, testing);
+					leisure_locations, parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_em.exposed_transitions(agent, infection, time, dt, 
 					households, schools, hospitals, carpools, public_transit,
-					infection_parameters, testing);
+					parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households, schools, 
@@ -657,6 +661,7 @@ bool test_symptomatic_transitions_seeded()
 
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object();
 
 	HspEmployeeTransitions hsp_em;
@@ -690,14 +695,14 @@ bool test_symptomatic_transitions_seeded()
 			if (agent.infected() == false){
 				got_infected = hsp_em.susceptible_transitions(agent, time, infection,
 					households, schools, hospitals, carpools, public_transit, 
-				   	leisure_locations, infection_parameters, agents, testing);
+				   	leisure_locations, parameters, agents, testing);
 			} else if (agent.exposed() == true){
 				state_changes = hsp_em.exposed_transitions(agent, infection, time, dt, 
 					households, schools, hospitals, carpools, public_transit,
-					infection_parameters, testing);
+					parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = hsp_em.symptomatic_transitions(agent, time, dt, infection,  
-					households, schools, hospitals, carpools, public_transit, infection_parameters);
+					households, schools, hospitals, carpools, public_transit, parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, schools, hospitals, 
 							carpools, public_transit, state_changes, n_sy_recovering, n_sy_dying, time, dt)){
@@ -60,6 +60,7 @@ bool test_susceptible_transitions()
 	std::vector<RetirementHome>& retirement_homes = abm.vector_of_retirement_homes();
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+    const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object();
 
 	HspPatientTransitions hsp_pt;
@@ -85,7 +86,7 @@ bool test_susceptible_transitions()
 			}
 			if (agent.infected() == false){
 				got_infected = hsp_pt.susceptible_transitions(agent, time, infection,
-					hospitals, infection_parameters, agents, testing);
+					hospitals, parameters, agents, testing);
 				if (got_infected == 0){
 					continue;
 				}
@@ -199,6 +200,7 @@ bool test_exposed_transitions()
 	std::vector<RetirementHome>& retirement_homes = abm.vector_of_retirement_homes();
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+    const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object(); 
 
 	HspPatientTransitions hsp_pt;
@@ -227,10 +229,10 @@ bool test_exposed_transitions()
 			}
 			if (agent.infected() == false){
 				got_infected = hsp_pt.susceptible_transitions(agent, time, infection,
-					hospitals, infection_parameters, agents, testing);
+					hospitals, parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_pt.exposed_transitions(agent, infection, time, dt, 
-					households, hospitals, infection_parameters, testing);
+					households, hospitals, parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households,  
@@ -346,6 +348,7 @@ bool test_symptomatic_transitions()
 	std::vector<RetirementHome>& retirement_homes = abm.vector_of_retirement_homes();
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object();
 
 	HspPatientTransitions hsp_pt;
@@ -372,13 +375,13 @@ bool test_symptomatic_transitions()
 			}
 			if (agent.infected() == false){
 				got_infected = hsp_pt.susceptible_transitions(agent, time, infection,
-					hospitals, infection_parameters, agents, testing);
+					hospitals, parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_pt.exposed_transitions(agent, infection, time, dt, 
-					households, hospitals, infection_parameters, testing);
+					households, hospitals, parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = hsp_pt.symptomatic_transitions(agent, time, dt, infection,  
-					households, hospitals, infection_parameters);
+					households, hospitals, parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, hospitals, 
 							state_changes, n_sy_recovering, n_sy_dying, time, dt)){
@@ -441,6 +444,7 @@ bool test_exposed_transitions_seeded()
 	std::vector<RetirementHome>& retirement_homes = abm.vector_of_retirement_homes();
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+    const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object(); 
 
 	HspPatientTransitions hsp_pt;
@@ -469,10 +473,10 @@ bool test_exposed_transitions_seeded()
 			}
 			if (agent.infected() == false){
 				got_infected = hsp_pt.susceptible_transitions(agent, time, infection,
-					hospitals, infection_parameters, agents, testing);
+					hospitals, parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_pt.exposed_transitions(agent, infection, time, dt, 
-					households, hospitals, infection_parameters, testing);
+					households, hospitals, parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households,  
@@ -590,6 +594,7 @@ bool test_symptomatic_transitions_seeded()
 	std::vector<RetirementHome>& retirement_homes = abm.vector_of_retirement_homes();
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object();
 
 	HspPatientTransitions hsp_pt;
@@ -616,13 +621,13 @@ bool test_symptomatic_transitions_seeded()
 			}
 			if (agent.infected() == false){
 				got_infected = hsp_pt.susceptible_transitions(agent, time, infection,
-					hospitals, infection_parameters, agents, testing);
+					hospitals, parameters, agents, testing);
 			}else if (agent.exposed() == true){
 				state_changes = hsp_pt.exposed_transitions(agent, infection, time, dt, 
-					households, hospitals, infection_parameters, testing);
+					households, hospitals, parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = hsp_pt.symptomatic_transitions(agent, time, dt, infection,  
-					households, hospitals, infection_parameters);
+					households, hospitals, parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, hospitals, 
 							state_changes, n_sy_recovering, n_sy_dying, time, dt)){
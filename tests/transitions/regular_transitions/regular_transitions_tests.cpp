@@ -82,6 +82,7 @@ bool test_susceptible_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+    const InfectionParameters& parameters = abm.get_infection_params();
 	Flu& flu = abm.get_flu_object();
 	Testing testing = abm.get_testing_object();
 
@@ -115,7 +116,7 @@ bool test_susceptible_transitions()
 				got_infected = regular.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, 
 					retirement_homes, carpools, public_transit, leisure_locations, 
-					infection_parameters, agents, flu, testing);
+					parameters, agents, flu, testing);
 				if (got_infected == 0){
 					continue;
 				}
@@ -249,6 +250,7 @@ bool test_exposed_transitions()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+    const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object();
 	Flu flu = abm.get_flu_object();
 
@@ -287,11 +289,11 @@ bool test_exposed_transitions()
 				got_infected = regular.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, 
 					retirement_homes, carpools, public_transit, leisure_locations,
-					infection_parameters, agents, flu, testing);
+					parameters, agents, flu, testing);
 			} else if (agent.exposed() == true){
 				state_changes = regular.exposed_transitions(agent, infection, time, dt, 
 					households, schools, workplaces, hospitals, retirement_homes,
-					carpools, public_transit, infection_parameters, testing);
+					carpools, public_transit, parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households, schools, 
@@ -416,6 +418,7 @@ bool test_symptomatic_transitions()
 
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& parameters = abm.get_infection_params();
 	Flu& flu = abm.get_flu_object();
 	Testing testing = abm.get_testing_object();
 
@@ -455,15 +458,15 @@ bool test_symptomatic_transitions()
 				got_infected = regular.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, 
 					retirement_homes, carpools, public_transit, leisure_locations,
-					infection_parameters, agents, flu, testing);
+					parameters, agents, flu, testing);
 			}else if (agent.exposed() == true){
 				state_changes = regular.exposed_transitions(agent, infection, time, dt, 
 					households, schools, workplaces, hospitals, retirement_homes, 
-					carpools, public_transit, infection_parameters, testing);
+					carpools, public_transit, parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = regular.symptomatic_transitions(agent, time, dt, infection,
 					households, schools, workplaces, hospitals, retirement_homes,
-					carpools, public_transit, infection_parameters);
+					carpools, public_transit, parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, schools, hospitals, retirement_homes, 
 									workplaces, carpools, public_transit, 
@@ -531,6 +534,7 @@ bool test_exposed_transitions_seeded()
 
 	Infection& infection = abm.get_infection_object();
     const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+    const InfectionParameters& parameters = abm.get_infection_params();
 	Testing testing = abm.get_testing_object();
 	Flu flu = abm.get_flu_object();
 
@@ -569,11 +573,11 @@ bool test_exposed_transitions_seeded()
 				got_infected = regular.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, 
 					retirement_homes, carpools, public_transit, leisure_locations,
-					infection_parameters, agents, flu, testing);
+					parameters, agents, flu, testing);
 			} else if (agent.exposed() == true){
 				state_changes = regular.exposed_transitions(agent, infection, time, dt, 
 					households, schools, workplaces, hospitals, retirement_homes,
-					carpools, public_transit, infection_parameters, testing);
+					carpools, public_transit, parameters, testing);
 				// Verify each possible state
 				if (agent.exposed()){
 					if (!check_testing_transitions(agent, households, schools, 
@@ -700,6 +704,7 @@ bool test_symptomatic_transitions_seeded()
 
 	Infection& infection = abm.get_infection_object();
 	const std::map<std::string, double> infection_parameters = abm.get_infection_parameters(); 
+	const InfectionParameters& parameters = abm.get_infection_params();
 	Flu& flu = abm.get_flu_object();
 	Testing testing = abm.get_testing_object();
 
@@ -739,15 +744,15 @@ bool test_symptomatic_transitions_seeded()
 				got_infected = regular.susceptible_transitions(agent, time, infection,
 					households, schools, workplaces, hospitals, 
 					retirement_homes, carpools, public_transit, leisure_locations,
-					infection_parameters, agents, flu, testing);
+					parameters, agents, flu, testing);
 			}else if (agent.exposed() == true){
 				state_changes = regular.exposed_transitions(agent, infection, time, dt, 
 					households, schools, workplaces, hospitals, retirement_homes, 
-					carpools, public_transit, infection_parameters, testing);
+					carpools, public_transit, parameters, testing);
 			} else if (agent.symptomatic() == true){
 				state_changes = regular.symptomatic_transitions(agent, time, dt, infection,
 					households, schools, workplaces, hospitals, retirement_homes,
-					carpools, public_transit, infection_parameters);
+					carpools, public_transit, parameters);
 				if (agent.removed()){
 					if (!check_symptomatic_agent_removal(agent, households, schools, hospitals, retirement_homes, 
 									workplaces, carpools, public_transit, state_changes, n_sy_recovering, n_sy_dying, time, dt)){